@@ -0,0 +1,409 @@
+/********************************************************************
+ * audit09.c
+ *
+ *  MC6809E CPU emulation cycle accounting audit.
+ *  Runs all test code and the Dragon 32 ROM through a CPU module
+ *  built with CPU_CYCLE_AUDIT, and reports the instructions whose
+ *  cycle counts do not match the cycle reference, with their
+ *  address and op-code.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "mem.h"
+#include    "cpu.h"
+
+/* -----------------------------------------
+   Include files for MC6909E test code.
+   Each test file defines a 'code' array and
+   load/run addresses, rename them on inclusion
+   so they can coexist in this module.
+----------------------------------------- */
+#define     code    code_addr
+#include    "test/addr.h"
+#undef      code
+static const int addr_load = LOAD_ADDRESS, addr_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_arith
+#include    "test/arith.h"
+#undef      code
+static const int arith_load = LOAD_ADDRESS, arith_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_bcc
+#include    "test/bcc.h"
+#undef      code
+static const int bcc_load = LOAD_ADDRESS, bcc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_branch
+#include    "test/branch.h"
+#undef      code
+static const int branch_load = LOAD_ADDRESS, branch_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_fusion
+#include    "test/fusion.h"
+#undef      code
+static const int fusion_load = LOAD_ADDRESS, fusion_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_irq
+#include    "test/irq.h"
+#undef      code
+static const int irq_load = LOAD_ADDRESS, irq_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_logic
+#include    "test/logic.h"
+#undef      code
+static const int logic_load = LOAD_ADDRESS, logic_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_misc
+#include    "test/misc.h"
+#undef      code
+static const int misc_load = LOAD_ADDRESS, misc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_prefix
+#include    "test/prefix.h"
+#undef      code
+static const int prefix_load = LOAD_ADDRESS, prefix_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_profile
+#include    "test/profile.h"
+#undef      code
+static const int profile_load = LOAD_ADDRESS, profile_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_smc
+#include    "test/smc.h"
+#undef      code
+static const int smc_load = LOAD_ADDRESS, smc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_stack
+#include    "test/stack.h"
+#undef      code
+static const int stack_load = LOAD_ADDRESS, stack_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_swi
+#include    "test/swi.h"
+#undef      code
+static const int swi_load = LOAD_ADDRESS, swi_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_dragon
+#include    "dragon/dragon.h"
+#undef      code
+static const int dragon_load = LOAD_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     AUDIT_INSTRUCTIONS      1000000     // Default maximum emulated instructions per test
+#define     DRAGON_ROM_START        0x8000
+#define     DRAGON_ROM_END          0xfeff
+#define     DRAGON_PIA_START        0xff00
+#define     DRAGON_PIA_END          0xff3f
+#define     DRAGON_VECTOR_START     0xfff0
+#define     DRAGON_VECTOR_END       0xffff
+#define     DRAGON_VECTOR_TARGET    0xbff0      // Vectors read from the top of the ROM image
+#define     IO_ADDR_ACIA_CS         0xf000      // irq.asm IO devices
+#define     IO_ADDR_ACIA_DAT        0xf001
+#define     IO_ADDR_FIRQ_ACK        0xf002
+#define     IO_ADDR_IRQ_ACK         0xf003
+#define     NMI_INTERVAL            3000        // irq.asm interrupt intervals in instructions
+#define     FIRQ_INTERVAL           5000
+#define     IRQ_INTERVAL            7000
+
+#define     AUDIT_CODE              0           // Test code, runs to its last instruction
+#define     AUDIT_IRQ               1           // Interrupt test code, runs with interrupts and IO
+#define     AUDIT_ROM               2           // Dragon ROM image, needs IO and reset vector
+
+typedef struct
+{
+    char       *name;
+    const int  *code;
+    int         load_address;
+    int         run_address;
+    int         type;
+} audit_test_t;
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+int     run_audit(audit_test_t *test, long instructions);
+int     load_code(audit_test_t *test);
+uint8_t io_handler_acia(uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_firq_ack(uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_irq_ack(uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+audit_test_t tests[] =
+{
+    { "addr",    code_addr,         addr_load,    addr_run,    AUDIT_CODE },
+    { "arith",   code_arith,        arith_load,   arith_run,   AUDIT_CODE },
+    { "bcc",     code_bcc,          bcc_load,     bcc_run,     AUDIT_CODE },
+    { "branch",  code_branch,       branch_load,  branch_run,  AUDIT_CODE },
+    { "fusion",  code_fusion,       fusion_load,  fusion_run,  AUDIT_CODE },
+    { "irq",     code_irq,          irq_load,     irq_run,     AUDIT_IRQ },
+    { "logic",   code_logic,        logic_load,   logic_run,   AUDIT_CODE },
+    { "misc",    code_misc,         misc_load,    misc_run,    AUDIT_CODE },
+    { "prefix",  code_prefix,       prefix_load,  prefix_run,  AUDIT_CODE },
+    { "profile", code_profile,      profile_load, profile_run, AUDIT_CODE },
+    { "smc",     code_smc,          smc_load,     smc_run,     AUDIT_CODE },
+    { "stack",   code_stack,        stack_load,   stack_run,   AUDIT_CODE },
+    { "swi",     code_swi,          swi_load,     swi_run,     AUDIT_CODE },
+    { "dragon",  code_dragon,       dragon_load,  0,           AUDIT_ROM },
+};
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: audit09 [instructions]
+ *
+ *  Build with a CPU module compiled with CPU_CYCLE_AUDIT,
+ *  returns '1' if any instruction cycle count did not match.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    int                 i, mismatches = 0;
+    long                instructions = AUDIT_INSTRUCTIONS;
+    cpu_cycle_audit_t   audit;
+
+    if ( argc > 1 )
+        instructions = atol(argv[1]);
+
+    if ( cpu_get_cycle_audit(&audit, 1) )
+    {
+        printf("CPU module is not built with CPU_CYCLE_AUDIT.\n");
+        return 1;
+    }
+
+    printf("MC6809E cycle accounting audit, up to %li instructions per test.\n", instructions);
+    printf("%-8s %12s %12s %12s %12s\n", "Test", "Instructions", "Cycles", "Checked", "Mismatches");
+
+    for ( i = 0; i < sizeof(tests)/sizeof(audit_test_t); i++ )
+    {
+        mismatches += run_audit(&tests[i], instructions);
+    }
+
+    return (mismatches != 0);
+}
+
+/*------------------------------------------------
+ * run_audit()
+ *
+ *  Run a test with cpu_run() until its last instruction, an
+ *  emulation exception or a count of instructions. Print the
+ *  instructions checked by the cycle audit and the log of mismatches.
+ *  The interrupt test runs with NMI, FIRQ and IRQ at fixed
+ *  instruction intervals, the Dragon ROM runs without a breakpoint.
+ *
+ *  param:  Pointer to test, maximum emulated instruction count
+ *  return: Count of instructions with mismatched cycles
+ */
+int run_audit(audit_test_t *test, long instructions)
+{
+    long                count;
+    int                 i, break_point;
+    cpu_state_t         cpu_state;
+    cpu_cycle_audit_t   audit;
+    cpu_audit_mismatch_t *entry;
+
+    break_point = load_code(test);
+    cpu_get_cycle_audit(&audit, 1);
+
+    for ( count = 0; count < instructions; count++ )
+    {
+        if ( test->type == AUDIT_IRQ )
+        {
+            if ( count % NMI_INTERVAL == NMI_INTERVAL - 1 )
+                cpu_nmi_trigger();
+            if ( count % FIRQ_INTERVAL == FIRQ_INTERVAL - 1 )
+                cpu_firq(1);
+            if ( count % IRQ_INTERVAL == IRQ_INTERVAL - 1 )
+                cpu_irq(1);
+        }
+
+        cpu_run();
+        cpu_get_state(&cpu_state);
+
+        if ( cpu_state.cpu_state == CPU_EXCEPTION )
+        {
+            printf("%-8s exception at pc=0x%04x (cpu.c line %i)\n", test->name, cpu_state.last_pc, cpu_state.exception_line_num);
+            break;
+        }
+
+        if ( cpu_state.pc == break_point )
+        {
+            count++;
+            break;
+        }
+    }
+
+    cpu_get_cycle_audit(&audit, 1);
+
+    printf("%-8s %12li %12llu %12llu %12llu\n", test->name, count, (unsigned long long) cpu_get_cycles(),
+            (unsigned long long) audit.instructions, (unsigned long long) audit.mismatches);
+
+    for ( i = 0; i < audit.logged; i++ )
+    {
+        entry = &audit.log[i];
+
+        printf("         pc=0x%04x op-code=0x%02x", entry->pc, entry->op_code);
+        if ( entry->post_byte != -1 )
+            printf(" post-byte=0x%02x", entry->post_byte);
+        printf(" %-5s cycles %i, reference ", cpu_get_menmonic(entry->pc), entry->cycles);
+        if ( entry->expected == -1 )
+            printf("none");
+        else
+            printf("%i", entry->expected);
+        printf(", %lu times\n", entry->count);
+    }
+
+    if ( audit.lost )
+        printf("         %lu mismatched instructions not logged\n", audit.lost);
+
+    return (int) audit.mismatches;
+}
+
+/*------------------------------------------------
+ * load_code()
+ *
+ *  Load test code or the Dragon ROM image into memory,
+ *  set up its IO, and initialize the CPU.
+ *
+ *  param:  Pointer to test
+ *  return: Address of the last instruction of test code,
+ *          '-1' for the interrupt test and the Dragon ROM
+ */
+int load_code(audit_test_t *test)
+{
+    int     i = 0;
+
+    mem_init();
+
+    while ( test->code[i] != -1 )
+    {
+        mem_write(i + test->load_address, test->code[i]);
+        i++;
+    }
+
+    if ( test->type == AUDIT_ROM )
+    {
+        /* Minimal Dragon 32 IO, no key pressed and
+         * reset vectors redirected to the ROM image
+         */
+        mem_define_rom(DRAGON_ROM_START, DRAGON_ROM_END);
+        mem_define_io(DRAGON_PIA_START, DRAGON_PIA_END, io_handler_pia);
+        mem_define_alias(DRAGON_VECTOR_START, DRAGON_VECTOR_END, DRAGON_VECTOR_TARGET);
+
+        cpu_init(test->run_address);
+        cpu_reset(1);
+        cpu_run();
+        cpu_reset(0);
+
+        return -1;
+    }
+
+    cpu_init(test->run_address);
+
+    if ( test->type == AUDIT_IRQ )
+    {
+        mem_define_io(IO_ADDR_ACIA_CS, IO_ADDR_ACIA_DAT, io_handler_acia);
+        mem_define_io(IO_ADDR_FIRQ_ACK, IO_ADDR_FIRQ_ACK, io_handler_firq_ack);
+        mem_define_io(IO_ADDR_IRQ_ACK, IO_ADDR_IRQ_ACK, io_handler_irq_ack);
+
+        return -1;
+    }
+
+    return (i + test->load_address - 1);
+}
+
+/*------------------------------------------------
+ * io_handler_acia()
+ *
+ *  ACIA stub, always ready to transmit, output is discarded.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_acia(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    if ( address == IO_ADDR_ACIA_CS )
+        return 0x02;
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * io_handler_firq_ack()
+ *
+ *  FIRQ acknowledge, removes the FIRQ request.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_firq_ack(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    cpu_firq(0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_irq_ack()
+ *
+ *  IRQ acknowledge, removes the IRQ request.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_irq_ack(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    cpu_irq(0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub returning an idle keyboard and joystick state.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    return 0xff;
+}
@@ -0,0 +1,919 @@
+/********************************************************************
+ * bench09.c
+ *
+ *  MC6809E CPU emulation benchmark.
+ *  Runs test code and the Dragon 32 ROM through the CPU emulation
+ *  and reports host time per emulated instruction and the
+ *  equivalent emulated CPU clock rate.
+ *  Checks and times all 256 indexed addressing post-bytes.
+ *  Times memory module reads and writes.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <time.h>
+
+#include    "mem.h"
+#include    "cpu.h"
+
+/* -----------------------------------------
+   Include files for MC6909E test code.
+   Each test file defines a 'code' array and
+   load/run addresses, rename them on inclusion
+   so they can coexist in this module.
+----------------------------------------- */
+#define     code    code_addr
+#include    "test/addr.h"
+#undef      code
+static const int addr_load = LOAD_ADDRESS, addr_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_arith
+#include    "test/arith.h"
+#undef      code
+static const int arith_load = LOAD_ADDRESS, arith_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_branch
+#include    "test/branch.h"
+#undef      code
+static const int branch_load = LOAD_ADDRESS, branch_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_bcc
+#include    "test/bcc.h"
+#undef      code
+static const int bcc_load = LOAD_ADDRESS, bcc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_logic
+#include    "test/logic.h"
+#undef      code
+static const int logic_load = LOAD_ADDRESS, logic_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_misc
+#include    "test/misc.h"
+#undef      code
+static const int misc_load = LOAD_ADDRESS, misc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_stack
+#include    "test/stack.h"
+#undef      code
+static const int stack_load = LOAD_ADDRESS, stack_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_swi
+#include    "test/swi.h"
+#undef      code
+static const int swi_load = LOAD_ADDRESS, swi_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_profile
+#include    "test/profile.h"
+#undef      code
+static const int profile_load = LOAD_ADDRESS, profile_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_prefix
+#include    "test/prefix.h"
+#undef      code
+static const int prefix_load = LOAD_ADDRESS, prefix_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_dragon
+#include    "dragon/dragon.h"
+#undef      code
+static const int dragon_load = LOAD_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     BENCH_INSTRUCTIONS      5000000     // Default emulated instructions per benchmark
+#define     BENCH_RUNS              5           // Benchmark repetitions, fastest run is reported
+#define     BENCH_BATCH_CYCLES      17784       // cpu_run_cycles() budget, one 50Hz video frame
+#define     DRAGON_ROM_START        0x8000
+#define     DRAGON_ROM_END          0xfeff
+#define     DRAGON_PIA_START        0xff00
+#define     DRAGON_PIA_END          0xff3f
+#define     DRAGON_VECTOR_START     0xfff0
+#define     DRAGON_VECTOR_END       0xffff
+#define     DRAGON_VECTOR_TARGET    0xbff0      // Vectors read from the top of the ROM image
+#define     INDEX_SETUP_ADDRESS     0x1000      // Indexed addressing test, register setup code
+#define     INDEX_CODE_ADDRESS      0x1011      // Indexed addressing test, LEA code after the setup
+#define     INDEX_COPIES            64          // LEA copies in the timed loop
+#define     INDEX_OFFSET_HIGH       0x12        // Offset bytes following the post-byte
+#define     INDEX_OFFSET_LOW        0x34
+#define     MEM_BENCH_ADDRESSES     4096        // Random addresses of the memory benchmark
+#define     MEM_BENCH_RAM_MASK      0x7fff      // Dragon 32 RAM addresses for writes
+
+typedef struct
+{
+    char       *name;
+    const int  *code;
+    int         load_address;
+    int         run_address;
+    int         is_rom;         // Dragon ROM image, needs IO and reset vector
+    cpu_fusion_stats_t fusion;  // Superinstruction fusion statistics of the last cpu_run_cycles() run
+    cpu_idle_stats_t idle;      // Guest idle statistics of the last cpu_run_cycles() run
+} benchmark_t;
+
+/* Expected result of an LEA with an indexed post-byte
+ */
+typedef struct
+{
+    uint16_t    x, y, u, s, pc;
+    uint8_t     cc;
+    int         cycles;
+    int         bytes;
+    int         exception;
+} index_result_t;
+
+/* Indexed addressing modes of the post-byte low nibble
+ */
+typedef struct
+{
+    char       *name;
+    int         cycles;             // Extra cycles
+    int         cycles_indirect;    // Extra cycles, indirect
+    int         bytes;              // Extra bytes
+    int         legal;
+} index_mode_t;
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+void    run_benchmark(benchmark_t *benchmark, long instructions);
+void    print_fusion(benchmark_t *benchmark, long instructions);
+double  run_step(benchmark_t *benchmark, long instructions, long long *cycles);
+double  run_batch(benchmark_t *benchmark, long long cycles, cpu_predecode_stats_t *stats);
+int     load_code(benchmark_t *benchmark);
+int     run_index_benchmark(long instructions);
+int     index_check(int post_byte);
+double  index_time(int post_byte, long instructions);
+int     index_load(int post_byte, int address);
+void    index_reference(int post_byte, index_result_t *result);
+void    run_memory_benchmark(long accesses);
+double  memory_time(int write, int random, long accesses);
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+benchmark_t benchmarks[] =
+{
+    { "addr",    code_addr,         addr_load,    addr_run,    0 },
+    { "arith",   code_arith,        arith_load,   arith_run,   0 },
+    { "branch",  code_branch,       branch_load,  branch_run,  0 },
+    { "bcc",     code_bcc,          bcc_load,     bcc_run,     0 },
+    { "logic",   code_logic,        logic_load,   logic_run,   0 },
+    { "misc",    code_misc,         misc_load,    misc_run,    0 },
+    { "stack",   code_stack,        stack_load,   stack_run,   0 },
+    { "swi",     code_swi,          swi_load,     swi_run,     0 },
+    { "profile", code_profile,      profile_load, profile_run, 0 },
+    { "prefix",  code_prefix,       prefix_load,  prefix_run,  0 },
+    { "dragon",  code_dragon,       dragon_load,  0,           1 },
+};
+
+/* Random addresses of the memory benchmark, and the sum
+ * of the values read so that reads are not optimized away
+ */
+uint16_t        mem_addresses[MEM_BENCH_ADDRESSES];
+volatile int    mem_sink;
+
+/* Register setup of the indexed addressing test:
+ * LDX #$2000, LDY #$3000, LDU #$4000, LDS #$5000, LDD #$8507
+ */
+const uint8_t index_setup[] =
+{
+    0x8e, 0x20, 0x00,
+    0x10, 0x8e, 0x30, 0x00,
+    0xce, 0x40, 0x00,
+    0x10, 0xce, 0x50, 0x00,
+    0xcc, 0x85, 0x07,
+};
+
+/* Index modes by post-byte bits 0 to 3, for post-bytes with bit 7 set.
+ * From the MC6809E data sheet indexed addressing table. Post-bytes the
+ * data sheet does not define are handled the same as the CPU emulation:
+ * ',R+' and ',-R' resolve an indirect address if bit 4 is set, and
+ * '[n16]' is not indirect if bit 4 is clear.
+ */
+const index_mode_t index_modes[16] =
+{
+    { ",R+",     2, 2, 0, 1 },
+    { ",R++",    3, 6, 0, 1 },
+    { ",-R",     2, 2, 0, 1 },
+    { ",--R",    3, 6, 0, 1 },
+    { ",R",      0, 3, 0, 1 },
+    { "B,R",     1, 4, 0, 1 },
+    { "A,R",     1, 4, 0, 1 },
+    { "illegal", 0, 0, 0, 0 },
+    { "n8,R",    1, 4, 1, 1 },
+    { "n16,R",   4, 7, 2, 1 },
+    { "illegal", 0, 0, 0, 0 },
+    { "D,R",     4, 7, 0, 1 },
+    { "n8,PCR",  1, 4, 1, 1 },
+    { "n16,PCR", 5, 8, 2, 1 },
+    { "illegal", 0, 0, 0, 0 },
+    { "[n16]",   5, 5, 2, 1 },
+};
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: bench09 [instructions]
+ *
+ */
+int main(int argc, char *argv[])
+{
+    int                 i;
+    long                instructions = BENCH_INSTRUCTIONS;
+    cpu_fusion_stats_t  fusion;
+
+    if ( argc > 1 )
+        instructions = atol(argv[1]);
+
+    printf("MC6809E emulation benchmark, %li instructions per test.\n", instructions);
+    printf("%-34s %-25s %-25s\n", "", "cpu_run()", "cpu_run_cycles()");
+    printf("%-8s %12s %12s %12s %12s %12s %12s %12s %12s %12s\n", "Test", "Instructions", "Cycles", "nSec/instr", "Emulated MHz", "nSec/instr", "Emulated MHz", "Predecode %", "Block %", "Idle %");
+
+    for ( i = 0; i < sizeof(benchmarks)/sizeof(benchmark_t); i++ )
+    {
+        run_benchmark(&benchmarks[i], instructions);
+    }
+
+    cpu_get_fusion_stats(&fusion, 0);
+
+    printf("\nSuperinstruction fusion, fused pair executions in cpu_run_cycles().\n");
+    printf("%-8s", "Test");
+    for ( i = 0; i < CPU_FUSION_TYPES; i++ )
+    {
+        printf(" %14s", fusion.name[i]);
+    }
+    printf(" %14s\n", "Saved %");
+
+    for ( i = 0; i < sizeof(benchmarks)/sizeof(benchmark_t); i++ )
+    {
+        print_fusion(&benchmarks[i], instructions);
+    }
+
+    if ( run_index_benchmark(instructions) )
+        return 1;
+
+    run_memory_benchmark(instructions);
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * run_benchmark()
+ *
+ *  Run a benchmark for a given count of instructions, once
+ *  by single instruction steps with cpu_run() and once in batches
+ *  of cycles with cpu_run_cycles(). Each is repeated BENCH_RUNS times
+ *  and the fastest run is reported, with the predecoded
+ *  instruction cache hit ratio, translated block ratio
+ *  and guest idle ratio of the cpu_run_cycles() runs.
+ *
+ *  param:  Pointer to benchmark and emulated instruction count
+ *  return: None
+ */
+void run_benchmark(benchmark_t *benchmark, long instructions)
+{
+    long long               cycles = 0;
+    int                     run;
+    double                  elapsed, best_step = 0, best_batch = 0;
+    cpu_predecode_stats_t   stats;
+
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        elapsed = run_step(benchmark, instructions, &cycles);
+        if ( elapsed < 0 )
+            return;
+        if ( run == 0 || elapsed < best_step )
+            best_step = elapsed;
+    }
+
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        elapsed = run_batch(benchmark, cycles, &stats);
+        if ( run == 0 || elapsed < best_batch )
+            best_batch = elapsed;
+    }
+
+    printf("%-8s %12li %12lli %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f\n", benchmark->name, instructions, cycles,
+            best_step / instructions, cycles / (best_step / 1e3),
+            best_batch / instructions, cycles / (best_batch / 1e3),
+            stats.hit_ratio, stats.block_ratio, benchmark->idle.idle_ratio);
+}
+
+/*------------------------------------------------
+ * print_fusion()
+ *
+ *  Print the superinstruction fusion statistics of a benchmark's
+ *  last cpu_run_cycles() run: executions of each fused pair, and the
+ *  instruction dispatches saved as percent of instructions executed.
+ *
+ *  param:  Pointer to benchmark and emulated instruction count
+ *  return: None
+ */
+void print_fusion(benchmark_t *benchmark, long instructions)
+{
+    int     i;
+
+    printf("%-8s", benchmark->name);
+    for ( i = 0; i < CPU_FUSION_TYPES; i++ )
+    {
+        printf(" %14lu", benchmark->fusion.fired[i]);
+    }
+    printf(" %14.2f\n", (100.0 * benchmark->fusion.dispatches_saved) / instructions);
+}
+
+/*------------------------------------------------
+ * run_step()
+ *
+ *  Run a benchmark for a given count of instructions, one
+ *  cpu_run() call per instruction.
+ *  Test code is restarted when it reaches its last instruction,
+ *  the Dragon ROM runs without a breakpoint.
+ *
+ *  param:  Pointer to benchmark, emulated instruction count,
+ *          pointer to emulated cycle count result
+ *  return: Run time in nano-seconds, -1 if emulation exception
+ */
+double run_step(benchmark_t *benchmark, long instructions, long long *cycles)
+{
+    long            count = 0;
+    int             break_point;
+    struct timespec start, end;
+    cpu_state_t     cpu_state;
+
+    *cycles = 0;
+
+    break_point = load_code(benchmark);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while ( count < instructions )
+    {
+        cpu_run();
+        cpu_get_state(&cpu_state);
+
+        *cycles += cpu_state.last_opcode_cycles;
+        count++;
+
+        if ( cpu_state.cpu_state == CPU_EXCEPTION )
+        {
+            printf("%-8s exception at pc=0x%04x (cpu.c line %i)\n", benchmark->name, cpu_state.last_pc, cpu_state.exception_line_num);
+            return -1;
+        }
+
+        if ( cpu_state.pc == break_point )
+        {
+            cpu_init(benchmark->run_address);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+/*------------------------------------------------
+ * run_batch()
+ *
+ *  Run a benchmark for a given count of cycles with
+ *  cpu_run_cycles() calls of one video frame of cycles.
+ *  Test code is restarted when it reaches its last instruction,
+ *  the Dragon ROM runs without a breakpoint.
+ *
+ *  param:  Pointer to benchmark, emulated cycle count,
+ *          pointer to predecoded instruction cache statistics result
+ *  return: Run time in nano-seconds
+ */
+double run_batch(benchmark_t *benchmark, long long cycles, cpu_predecode_stats_t *stats)
+{
+    long long       count = 0;
+    int             break_point;
+    struct timespec start, end;
+    cpu_state_t     cpu_state;
+
+    break_point = load_code(benchmark);
+    cpu_break_point(break_point);
+    cpu_get_predecode_stats(stats, 1);
+    cpu_get_fusion_stats(&benchmark->fusion, 1);
+    cpu_get_idle_stats(&benchmark->idle, 1);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while ( count < cycles )
+    {
+        count += cpu_run_cycles(BENCH_BATCH_CYCLES);
+
+        if ( cpu_get_state(&cpu_state) == CPU_EXCEPTION )
+            break;
+
+        if ( cpu_state.pc == break_point )
+        {
+            cpu_init(benchmark->run_address);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    cpu_break_point(-1);
+
+    cpu_get_predecode_stats(stats, 1);
+    cpu_get_fusion_stats(&benchmark->fusion, 1);
+    cpu_get_idle_stats(&benchmark->idle, 1);
+
+    return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+/*------------------------------------------------
+ * run_index_benchmark()
+ *
+ *  Run an LEA instruction with each of the 256 indexed addressing
+ *  post-bytes. Check the effective address, register updates, cycles
+ *  and bytes against index_reference(), and report the time per
+ *  instruction of each index mode, direct and indirect.
+ *
+ *  param:  Emulated instruction count for all post-bytes
+ *  return: Count of post-bytes that do not match the reference
+ */
+int run_index_benchmark(long instructions)
+{
+    int     mode, reg, post_byte, mismatches = 0, total = 0;
+    long    count;
+    double  direct, indirect;
+
+    count = instructions / 256;
+    if ( count < INDEX_COPIES )
+        count = INDEX_COPIES;
+
+    printf("\nIndexed addressing, LEA with all 256 post-bytes, %li instructions per post-byte.\n", count);
+    printf("%-8s %12s %12s %12s %12s\n", "Mode", "Post-bytes", "nSec/instr", "Indirect", "Mismatches");
+
+    /* 5-bit offset post-bytes
+     */
+    direct = 0;
+    for ( post_byte = 0; post_byte < 0x80; post_byte++ )
+    {
+        mismatches += index_check(post_byte);
+        direct += index_time(post_byte, count);
+    }
+
+    printf("%-8s %12i %12.2f %12s %12i\n", "n5,R", 0x80, direct / 0x80, "-", mismatches);
+    total += mismatches;
+
+    /* Post-bytes by index mode, four index registers each
+     */
+    for ( mode = 0; mode < 16; mode++ )
+    {
+        mismatches = 0;
+        direct = 0;
+        indirect = 0;
+
+        for ( reg = 0; reg < 4; reg++ )
+        {
+            post_byte = 0x80 | (reg << 5) | mode;
+
+            mismatches += index_check(post_byte);
+            mismatches += index_check(post_byte | 0x10);
+
+            if ( index_modes[mode].legal )
+            {
+                direct += index_time(post_byte, count);
+                indirect += index_time(post_byte | 0x10, count);
+            }
+        }
+
+        if ( index_modes[mode].legal )
+            printf("%-8s %12i %12.2f %12.2f %12i\n", index_modes[mode].name, 8, direct / 4, indirect / 4, mismatches);
+        else
+            printf("%-8s %12i %12s %12s %12i\n", index_modes[mode].name, 8, "-", "-", mismatches);
+
+        total += mismatches;
+    }
+
+    return total;
+}
+
+/*------------------------------------------------
+ * index_check()
+ *
+ *  Run the register setup code and an LEA instruction with
+ *  an indexed addressing post-byte, and compare the CPU state
+ *  with the reference result.
+ *
+ *  param:  Post-byte
+ *  return: '0' if the CPU state matches the reference, '1' if not
+ */
+int index_check(int post_byte)
+{
+    int             i;
+    cpu_state_t     cpu_state;
+    index_result_t  expected;
+
+    index_load(post_byte, INDEX_CODE_ADDRESS);
+
+    cpu_init(INDEX_SETUP_ADDRESS);
+    for ( i = 0; i < 6; i++ )
+    {
+        cpu_run();
+    }
+    cpu_get_state(&cpu_state);
+
+    index_reference(post_byte, &expected);
+
+    if ( expected.exception )
+        return (cpu_state.cpu_state != CPU_EXCEPTION);
+
+    if ( cpu_state.cpu_state == CPU_EXCEPTION ||
+         cpu_state.x != expected.x || cpu_state.y != expected.y ||
+         cpu_state.u != expected.u || cpu_state.s != expected.s ||
+         cpu_state.pc != expected.pc || cpu_state.cc != expected.cc ||
+         cpu_state.last_opcode_cycles != expected.cycles ||
+         cpu_state.last_opcode_bytes != expected.bytes )
+    {
+        printf("post-byte 0x%02x mismatch\n", post_byte);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * index_time()
+ *
+ *  Time a loop of LEA instructions with an indexed
+ *  addressing post-byte, one cpu_run() call per instruction.
+ *  The loop is repeated BENCH_RUNS times and the fastest run is reported.
+ *
+ *  param:  Post-byte, emulated instruction count
+ *  return: Time per instruction in nano-seconds
+ */
+double index_time(int post_byte, long instructions)
+{
+    int             i, run, address;
+    long            count;
+    double          elapsed, best = 0;
+    struct timespec start, end;
+
+    address = INDEX_CODE_ADDRESS;
+    for ( i = 0; i < INDEX_COPIES; i++ )
+    {
+        address += index_load(post_byte, address);
+    }
+
+    mem_write(address, 0x7e);      // JMP INDEX_CODE_ADDRESS
+    mem_write(address + 1, INDEX_CODE_ADDRESS >> 8);
+    mem_write(address + 2, INDEX_CODE_ADDRESS & 0xff);
+
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        cpu_init(INDEX_SETUP_ADDRESS);
+        for ( i = 0; i < 5; i++ )
+        {
+            cpu_run();
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for ( count = 0; count < instructions; count++ )
+        {
+            cpu_run();
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        elapsed = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+    }
+
+    return best / instructions;
+}
+
+/*------------------------------------------------
+ * index_load()
+ *
+ *  Initialize memory with a data pattern for indirect addresses,
+ *  load the register setup code, and write an LEA instruction with
+ *  an indexed addressing post-byte. The instruction is LEAY if the
+ *  post-byte selects X as the index register, or LEAX if not.
+ *  Memory is initialized only when the instruction is written
+ *  right after the setup code.
+ *
+ *  param:  Post-byte, instruction address
+ *  return: Instruction length in bytes
+ */
+int index_load(int post_byte, int address)
+{
+    int     i, extra_bytes = 0;
+
+    if ( address == INDEX_CODE_ADDRESS )
+    {
+        mem_init();
+
+        for ( i = 0; i < 0x10000; i++ )
+        {
+            mem_write(i, (i ^ (i >> 8) ^ 0x5a) & 0xff);
+        }
+
+        for ( i = 0; i < sizeof(index_setup); i++ )
+        {
+            mem_write(INDEX_SETUP_ADDRESS + i, index_setup[i]);
+        }
+    }
+
+    if ( post_byte & 0x80 )
+        extra_bytes = index_modes[post_byte & 0x0f].bytes;
+
+    mem_write(address, (post_byte & 0x60) ? 0x30 : 0x31);
+    mem_write(address + 1, post_byte);
+    mem_write(address + 2, INDEX_OFFSET_HIGH);
+    mem_write(address + 3, INDEX_OFFSET_LOW);
+
+    return (2 + extra_bytes);
+}
+
+/*------------------------------------------------
+ * index_reference()
+ *
+ *  Compute the expected CPU state after the register setup code
+ *  and an LEA instruction with an indexed addressing post-byte.
+ *  Effective addresses and cycles follow the MC6809E data sheet.
+ *
+ *  param:  Post-byte, pointer to expected result
+ *  return: None
+ */
+void index_reference(int post_byte, index_result_t *result)
+{
+    const index_mode_t *mode = &index_modes[post_byte & 0x0f];
+    uint16_t           *index_reg;
+    uint16_t            effective_addr = 0;
+    int                 is_indirect = (post_byte & 0x10);
+
+    result->x = 0x2000;
+    result->y = 0x3000;
+    result->u = 0x4000;
+    result->s = 0x5000;
+    result->pc = INDEX_CODE_ADDRESS + 2;
+    result->cc = 0x08;                      // N flag set by LDD #$8507
+    result->cycles = 4;
+    result->bytes = 2;
+    result->exception = 0;
+
+    switch ( post_byte & 0x60 )
+    {
+        case 0x00:
+            index_reg = &result->x;
+            break;
+        case 0x20:
+            index_reg = &result->y;
+            break;
+        case 0x40:
+            index_reg = &result->u;
+            break;
+        default:
+            index_reg = &result->s;
+    }
+
+    if ( !(post_byte & 0x80) )
+    {
+        /* 5-bit signed offset
+         */
+        effective_addr = *index_reg + (int8_t)((post_byte & 0x1f) << 3) / 8;
+        result->cycles += 1;
+    }
+    else if ( !mode->legal )
+    {
+        result->exception = 1;
+        return;
+    }
+    else
+    {
+        result->cycles += is_indirect ? mode->cycles_indirect : mode->cycles;
+        result->bytes += mode->bytes;
+        result->pc += mode->bytes;
+
+        switch ( post_byte & 0x0f )
+        {
+            case 0:
+                effective_addr = (*index_reg)++;
+                break;
+            case 1:
+                effective_addr = *index_reg;
+                *index_reg += 2;
+                break;
+            case 2:
+                effective_addr = --(*index_reg);
+                break;
+            case 3:
+                *index_reg -= 2;
+                effective_addr = *index_reg;
+                break;
+            case 4:
+                effective_addr = *index_reg;
+                break;
+            case 5:
+                effective_addr = *index_reg + (int8_t) 0x07;     // B
+                break;
+            case 6:
+                effective_addr = *index_reg + (int8_t) 0x85;     // A
+                break;
+            case 8:
+                effective_addr = *index_reg + (int8_t) INDEX_OFFSET_HIGH;
+                break;
+            case 9:
+                effective_addr = *index_reg + ((INDEX_OFFSET_HIGH << 8) | INDEX_OFFSET_LOW);
+                break;
+            case 11:
+                effective_addr = *index_reg + 0x8507;           // D
+                break;
+            case 12:
+                effective_addr = result->pc + (int8_t) INDEX_OFFSET_HIGH;
+                break;
+            case 13:
+                effective_addr = result->pc + ((INDEX_OFFSET_HIGH << 8) | INDEX_OFFSET_LOW);
+                break;
+            case 15:
+                effective_addr = (INDEX_OFFSET_HIGH << 8) | INDEX_OFFSET_LOW;
+                break;
+        }
+
+        if ( is_indirect )
+            effective_addr = (mem_read(effective_addr) << 8) + mem_read(effective_addr + 1);
+    }
+
+    if ( post_byte & 0x60 )
+        result->x = effective_addr;
+    else
+        result->y = effective_addr;
+
+    if ( effective_addr == 0 )
+        result->cc |= 0x04;                 // Z flag
+}
+
+/*------------------------------------------------
+ * run_memory_benchmark()
+ *
+ *  Time mem_read() and mem_write() in sequential and random
+ *  address order, with the Dragon 32 memory map of ROM and IO
+ *  addresses. Reads cover all 64K addresses, writes cover RAM.
+ *  Random addresses come from a fixed table so that every
+ *  memory layout is timed with the same addresses.
+ *
+ *  param:  Count of accesses per test
+ *  return: None
+ */
+void run_memory_benchmark(long accesses)
+{
+    int     i;
+    uint32_t seed = 1;
+
+    for ( i = 0; i < MEM_BENCH_ADDRESSES; i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        mem_addresses[i] = (uint16_t) (seed >> 16);
+    }
+
+    mem_init();
+    mem_define_rom(DRAGON_ROM_START, DRAGON_ROM_END);
+    mem_define_io(DRAGON_PIA_START, DRAGON_PIA_END, io_handler_pia);
+    mem_define_alias(DRAGON_VECTOR_START, DRAGON_VECTOR_END, DRAGON_VECTOR_TARGET);
+
+    printf("\nMemory module, Dragon 32 memory map, %li accesses per test.\n", accesses);
+    printf("%-8s %12s %12s\n", "Access", "Addresses", "nSec/access");
+    printf("%-8s %12s %12.2f\n", "read", "sequential", memory_time(0, 0, accesses));
+    printf("%-8s %12s %12.2f\n", "read", "random", memory_time(0, 1, accesses));
+    printf("%-8s %12s %12.2f\n", "write", "sequential", memory_time(1, 0, accesses));
+    printf("%-8s %12s %12.2f\n", "write", "random", memory_time(1, 1, accesses));
+}
+
+/*------------------------------------------------
+ * memory_time()
+ *
+ *  Time a count of memory reads or writes.
+ *  The loop is repeated BENCH_RUNS times and the fastest run is reported.
+ *
+ *  param:  '1' write or '0' read, '1' random or '0' sequential addresses,
+ *          count of accesses
+ *  return: Time per access in nano-seconds
+ */
+double memory_time(int write, int random, long accesses)
+{
+    int             run, sum = 0;
+    long            count;
+    double          elapsed, best = 0;
+    struct timespec start, end;
+
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        if ( write && random )
+        {
+            for ( count = 0; count < accesses; count++ )
+                mem_write(mem_addresses[count % MEM_BENCH_ADDRESSES] & MEM_BENCH_RAM_MASK, (int) count);
+        }
+        else if ( write )
+        {
+            for ( count = 0; count < accesses; count++ )
+                mem_write(count & MEM_BENCH_RAM_MASK, (int) count);
+        }
+        else if ( random )
+        {
+            for ( count = 0; count < accesses; count++ )
+                sum += mem_read(mem_addresses[count % MEM_BENCH_ADDRESSES]);
+        }
+        else
+        {
+            for ( count = 0; count < accesses; count++ )
+                sum += mem_read(count & (MEMORY - 1));
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        elapsed = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+    }
+
+    mem_sink = sum;
+
+    return best / accesses;
+}
+
+/*------------------------------------------------
+ * load_code()
+ *
+ *  Initialize memory, load benchmark code and initialize the CPU.
+ *
+ *  param:  Pointer to benchmark
+ *  return: Break point address, -1 if none
+ */
+int load_code(benchmark_t *benchmark)
+{
+    int     i = 0;
+
+    mem_init();
+
+    while ( benchmark->code[i] != -1 )
+    {
+        mem_write(i + benchmark->load_address, benchmark->code[i]);
+        i++;
+    }
+
+    if ( benchmark->is_rom )
+    {
+        /* Minimal Dragon 32 IO, no key pressed and
+         * reset vectors redirected to the ROM image
+         */
+        mem_define_rom(DRAGON_ROM_START, DRAGON_ROM_END);
+        mem_define_io(DRAGON_PIA_START, DRAGON_PIA_END, io_handler_pia);
+        mem_define_alias(DRAGON_VECTOR_START, DRAGON_VECTOR_END, DRAGON_VECTOR_TARGET);
+
+        cpu_init(benchmark->run_address);
+        cpu_reset(1);
+        cpu_run();
+        cpu_reset(0);
+
+        return -1;
+    }
+
+    cpu_init(benchmark->run_address);
+
+    return (i + benchmark->load_address - 1);
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub returning an idle keyboard and joystick state.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    return 0xff;
+}
@@ -15,9 +15,23 @@
  *
  *******************************************************************/
 
+#include    <stdio.h>
+#include    <stddef.h>
+#include    <stdlib.h>
 #include    <string.h>
 
+#include    "config.h"
+#if (CPU_CONTEXTS)
+#include    <pthread.h>
+#endif
+#if (CPU_TRANSLATE_X86 && defined(__x86_64__) && defined(__linux__))
+#include    <sys/mman.h>
+#endif
 #include    "mc6809e.h"
+#include    "mc6809e_ops.h"
+#if (CPU_CYCLE_AUDIT)
+#include    "mc6809e_cycles.h"
+#endif
 #include    "mem.h"
 #include    "cpu.h"
 
@@ -37,12 +51,64 @@
 #define     VEC_SWI3                0xfff2
 #define     VEC_RESERVED            0xfff0
 
+/* Host cache line size in bytes
+ */
+#define     CACHE_LINE              64
+
 /* Interrupt sources
  */
 #define     INT_NMI                 1
 #define     INT_IRQ                 2
 #define     INT_FIRQ                4
 
+/* Interrupt entry cycles, from the end of the interrupted
+ * instruction to the first cycle of the service routine
+ */
+#define     INT_CYCLES_NMI          19
+#define     INT_CYCLES_FIRQ         10
+#define     INT_CYCLES_IRQ          19
+
+/* HD6309 mode and error register (MD) bits, illegal op-code and
+ * division by zero trap cycles, and the cycles native mode adds
+ * to interrupt frames for stacking E and F
+ */
+#define     MD_NATIVE               0x01        // Native mode
+#define     MD_FIRQ_ALL             0x02        // FIRQ stacks the entire machine state
+#define     MD_ILLEGAL              0x40        // Illegal op-code trap
+#define     MD_DIV0                 0x80        // Division by zero trap
+
+#define     INT_CYCLES_TRAP         20
+#define     INT_CYCLES_NATIVE       2
+
+/* HD6309 bit transfer operations, in BAND to STBT op-code order
+ */
+#define     BIT_AND                 0
+#define     BIT_IAND                1
+#define     BIT_OR                  2
+#define     BIT_IOR                 3
+#define     BIT_EOR                 4
+#define     BIT_IEOR                5
+#define     BIT_LDBT                6
+#define     BIT_STBT                7
+
+/* Pending event word bits. RESET, HALT and the interrupt lines are set
+ * when the lines change, and EVENT_STATE while the CPU state is not
+ * CPU_EXEC. Instructions are fetched without any other checks while
+ * the word is '0'.
+ */
+#define     EVENT_NMI               INT_NMI     // NMI latched
+#define     EVENT_IRQ               INT_IRQ     // IRQ line asserted
+#define     EVENT_FIRQ              INT_FIRQ    // FIRQ line asserted
+#define     EVENT_RESET             8
+#define     EVENT_HALT              16
+#define     EVENT_STATE             32          // SYNC or CWAI wait, HALTED, RESET or exception state
+
+/* CPU states that use up clock cycles without executing instructions
+ */
+#define     CPU_WAITING(c)          ((c)->cpu.cpu_state == CPU_SYNC || \
+                                     (c)->cpu.cpu_state == CPU_HALTED || \
+                                     (c)->cpu.cpu_state == CPU_RESET)
+
 /* Indexed addressing post-byte bit fields
  */
 #define     INDX_POST_5BIT_OFF      0x80
@@ -55,12 +121,414 @@
 #define     CC_FLAG_CLR             0
 #define     CC_FLAG_SET             1
 
+/* Condition-code register bit masks
+ */
+#define     CC_C                    0x01
+#define     CC_V                    0x02
+#define     CC_Z                    0x04
+#define     CC_N                    0x08
+#define     CC_I                    0x10
+#define     CC_H                    0x20
+#define     CC_F                    0x40
+#define     CC_E                    0x80
+
+/* Condition-code flag access.
+ * The CC register is the 'cc' byte of the register file, and a flag
+ * read returns CC_FLAG_SET or CC_FLAG_CLR.
+ * With CPU_LAZY_CC the flag members of 'cc' in the CPU context hold
+ * the raw result term N, Z, V, C and H are derived from, and the
+ * flag bit is only extracted on read:
+ *   C = bit 16, N = bit 15, V = bit 15, H = bit 4, Z = term is zero.
+ * 8-bit terms are shifted left by 8 when recorded.
+ */
+#if (CPU_LAZY_CC)
+#define     GET_CC_C()              ((active->cc.c >> 16) & 0x01)
+#define     GET_CC_V()              ((active->cc.v >> 15) & 0x01)
+#define     GET_CC_Z()              (active->cc.z == 0)
+#define     GET_CC_N()              ((active->cc.n >> 15) & 0x01)
+#define     GET_CC_H()              ((active->cc.h >> 4) & 0x01)
+#define     GET_CC_I()              (active->cc.i)
+#define     GET_CC_F()              (active->cc.f)
+#define     GET_CC_E()              (active->cc.e)
+#define     SET_CC_C(flag)          (active->cc.c = (flag) << 16)
+#define     SET_CC_V(flag)          (active->cc.v = (flag) << 15)
+#define     SET_CC_Z(flag)          (active->cc.z = !(flag))
+#define     SET_CC_N(flag)          (active->cc.n = (flag) << 15)
+#define     SET_CC_H(flag)          (active->cc.h = (flag) << 4)
+#define     SET_CC_I(flag)          (active->cc.i = (flag))
+#define     SET_CC_F(flag)          (active->cc.f = (flag))
+#define     SET_CC_E(flag)          (active->cc.e = (flag))
+#else
+#define     GET_CC_BIT(bit)         ((active->cpu.cc >> (bit)) & 0x01)
+#define     SET_CC_BIT(mask, flag)  (active->cpu.cc = (active->cpu.cc & ~(mask)) | ((flag) ? (mask) : 0))
+#define     GET_CC_C()              GET_CC_BIT(0)
+#define     GET_CC_V()              GET_CC_BIT(1)
+#define     GET_CC_Z()              GET_CC_BIT(2)
+#define     GET_CC_N()              GET_CC_BIT(3)
+#define     GET_CC_I()              GET_CC_BIT(4)
+#define     GET_CC_H()              GET_CC_BIT(5)
+#define     GET_CC_F()              GET_CC_BIT(6)
+#define     GET_CC_E()              GET_CC_BIT(7)
+#define     SET_CC_C(flag)          SET_CC_BIT(CC_C, flag)
+#define     SET_CC_V(flag)          SET_CC_BIT(CC_V, flag)
+#define     SET_CC_Z(flag)          SET_CC_BIT(CC_Z, flag)
+#define     SET_CC_N(flag)          SET_CC_BIT(CC_N, flag)
+#define     SET_CC_I(flag)          SET_CC_BIT(CC_I, flag)
+#define     SET_CC_H(flag)          SET_CC_BIT(CC_H, flag)
+#define     SET_CC_F(flag)          SET_CC_BIT(CC_F, flag)
+#define     SET_CC_E(flag)          SET_CC_BIT(CC_E, flag)
+#endif
+
+/* Conditional branch decision, by the low nibble of the branch op-code
+ * and the packed CC register. With CPU_LAZY_CC only the N, Z, V and C
+ * flags are packed into the table index.
+ */
+#if (CPU_LAZY_CC)
+#define     BRANCH_CC()             ((GET_CC_N() << 3) | (GET_CC_Z() << 2) | (GET_CC_V() << 1) | GET_CC_C())
+#else
+#define     BRANCH_CC()             (active->cpu.cc)
+#endif
+#define     BRANCH_TAKEN(op_code)   (branch_taken[(op_code) & 0x0f][BRANCH_CC()])
+
 /* Word and Byte operations
  */
 #define     GET_REG_HIGH(r)         ((uint8_t)(r >> 8))
 #define     GET_REG_LOW(r)          ((uint8_t)r)
 #define     SIG_EXTEND(b)           ((((uint8_t)b) & 0x80) ? (((uint16_t)b) | 0xff00):((uint16_t)b))
 
+/* HD6309 variant: op-code cycle counts come from
+ * the native mode column in native mode
+ */
+#if (CPU_6309)
+#if (CPU_DISPATCH == CPU_DISPATCH_SWITCH)
+#error "CPU_6309 requires the table or computed-goto dispatch engine"
+#endif
+#define     NATIVE_MODE()           (active->cpu.md & MD_NATIVE)
+#define     CYCLES(entry)           (NATIVE_MODE() ? (entry).cycles_native : (entry).cycles)
+#else
+#define     CYCLES(entry)           ((entry).cycles)
+#endif
+
+/* Op-code decode table entry for the 0x10 and 0x11
+ * double-byte op-code pages. The tables are indexed directly
+ * by the second op-code byte.
+ */
+typedef struct
+{
+    int     mode;
+    int     cycles;
+    int     cycles_native;
+    int     bytes;
+    int     index;      // Entry in machine_code[], or -1 for illegal op-code
+} op_decode_t;
+
+/* Indexed addressing post-byte decode table entry.
+ * The table is indexed directly by the post-byte, and resolves
+ * the index register, offset, auto increment/decrement,
+ * indirection, and the cycles and bytes the mode adds.
+ */
+#define     INDX_OFFSET_NONE        0           // EA = ,R
+#define     INDX_OFFSET_POST_INC    1           // EA = ,R+ ,R++
+#define     INDX_OFFSET_PRE_DEC     2           // EA = ,-R ,--R
+#define     INDX_OFFSET_5BIT        3           // EA = n,R 5-bit offset in the post-byte
+#define     INDX_OFFSET_ACCB        4           // EA = B,R
+#define     INDX_OFFSET_ACCA        5           // EA = A,R
+#define     INDX_OFFSET_ACCD        6           // EA = D,R
+#define     INDX_OFFSET_8BIT        7           // EA = n,R 8-bit offset
+#define     INDX_OFFSET_16BIT       8           // EA = n,R 16-bit offset
+#define     INDX_OFFSET_PC8         9           // EA = n,PCR 8-bit offset
+#define     INDX_OFFSET_PC16        10          // EA = n,PCR 16-bit offset
+#define     INDX_OFFSET_EXTENDED    11          // EA = [n] Extended indirect
+#define     INDX_OFFSET_ILLEGAL     12          // Illegal index mode
+#define     INDX_OFFSET_ACCE        13          // EA = E,R HD6309
+#define     INDX_OFFSET_ACCF        14          // EA = F,R HD6309
+#define     INDX_OFFSET_ACCW        15          // EA = W,R HD6309
+
+typedef struct
+{
+    uint8_t     reg;        // Index register offset in cpu_state_t
+    uint8_t     offset;     // Offset kind
+    int8_t      inc_dec;    // Auto increment or decrement amount
+    uint8_t     indirect;   // Read the effective address from memory
+    uint8_t     cycles;     // Cycles added by the index mode
+    uint8_t     bytes;      // Offset bytes following the post-byte
+    uint16_t    offset5;    // Sign extended 5-bit offset
+} index_decode_t;
+
+/* EXG and TFR register post-byte codes
+ */
+#define     REG_INVALID             0           // Not a register
+#define     REG_WORD                1           // 16-bit register
+#define     REG_BYTE                2           // 8-bit register
+#define     REG_CC                  3           // CC register with CPU_LAZY_CC
+#define     REG_ZERO                4           // HD6309 zero register
+
+typedef struct
+{
+    uint8_t     kind;       // Register kind REG_*
+    uint8_t     offset;     // Register offset in cpu_state_t
+} register_decode_t;
+
+/* PSHS, PSHU, PULS and PULU register list post-byte
+ */
+#define     STACK_FRAME_MAX         14          // Entire state with HD6309 W
+
+typedef struct
+{
+    uint8_t     bytes;      // Bytes pushed or pulled
+    uint8_t     cycles;     // Cycles added by the register list
+} stack_list_t;
+
+/* Op-code handler for the handler table dispatch
+ */
+typedef void (*op_handler_t)(int *cycles, int *bytes);
+
+/* Predecoded instruction cache, direct mapped by PC.
+ * The cache is only used with the table and computed-goto
+ * dispatch engines.
+ */
+#if (CPU_PREDECODE && CPU_DISPATCH != CPU_DISPATCH_SWITCH)
+#define     PREDECODE               1
+#else
+#define     PREDECODE               0
+#endif
+
+#define     PREDECODE_ENTRIES       4096        // Power of 2
+#define     PREDECODE_MASK          (PREDECODE_ENTRIES-1)
+
+#define     EA_CONSTANT             0           // Effective address resolved at decode
+#define     EA_DIRECT               1           // DP register and 8-bit offset
+#define     EA_INDEXED              2           // Index post-byte and offset
+
+/* Op-code operation, called with the effective address
+ */
+typedef void (*op_operation_t)(int eff_addr, int *cycles);
+
+/* Op-code operation and addressing mode
+ */
+typedef struct
+{
+    op_operation_t  operation;
+    int             mode;
+} op_recipe_t;
+
+/* Predecoded instruction
+ */
+typedef struct
+{
+    int             pc;         // Instruction address, '-1' if the entry is empty
+    uint32_t        version;    // Memory page write version at decode
+    op_operation_t  operation;
+    uint16_t        next_pc;    // Address of the next instruction
+    uint16_t        operand;    // Effective address, direct page offset or index offset
+    uint8_t         ea_recipe;  // EA_CONSTANT, EA_DIRECT or EA_INDEXED
+    uint8_t         post_byte;  // Index post-byte
+    uint8_t         cycles;     // Cycles, including index mode cycles
+    uint8_t         bytes;      // Bytes, including index offset bytes
+#if (CPU_6309)
+    uint8_t         immediate;  // Immediate byte of HD6309 immediate and memory operand op-codes
+#endif
+} predecode_t;
+
+/* Translated basic blocks, direct mapped by block start PC.
+ * Block translation requires the predecoded instruction cache,
+ * and is not used with the call graph or the cycle audit that
+ * follow every instruction.
+ */
+#if (CPU_TRANSLATE && PREDECODE && !CPU_CALL_GRAPH && !CPU_CYCLE_AUDIT)
+#define     TRANSLATE               1
+#else
+#define     TRANSLATE               0
+#endif
+
+#define     BLOCK_ENTRIES           1024        // Power of 2
+#define     BLOCK_MASK              (BLOCK_ENTRIES-1)
+#define     BLOCK_INSTRUCTIONS      16          // Maximum instructions in a block
+#define     BLOCK_HOT_COUNT         8           // Block start executions before translation
+
+/* x86-64 host code of translated blocks, not used with
+ * the profiler that counts every instruction.
+ * Each block cache entry has a fixed slot of host code.
+ */
+#if (CPU_TRANSLATE_X86 && TRANSLATE && !CPU_PROFILE && defined(__x86_64__) && defined(__linux__))
+#define     NATIVE                  1
+#else
+#define     NATIVE                  0
+#endif
+
+#define     NATIVE_SLOT_SIZE        8192        // Host code bytes per block cache entry, 16 instructions of up to 300 bytes
+#define     NATIVE_EXITS            8           // Exit jumps per instruction
+
+/* Host code of a translated block, returns the cycles used
+ */
+typedef int (*native_block_t)(int cycle_budget, cpu_context_t *ctx);
+
+/* Translated basic block
+ */
+typedef struct
+{
+    int             pc;         // Block start address, '-1' if the entry is empty
+    uint32_t        version;    // Memory page write version
+    int             count;      // Block start executions before translation
+    int             length;     // Instructions, '0' not translated yet, '-1' cannot be translated
+    predecode_t     code[BLOCK_INSTRUCTIONS];
+    uint8_t         fusion[BLOCK_INSTRUCTIONS]; // Fusion type of the pair starting at the instruction
+    uint8_t         idle;       // Idle loop type
+    uint8_t         idle_length;// Instructions of one idle loop iteration
+    int             idle_cycles;// Cycles of one idle loop iteration
+#if (NATIVE)
+    native_block_t  native;     // Host code, '0' if none
+#endif
+} block_t;
+
+/* Superinstruction fusion of instruction pairs in translated blocks.
+ */
+#if (CPU_FUSION && TRANSLATE)
+#define     FUSION                  1
+#else
+#define     FUSION                  0
+#endif
+
+#define     FUSION_NONE             0
+#define     FUSION_CMP_BCC          1           // CMPr + Bcc
+#define     FUSION_TST_BCC          2           // TSTr, TST + Bcc
+#define     FUSION_CNT_BCC          3           // LEAX, LEAY, DECr, INCr + Bcc
+#define     FUSION_LD_BCC           4           // LDr + Bcc
+#define     FUSION_COPY             5           // LDr ,R+ / ,R++ + STr ,R+ / ,R++
+
+/* Fused pair handler, returns the count of instructions executed
+ */
+typedef int (*fused_handler_t)(predecode_t *entry);
+
+/* Guest idle loop skipping in translated blocks.
+ */
+#if (CPU_IDLE_SKIP && TRANSLATE)
+#define     IDLE_SKIP               1
+#else
+#define     IDLE_SKIP               0
+#endif
+
+#define     IDLE_NONE               0
+#define     IDLE_COUNTDOWN          1           // LEAX -1,X, LEAY -1,Y, DECA, DECB + BNE to the block start
+#define     IDLE_SPIN               2           // Loads, compares, tests and branches, looping to the block start
+
+/* Execution profiler, counts per guest address.
+ * The op-code at an address is recorded on its first execution.
+ */
+#if (CPU_PROFILE)
+#define     PROFILE                 1
+#else
+#define     PROFILE                 0
+#endif
+
+#define     PROFILE_OP_UNKNOWN      0xffff      // Op-code not read, executed from an IO page
+#define     PROFILE_REPORT_ADDRESSES 100        // Addresses listed in the report
+#define     PROFILE_DUMP_MAGIC      "MC09PROF"
+#define     PROFILE_DUMP_VERSION    1
+
+typedef struct
+{
+    uint64_t    executions;
+    uint64_t    cycles;
+} profile_count_t;
+
+typedef struct
+{
+    profile_count_t count[MEMORY];
+    uint16_t    op_code[MEMORY];    // Op-code, 0x10nn and 0x11nn for pages 2 and 3
+} profile_t;
+
+/* Call graph, a tree of the call paths to guest routines with
+ * a shadow stack of the routines being run.
+ */
+#if (CPU_CALL_GRAPH)
+#define     CALL_GRAPH              1
+#else
+#define     CALL_GRAPH              0
+#endif
+
+#define     CALL_GRAPH_NODES        16384       // Call tree nodes, one per call path
+#define     CALL_GRAPH_DEPTH        256         // Shadow stack frames
+#define     CALL_GRAPH_TOP          0x10000     // Stack address of frames that are never returned from
+
+#define     CALL_ROOT               0           // Call tree root, not a routine
+#define     CALL_ENTRY              1           // Routine run at the call graph start or after RESET
+#define     CALL_SUBROUTINE         2           // JSR, BSR, LBSR
+#define     CALL_SWI                3           // SWI, SWI2, SWI3
+#define     CALL_NMI                4
+#define     CALL_FIRQ               5
+#define     CALL_IRQ                6
+
+typedef struct
+{
+    uint16_t    routine;        // Routine entry address
+    uint8_t     kind;           // CALL_* type of the call
+    int         parent;
+    int         child;          // First callee node, '-1' if none
+    int         sibling;        // Next callee node of the parent, '-1' if none
+    uint64_t    calls;
+    uint64_t    cycles;         // Exclusive cycles of the routine on this call path
+} call_node_t;
+
+typedef struct
+{
+    int         node;
+    int         stack;          // S after the return address or interrupt state was pushed
+} call_frame_t;
+
+typedef struct
+{
+    call_node_t     node[CALL_GRAPH_NODES];
+    int             nodes;
+    call_frame_t    frame[CALL_GRAPH_DEPTH];
+    int             depth;
+    uint64_t        charged;    // Emulated time charged to the routines
+    unsigned long   lost;       // Calls not recorded, call tree or shadow stack full
+} call_graph_t;
+
+/* Cycle accounting audit of every executed instruction
+ * against the reference cycles of mc6809e_cycles.h
+ */
+#if (CPU_CYCLE_AUDIT)
+#define     CYCLE_AUDIT             1
+#else
+#define     CYCLE_AUDIT             0
+#endif
+
+#if (CYCLE_AUDIT && CPU_6309)
+#error "CPU_CYCLE_AUDIT has no HD6309 cycle reference, build without CPU_6309"
+#endif
+
+#define     AUDIT_UNCHECKED         -2          // Instruction not checked, read from an IO page
+
+/* Instruction being audited, with its reference cycles
+ */
+typedef struct
+{
+    int         pc;
+    int         op_code;        // Op-code, 0x10nn and 0x11nn for pages 2 and 3
+    int         post_byte;      // Index or register list post-byte, '-1' if none
+    int         expected;       // Reference cycles, '-1' no reference, AUDIT_UNCHECKED
+} audit_op_t;
+
+/* Registers compared between iterations of a polling loop
+ */
+typedef struct
+{
+    uint16_t    x, y, u, s;
+    uint8_t     a, b, dp, cc;
+} idle_regs_t;
+
+/* Conditions that require run_instruction() processing
+ * before the next instruction: RESET, HALT, SYNC, exceptions
+ * and interrupts that will be serviced
+ */
+#define     EVENT_PENDING()         (active->events && \
+                                     ((active->events & (EVENT_STATE | EVENT_RESET | EVENT_HALT)) || \
+                                      ((active->events & EVENT_NMI) && active->cpu.nmi_armed) || \
+                                      ((active->events & EVENT_FIRQ) && !GET_CC_F()) || \
+                                      ((active->events & EVENT_IRQ) && !GET_CC_I())))
+
 /* -----------------------------------------
    Module static functions
 ----------------------------------------- */
@@ -106,25 +574,137 @@ static void    swi(int swi_id);
 static void    tfr(uint8_t regs);
 static void    tst(uint8_t byte);
 
+/* HD6309 op-code processing
+ */
+#if (CPU_6309)
+static uint16_t adc16(uint16_t acc, uint16_t word);
+static uint16_t add16(uint16_t acc, uint16_t word);
+static uint16_t and16(uint16_t acc, uint16_t word);
+static uint16_t asl16(uint16_t word);
+static uint16_t asr16(uint16_t word);
+static uint16_t com16(uint16_t word);
+static uint16_t dec16(uint16_t word);
+static uint16_t eor16(uint16_t acc, uint16_t word);
+static uint16_t inc16(uint16_t word);
+static uint16_t lsr16(uint16_t word);
+static uint16_t neg16(uint16_t word);
+static uint16_t or16(uint16_t acc, uint16_t word);
+static uint16_t rol16(uint16_t word);
+static uint16_t ror16(uint16_t word);
+static uint16_t sbc16(uint16_t acc, uint16_t word);
+static uint16_t sub16(uint16_t acc, uint16_t word);
+static void     tst16(uint16_t word);
+static void     divd(int8_t divisor, int *cycles);
+static void     divq(int16_t divisor, int *cycles);
+static void     reg_alu(uint8_t regs, uint8_t (*op8)(uint8_t, uint8_t), uint16_t (*op16)(uint16_t, uint16_t), int store);
+static void     bit_transfer(int eff_addr, int operation, int *cycles);
+static void     tfm(uint8_t regs, int src_step, int dst_step, int *cycles);
+static int      trap(uint8_t md_flag);
+#endif
+
 /* CPU op-code support functions
  */
+static int      run_instruction(void);
+static int      process_events(int *int_cycles);
+static inline void set_state(cpu_run_state_t state);
+#if (CPU_DISPATCH == CPU_DISPATCH_SWITCH)
 static void     branch(int instruction, int long_short, uint16_t effective_address, int *cycles);
 static void     do_branch(int long_short, uint16_t effective_address, int *cycles);
-static int      get_eff_addr(int op_code, int *cycles, int *bytes);
+#endif
+static int      get_eff_addr(int mode, int *cycles, int *bytes);
+static void     push_registers(uint16_t *stack, uint8_t push_list, uint16_t other_stack, int push_w);
+static void     pull_registers(uint16_t *stack, uint8_t pull_list, uint16_t *other_stack, int pull_w);
+static void     push_entire_state(void);
+static void     decode_tables_init(void);
+static void     decode_tables_build(void);
+static void     context_init(cpu_context_t *ctx, mem_context_t *mem);
+#if (CPU_DISPATCH == CPU_DISPATCH_TABLE)
+static void     execute_table(int *cycles, int *bytes);
+#elif (CPU_DISPATCH == CPU_DISPATCH_GOTO)
+static void     execute_goto(int *cycles, int *bytes);
+#endif
+#if (PREDECODE)
+static void     execute_predecoded(int *cycles, int *bytes);
+static inline void execute_entry(predecode_t *entry, int *cycles, int *bytes);
+static inline uint16_t indexed_address(predecode_t *entry);
+static int      predecode(predecode_t *entry, int address);
+#endif
+#if (TRANSLATE)
+static block_t *block_lookup(int address);
+static int      translate_block(block_t *block, int address);
+static int      execute_block(block_t *block, int cycle_budget);
+#endif
+#if (NATIVE)
+static native_block_t native_translate(block_t *block);
+static int      execute_native(block_t *block, int cycle_budget);
+static int      native_indexed(predecode_t *entry);
+static int      native_events(void);
+static uint8_t *emit_bytes(uint8_t *code, const uint8_t *bytes, int length);
+static uint8_t *emit_ctx(uint8_t *code, const uint8_t *op, int length, int offset);
+static uint8_t *emit_imm(uint8_t *code, uint64_t value, int length);
+static uint8_t *emit_exit(uint8_t *code, uint8_t condition, uint8_t **exits, int *exit_count);
+#endif
+#if (FUSION)
+static int      fusion_match(predecode_t *first, predecode_t *second);
+static int      fused_branch(predecode_t *entry);
+static int      fused_copy(predecode_t *entry);
+#endif
+#if (IDLE_SKIP)
+static int      idle_match(block_t *block, int length);
+static int      idle_skip(block_t *block, int cycle_budget);
+static void     idle_regs(idle_regs_t *regs);
+static int      idle_reads_io(block_t *block);
+#endif
+#if (PROFILE || CALL_GRAPH)
+static int      peek_op_code(int address);
+static int      sort_compare(const void *a, const void *b);
+#endif
+#if (PROFILE)
+static inline void profile_count(int address, int cycles);
+static const char *profile_mnemonic(int op_code);
+static const char *profile_op_name(int op_code);
+static void     profile_exit(void);
+#endif
+#if (CALL_GRAPH)
+static void     call_graph_step(int op_pc);
+static void     call_graph_interrupt(int kind);
+static void     call_graph_enter(int routine, int kind, int stack);
+static void     call_graph_charge(cpu_context_t *ctx);
+static void     call_graph_restart(cpu_context_t *ctx);
+static const char *call_graph_frame_name(call_node_t *node, cpu_symbol_t symbol);
+#endif
+#if (CYCLE_AUDIT)
+static void     audit_reference(audit_op_t *op, int address);
+static int      audit_branch_taken(uint8_t cc, int op_code);
+static void     audit_check(audit_op_t *op, int cycles);
+#endif
 static uint16_t read_register(int reg);
 static void     write_register(int reg, uint16_t data);
+static void     cache_invalidate(cpu_context_t *ctx);
 
 /* Condition code register CC functions
  */
 static void    eval_cc_c(uint16_t value);
-static void    eval_cc_c16(uint32_t value);
 static void    eval_cc_z(uint16_t value);
 static void    eval_cc_z16(uint32_t value);
-static void    eval_cc_n(uint16_t value);
-static void    eval_cc_n16(uint32_t value);
+static void    eval_cc_nz(uint16_t value);
+static void    eval_cc_nz16(uint32_t value);
+#if (CPU_6309)
+static void    eval_cc_nz32(uint32_t value);
+#endif
+#if (CPU_LAZY_CC)
+static void    eval_cc_c16(uint32_t value);
 static void    eval_cc_v(uint8_t val1, uint8_t val2, uint16_t result);
 static void    eval_cc_v16(uint16_t val1, uint16_t val2, uint32_t result);
 static void    eval_cc_h(uint8_t val1, uint8_t val2, uint8_t result);
+#endif
+static void    eval_cc_nzv(uint8_t val1, uint8_t val2, uint16_t result);
+static void    eval_cc_nzvc(uint8_t val1, uint8_t val2, uint16_t result);
+static void    eval_cc_hnzvc(uint8_t val1, uint8_t val2, uint16_t result);
+#if (CPU_6309)
+static void    eval_cc_nzv16(uint16_t val1, uint16_t val2, uint32_t result);
+#endif
+static void    eval_cc_nzvc16(uint16_t val1, uint16_t val2, uint32_t result);
 
 static uint8_t get_cc(void);
 static void    set_cc(uint8_t value);
@@ -134,10 +714,10 @@ static void    set_cc(uint8_t value);
    Module globals
 ----------------------------------------- */
 
-/* MC6809E register file
+/* Condition code flags and result terms of CPU_LAZY_CC
  */
-static cpu_state_t cpu;
-static struct cc_t
+#if (CPU_LAZY_CC)
+struct cc_t
 {
     int c;
     int v;
@@ -147,9 +727,265 @@ static struct cc_t
     int h;
     int f;
     int e;
-} cc;
+};
+#endif
+
+/* CPU context: MC6809E register file and run state, memory context,
+ * cpu_run_cycles() stop conditions, predecoded instruction and
+ * translated block caches, and statistics.
+ * The context starts on a cache line, so that the register file
+ * near the start of 'cpu' is in one cache line.
+ */
+struct __attribute__ ((aligned(CACHE_LINE))) cpu_context_t
+{
+    cpu_state_t         cpu;
+#if (CPU_LAZY_CC)
+    struct cc_t         cc;
+#endif
+    mem_context_t      *mem;
+
+    int                 break_point;
+    int                 int_line_change;
+    int                 events;         // Pending event word, EVENT_* bits
+#if (CPU_6309)
+    uint8_t             immediate;      // Immediate byte of HD6309 immediate and memory operand op-codes
+#endif
+    uint64_t            event_deadline;
+
+#if (PREDECODE)
+    predecode_t         predecode_cache[PREDECODE_ENTRIES];
+    const uint32_t     *page_versions;
+#endif
+#if (TRANSLATE)
+    block_t             block_cache[BLOCK_ENTRIES];
+    const uint32_t     *io_accesses;
+#endif
+#if (NATIVE)
+    uint8_t            *native_code;    // Host code slots, one per block cache entry
+    int                 native_failed;  // Host code slots could not be allocated
+    uint32_t            native_io_count;// IO access count at the block start
+#endif
+    cpu_predecode_stats_t predecode_stats;
+    int                 idle;           // The last run skipped idle loop iterations or waited
+    uint64_t            idle_end;       // Emulated time the idle loop ends, CPU_NO_EVENT if at an event
+    uint64_t            idle_cycles;    // Cycles skipped in idle loops or waited
+    uint64_t            idle_start;     // Emulated time of the last idle statistics clear
+#if (IDLE_SKIP)
+    int                 spin_pc;        // Polling loop start address at the last pass
+    uint64_t            spin_time;      // Emulated time of the last pass
+    idle_regs_t         spin_regs;      // Registers at the last pass
+#endif
+#if (PROFILE)
+    profile_t           profile;
+#endif
+#if (CALL_GRAPH)
+    call_graph_t        call_graph;
+#endif
+#if (CYCLE_AUDIT)
+    cpu_cycle_audit_t   audit;
+#endif
+    unsigned long       fusion_fired[CPU_FUSION_TYPES + 1];
+};
+
+/* Default CPU context of the API functions without a context parameter.
+ * The module static functions operate on the active context: with
+ * CPU_CONTEXTS the context being run by this thread, without it
+ * the default context.
+ */
+static cpu_context_t                default_context = { .break_point = -1,
+                                                        .event_deadline = CPU_NO_EVENT };
+#if (CPU_CONTEXTS)
+static _Thread_local cpu_context_t *active = &default_context;
+#define     CONTEXT_ENTER(c)        cpu_context_t *caller = active; active = (c)
+#define     CONTEXT_EXIT()          (active = caller)
+#else
+static int                          default_context_created = 0;
+#define     active                  (&default_context)
+#define     CONTEXT_ENTER(c)
+#define     CONTEXT_EXIT()
+#endif
+
+/* Memory access through the memory context of the active CPU context,
+ * with the inline accessors of mem.h. 16-bit accesses are big-endian.
+ */
+#define     MEM_READ(a)             mem_ctx_read8(active->mem, (uint16_t) (a))
+#define     MEM_WRITE(a, v)         mem_ctx_write8(active->mem, (uint16_t) (a), (uint8_t) (v))
+#define     MEM_READ16(a)           mem_ctx_read16(active->mem, (uint16_t) (a))
+#define     MEM_WRITE16(a, v)       mem_ctx_write16(active->mem, (uint16_t) (a), (uint16_t) (v))
+
+/* Decode tables for 0x10 and 0x11 prefixed op-codes
+ * generated from machine_code[] by decode_tables_init()
+ */
+static op_decode_t  op_code_page2[256];
+static op_decode_t  op_code_page3[256];
+
+/* Indexed addressing post-byte decode table
+ * generated by decode_tables_init()
+ */
+static index_decode_t   index_decode[256];
+
+/* Conditional branch table, branch taken '1' or not '0'
+ * by branch condition and CC, generated by decode_tables_init()
+ */
+static uint8_t          branch_taken[16][256];
+
+/* Stack register list post-byte table
+ * generated by decode_tables_init()
+ */
+static stack_list_t     stack_list[256];
+
+/* EXG and TFR register table indexed by the register code
+ */
+static const register_decode_t register_decode[16] =
+{
+    [0]  = { REG_WORD, offsetof(cpu_state_t, d) },
+    [1]  = { REG_WORD, offsetof(cpu_state_t, x) },
+    [2]  = { REG_WORD, offsetof(cpu_state_t, y) },
+    [3]  = { REG_WORD, offsetof(cpu_state_t, u) },
+    [4]  = { REG_WORD, offsetof(cpu_state_t, s) },
+    [5]  = { REG_WORD, offsetof(cpu_state_t, pc) },
+#if (CPU_6309)
+    [6]  = { REG_WORD, offsetof(cpu_state_t, w) },
+    [7]  = { REG_WORD, offsetof(cpu_state_t, v) },
+#endif
+    [8]  = { REG_BYTE, offsetof(cpu_state_t, a) },
+    [9]  = { REG_BYTE, offsetof(cpu_state_t, b) },
+#if (CPU_LAZY_CC)
+    [10] = { REG_CC,   offsetof(cpu_state_t, cc) },
+#else
+    [10] = { REG_BYTE, offsetof(cpu_state_t, cc) },
+#endif
+    [11] = { REG_BYTE, offsetof(cpu_state_t, dp) },
+#if (CPU_6309)
+    [12] = { REG_ZERO, 0 },
+    [13] = { REG_ZERO, 0 },
+    [14] = { REG_BYTE, offsetof(cpu_state_t, e) },
+    [15] = { REG_BYTE, offsetof(cpu_state_t, f) },
+#endif
+};
+
+/* Superinstruction fusion handlers and names, indexed by fusion type
+ */
+#if (FUSION)
+static const fused_handler_t fused_handlers[CPU_FUSION_TYPES + 1] =
+{
+    [FUSION_CMP_BCC] = fused_branch,
+    [FUSION_TST_BCC] = fused_branch,
+    [FUSION_CNT_BCC] = fused_branch,
+    [FUSION_LD_BCC]  = fused_branch,
+    [FUSION_COPY]    = fused_copy,
+};
+#endif
+static const char      *fusion_names[CPU_FUSION_TYPES + 1] =
+{
+    [FUSION_CMP_BCC] = "CMP + Bcc",
+    [FUSION_TST_BCC] = "TST + Bcc",
+    [FUSION_CNT_BCC] = "LEA/DEC + Bcc",
+    [FUSION_LD_BCC]  = "LD + Bcc",
+    [FUSION_COPY]    = "LD + ST copy",
+};
+
+/* Profile and call graph report sort key
+ */
+#if (PROFILE || CALL_GRAPH)
+static const uint64_t  *sort_key;
+#endif
+
+/* Execution profiler exit files
+ */
+#if (PROFILE)
+static const char      *profile_report_file = 0L;
+static const char      *profile_dump_file = 0L;
+static int              profile_exit_registered = 0;
+#endif
+
+/*------------------------------------------------
+ * cpu_create()
+ *
+ *  Allocate a CPU context that runs code from a memory context.
+ *  cpu_ctx_init() should be called before the context is run.
+ *  The decode tables shared by all contexts are built by the
+ *  first cpu_create() or cpu_init() call, so the first context
+ *  should be created before other threads use the CPU module.
+ *  Without CPU_CONTEXTS there is only the default context: the
+ *  first call attaches it to the memory context and returns it,
+ *  and later calls return NULL until it is passed to cpu_destroy().
+ *  The API functions without a context parameter then also run
+ *  on this memory context.
+ *
+ *  param:  Pointer to memory context
+ *  return: Pointer to CPU context, NULL if allocation failed
+ *          or the default context is in use without CPU_CONTEXTS
+ */
+cpu_context_t *cpu_create(mem_context_t *mem)
+{
+    cpu_context_t  *ctx = 0L;
+
+    decode_tables_init();
+
+#if (CPU_CONTEXTS)
+    ctx = aligned_alloc(CACHE_LINE, sizeof(cpu_context_t));
+    if ( ctx != 0L )
+    {
+        memset(ctx, 0, sizeof(cpu_context_t));
+        context_init(ctx, mem);
+    }
+#else
+    if ( !default_context_created )
+    {
+        default_context_created = 1;
+        ctx = &default_context;
+        context_init(ctx, mem);
+    }
+#endif
+
+    return ctx;
+}
+
+/*------------------------------------------------
+ * cpu_destroy()
+ *
+ *  Free a CPU context allocated by cpu_create().
+ *  The memory context is not freed. Without CPU_CONTEXTS
+ *  the default context is released for the next cpu_create().
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+void cpu_destroy(cpu_context_t *ctx)
+{
+#if (!CPU_CONTEXTS)
+    if ( ctx == &default_context )
+        default_context_created = 0;
+#endif
+
+    if ( ctx != &default_context )
+    {
+#if (NATIVE)
+        if ( ctx->native_code )
+            munmap(ctx->native_code, BLOCK_ENTRIES * NATIVE_SLOT_SIZE);
+#endif
+        free(ctx);
+    }
+}
+
+/*------------------------------------------------
+ * cpu_default_context()
+ *
+ *  Return the CPU context used by the API functions
+ *  without a context parameter. The default context runs
+ *  code from the default memory context.
+ *
+ *  param:  Nothing
+ *  return: Pointer to default CPU context
+ */
+cpu_context_t *cpu_default_context(void)
+{
+    if ( default_context.mem == 0L )
+        context_init(&default_context, mem_default_context());
 
-#define     d       ((uint16_t)(((uint16_t)cpu.a << 8) + cpu.b))    // Accumulator D
+    return &default_context;
+}
 
 /*------------------------------------------------
  * cpu_init()
@@ -162,37 +998,75 @@ static struct cc_t
  */
 int cpu_init(int address)
 {
+    return cpu_ctx_init(cpu_default_context(), address);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_init()
+ *
+ *  Initialize a CPU context for command execution at address.
+ *
+ *  param:  Pointer to CPU context, start address
+ *  return: 0- initialization ok, 1- Start address error
+ */
+int cpu_ctx_init(cpu_context_t *ctx, int address)
+{
+    CONTEXT_ENTER(ctx);
+
+    decode_tables_init();
+
     /* Registers
      */
-    cpu.x  = 0;
-    cpu.y  = 0;
-    cpu.u  = 0;
-    cpu.s  = 0;
-    cpu.pc = 0;
-    cpu.a  = 0;
-    cpu.b  = 0;
-
-    cpu.dp = 0;
+    ctx->cpu.x  = 0;
+    ctx->cpu.y  = 0;
+    ctx->cpu.u  = 0;
+    ctx->cpu.s  = 0;
+    ctx->cpu.pc = 0;
+    ctx->cpu.a  = 0;
+    ctx->cpu.b  = 0;
+
+    ctx->cpu.dp = 0;
     set_cc(0);
 
+#if (CPU_6309)
+    if ( NATIVE_MODE() )
+        cache_invalidate(ctx);
+#endif
+    ctx->cpu.w  = 0;
+    ctx->cpu.v  = 0;
+    ctx->cpu.md = 0;
+
     /* CPU state
      */
-    cpu.nmi_armed = 0;
-    cpu.nmi_latched = 0;
-    cpu.halt_asserted = 0;
-    cpu.reset_asserted = 0;
-    cpu.irq_asserted = 0;
-    cpu.firq_asserted = 0;
-    cpu.int_latch = 0;
-    cpu.cpu_state = CPU_HALTED;
-    cpu.exception_line_num = -1;
+    ctx->cpu.nmi_armed = 0;
+    ctx->cpu.nmi_latched = 0;
+    ctx->cpu.halt_asserted = 0;
+    ctx->cpu.reset_asserted = 0;
+    ctx->cpu.irq_asserted = 0;
+    ctx->cpu.firq_asserted = 0;
+    ctx->cpu.int_latch = 0;
+    ctx->cpu.cpu_state = CPU_HALTED;
+    ctx->cpu.exception_line_num = -1;
+    ctx->events = EVENT_STATE;
+
+    /* Emulated time
+     */
+    ctx->cpu.cycles = 0;
+    ctx->event_deadline = CPU_NO_EVENT;
+    ctx->idle_cycles = 0;
+    ctx->idle_start = 0;
+#if (CALL_GRAPH)
+    call_graph_restart(ctx);
+#endif
+
+    CONTEXT_EXIT();
 
     /* Check start address and update PC
      */
     if ( address < 0 || address > (MEMORY-1) )
         return 1;
 
-    cpu.pc = address;
+    ctx->cpu.pc = address;
 
     return 0;
 }
@@ -207,7 +1081,25 @@ int cpu_init(int address)
  */
 void cpu_halt(int state)
 {
-    cpu.halt_asserted = state;
+    cpu_ctx_halt(&default_context, state);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_halt()
+ *
+ *  Assert HALT state of a CPU context
+ *
+ *  param:  Pointer to CPU context, 0- clear, 1- asserted
+ *  return: Nothing
+ */
+void cpu_ctx_halt(cpu_context_t *ctx, int state)
+{
+    ctx->cpu.halt_asserted = state;
+
+    if ( state )
+        ctx->events |= EVENT_HALT;
+    else
+        ctx->events &= ~EVENT_HALT;
 }
 
 /*------------------------------------------------
@@ -220,7 +1112,25 @@ void cpu_halt(int state)
  */
 void cpu_reset(int state)
 {
-    cpu.reset_asserted = state;
+    cpu_ctx_reset(&default_context, state);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_reset()
+ *
+ *  Assert RESET state of a CPU context
+ *
+ *  param:  Pointer to CPU context, 0- clear, 1- asserted
+ *  return: Nothing
+ */
+void cpu_ctx_reset(cpu_context_t *ctx, int state)
+{
+    ctx->cpu.reset_asserted = state;
+
+    if ( state )
+        ctx->events |= EVENT_RESET;
+    else
+        ctx->events &= ~EVENT_RESET;
 }
 
 /*------------------------------------------------
@@ -233,7 +1143,22 @@ void cpu_reset(int state)
  */
 void cpu_nmi_trigger(void)
 {
-    cpu.nmi_latched = 1;
+    cpu_ctx_nmi_trigger(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_nmi_trigger()
+ *
+ *  Trigger a Non Mask-able Interrupt (NMI) state of a CPU context
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+void cpu_ctx_nmi_trigger(cpu_context_t *ctx)
+{
+    ctx->cpu.nmi_latched = 1;
+    ctx->events |= EVENT_NMI;
+    ctx->int_line_change = 1;
 }
 
 /*------------------------------------------------
@@ -246,7 +1171,28 @@ void cpu_nmi_trigger(void)
  */
 void cpu_firq(int state)
 {
-    cpu.firq_asserted = state;
+    cpu_ctx_firq(&default_context, state);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_firq()
+ *
+ *  Assert Fast IRQ (FIRQ) state of a CPU context
+ *
+ *  param:  Pointer to CPU context, 0- clear, 1- asserted
+ *  return: Nothing
+ */
+void cpu_ctx_firq(cpu_context_t *ctx, int state)
+{
+    if ( ctx->cpu.firq_asserted != state )
+        ctx->int_line_change = 1;
+
+    ctx->cpu.firq_asserted = state;
+
+    if ( state )
+        ctx->events |= EVENT_FIRQ;
+    else
+        ctx->events &= ~EVENT_FIRQ;
 }
 
 /*------------------------------------------------
@@ -259,7 +1205,28 @@ void cpu_firq(int state)
  */
 void cpu_irq(int state)
 {
-    cpu.irq_asserted = state;
+    cpu_ctx_irq(&default_context, state);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_irq()
+ *
+ *  Assert IRQ state of a CPU context
+ *
+ *  param:  Pointer to CPU context, 0- clear, 1- asserted
+ *  return: Nothing
+ */
+void cpu_ctx_irq(cpu_context_t *ctx, int state)
+{
+    if ( ctx->cpu.irq_asserted != state )
+        ctx->int_line_change = 1;
+
+    ctx->cpu.irq_asserted = state;
+
+    if ( state )
+        ctx->events |= EVENT_IRQ;
+    else
+        ctx->events &= ~EVENT_IRQ;
 }
 
 /*------------------------------------------------
@@ -274,77 +1241,1963 @@ void cpu_irq(int state)
  */
 cpu_run_state_t cpu_run(void)
 {
-    int         op_code_index;
-    int         cycles;
-    int         bytes;
-    int         eff_addr;
-    uint8_t     operand8;
-    uint16_t    operand16;
-
-    int  intr_latch = 0;
-    int  op_code = -1;
+    return cpu_ctx_run(&default_context);
+}
 
-    /* Latch interrupt requests
-     */
-    intr_latch |= cpu.nmi_latched ? INT_NMI : 0;
-    intr_latch |= cpu.irq_asserted ? INT_IRQ : 0;
-    intr_latch |= cpu.firq_asserted ? INT_FIRQ : 0;
+/*------------------------------------------------
+ * cpu_ctx_run()
+ *
+ *  Run one instruction of a CPU context.
+ *  A CPU waiting in SYNC or CWAI, halted or held in reset
+ *  advances the emulated time by one clock cycle.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Integer of CPU_* value (see #define CPU_*)
+ */
+cpu_run_state_t cpu_ctx_run(cpu_context_t *ctx)
+{
+    CONTEXT_ENTER(ctx);
 
-    /* Check RESET at every cycle
-     * this will emulate an asynchronous RESET response.
-     */
-    if ( cpu.reset_asserted )
-    {
-        cc.f = CC_FLAG_SET;
-        cc.i = CC_FLAG_SET;
-        cpu.dp = 0;
-        cpu.nmi_armed = 0;
-        cpu.nmi_latched = 0;
-        bytes = 0;
-        cycles = 0;
-        cpu.cpu_state = CPU_RESET;
-        cpu.pc = (mem_read(VEC_RESET) << 8) + mem_read(VEC_RESET+1);
-        cpu.last_pc = cpu.pc;
-    }
-    else
+    if ( run_instruction() == 0 && CPU_WAITING(ctx) )
     {
-        /* At exit of this function PC will point to the next op-code
-         * so this preserves the current PC for other uses such as
-         * single step etc.
-         */
-        cpu.last_pc = cpu.pc;
+        ctx->cpu.cycles++;
+        ctx->idle_cycles++;
+    }
 
-        /* Only check HALT and interrupts before instruction
-         * fetch execution
+#if (CPU_LAZY_CC)
+    ctx->cpu.cc = get_cc();
+#endif
+
+    CONTEXT_EXIT();
+
+    return ctx->cpu.cpu_state;
+}
+
+/*------------------------------------------------
+ * cpu_run_cycles()
+ *
+ *  Run the CPU until a budget of clock cycles is used.
+ *  Frequently executed basic blocks run as translated blocks,
+ *  with the same stop conditions checked after every instruction.
+ *  The budget is cut short by an event deadline set with cpu_set_event().
+ *  A CPU that is halted, waits in SYNC or CWAI, or is held in reset
+ *  uses up the rest of the budget as wait cycles.
+ *  Whole iterations of guest idle loops are skipped, see idle_skip().
+ *  Execution stops before the budget is used if the CPU hits an
+ *  emulation exception, reaches the break point address set by
+ *  cpu_break_point(), or when an interrupt line changes state.
+ *  The last instruction may exceed the budget.
+ *  Function should be called periodically
+ *  after an initialization by cpu_init().
+ *
+ *  param:  Cycle budget
+ *  return: Cycles used, including interrupt entry and wait cycles
+ */
+int cpu_run_cycles(int cycle_budget)
+{
+    return cpu_ctx_run_cycles(&default_context, cycle_budget);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_run_cycles()
+ *
+ *  Run a CPU context until a budget of clock cycles is used.
+ *  Same as cpu_run_cycles().
+ *
+ *  param:  Pointer to CPU context, cycle budget
+ *  return: Cycles used
+ */
+int cpu_ctx_run_cycles(cpu_context_t *ctx, int cycle_budget)
+{
+    int             cycles_used = 0;
+#if (TRANSLATE)
+    block_t        *block;
+#endif
+
+    CONTEXT_ENTER(ctx);
+
+    ctx->int_line_change = 0;
+    ctx->idle = 0;
+    ctx->idle_end = CPU_NO_EVENT;
+#if (IDLE_SKIP)
+    ctx->spin_pc = -1;
+#endif
+
+    if ( ctx->event_deadline > ctx->cpu.cycles &&
+         ctx->event_deadline - ctx->cpu.cycles < (uint64_t) cycle_budget )
+        cycle_budget = (int)(ctx->event_deadline - ctx->cpu.cycles);
+
+    do
+    {
+#if (TRANSLATE)
+        /* Run a translated block if one starts at PC and
+         * the next instruction needs no RESET, HALT, SYNC
+         * or interrupt processing.
          */
-        if ( cpu.halt_asserted )
+        block = block_lookup(ctx->cpu.pc);
+        if ( block && !EVENT_PENDING() )
         {
-            cpu.cpu_state = CPU_HALTED;
-            return cpu.cpu_state;
+#if (IDLE_SKIP)
+            if ( block->idle != IDLE_NONE )
+                cycles_used += idle_skip(block, cycle_budget - cycles_used);
+#endif
+            cycles_used += execute_block(block, cycle_budget - cycles_used);
         }
+        else
+#endif
+        cycles_used += run_instruction();
+    }
+    while ( cycles_used < cycle_budget &&
+            ctx->cpu.cpu_state == CPU_EXEC &&
+            ctx->cpu.pc != ctx->break_point &&
+            !ctx->int_line_change );
 
-        /* We get here if not in RESET and not HALTed.
-         * If the CPU was put into SYNC mode by 'SYNC' or 'CWAI'
-         * then this point will force the emulation to exit execution
-         * and stay in wait mode, or if an interrupt was latched
-         * then execution will proceed with op-code fetch.
-         */
-        if ( cpu.cpu_state == CPU_SYNC )
+    /* A waiting CPU still uses up its clock cycles
+     */
+    if ( CPU_WAITING(ctx) && !ctx->int_line_change )
+    {
+        if ( cycles_used < cycle_budget )
         {
-            if ( intr_latch & (INT_NMI | INT_FIRQ | INT_IRQ) )
-            {
-                cpu.cpu_state = CPU_EXEC;
-            }
-            else
-            {
-                return cpu.cpu_state;
-            }
+            ctx->cpu.cycles += cycle_budget - cycles_used;
+            ctx->idle_cycles += cycle_budget - cycles_used;
+            cycles_used = cycle_budget;
         }
 
-        /* If an interrupt is received and it is enabled, then
-         * setup stack frame and call interrupt service by
-         * setting the PC to the vectors content.
-         * Release CPU state to CPU_EXEC to let COU emulation
+        ctx->idle = 1;
+        ctx->idle_end = CPU_NO_EVENT;
+    }
+
+#if (CPU_LAZY_CC)
+    ctx->cpu.cc = get_cc();
+#endif
+
+    CONTEXT_EXIT();
+
+    return cycles_used;
+}
+
+/*------------------------------------------------
+ * cpu_break_point()
+ *
+ *  Set a break point address for cpu_run_cycles().
+ *
+ *  param:  Break point address, '-1' to clear the break point
+ *  return: Nothing
+ */
+void cpu_break_point(int address)
+{
+    cpu_ctx_break_point(&default_context, address);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_break_point()
+ *
+ *  Set a break point address for cpu_ctx_run_cycles().
+ *
+ *  param:  Pointer to CPU context,
+ *          break point address, '-1' to clear the break point
+ *  return: Nothing
+ */
+void cpu_ctx_break_point(cpu_context_t *ctx, int address)
+{
+    ctx->break_point = address;
+}
+
+/*------------------------------------------------
+ * cpu_get_cycles()
+ *
+ *  Get the emulated time.
+ *
+ *  param:  Nothing
+ *  return: Clock cycles since cpu_init()
+ */
+uint64_t cpu_get_cycles(void)
+{
+    return cpu_ctx_get_cycles(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_cycles()
+ *
+ *  Get the emulated time of a CPU context.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Clock cycles since cpu_ctx_init()
+ */
+uint64_t cpu_ctx_get_cycles(cpu_context_t *ctx)
+{
+    return ctx->cpu.cycles;
+}
+
+/*------------------------------------------------
+ * cpu_set_event()
+ *
+ *  Set the emulated time of the next event.
+ *  cpu_run_cycles() will not run past the deadline, so a caller
+ *  can service device events at their emulated time.
+ *  A deadline that has passed does not limit the run.
+ *  Setting the deadline from a device call-back stops
+ *  cpu_run_cycles() after the current instruction.
+ *
+ *  param:  Event deadline in clock cycles, CPU_NO_EVENT to clear
+ *  return: Nothing
+ */
+void cpu_set_event(uint64_t deadline)
+{
+    cpu_ctx_set_event(&default_context, deadline);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_set_event()
+ *
+ *  Set the emulated time of the next event of a CPU context.
+ *
+ *  param:  Pointer to CPU context,
+ *          event deadline in clock cycles, CPU_NO_EVENT to clear
+ *  return: Nothing
+ */
+void cpu_ctx_set_event(cpu_context_t *ctx, uint64_t deadline)
+{
+    ctx->event_deadline = deadline;
+    ctx->int_line_change = 1;
+}
+
+/*------------------------------------------------
+ * cpu_cycles_to_event()
+ *
+ *  Get the clock cycles left until the next event.
+ *
+ *  param:  Nothing
+ *  return: Clock cycles to the event deadline, '0' if it has passed,
+ *          a very large count if no event is set
+ */
+uint64_t cpu_cycles_to_event(void)
+{
+    return cpu_ctx_cycles_to_event(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_cycles_to_event()
+ *
+ *  Get the clock cycles left until the next event of a CPU context.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Clock cycles to the event deadline, '0' if it has passed,
+ *          a very large count if no event is set
+ */
+uint64_t cpu_ctx_cycles_to_event(cpu_context_t *ctx)
+{
+    if ( ctx->event_deadline > ctx->cpu.cycles )
+        return ctx->event_deadline - ctx->cpu.cycles;
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * cpu_is_idle()
+ *
+ *  Check if the guest was idle in the last cpu_run_cycles() run.
+ *  The guest is idle if iterations of a delay or polling loop were
+ *  skipped, or if the CPU waits in SYNC or CWAI, is halted or is held
+ *  in reset. The caller can then fast forward to the end of the idle
+ *  time with a cpu_run_cycles() run of cpu_idle_cycles_left() cycles.
+ *
+ *  param:  Nothing
+ *  return: '1' if idle, '0' if not
+ */
+int cpu_is_idle(void)
+{
+    return cpu_ctx_is_idle(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_is_idle()
+ *
+ *  Check if the guest of a CPU context was idle
+ *  in the last cpu_ctx_run_cycles() run.
+ *
+ *  param:  Pointer to CPU context
+ *  return: '1' if idle, '0' if not
+ */
+int cpu_ctx_is_idle(cpu_context_t *ctx)
+{
+    return ctx->idle;
+}
+
+/*------------------------------------------------
+ * cpu_idle_cycles_left()
+ *
+ *  Get the clock cycles an idle guest stays idle after the
+ *  last cpu_run_cycles() run: to the end of a countdown delay loop,
+ *  or to the next event for a polling loop or a waiting CPU.
+ *  A run of these cycles skips the rest of the idle time, and
+ *  stops at the same state as when the loop is executed.
+ *
+ *  param:  Nothing
+ *  return: Clock cycles left, '0' if the guest is not idle
+ */
+uint64_t cpu_idle_cycles_left(void)
+{
+    return cpu_ctx_idle_cycles_left(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_idle_cycles_left()
+ *
+ *  Get the clock cycles the guest of a CPU context stays idle
+ *  after the last cpu_ctx_run_cycles() run.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Clock cycles left, '0' if the guest is not idle
+ */
+uint64_t cpu_ctx_idle_cycles_left(cpu_context_t *ctx)
+{
+    uint64_t    cycles;
+
+    if ( !ctx->idle )
+        return 0;
+
+    cycles = cpu_ctx_cycles_to_event(ctx);
+
+    if ( ctx->idle_end != CPU_NO_EVENT )
+    {
+        if ( ctx->idle_end <= ctx->cpu.cycles )
+            return 0;
+
+        if ( ctx->idle_end - ctx->cpu.cycles < cycles )
+            cycles = ctx->idle_end - ctx->cpu.cycles;
+    }
+
+    return cycles;
+}
+
+/*------------------------------------------------
+ * cpu_get_idle_stats()
+ *
+ *  Get the guest idle statistics: emulated cycles, and the cycles
+ *  skipped in idle loops or waited in SYNC, CWAI, HALT or reset.
+ *
+ *  param:  Pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_get_idle_stats(cpu_idle_stats_t* stats, int clear)
+{
+    cpu_ctx_get_idle_stats(&default_context, stats, clear);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_idle_stats()
+ *
+ *  Get the guest idle statistics of a CPU context.
+ *
+ *  param:  Pointer to CPU context, pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_ctx_get_idle_stats(cpu_context_t *ctx, cpu_idle_stats_t* stats, int clear)
+{
+    stats->cycles = ctx->cpu.cycles - ctx->idle_start;
+    stats->idle = ctx->idle_cycles;
+    stats->idle_ratio = stats->cycles ? (100.0 * stats->idle) / stats->cycles : 0.0;
+
+    if ( clear )
+    {
+        ctx->idle_start = ctx->cpu.cycles;
+        ctx->idle_cycles = 0;
+    }
+}
+
+/*------------------------------------------------
+ * cpu_profile_clear()
+ *
+ *  Clear the execution profile.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+void cpu_profile_clear(void)
+{
+    cpu_ctx_profile_clear(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_profile_clear()
+ *
+ *  Clear the execution profile of a CPU context.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+void cpu_ctx_profile_clear(cpu_context_t *ctx)
+{
+#if (PROFILE)
+    memset(&ctx->profile, 0, sizeof(profile_t));
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_profile_report()
+ *
+ *  Write a text report of the execution profile: executions
+ *  and cycles of every executed op-code, and of the addresses
+ *  with the most cycles, sorted by cycles.
+ *
+ *  param:  Report file name
+ *  return: 0- report written, -1- file error or profiler not enabled
+ */
+int cpu_profile_report(const char *file_name)
+{
+    return cpu_ctx_profile_report(&default_context, file_name);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_profile_report()
+ *
+ *  Write a text report of the execution profile of a CPU context.
+ *
+ *  param:  Pointer to CPU context, report file name
+ *  return: 0- report written, -1- file error or profiler not enabled
+ */
+int cpu_ctx_profile_report(cpu_context_t *ctx, const char *file_name)
+{
+#if (PROFILE)
+    profile_t      *profile = &ctx->profile;
+    FILE           *file;
+    uint64_t       *executions, *cycles, *address_cycles;
+    uint64_t        total_executions = 0, total_cycles = 0;
+    int            *order;
+    int             i, op_code, count;
+
+    decode_tables_init();
+
+    /* Op-code counts, indexed by page (0, 1 or 2) * 256 + op-code
+     */
+    executions = calloc(3 * 256, sizeof(uint64_t));
+    cycles = calloc(3 * 256, sizeof(uint64_t));
+    address_cycles = malloc(MEMORY * sizeof(uint64_t));
+    order = malloc(MEMORY * sizeof(int));
+    file = fopen(file_name, "w");
+
+    if ( executions == 0L || cycles == 0L || address_cycles == 0L || order == 0L || file == 0L )
+    {
+        free(executions);
+        free(cycles);
+        free(address_cycles);
+        free(order);
+        if ( file )
+            fclose(file);
+        return -1;
+    }
+
+    for ( i = 0; i < MEMORY; i++ )
+    {
+        address_cycles[i] = profile->count[i].cycles;
+
+        if ( profile->count[i].executions == 0 || profile->op_code[i] == PROFILE_OP_UNKNOWN )
+            continue;
+
+        op_code = profile->op_code[i];
+        op_code = (op_code >> 8) ? ((op_code >> 8) - 0x0f) * 256 + (op_code & 0xff) : op_code;
+
+        executions[op_code] += profile->count[i].executions;
+        cycles[op_code] += profile->count[i].cycles;
+        total_executions += profile->count[i].executions;
+        total_cycles += profile->count[i].cycles;
+    }
+
+    fprintf(file, "MC6809E execution profile\n");
+    fprintf(file, "%llu instructions, %llu instruction cycles\n\n",
+            (unsigned long long) total_executions, (unsigned long long) total_cycles);
+
+    /* Op-codes sorted by cycles
+     */
+    sort_key = cycles;
+    for ( i = 0, count = 0; i < 3 * 256; i++ )
+    {
+        if ( executions[i] )
+            order[count++] = i;
+    }
+    qsort(order, count, sizeof(int), sort_compare);
+
+    fprintf(file, "%-9s %-8s %14s %14s %9s\n", "Op-code", "Mnemonic", "Executions", "Cycles", "Cycles %");
+    for ( i = 0; i < count; i++ )
+    {
+        op_code = order[i] < 256 ? order[i] : ((order[i] / 256 + 0x0f) << 8) + (order[i] & 0xff);
+        fprintf(file, "%-9s %-8s %14llu %14llu %9.2f\n",
+                profile_op_name(op_code), profile_mnemonic(op_code),
+                (unsigned long long) executions[order[i]], (unsigned long long) cycles[order[i]],
+                total_cycles ? (100.0 * cycles[order[i]]) / total_cycles : 0.0);
+    }
+
+    /* Addresses sorted by cycles
+     */
+    sort_key = address_cycles;
+    for ( i = 0, count = 0; i < MEMORY; i++ )
+    {
+        if ( profile->count[i].executions )
+            order[count++] = i;
+    }
+    qsort(order, count, sizeof(int), sort_compare);
+
+    fprintf(file, "\n%-9s %-8s %14s %14s %9s\n", "Address", "Mnemonic", "Executions", "Cycles", "Cycles %");
+    for ( i = 0; i < count && i < PROFILE_REPORT_ADDRESSES; i++ )
+    {
+        fprintf(file, "0x%04x    %-8s %14llu %14llu %9.2f\n",
+                order[i], profile_mnemonic(profile->op_code[order[i]]),
+                (unsigned long long) profile->count[order[i]].executions,
+                (unsigned long long) profile->count[order[i]].cycles,
+                total_cycles ? (100.0 * profile->count[order[i]].cycles) / total_cycles : 0.0);
+    }
+
+    free(executions);
+    free(cycles);
+    free(address_cycles);
+    free(order);
+    fclose(file);
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_profile_dump()
+ *
+ *  Write the execution profile as a raw binary dump: an 8 byte
+ *  magic string "MC09PROF", a 32-bit version and a 32-bit address count,
+ *  followed by a 64-bit executions and 64-bit cycles pair per address
+ *  and a 16-bit op-code per address, all in host byte order.
+ *
+ *  param:  Dump file name
+ *  return: 0- dump written, -1- file error or profiler not enabled
+ */
+int cpu_profile_dump(const char *file_name)
+{
+    return cpu_ctx_profile_dump(&default_context, file_name);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_profile_dump()
+ *
+ *  Write the execution profile of a CPU context as a raw binary dump.
+ *
+ *  param:  Pointer to CPU context, dump file name
+ *  return: 0- dump written, -1- file error or profiler not enabled
+ */
+int cpu_ctx_profile_dump(cpu_context_t *ctx, const char *file_name)
+{
+#if (PROFILE)
+    FILE           *file;
+    uint32_t        header[2] = { PROFILE_DUMP_VERSION, MEMORY };
+    int             error = 0;
+
+    file = fopen(file_name, "wb");
+    if ( file == 0L )
+        return -1;
+
+    error |= fwrite(PROFILE_DUMP_MAGIC, 8, 1, file) != 1;
+    error |= fwrite(header, sizeof(header), 1, file) != 1;
+    error |= fwrite(ctx->profile.count, sizeof(ctx->profile.count), 1, file) != 1;
+    error |= fwrite(ctx->profile.op_code, sizeof(ctx->profile.op_code), 1, file) != 1;
+
+    if ( fclose(file) != 0 || error )
+        return -1;
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_profile_on_exit()
+ *
+ *  Write the execution profile report and dump of the
+ *  default context when the program exits.
+ *
+ *  param:  Report file name and dump file name, NULL to skip either
+ *  return: 0- registered, -1- profiler not enabled or registration failed
+ */
+int cpu_profile_on_exit(const char *report_file_name, const char *dump_file_name)
+{
+#if (PROFILE)
+    profile_report_file = report_file_name;
+    profile_dump_file = dump_file_name;
+
+    if ( !profile_exit_registered && atexit(profile_exit) != 0 )
+        return -1;
+
+    profile_exit_registered = 1;
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_call_graph_clear()
+ *
+ *  Clear the call graph. The routines being run
+ *  stay on the shadow stack.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+void cpu_call_graph_clear(void)
+{
+    cpu_ctx_call_graph_clear(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_call_graph_clear()
+ *
+ *  Clear the call graph of a CPU context.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+void cpu_ctx_call_graph_clear(cpu_context_t *ctx)
+{
+#if (CALL_GRAPH)
+    call_graph_t   *graph = &ctx->call_graph;
+    call_node_t     frames[CALL_GRAPH_DEPTH];
+    int             stack[CALL_GRAPH_DEPTH];
+    int             i, depth;
+
+    if ( graph->nodes == 0 )
+        return;
+
+    /* Keep the routines on the shadow stack and
+     * enter them again into an empty call tree
+     */
+    depth = graph->depth;
+    for ( i = 1; i < depth; i++ )
+    {
+        frames[i] = graph->node[graph->frame[i].node];
+        stack[i] = graph->frame[i].stack;
+    }
+
+    graph->nodes = 0;
+    graph->lost = 0;
+    call_graph_restart(ctx);
+
+    CONTEXT_ENTER(ctx);
+    for ( i = 1; i < depth; i++ )
+    {
+        call_graph_enter(frames[i].routine, frames[i].kind, stack[i]);
+    }
+    CONTEXT_EXIT();
+
+    for ( i = 1; i < graph->nodes; i++ )
+    {
+        graph->node[i].calls = 0;
+    }
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_call_graph_folded()
+ *
+ *  Write the call graph as folded stacks, one line per call path
+ *  with the routine names from the call graph root separated by ';'
+ *  and the exclusive cycles of the last routine. This is the input
+ *  format of flame graph tools such as flamegraph.pl.
+ *
+ *  param:  File name, symbol name function or NULL for addresses only
+ *  return: 0- file written, -1- file error or call graph not enabled
+ */
+int cpu_call_graph_folded(const char *file_name, cpu_symbol_t symbol)
+{
+    return cpu_ctx_call_graph_folded(&default_context, file_name, symbol);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_call_graph_folded()
+ *
+ *  Write the call graph of a CPU context as folded stacks.
+ *
+ *  param:  Pointer to CPU context, file name,
+ *          symbol name function or NULL for addresses only
+ *  return: 0- file written, -1- file error or call graph not enabled
+ */
+int cpu_ctx_call_graph_folded(cpu_context_t *ctx, const char *file_name, cpu_symbol_t symbol)
+{
+#if (CALL_GRAPH)
+    call_graph_t   *graph = &ctx->call_graph;
+    FILE           *file;
+    int             path[CALL_GRAPH_DEPTH + 1];
+    int             i, node, length;
+
+    file = fopen(file_name, "w");
+    if ( file == 0L )
+        return -1;
+
+    if ( graph->nodes )
+        call_graph_charge(ctx);
+
+    for ( i = 1; i < graph->nodes; i++ )
+    {
+        if ( graph->node[i].cycles == 0 )
+            continue;
+
+        length = 0;
+        for ( node = i; node > 0 && length <= CALL_GRAPH_DEPTH; node = graph->node[node].parent )
+        {
+            path[length++] = node;
+        }
+
+        while ( length-- )
+        {
+            fprintf(file, "%s", call_graph_frame_name(&graph->node[path[length]], symbol));
+            fprintf(file, "%s", length ? ";" : " ");
+        }
+
+        fprintf(file, "%llu\n", (unsigned long long) graph->node[i].cycles);
+    }
+
+    if ( fclose(file) != 0 )
+        return -1;
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_call_graph_report()
+ *
+ *  Write a text report of the call graph: calls, inclusive and
+ *  exclusive cycles of every routine, sorted by inclusive cycles.
+ *  Cycles of recursive calls are included once in the
+ *  inclusive cycles of the outermost call.
+ *
+ *  param:  File name, symbol name function or NULL for addresses only
+ *  return: 0- file written, -1- file error or call graph not enabled
+ */
+int cpu_call_graph_report(const char *file_name, cpu_symbol_t symbol)
+{
+    return cpu_ctx_call_graph_report(&default_context, file_name, symbol);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_call_graph_report()
+ *
+ *  Write a text report of the call graph of a CPU context.
+ *
+ *  param:  Pointer to CPU context, file name,
+ *          symbol name function or NULL for addresses only
+ *  return: 0- file written, -1- file error or call graph not enabled
+ */
+int cpu_ctx_call_graph_report(cpu_context_t *ctx, const char *file_name, cpu_symbol_t symbol)
+{
+#if (CALL_GRAPH)
+    call_graph_t   *graph = &ctx->call_graph;
+    call_node_t    *node;
+    FILE           *file;
+    uint64_t       *path_cycles, *inclusive, *exclusive, *calls;
+    uint64_t        total_cycles;
+    const char     *name;
+    int            *order;
+    int             i, ancestor, count;
+
+    path_cycles = calloc(CALL_GRAPH_NODES, sizeof(uint64_t));
+    inclusive = calloc(MEMORY, sizeof(uint64_t));
+    exclusive = calloc(MEMORY, sizeof(uint64_t));
+    calls = calloc(MEMORY, sizeof(uint64_t));
+    order = malloc(MEMORY * sizeof(int));
+    file = fopen(file_name, "w");
+
+    if ( path_cycles == 0L || inclusive == 0L || exclusive == 0L ||
+         calls == 0L || order == 0L || file == 0L )
+    {
+        free(path_cycles);
+        free(inclusive);
+        free(exclusive);
+        free(calls);
+        free(order);
+        if ( file )
+            fclose(file);
+        return -1;
+    }
+
+    if ( graph->nodes )
+        call_graph_charge(ctx);
+
+    /* Inclusive cycles of every call path. A callee node
+     * is always created after its caller node.
+     */
+    for ( i = 0; i < graph->nodes; i++ )
+    {
+        path_cycles[i] = graph->node[i].cycles;
+    }
+
+    for ( i = graph->nodes - 1; i > 0; i-- )
+    {
+        path_cycles[graph->node[i].parent] += path_cycles[i];
+    }
+
+    total_cycles = graph->nodes ? path_cycles[0] : 0;
+
+    /* Routine totals, counting the inclusive cycles of
+     * a recursive call path only at its outermost call
+     */
+    for ( i = 1; i < graph->nodes; i++ )
+    {
+        node = &graph->node[i];
+
+        exclusive[node->routine] += node->cycles;
+        calls[node->routine] += node->calls;
+
+        for ( ancestor = node->parent; ancestor > 0; ancestor = graph->node[ancestor].parent )
+        {
+            if ( graph->node[ancestor].routine == node->routine )
+                break;
+        }
+
+        if ( ancestor <= 0 )
+            inclusive[node->routine] += path_cycles[i];
+    }
+
+    fprintf(file, "MC6809E call graph\n");
+    fprintf(file, "%llu cycles, %d call paths, %lu calls not recorded\n\n",
+            (unsigned long long) total_cycles, graph->nodes ? graph->nodes - 1 : 0, graph->lost);
+
+    sort_key = inclusive;
+    for ( i = 0, count = 0; i < MEMORY; i++ )
+    {
+        if ( inclusive[i] || calls[i] )
+            order[count++] = i;
+    }
+    qsort(order, count, sizeof(int), sort_compare);
+
+    fprintf(file, "%-9s %-20s %12s %14s %9s %14s %9s\n",
+            "Address", "Routine", "Calls", "Inclusive", "Incl. %", "Exclusive", "Excl. %");
+    for ( i = 0; i < count; i++ )
+    {
+        name = symbol ? symbol(order[i]) : 0L;
+        fprintf(file, "0x%04x    %-20s %12llu %14llu %9.2f %14llu %9.2f\n",
+                order[i], name ? name : "",
+                (unsigned long long) calls[order[i]],
+                (unsigned long long) inclusive[order[i]],
+                total_cycles ? (100.0 * inclusive[order[i]]) / total_cycles : 0.0,
+                (unsigned long long) exclusive[order[i]],
+                total_cycles ? (100.0 * exclusive[order[i]]) / total_cycles : 0.0);
+    }
+
+    free(path_cycles);
+    free(inclusive);
+    free(exclusive);
+    free(calls);
+    free(order);
+
+    if ( fclose(file) != 0 )
+        return -1;
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * cpu_get_cycle_audit()
+ *
+ *  Get the cycle audit: the count of instructions checked against
+ *  the cycle reference, the count of mismatches, and a log of the
+ *  mismatches by address, op-code and cycles.
+ *
+ *  param:  Pointer to cycle audit data structure,
+ *          '1' to clear the audit after reading it
+ *  return: 0- audit read, -1- cycle audit not enabled
+ */
+int cpu_get_cycle_audit(cpu_cycle_audit_t *audit, int clear)
+{
+    return cpu_ctx_get_cycle_audit(&default_context, audit, clear);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_cycle_audit()
+ *
+ *  Get the cycle audit of a CPU context.
+ *
+ *  param:  Pointer to CPU context, pointer to cycle audit data structure,
+ *          '1' to clear the audit after reading it
+ *  return: 0- audit read, -1- cycle audit not enabled
+ */
+int cpu_ctx_get_cycle_audit(cpu_context_t *ctx, cpu_cycle_audit_t *audit, int clear)
+{
+#if (CYCLE_AUDIT)
+    *audit = ctx->audit;
+
+    if ( clear )
+        memset(&ctx->audit, 0, sizeof(cpu_cycle_audit_t));
+
+    return 0;
+#else
+    memset(audit, 0, sizeof(cpu_cycle_audit_t));
+    return -1;
+#endif
+}
+
+/*------------------------------------------------
+ * run_instruction()
+ *
+ *  Process RESET, HALT and interrupts, then fetch and
+ *  execute one instruction.
+ *  The cycles are added to the emulated time.
+ *
+ *  param:  Nothing
+ *  return: Instruction and interrupt entry cycles, '0' if no instruction was executed
+ */
+static int run_instruction(void)
+{
+    int         cycles;
+    int         bytes;
+    int         int_cycles = 0;
+#if (PROFILE || CALL_GRAPH)
+    int         op_pc = -1;
+#endif
+#if (CYCLE_AUDIT)
+    audit_op_t  audit_op;
+#endif
+#if (CPU_DISPATCH == CPU_DISPATCH_SWITCH)
+    int         eff_addr;
+    uint8_t     operand8;
+    uint16_t    operand16;
+    int         op_code = -1;
+#endif
+
+    /* At exit of this function PC will point to the next op-code
+     * so this preserves the current PC for other uses such as
+     * single step etc.
+     */
+    active->cpu.last_pc = active->cpu.pc;
+
+    /* RESET, HALT, SYNC and interrupts are only processed when
+     * the pending event word is set, otherwise fetch and execute.
+     */
+    if ( active->events == 0 || process_events(&int_cycles) )
+    {
+
+#if (PROFILE || CALL_GRAPH)
+        op_pc = active->cpu.pc;
+#endif
+
+#if (CYCLE_AUDIT)
+        audit_reference(&audit_op, active->cpu.pc);
+#endif
+
+#if (PREDECODE)
+        execute_predecoded(&cycles, &bytes);
+#elif (CPU_DISPATCH == CPU_DISPATCH_TABLE)
+        execute_table(&cycles, &bytes);
+#elif (CPU_DISPATCH == CPU_DISPATCH_GOTO)
+        execute_goto(&cycles, &bytes);
+#else
+        op_code = MEM_READ(active->cpu.pc);
+        active->cpu.pc++;
+
+        /* Double-byte 0x10 prefix
+         */
+        if ( op_code == 0x10 )
+        {
+            op_code = MEM_READ(active->cpu.pc);
+            active->cpu.pc++;
+
+            /* Decode 0x10 double byte op-code. An illegal op-code
+             * will be caught by get_eff_addr() and the switch-case below.
+             */
+            cycles = op_code_page2[op_code].cycles;
+            bytes = op_code_page2[op_code].bytes;
+
+            eff_addr = get_eff_addr(op_code_page2[op_code].mode, &cycles, &bytes);
+
+            switch ( op_code )
+            {
+                /* CMPD
+                 */
+                case 0x83:
+                case 0x93:
+                case 0xa3:
+                case 0xb3:
+                    operand16 = MEM_READ16(eff_addr);
+                    cmp16(active->cpu.d, operand16);
+                    break;
+
+                /* CMPY
+                 */
+                case 0x8c:
+                case 0x9c:
+                case 0xac:
+                case 0xbc:
+                    operand16 = MEM_READ16(eff_addr);
+                    cmp16(active->cpu.y, operand16);
+                    break;
+
+                /* LDS
+                 */
+                case 0xce:
+                case 0xde:
+                case 0xee:
+                case 0xfe:
+                    active->cpu.s = MEM_READ16(eff_addr);
+                    eval_cc_nz16(active->cpu.s);
+                    SET_CC_V(CC_FLAG_CLR);
+                    active->cpu.nmi_armed = 1;
+                    break;
+
+                /* LDY
+                 */
+                case 0x8e:
+                case 0x9e:
+                case 0xae:
+                case 0xbe:
+                    active->cpu.y = MEM_READ16(eff_addr);
+                    eval_cc_nz16(active->cpu.y);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STS
+                 */
+                case 0xdf:
+                case 0xef:
+                case 0xff:
+                    MEM_WRITE16(eff_addr, active->cpu.s);
+                    eval_cc_nz16(active->cpu.s);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STY
+                 */
+                case 0x9f:
+                case 0xaf:
+                case 0xbf:
+                    MEM_WRITE16(eff_addr, active->cpu.y);
+                    eval_cc_nz16(active->cpu.y);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LBRN
+                 */
+                case 0x21:
+                    // Long branch never
+                    break;
+
+                /* Long conditional branches
+                 */
+                case 0x22 ... 0x2f:
+                    branch(op_code, 1, eff_addr, &cycles);
+                    break;
+
+                /* SWI2
+                 */
+                case 0x3f:
+                    swi(2);
+                    break;
+
+                default:
+                    /* Exception: Illegal 0x10 op-code cpu_run()
+                     */
+                    set_state(CPU_EXCEPTION);
+                    active->cpu.exception_line_num = __LINE__;
+            }
+        }
+        /* Double-byte 0x11 prefix
+         */
+        else if ( op_code == 0x11 )
+        {
+            op_code = MEM_READ(active->cpu.pc);
+            active->cpu.pc++;
+
+            /* Decode 0x11 double byte op-code. An illegal op-code
+             * will be caught by get_eff_addr() and the switch-case below.
+             */
+            cycles = op_code_page3[op_code].cycles;
+            bytes = op_code_page3[op_code].bytes;
+
+            eff_addr = get_eff_addr(op_code_page3[op_code].mode, &cycles, &bytes);
+
+            switch ( op_code )
+            {
+                /* CMPU
+                 */
+                case 0x83:
+                case 0x93:
+                case 0xa3:
+                case 0xb3:
+                    operand16 = MEM_READ16(eff_addr);
+                    cmp16(active->cpu.u, operand16);
+                    break;
+
+                /* CMPS
+                 */
+                case 0x8c:
+                case 0x9c:
+                case 0xac:
+                case 0xbc:
+                    operand16 = MEM_READ16(eff_addr);
+                    cmp16(active->cpu.s, operand16);
+                    break;
+
+                /* SWI3
+                 */
+                case 0x3f:
+                    swi(3);
+                    break;
+
+                default:
+                    /* Exception: Illegal 0x11 op-code cpu_run()
+                     */
+                    set_state(CPU_EXCEPTION);
+                    active->cpu.exception_line_num = __LINE__;
+            }
+        }
+        /* Common op-code processing
+         */
+        else
+        {
+            /* 'operand8' will be operand byte, and for a 16-bit operand 'operand8'
+             * will be the high order byte and low order byte should be read separately
+             * and combined into 16-bit value.
+             */
+            cycles = machine_code[op_code].cycles;
+            bytes = machine_code[op_code].bytes;
+
+            eff_addr = get_eff_addr(machine_code[op_code].mode, &cycles, &bytes);
+
+            switch ( op_code )
+            {
+                /* ABX
+                 */
+                case 0x3a:
+                    active->cpu.x += active->cpu.b;
+                    break;
+
+                /* ADCA
+                 */
+                case 0x89:
+                case 0x99:
+                case 0xa9:
+                case 0xb9:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = adc(active->cpu.a, operand8);
+                    break;
+
+                /* ADCB
+                 */
+                case 0xc9:
+                case 0xd9:
+                case 0xe9:
+                case 0xf9:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = adc(active->cpu.b, operand8);
+                    break;
+
+                /* ADDA
+                 */
+                case 0x8b:
+                case 0x9b:
+                case 0xab:
+                case 0xbb:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = add(active->cpu.a, operand8);
+                    break;
+
+                /* ADDB
+                 */
+                case 0xcb:
+                case 0xdb:
+                case 0xeb:
+                case 0xfb:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = add(active->cpu.b, operand8);
+                    break;
+
+                /* ADDD
+                 */
+                case 0xc3:
+                case 0xd3:
+                case 0xe3:
+                case 0xf3:
+                    operand16 = MEM_READ16(eff_addr);
+                    addd(operand16);
+                    break;
+
+                /* ANDA
+                 */
+                case 0x84:
+                case 0x94:
+                case 0xa4:
+                case 0xb4:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = and(active->cpu.a, operand8);
+                    break;
+
+                /* ADDB
+                 */
+                case 0xc4:
+                case 0xd4:
+                case 0xe4:
+                case 0xf4:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = and(active->cpu.b, operand8);
+                    break;
+
+                /* ANDCC
+                 */
+                case 0x1c:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    andcc(operand8);
+                    break;
+
+                /* ASL, ASLA, ASLB
+                 * LSL, LSLA, LSLB
+                 */
+                case 0x08:
+                case 0x68:
+                case 0x78:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = asl(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x48:
+                    active->cpu.a = asl(active->cpu.a);
+                    break;
+
+                case 0x58:
+                    active->cpu.b = asl(active->cpu.b);
+                    break;
+
+                /* ASR, ASRA, ASRB
+                 */
+                case 0x07:
+                case 0x67:
+                case 0x77:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = asr(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x47:
+                    active->cpu.a = asr(active->cpu.a);
+                    break;
+
+                case 0x57:
+                    active->cpu.b = asr(active->cpu.b);
+                    break;
+
+                /* BITA
+                 */
+                case 0x85:
+                case 0x95:
+                case 0xa5:
+                case 0xb5:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    bit(active->cpu.a, operand8);
+                    break;
+
+                /* BITB
+                 */
+                case 0xc5:
+                case 0xd5:
+                case 0xe5:
+                case 0xf5:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    bit(active->cpu.b, operand8);
+                    break;
+
+                /* CLR, CLRA, CLRB
+                 */
+                case 0x0f:
+                case 0x6f:
+                case 0x7f:
+                    operand8 = clr();
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x4f:
+                    active->cpu.a = clr();
+                    break;
+
+                case 0x5f:
+                    active->cpu.b = clr();
+                    break;
+
+                /* CMPA
+                 */
+                case 0x81:
+                case 0x91:
+                case 0xa1:
+                case 0xb1:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    cmp(active->cpu.a, operand8);
+                    break;
+
+                /* CMPB
+                 */
+                case 0xc1:
+                case 0xd1:
+                case 0xe1:
+                case 0xf1:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    cmp(active->cpu.b, operand8);
+                    break;
+
+                /* CMPX
+                 */
+                case 0x8c:
+                case 0x9c:
+                case 0xac:
+                case 0xbc:
+                    operand16 = MEM_READ16(eff_addr);
+                    cmp16(active->cpu.x, operand16);
+                    break;
+
+                /* COM, COMA, COMB
+                 */
+                case 0x03:
+                case 0x63:
+                case 0x73:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = com(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x43:
+                    active->cpu.a = com(active->cpu.a);
+                    break;
+
+                case 0x53:
+                    active->cpu.b = com(active->cpu.b);
+                    break;
+
+                /* CWAI
+                 */
+                case 0x3c:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    cwai(operand8);
+                    break;
+
+                /* DAA
+                 */
+                case 0x19:
+                    daa();
+                    break;
+
+                /* DEC, DECA, DECB
+                 */
+                case 0x0a:
+                case 0x6a:
+                case 0x7a:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = dec(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x4a:
+                    active->cpu.a = dec(active->cpu.a);
+                    break;
+
+                case 0x5a:
+                    active->cpu.b = dec(active->cpu.b);
+                    break;
+
+                /* EORA
+                 */
+                case 0x88:
+                case 0x98:
+                case 0xa8:
+                case 0xb8:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = eor(active->cpu.a, operand8);
+                    break;
+
+                /* EORB
+                 */
+                case 0xc8:
+                case 0xd8:
+                case 0xe8:
+                case 0xf8:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = eor(active->cpu.b, operand8);
+                    break;
+
+                /* EXG
+                 */
+                case 0x1e:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    exg(operand8);
+                    break;
+
+                /* INC, INCA, INCB
+                 */
+                case 0x0c:
+                case 0x6c:
+                case 0x7c:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = inc(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x4c:
+                    active->cpu.a = inc(active->cpu.a);
+                    break;
+
+                case 0x5c:
+                    active->cpu.b = inc(active->cpu.b);
+                    break;
+
+                /* JMP
+                 */
+                case 0x0e:
+                case 0x6e:
+                case 0x7e:
+                    active->cpu.pc = eff_addr;
+                    break;
+
+                /* JSR
+                 */
+                case 0x9d:
+                case 0xad:
+                case 0xbd:
+                    active->cpu.s--;
+                    MEM_WRITE(active->cpu.s, GET_REG_LOW(active->cpu.pc));
+                    active->cpu.s--;
+                    MEM_WRITE(active->cpu.s, GET_REG_HIGH(active->cpu.pc));
+                    active->cpu.pc = eff_addr;
+                    break;
+
+                /* LDA
+                 */
+                case 0x86:
+                case 0x96:
+                case 0xa6:
+                case 0xb6:
+                    active->cpu.a = (uint8_t) MEM_READ(eff_addr);;
+                    eval_cc_nz((uint16_t) active->cpu.a);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LDB
+                 */
+                case 0xc6:
+                case 0xd6:
+                case 0xe6:
+                case 0xf6:
+                    active->cpu.b = (uint8_t) MEM_READ(eff_addr);;
+                    eval_cc_nz((uint16_t) active->cpu.b);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LDD
+                 */
+                case 0xcc:
+                case 0xdc:
+                case 0xec:
+                case 0xfc:
+                    active->cpu.a = (uint8_t) MEM_READ(eff_addr);;
+                    eff_addr++;
+                    active->cpu.b = (uint8_t) MEM_READ(eff_addr);
+                    eval_cc_nz16(active->cpu.d);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LDU
+                 */
+                case 0xce:
+                case 0xde:
+                case 0xee:
+                case 0xfe:
+                    active->cpu.u = MEM_READ16(eff_addr);
+                    eval_cc_nz16(active->cpu.u);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LDX
+                 */
+                case 0x8e:
+                case 0x9e:
+                case 0xae:
+                case 0xbe:
+                    active->cpu.x = MEM_READ16(eff_addr);
+                    eval_cc_nz16(active->cpu.x);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* LEA
+                 */
+                case 0x30:
+                    active->cpu.x = eff_addr;
+                    eval_cc_z16(active->cpu.x);
+                    break;
+
+                case 0x31:
+                    active->cpu.y = eff_addr;
+                    eval_cc_z16(active->cpu.y);
+                    break;
+
+                case 0x32:
+                    active->cpu.s = eff_addr;
+                    active->cpu.nmi_armed = 1;
+                    break;
+
+                case 0x33:
+                    active->cpu.u = eff_addr;
+                    break;
+
+                /* LSR, LSRA, LSRB
+                 */
+                case 0x04:
+                case 0x64:
+                case 0x74:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = lsr(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x44:
+                    active->cpu.a = lsr(active->cpu.a);
+                    break;
+
+                case 0x54:
+                    active->cpu.b = lsr(active->cpu.b);
+                    break;
+
+                /* MUL
+                 */
+                case 0x3d:
+                    operand16 = active->cpu.a * active->cpu.b;
+                    active->cpu.d = operand16;
+                    eval_cc_z16(operand16);
+                    eval_cc_c(operand16);;
+                    break;
+
+                /* NEG, NEGA, NEGB
+                 */
+                case 0x00:
+                case 0x60:
+                case 0x70:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = neg(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x40:
+                    active->cpu.a = neg(active->cpu.a);
+                    break;
+
+                case 0x50:
+                    active->cpu.b = neg(active->cpu.b);
+                    break;
+
+                /* NOP
+                 */
+                case 0x12:
+                    break;
+
+                /* ORA, ORB
+                 */
+                case 0x8a:
+                case 0x9a:
+                case 0xaa:
+                case 0xba:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = or(active->cpu.a, operand8);
+                    break;
+
+                case 0xca:
+                case 0xda:
+                case 0xea:
+                case 0xfa:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = or(active->cpu.b, operand8);
+                    break;
+
+                /* ORCC
+                 */
+                case 0x1a:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    orcc(operand8);
+                    break;
+
+                /* PSHS, PSHU
+                 */
+                case 0x34:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    pshs(operand8, &cycles);
+                    break;
+
+                case 0x36:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    pshu(operand8, &cycles);
+                    break;
+
+                /* PULS, PULU
+                 */
+                case 0x35:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    puls(operand8, &cycles);
+                    break;
+
+                case 0x37:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    pulu(operand8, &cycles);
+                    break;
+
+                /* ROL, ROLA, ROLB
+                 */
+                case 0x09:
+                case 0x69:
+                case 0x79:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = rol(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x49:
+                    active->cpu.a = rol(active->cpu.a);
+                    break;
+
+                case 0x59:
+                    active->cpu.b = rol(active->cpu.b);
+                    break;
+
+                /* ROR, RORA, RORB
+                 */
+                case 0x06:
+                case 0x66:
+                case 0x76:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    operand8 = ror(operand8);
+                    MEM_WRITE(eff_addr, operand8);
+                    break;
+
+                case 0x46:
+                    active->cpu.a = ror(active->cpu.a);
+                    break;
+
+                case 0x56:
+                    active->cpu.b = ror(active->cpu.b);
+                    break;
+
+                /* RTI
+                 */
+                case 0x3b:
+                    rti(&cycles);
+                    break;
+
+                /* RTS
+                 */
+                case 0x39:
+                     /* Restore PC and return
+                      */
+                     operand8 = MEM_READ(active->cpu.s);
+                     active->cpu.s++;
+                     active->cpu.pc = (uint16_t) operand8 << 8;
+                     operand8 = MEM_READ(active->cpu.s);
+                     active->cpu.s++;
+                     active->cpu.pc += operand8;
+                     break;
+
+                /* SBCA
+                 */
+                case 0x82:
+                case 0x92:
+                case 0xa2:
+                case 0xb2:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = sbc(active->cpu.a, operand8);
+                    break;
+
+                /* SBCB
+                 */
+                case 0xc2:
+                case 0xd2:
+                case 0xe2:
+                case 0xf2:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = sbc(active->cpu.b, operand8);
+                    break;
+
+                /* SEX
+                 */
+                case 0x1d:
+                    sex();
+                    break;
+
+                /* STA
+                 */
+                case 0x97:
+                case 0xa7:
+                case 0xb7:
+                    MEM_WRITE(eff_addr, active->cpu.a);
+                    eval_cc_nz((uint16_t) active->cpu.a);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STB
+                 */
+                case 0xd7:
+                case 0xe7:
+                case 0xf7:
+                    MEM_WRITE(eff_addr, active->cpu.b);
+                    eval_cc_nz((uint16_t) active->cpu.b);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STD
+                 */
+                case 0xdd:
+                case 0xed:
+                case 0xfd:
+                    MEM_WRITE16(eff_addr, active->cpu.d);
+                    eval_cc_nz16(active->cpu.d);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STU
+                 */
+                case 0xdf:
+                case 0xef:
+                case 0xff:
+                    MEM_WRITE16(eff_addr, active->cpu.u);
+                    eval_cc_nz16(active->cpu.u);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* STX
+                 */
+                case 0x9f:
+                case 0xaf:
+                case 0xbf:
+                    MEM_WRITE16(eff_addr, active->cpu.x);
+                    eval_cc_nz16(active->cpu.x);
+                    SET_CC_V(CC_FLAG_CLR);
+                    break;
+
+                /* SUBA
+                 */
+                case 0x80:
+                case 0x90:
+                case 0xa0:
+                case 0xb0:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.a = sub(active->cpu.a, operand8);
+                    break;
+
+                /* SUBB
+                 */
+                case 0xc0:
+                case 0xd0:
+                case 0xe0:
+                case 0xf0:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    active->cpu.b = sub(active->cpu.b, operand8);
+                    break;
+
+                /* SUBD
+                 */
+                case 0x83:
+                case 0x93:
+                case 0xa3:
+                case 0xb3:
+                    operand16 = MEM_READ16(eff_addr);
+                    subd(operand16);
+                    break;
+
+                /* SWI
+                 */
+                case 0x3f:
+                    swi(1);
+                    break;
+
+                /* SYNC
+                 *
+                 * The SYNC instruction allows software to synchronize with an external hardware
+                 * event (interrupt). When executed, SYNC stops executing instructions and waits
+                 * for an interrupt. None of the CC flags are directly affected.
+                 */
+                case 0x13:
+                    set_state(CPU_SYNC);
+                    break;
+
+                /* TFR
+                 */
+                case 0x1f:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    tfr(operand8);
+                    break;
+
+                /* TSTA
+                 */
+                case 0x4d:
+                    tst(active->cpu.a);
+                    break;
+
+                /* TSTB
+                 */
+                case 0x5d:
+                    tst(active->cpu.b);
+                    break;
+
+                /* TST
+                 */
+                case 0x0d:
+                case 0x6d:
+                case 0x7d:
+                    operand8 = (uint8_t) MEM_READ(eff_addr);
+                    tst(operand8);
+                    break;
+
+                /* BRA / LBRA
+                 */
+                case 0x20:
+                case 0x16:
+                    active->cpu.pc = eff_addr;
+                    break;
+
+                /* BRN
+                 */
+                case 0x21:
+                    // Branch never
+                    break;
+
+                /* BSR / LBSR
+                 */
+                case 0x8d:
+                case 0x17:
+                    active->cpu.s--;
+                    MEM_WRITE(active->cpu.s, GET_REG_LOW(active->cpu.pc));
+                    active->cpu.s--;
+                    MEM_WRITE(active->cpu.s, GET_REG_HIGH(active->cpu.pc));
+                    active->cpu.pc = eff_addr;
+                    break;
+
+                /* Short conditional branches
+                 */
+                case 0x22 ... 0x2f:
+                    branch(op_code, 0, eff_addr, &cycles);
+                    break;
+
+                default:
+                    /* Exception: Illegal op-code cpu_run()
+                     */
+                    set_state(CPU_EXCEPTION);
+                    active->cpu.exception_line_num = __LINE__;
+            }
+        }
+#endif  /* CPU_DISPATCH */
+
+#if (PROFILE)
+        profile_count(op_pc, cycles);
+#endif
+
+#if (CYCLE_AUDIT)
+        audit_check(&audit_op, cycles);
+#endif
+    }
+    else
+    {
+        return 0;
+    }
+
+    /* Preserves for other uses such as
+     * single step etc.
+     */
+    active->cpu.last_opcode_bytes = bytes;
+    active->cpu.last_opcode_cycles = cycles;
+
+    cycles += int_cycles;
+    active->cpu.cycles += cycles;
+
+#if (CALL_GRAPH)
+    if ( op_pc != -1 )
+        call_graph_step(op_pc);
+#endif
+
+    return cycles;
+}
+
+/*------------------------------------------------
+ * process_events()
+ *
+ *  Process RESET, HALT, SYNC and interrupts before
+ *  the next instruction fetch. Called by run_instruction()
+ *  only when the pending event word is not '0'.
+ *
+ *  param:  Pointer to interrupt service cycle count
+ *  return: 1- fetch and execute the next instruction,
+ *          0- CPU in RESET, HALTed or waiting in SYNC
+ */
+static int process_events(int *int_cycles)
+{
+    int  intr_latch;
+
+    /* Latch interrupt requests, the interrupt event
+     * bits are the NMI latch and the IRQ and FIRQ line levels.
+     */
+    intr_latch = active->events & (INT_NMI | INT_FIRQ | INT_IRQ);
+
+    /* Check RESET at every cycle
+     * this will emulate an asynchronous RESET response.
+     */
+    if ( active->cpu.reset_asserted )
+    {
+        SET_CC_F(CC_FLAG_SET);
+        SET_CC_I(CC_FLAG_SET);
+        active->cpu.dp = 0;
+        active->cpu.nmi_armed = 0;
+        active->cpu.nmi_latched = 0;
+        active->events &= ~EVENT_NMI;
+#if (CPU_6309)
+        if ( NATIVE_MODE() )
+            cache_invalidate(active);
+        active->cpu.md = 0;
+#endif
+        set_state(CPU_RESET);
+        active->cpu.pc = MEM_READ16(VEC_RESET);
+        active->cpu.last_pc = active->cpu.pc;
+        active->cpu.last_opcode_bytes = 0;
+        active->cpu.last_opcode_cycles = 0;
+#if (CALL_GRAPH)
+        call_graph_restart(active);
+#endif
+        return 0;
+    }
+    else
+    {
+        /* Only check HALT and interrupts before instruction
+         * fetch execution
+         */
+        if ( active->cpu.halt_asserted )
+        {
+            set_state(CPU_HALTED);
+            return 0;
+        }
+
+        /* We get here if not in RESET and not HALTed.
+         * If the CPU was put into SYNC mode by 'SYNC' or 'CWAI'
+         * then this point will force the emulation to exit execution
+         * and stay in wait mode, or if an interrupt was latched
+         * then execution will proceed with op-code fetch.
+         */
+        if ( active->cpu.cpu_state == CPU_SYNC )
+        {
+            if ( intr_latch == 0 )
+            {
+                return 0;
+            }
+        }
+
+        /* If an interrupt is received and it is enabled, then
+         * setup stack frame and call interrupt service by
+         * setting the PC to the vectors content.
+         * Release CPU state to CPU_EXEC to let COU emulation
          * start fetching and executing instructions.
          *
          * NMI signal is latched at any time and services here.
@@ -355,2582 +3208,5301 @@ cpu_run_state_t cpu_run(void)
          * then it will not be serviced.
          * The IRQ and FIRQ signal is level driven.
          */
-        if ( cpu.nmi_armed && (intr_latch & INT_NMI) )
+        if ( active->cpu.nmi_armed && (intr_latch & INT_NMI) )
+        {
+            SET_CC_E(CC_FLAG_SET);
+
+            push_entire_state();
+
+            active->cpu.nmi_latched = 0;
+            active->events &= ~EVENT_NMI;
+
+            SET_CC_F(CC_FLAG_SET);
+            SET_CC_I(CC_FLAG_SET);
+
+            active->cpu.pc = MEM_READ16(VEC_NMI);
+            *int_cycles = INT_CYCLES_NMI;
+#if (CPU_6309)
+            if ( NATIVE_MODE() )
+                *int_cycles += INT_CYCLES_NATIVE;
+#endif
+#if (CALL_GRAPH)
+            call_graph_interrupt(CALL_NMI);
+#endif
+        }
+#if (CPU_6309)
+        else if ( !GET_CC_F() && (intr_latch & INT_FIRQ) && (active->cpu.md & MD_FIRQ_ALL) )
+        {
+            /* HD6309 FIRQ that stacks the entire machine state like IRQ
+             */
+            SET_CC_E(CC_FLAG_SET);
+            push_entire_state();
+
+            SET_CC_F(CC_FLAG_SET);
+            SET_CC_I(CC_FLAG_SET);
+
+            active->cpu.pc = MEM_READ16(VEC_FIRQ);
+            *int_cycles = INT_CYCLES_IRQ;
+            if ( NATIVE_MODE() )
+                *int_cycles += INT_CYCLES_NATIVE;
+#if (CALL_GRAPH)
+            call_graph_interrupt(CALL_FIRQ);
+#endif
+        }
+#endif
+        else if ( !GET_CC_F() && (intr_latch & INT_FIRQ) )
+        {
+            SET_CC_E(CC_FLAG_CLR);
+
+            push_registers(&active->cpu.s, 0x81, 0, 0);
+
+            SET_CC_F(CC_FLAG_SET);
+            SET_CC_I(CC_FLAG_SET);
+
+            active->cpu.pc = MEM_READ16(VEC_FIRQ);
+            *int_cycles = INT_CYCLES_FIRQ;
+#if (CALL_GRAPH)
+            call_graph_interrupt(CALL_FIRQ);
+#endif
+        }
+        else if ( !GET_CC_I() && (intr_latch & INT_IRQ) )
+        {
+            SET_CC_E(CC_FLAG_SET);
+
+            push_entire_state();
+
+            SET_CC_I(CC_FLAG_SET);
+
+            active->cpu.pc = MEM_READ16(VEC_IRQ);
+            *int_cycles = INT_CYCLES_IRQ;
+#if (CPU_6309)
+            if ( NATIVE_MODE() )
+                *int_cycles += INT_CYCLES_NATIVE;
+#endif
+#if (CALL_GRAPH)
+            call_graph_interrupt(CALL_IRQ);
+#endif
+        }
+
+        /* CPU now running so fetch instruction.
+         * Force state to CPU_EXEC so that the state is
+         * defined if we just came out of reset or SYNC.
+         */
+        set_state(CPU_EXEC);
+    }
+
+    return 1;
+}
+
+/*------------------------------------------------
+ * set_state()
+ *
+ *  Set the CPU running state and keep the pending
+ *  event word state bit in step with it.
+ *
+ *  param:  CPU running state
+ *  return: Nothing
+ */
+static inline void set_state(cpu_run_state_t state)
+{
+    active->cpu.cpu_state = state;
+
+    if ( state == CPU_EXEC )
+        active->events &= ~EVENT_STATE;
+    else
+        active->events |= EVENT_STATE;
+}
+
+/*------------------------------------------------
+ * cpu_get_state()
+ *
+ *  Get the state of the CPU.
+ *
+ *  param:  Pointer to CPU state data structure
+ *  return: CPU running state
+ */
+cpu_run_state_t cpu_get_state(cpu_state_t* cpu_state)
+{
+    return cpu_ctx_get_state(&default_context, cpu_state);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_state()
+ *
+ *  Get the state of a CPU context.
+ *
+ *  param:  Pointer to CPU context, pointer to CPU state data structure
+ *  return: CPU running state
+ */
+cpu_run_state_t cpu_ctx_get_state(cpu_context_t *ctx, cpu_state_t* cpu_state)
+{
+    memcpy(cpu_state, &ctx->cpu, sizeof(cpu_state_t));
+
+    return ctx->cpu.cpu_state;
+}
+
+/*------------------------------------------------
+ * cpu_get_run_state()
+ *
+ *  Get the CPU running state without copying the full CPU state.
+ *
+ *  param:  Nothing
+ *  return: CPU running state
+ */
+cpu_run_state_t cpu_get_run_state(void)
+{
+    return cpu_ctx_get_run_state(&default_context);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_run_state()
+ *
+ *  Get the running state of a CPU context.
+ *
+ *  param:  Pointer to CPU context
+ *  return: CPU running state
+ */
+cpu_run_state_t cpu_ctx_get_run_state(cpu_context_t *ctx)
+{
+    return ctx->cpu.cpu_state;
+}
+
+/*------------------------------------------------
+ * cpu_get_menmonic()
+ *
+ *  Return a pointer to a constant string representing the
+ *  op-code's mnemonic at the input memory address.
+ *
+ *  param:  Memory address
+ *  return: Pointer to constant mnemonic string
+ */
+const char* cpu_get_menmonic(uint16_t address)
+{
+    return cpu_ctx_get_menmonic(cpu_default_context(), address);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_menmonic()
+ *
+ *  Return a pointer to a constant string representing the
+ *  op-code's mnemonic at an address of a CPU context's memory.
+ *
+ *  param:  Pointer to CPU context, memory address
+ *  return: Pointer to constant mnemonic string
+ */
+const char* cpu_ctx_get_menmonic(cpu_context_t *ctx, uint16_t address)
+{
+    int     op_code, index;
+
+    decode_tables_init();
+
+    op_code = mem_ctx_read(ctx->mem, address);
+
+    if ( op_code == 0x10 )
+    {
+        index = op_code_page2[mem_ctx_read(ctx->mem, address + 1)].index;
+    }
+    else if ( op_code == 0x11 )
+    {
+        index = op_code_page3[mem_ctx_read(ctx->mem, address + 1)].index;
+    }
+    else
+    {
+        index = op_code;
+    }
+
+    if ( index == -1 )
+        return "???";
+
+    return machine_code[index].mnem;
+}
+
+/*------------------------------------------------
+ * cpu_get_predecode_stats()
+ *
+ *  Get the predecoded instruction cache and block translation statistics.
+ *  All counts are zero if the cache or translation are not used.
+ *
+ *  param:  Pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_get_predecode_stats(cpu_predecode_stats_t* stats, int clear)
+{
+    cpu_ctx_get_predecode_stats(&default_context, stats, clear);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_predecode_stats()
+ *
+ *  Get the predecoded instruction cache and block translation
+ *  statistics of a CPU context.
+ *
+ *  param:  Pointer to CPU context, pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_ctx_get_predecode_stats(cpu_context_t *ctx, cpu_predecode_stats_t* stats, int clear)
+{
+    cpu_predecode_stats_t  *ctx_stats = &ctx->predecode_stats;
+    unsigned long           total;
+
+    total = ctx_stats->hits + ctx_stats->misses +
+            ctx_stats->uncached + ctx_stats->translated;
+
+    ctx_stats->hit_ratio = total ? (100.0 * (ctx_stats->hits + ctx_stats->translated)) / total : 0.0;
+    ctx_stats->block_ratio = total ? (100.0 * ctx_stats->translated) / total : 0.0;
+
+    memcpy(stats, ctx_stats, sizeof(cpu_predecode_stats_t));
+
+    if ( clear )
+        memset(ctx_stats, 0, sizeof(cpu_predecode_stats_t));
+}
+
+/*------------------------------------------------
+ * cpu_get_fusion_stats()
+ *
+ *  Get the superinstruction fusion statistics: executions of
+ *  each fused instruction sequence, and the instruction dispatches
+ *  saved by them. All counts are zero if fusion is not used.
+ *
+ *  param:  Pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_get_fusion_stats(cpu_fusion_stats_t* stats, int clear)
+{
+    cpu_ctx_get_fusion_stats(&default_context, stats, clear);
+}
+
+/*------------------------------------------------
+ * cpu_ctx_get_fusion_stats()
+ *
+ *  Get the superinstruction fusion statistics of a CPU context.
+ *
+ *  param:  Pointer to CPU context, pointer to statistics data structure,
+ *          '1' to clear the statistics after reading them
+ *  return: Nothing
+ */
+void cpu_ctx_get_fusion_stats(cpu_context_t *ctx, cpu_fusion_stats_t* stats, int clear)
+{
+    int     i;
+
+    stats->dispatches_saved = 0;
+
+    for ( i = 0; i < CPU_FUSION_TYPES; i++ )
+    {
+        stats->name[i] = fusion_names[i + 1];
+        stats->fired[i] = ctx->fusion_fired[i + 1];
+        stats->dispatches_saved += ctx->fusion_fired[i + 1];    // One dispatch per fused pair
+    }
+
+    if ( clear )
+        memset(ctx->fusion_fired, 0, sizeof(ctx->fusion_fired));
+}
+
+/*------------------------------------------------
+ * adc()
+ *
+ *  Add with carry.
+ *
+ *  acc+byte+carry
+ */
+static uint8_t adc(uint8_t acc, uint8_t byte)
+{
+    uint16_t result;
+
+    result = (acc + byte + GET_CC_C());
+
+    eval_cc_hnzvc(acc, byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * add()
+ *
+ *  Add.
+ *
+ *  acc+byte
+ */
+static uint8_t add(uint8_t acc, uint8_t byte)
+{
+    uint16_t result;
+
+    result = (acc + byte);
+
+    eval_cc_hnzvc(acc, byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * addd()
+ *
+ *  Add 16-bit operand to Acc-D
+ *
+ *  acc+word
+ */
+static void addd(uint16_t word)
+{
+    uint16_t acc;
+    uint32_t result;
+
+    acc = active->cpu.d;
+    result = acc + word;
+
+    active->cpu.d = (uint16_t) result;
+
+    eval_cc_nzvc16(acc, word, result);
+}
+
+/*------------------------------------------------
+ * and()
+ *
+ *  Logical AND accumulator with byte operand.
+ *
+ */
+static uint8_t and(uint8_t acc, uint8_t byte)
+{
+    uint8_t result;
+
+    result = (acc & byte);
+
+    eval_cc_nz((uint16_t) result);
+    SET_CC_V(CC_FLAG_CLR);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * andcc()
+ *
+ *  Logical AND condition-code register with operand.
+ *
+ */
+static void andcc(uint8_t byte)
+{
+    uint8_t temp_cc;
+
+    temp_cc = get_cc();
+    temp_cc &= byte;
+    set_cc(temp_cc);
+}
+
+/*------------------------------------------------
+ * asl()
+ *
+ *  Arithmetic shift left.
+ *
+ *  'byte' shift left, MSB into carry flag.
+ */
+static uint8_t asl(uint8_t byte)
+{
+    uint16_t result;
+
+    result = ((uint16_t) byte) << 1;
+
+    eval_cc_nzvc(byte, byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * asr()
+ *
+ *  Arithmetic shift right.
+ *
+ *  'byte' shift right, MSB replicated b7, LSB into carry flag.
+ */
+static uint8_t asr(uint8_t byte)
+{
+    uint8_t result;
+
+    result = (byte >> 1) | (byte & 0x80);
+
+    SET_CC_C((byte & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR);
+    eval_cc_nz((uint16_t) result);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * bit()
+ *
+ *  Bit test accumulator with operand by AND
+ *  without changing accumulator.
+ *  Change flag bit appropriately.
+ *
+ *  acc AND byte
+ */
+static void bit(uint8_t acc, uint8_t byte)
+{
+    uint8_t result;
+
+    result = acc & byte;
+
+    eval_cc_nz((uint16_t) result);
+    SET_CC_V(CC_FLAG_CLR);
+}
+
+/*------------------------------------------------
+ * clr()
+ *
+ *  Clear (zero) bits in operand.
+ *  Change flag bit appropriately.
+ *
+ */
+static uint8_t clr(void)
+{
+    SET_CC_C(CC_FLAG_CLR);
+    SET_CC_V(CC_FLAG_CLR);
+    SET_CC_Z(CC_FLAG_SET);
+    SET_CC_N(CC_FLAG_CLR);
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * cmp()
+ *
+ *  Compare 'arg' to 'byte' by subtracting
+ *  the byte from the argument and updating the
+ *  flags.
+ *
+ */
+static void cmp(uint8_t arg, uint8_t byte)
+{
+    uint16_t result;
+
+    result = arg - byte;
+
+    eval_cc_nzvc(arg, ~byte, result);
+}
+
+/*------------------------------------------------
+ * cmp16()
+ *
+ *  Compare 'arg' to 'word' by subtracting
+ *  the a 16-bit value from the argument and updating the
+ *  flags.
+ *
+ */
+static void cmp16(uint16_t arg, uint16_t word)
+{
+    uint32_t result;
+
+    result = arg - word;
+
+    eval_cc_nzvc16(arg, ~word, result);
+}
+
+/*------------------------------------------------
+ * com()
+ *
+ *  Complement (bit-wise NOT) a byte.
+ *
+ *  ~byte
+ */
+static uint8_t com(uint8_t byte)
+{
+    uint8_t result;
+
+    result = ~byte;
+
+    SET_CC_C(CC_FLAG_SET);
+    SET_CC_V(CC_FLAG_CLR);
+    eval_cc_nz((uint16_t) result);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * cwai()
+ *
+ *  This instruction logically ANDs the contents of the Condition Codes register with the 8-
+ *  bit value specified by the immediate operand. The result is placed back into the
+ *  Condition Codes register. The E flag in the CC register is then set and the entire machine
+ *  state is pushed onto the hardware stack (S). The CPU then halts execution and waits for
+ *  an unmasked interrupt to occur. When such an interrupt occurs, the CPU resumes
+ *  execution at the address obtained from the corresponding interrupt vector.
+ *
+ */
+static void cwai(uint8_t byte)
+{
+    uint8_t temp_cc;
+
+    temp_cc = get_cc();
+    temp_cc &= byte;
+    temp_cc |= 0x80;
+    set_cc(temp_cc);
+
+    push_entire_state();
+
+    set_state(CPU_SYNC);
+}
+
+/*------------------------------------------------
+ * daa()
+ *
+ *  Decimal adjust accumulator A
+ *
+ */
+static void daa(void)
+{
+    uint16_t    temp;
+    uint16_t    high_nibble;
+    uint16_t    low_nibble;
+
+    temp = active->cpu.a;
+    high_nibble = temp & 0xf0;
+    low_nibble = temp & 0x0f;
+
+    if ( low_nibble > 0x09 || GET_CC_H() )
+        temp += 0x06;
+    if ( high_nibble > 0x80 && low_nibble > 0x09 )
+        temp += 0x60;
+    if (high_nibble > 0x90 || GET_CC_C())
+        temp += 0x60;
+
+    active->cpu.a = temp;
+
+    eval_cc_c(temp);
+    eval_cc_nz(temp);
+    SET_CC_V(CC_FLAG_CLR);
+}
+
+/*------------------------------------------------
+ * dec()
+ *
+ *  Decrement the operand.
+ *
+ *  byte = byte - 1
+ */
+static uint8_t dec(uint8_t byte)
+{
+    uint16_t result;
+
+    result = byte - 1;
+
+    eval_cc_nzv(byte, 0xfe, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * eor()
+ *
+ *  Exclusive OR accumulator with operand.
+ *
+ *  acc ^ byte
+ */
+static uint8_t eor(uint8_t acc, uint8_t byte)
+{
+    uint8_t result;
+
+    result = acc ^ byte;
+
+    eval_cc_nz((uint16_t) result);
+    SET_CC_V(CC_FLAG_CLR);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * exg()
+ *
+ *  Exchange like-sized registers.
+ *
+ *  NOTE: The function relies on the assembler to not mix
+ *  8-bit registers with 16-bit register, otherwise
+ *  results are unexpected.
+ *  Check: if (((regs ^ (regs << 4)) & 0x80) == 0) {...}
+ *
+ */
+static void exg(uint8_t regs)
+{
+    int         src, dst;
+    uint16_t    temp1, temp2;
+
+    src = (int)((regs >> 4) & 0x0f);
+    dst = (int)(regs & 0x0f);
+
+    temp1 = read_register(src);
+    temp2 = read_register(dst);
+
+    write_register(dst, temp1);
+    write_register(src, temp2);
+}
+
+/*------------------------------------------------
+ * inc()
+ *
+ *  Increment the operand.
+ *
+ *  byte = byte + 1
+ */
+static uint8_t inc(uint8_t byte)
+{
+    uint16_t result;
+
+    result = byte + 1;
+
+    eval_cc_nzv(byte, 1, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * lsr()
+ *
+ *  Logic shift right.
+ *
+ *  'byte' shift right, MSB replicated with zero, LSB into carry flag.
+ */
+static uint8_t lsr(uint8_t byte)
+{
+    uint8_t result;
+
+    result = (byte >> 1) & 0x7f;
+
+    SET_CC_C((byte & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR);
+    eval_cc_z((uint16_t) result);
+    SET_CC_N(CC_FLAG_CLR);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * neg()
+ *
+ *  Negate byte.
+ *  Two's complement: ~byte+1
+ *
+ */
+static uint8_t neg(uint8_t byte)
+{
+    uint16_t result;
+
+    result =  0 - byte;
+
+    eval_cc_nzvc(0, ~byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * or()
+ *
+ *  Bit-wise logical OR between 'acc' and 'byte'
+ *
+ */
+static uint8_t or(uint8_t acc, uint8_t byte)
+{
+    uint8_t result;
+
+    result = acc | byte;
+
+    SET_CC_V(CC_FLAG_CLR);
+    eval_cc_nz((uint16_t) result);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * orcc()
+ *
+ *  Logical OR condition-code register with operand.
+ *
+ */
+static void orcc(uint8_t byte)
+{
+    uint8_t temp_cc;
+
+    temp_cc = get_cc();
+    temp_cc |= byte;
+    set_cc(temp_cc);
+}
+
+/*------------------------------------------------
+ * pshs()
+ *
+ *  Push registers onto stack S (systems)
+ *  Modifies 's' stack register.
+ *
+ *  param:  Push-list operand, and command cycles to update if needed.
+ *  return: Nothing
+ */
+static void pshs(uint8_t push_list, int *cycles)
+{
+    (*cycles) += stack_list[push_list].cycles;
+    push_registers(&active->cpu.s, push_list, active->cpu.u, 0);
+}
+
+/*------------------------------------------------
+ * pshu()
+ *
+ *  Push registers onto stack U (user)
+ *  Modifies 'u' stack register.
+ *
+ *  param:  Push-list operand, and command cycles to update if needed.
+ *  return: Nothing
+ */
+static void pshu(uint8_t push_list, int *cycles)
+{
+    (*cycles) += stack_list[push_list].cycles;
+    push_registers(&active->cpu.u, push_list, active->cpu.s, 0);
+}
+
+/*------------------------------------------------
+ * puls()
+ *
+ *  Pull registers from stack S (systems)
+ *  Modifies 's' stack register.
+ *
+ *  param:  Pull-list operand, and command cycles to update if needed.
+ *  return: Nothing
+ */
+static void puls(uint8_t pull_list, int *cycles)
+{
+    (*cycles) += stack_list[pull_list].cycles;
+    pull_registers(&active->cpu.s, pull_list, &active->cpu.u, 0);
+}
+
+/*------------------------------------------------
+ * pulu()
+ *
+ *  Pull registers from stack U (user)
+ *  Modifies 'u' stack register.
+ *
+ *  param:  Pull-list operand, and command cycles to update if needed.
+ *  return: Nothing
+ */
+static void pulu(uint8_t pull_list, int *cycles)
+{
+    (*cycles) += stack_list[pull_list].cycles;
+    pull_registers(&active->cpu.u, pull_list, &active->cpu.s, 0);
+}
+
+/*------------------------------------------------
+ * rol()
+ *
+ *  Rotate left through Carry
+ *
+ */
+static uint8_t rol(uint8_t byte)
+{
+    uint16_t    result;
+
+    result = (byte << 1);
+
+    if ( GET_CC_C() )
+        result |= 0x0001;
+    else
+        result &= 0xfffe;
+
+    eval_cc_nzvc(byte, byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * ror()
+ *
+ *  Rotate right through Carry
+ *
+ */
+static uint8_t ror(uint8_t byte)
+{
+    uint16_t    result;
+
+
+    result = byte;
+
+    if ( GET_CC_C() )
+        result |= 0x0100;
+    else
+        result &= 0xfeff;
+
+    if ( byte & 0x01 )
+        SET_CC_C(CC_FLAG_SET);
+    else
+        SET_CC_C(CC_FLAG_CLR);
+
+    result = (result >> 1);
+
+    eval_cc_nz(result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * rti()
+ *
+ *  Return from interrupt
+ *
+ */
+static void rti(int *cycles)
+{
+    uint8_t byte;
+    int     pull_w = 0;
+
+    /* Restore CCR
+     */
+    byte = MEM_READ(active->cpu.s);
+    active->cpu.s++;
+    set_cc(byte);
+
+    /* Restore registers if this is an extended
+     * interrupt frame (IRQ, NMI, SWIx), and PC
+     */
+    if ( GET_CC_E() )
+    {
+#if (CPU_6309)
+        if ( NATIVE_MODE() )
+        {
+            pull_w = 1;
+            (*cycles) += INT_CYCLES_NATIVE;
+        }
+#endif
+        pull_registers(&active->cpu.s, 0xfe, &active->cpu.u, pull_w);
+
+        (*cycles) += 9;
+    }
+    else
+    {
+        pull_registers(&active->cpu.s, 0x80, 0L, 0);
+    }
+}
+
+/*------------------------------------------------
+ * sbc()
+ *
+ *  Subtract with carry.
+ *
+ *  acc-byte-carry
+ */
+static uint8_t sbc(uint8_t acc, uint8_t byte)
+{
+    uint16_t result;
+
+    result = acc - byte - GET_CC_C();
+
+    eval_cc_nzvc(acc, ~byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * sex()
+ *
+ *  Sign extend Acc-B to Acc-A
+ *
+ */
+static void sex(void)
+{
+    if ( active->cpu.b & 0x80 )
+        active->cpu.a = 0xff;
+    else
+        active->cpu.a = 0;
+
+    SET_CC_V(CC_FLAG_CLR);
+    eval_cc_nz((uint16_t) active->cpu.a);
+}
+
+/*------------------------------------------------
+ * sub()
+ *
+ *  Subtract byte from Acc and set flags
+ *
+ */
+static uint8_t sub(uint8_t acc, uint8_t byte)
+{
+    uint16_t result;
+
+    result = acc - byte;
+
+    eval_cc_nzvc(acc, ~byte, result);
+
+    return (uint8_t) result;
+}
+
+/*------------------------------------------------
+ * subd()
+ *
+ *  Subtract word from D accumulator and set flags
+ *  Using 2's complement addition.
+ *
+ */
+static void subd(uint16_t word)
+{
+    uint16_t acc;
+    uint32_t result;
+
+    acc = active->cpu.d;
+    result = acc - word;
+
+    active->cpu.d = (uint16_t) result;
+
+    eval_cc_nzvc16(acc, ~word, result);
+}
+
+/*------------------------------------------------
+ * swi()
+ *
+ *  Software interrupt.
+ *  SWI type is input to the function:
+ *  SWI=1, SWI2=2, SWI3=3
+ *
+ */
+static void swi(int swi_id)
+{
+    SET_CC_E(CC_FLAG_SET);
+
+    push_entire_state();
+
+    switch ( swi_id )
+    {
+        case 1:
+            SET_CC_I(CC_FLAG_SET);
+            SET_CC_F(CC_FLAG_SET);
+            active->cpu.pc = MEM_READ16(VEC_SWI);
+            break;
+
+        case 2:
+            active->cpu.pc = MEM_READ16(VEC_SWI2);
+            break;
+
+        case 3:
+            active->cpu.pc = MEM_READ16(VEC_SWI3);
+            break;
+
+        default:
+            /* Exception: Illegal SWI type swi()
+             */
+            set_state(CPU_EXCEPTION);
+            active->cpu.exception_line_num = __LINE__;
+    }
+}
+
+/*------------------------------------------------
+ * tfr()
+ *
+ *  Transfer value from source register to destination register
+ *
+ *  NOTE: The function relies on the assembler to not mix
+ *  8-bit registers with 16-bit register, otherwise
+ *  results are unexpected.
+ *  Check: if (((regs ^ (regs << 4)) & 0x80) == 0) {...}
+ *
+ */
+static void tfr(uint8_t regs)
+{
+    int         src, dst;
+    uint16_t    temp1;
+
+    src = (int)((regs >> 4) & 0x0f);
+    dst = (int)(regs & 0x0f);
+
+    temp1 = read_register(src);
+    write_register(dst, temp1);
+}
+
+/*------------------------------------------------
+ * tst()
+ *
+ *  Test 8 bit operand and set V,Z,N flags.
+ *
+ */
+static void tst(uint8_t byte)
+{
+    eval_cc_nz((uint16_t) byte);
+    SET_CC_V(CC_FLAG_CLR);
+}
+
+#if (CPU_6309)
+/*------------------------------------------------
+ * adc16(), add16(), sbc16(), sub16()
+ *
+ *  HD6309 16-bit add and subtract, with and without carry,
+ *  of a word operand to a 16-bit accumulator.
+ *
+ *  acc+word, acc-word
+ */
+static uint16_t adc16(uint16_t acc, uint16_t word)
+{
+    uint32_t result;
+
+    result = acc + word + GET_CC_C();
+
+    eval_cc_nzvc16(acc, word, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t add16(uint16_t acc, uint16_t word)
+{
+    uint32_t result;
+
+    result = acc + word;
+
+    eval_cc_nzvc16(acc, word, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t sbc16(uint16_t acc, uint16_t word)
+{
+    uint32_t result;
+
+    result = acc - word - GET_CC_C();
+
+    eval_cc_nzvc16(acc, ~word, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t sub16(uint16_t acc, uint16_t word)
+{
+    uint32_t result;
+
+    result = acc - word;
+
+    eval_cc_nzvc16(acc, ~word, result);
+
+    return (uint16_t) result;
+}
+
+/*------------------------------------------------
+ * and16(), eor16(), or16()
+ *
+ *  HD6309 16-bit logical operations of a 16-bit
+ *  accumulator with a word operand.
+ *
+ */
+static uint16_t and16(uint16_t acc, uint16_t word)
+{
+    uint16_t result;
+
+    result = acc & word;
+
+    eval_cc_nz16(result);
+    SET_CC_V(CC_FLAG_CLR);
+
+    return result;
+}
+
+static uint16_t eor16(uint16_t acc, uint16_t word)
+{
+    uint16_t result;
+
+    result = acc ^ word;
+
+    eval_cc_nz16(result);
+    SET_CC_V(CC_FLAG_CLR);
+
+    return result;
+}
+
+static uint16_t or16(uint16_t acc, uint16_t word)
+{
+    uint16_t result;
+
+    result = acc | word;
+
+    eval_cc_nz16(result);
+    SET_CC_V(CC_FLAG_CLR);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * asl16(), asr16(), lsr16(), rol16(), ror16()
+ *
+ *  HD6309 16-bit shifts and rotates, flags as
+ *  the 8-bit forms.
+ *
+ */
+static uint16_t asl16(uint16_t word)
+{
+    uint32_t result;
+
+    result = ((uint32_t) word) << 1;
+
+    eval_cc_nzvc16(word, word, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t asr16(uint16_t word)
+{
+    uint16_t result;
+
+    result = (word >> 1) | (word & 0x8000);
+
+    SET_CC_C((word & 0x0001) ? CC_FLAG_SET : CC_FLAG_CLR);
+    eval_cc_nz16(result);
+
+    return result;
+}
+
+static uint16_t lsr16(uint16_t word)
+{
+    uint16_t result;
+
+    result = (word >> 1) & 0x7fff;
+
+    SET_CC_C((word & 0x0001) ? CC_FLAG_SET : CC_FLAG_CLR);
+    eval_cc_z16(result);
+    SET_CC_N(CC_FLAG_CLR);
+
+    return result;
+}
+
+static uint16_t rol16(uint16_t word)
+{
+    uint32_t result;
+
+    result = (((uint32_t) word) << 1) | GET_CC_C();
+
+    eval_cc_nzvc16(word, word, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t ror16(uint16_t word)
+{
+    uint16_t result;
+
+    result = (word >> 1) | (GET_CC_C() << 15);
+
+    SET_CC_C((word & 0x0001) ? CC_FLAG_SET : CC_FLAG_CLR);
+    eval_cc_nz16(result);
+
+    return result;
+}
+
+/*------------------------------------------------
+ * com16(), dec16(), inc16(), neg16(), tst16()
+ *
+ *  HD6309 16-bit complement, decrement, increment,
+ *  negate and test, flags as the 8-bit forms.
+ *
+ */
+static uint16_t com16(uint16_t word)
+{
+    uint16_t result;
+
+    result = ~word;
+
+    SET_CC_C(CC_FLAG_SET);
+    SET_CC_V(CC_FLAG_CLR);
+    eval_cc_nz16(result);
+
+    return result;
+}
+
+static uint16_t dec16(uint16_t word)
+{
+    uint32_t result;
+
+    result = word - 1;
+
+    eval_cc_nzv16(word, 0xfffe, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t inc16(uint16_t word)
+{
+    uint32_t result;
+
+    result = word + 1;
+
+    eval_cc_nzv16(word, 1, result);
+
+    return (uint16_t) result;
+}
+
+static uint16_t neg16(uint16_t word)
+{
+    uint32_t result;
+
+    result = 0 - word;
+
+    eval_cc_nzvc16(0, ~word, result);
+
+    return (uint16_t) result;
+}
+
+static void tst16(uint16_t word)
+{
+    eval_cc_nz16(word);
+    SET_CC_V(CC_FLAG_CLR);
+}
+
+/*------------------------------------------------
+ * divd()
+ *
+ *  HD6309 signed division of D by an 8-bit divisor, quotient in B
+ *  and remainder in A. A quotient outside the 9-bit signed range
+ *  aborts the division with V set and the registers unchanged,
+ *  and a quotient outside the 8-bit range sets V.
+ *  Division by zero traps.
+ *
+ *  param:  Divisor, pointer to command cycles count
+ *  return: Nothing
+ */
+static void divd(int8_t divisor, int *cycles)
+{
+    int     dividend, quotient;
+
+    if ( divisor == 0 )
+    {
+        (*cycles) += trap(MD_DIV0);
+        return;
+    }
+
+    dividend = (int16_t) active->cpu.d;
+    quotient = dividend / divisor;
+
+    if ( quotient < -256 || quotient > 255 )
+    {
+        SET_CC_N(CC_FLAG_CLR);
+        SET_CC_Z(CC_FLAG_CLR);
+        SET_CC_V(CC_FLAG_SET);
+        SET_CC_C(CC_FLAG_CLR);
+        return;
+    }
+
+    active->cpu.a = (uint8_t) (dividend % divisor);
+    active->cpu.b = (uint8_t) quotient;
+
+    eval_cc_nz((uint16_t) active->cpu.b);
+    SET_CC_V((quotient < -128 || quotient > 127) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_C((quotient & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR);
+}
+
+/*------------------------------------------------
+ * divq()
+ *
+ *  HD6309 signed division of Q by a 16-bit divisor, quotient in W
+ *  and remainder in D. A quotient outside the 17-bit signed range
+ *  aborts the division with V set and the registers unchanged,
+ *  and a quotient outside the 16-bit range sets V.
+ *  Division by zero traps.
+ *
+ *  param:  Divisor, pointer to command cycles count
+ *  return: Nothing
+ */
+static void divq(int16_t divisor, int *cycles)
+{
+    int64_t     dividend, quotient;
+    uint16_t    remainder;
+
+    if ( divisor == 0 )
+    {
+        (*cycles) += trap(MD_DIV0);
+        return;
+    }
+
+    dividend = (int32_t) (((uint32_t) active->cpu.d << 16) | active->cpu.w);
+    quotient = dividend / divisor;
+
+    if ( quotient < -65536 || quotient > 65535 )
+    {
+        SET_CC_N(CC_FLAG_CLR);
+        SET_CC_Z(CC_FLAG_CLR);
+        SET_CC_V(CC_FLAG_SET);
+        SET_CC_C(CC_FLAG_CLR);
+        return;
+    }
+
+    remainder = (uint16_t) (dividend % divisor);
+    active->cpu.d = remainder;
+    active->cpu.w = (uint16_t) quotient;
+
+    eval_cc_nz16(active->cpu.w);
+    SET_CC_V((quotient < -32768 || quotient > 32767) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_C((quotient & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR);
+}
+
+/*------------------------------------------------
+ * reg_alu()
+ *
+ *  HD6309 register to register operations ADDR, ADCR, SUBR, SBCR,
+ *  ANDR, ORR, EORR and CMPR. Post-byte register numbers are as
+ *  defined for EXG and TFR, and the destination register selects an
+ *  8-bit or a 16-bit operation.
+ *
+ *  param:  Post-byte, 8-bit and 16-bit operations,
+ *          '1' to store the result in the destination register
+ *  return: Nothing
+ */
+static void reg_alu(uint8_t regs, uint8_t (*op8)(uint8_t, uint8_t), uint16_t (*op16)(uint16_t, uint16_t), int store)
+{
+    int         src, dst;
+    uint16_t    result;
+
+    src = (int)((regs >> 4) & 0x0f);
+    dst = (int)(regs & 0x0f);
+
+    if ( dst < 8 )
+        result = op16(read_register(dst), read_register(src));
+    else
+        result = op8((uint8_t) read_register(dst), (uint8_t) read_register(src));
+
+    if ( store )
+        write_register(dst, result);
+}
+
+/*------------------------------------------------
+ * bit_transfer()
+ *
+ *  HD6309 bit transfers between a direct page memory bit and
+ *  a CC, A or B register bit. The post-byte holds the register in
+ *  bits 7-6, the source bit in bits 5-3 and the destination bit in
+ *  bits 2-0, where STBT stores a register bit and the other
+ *  operations change a register bit.
+ *
+ *  param:  Effective address, BIT_* operation, pointer to command cycles count
+ *  return: Nothing
+ */
+static void bit_transfer(int eff_addr, int operation, int *cycles)
+{
+    uint8_t     value, byte, bit;
+    int         reg, src_bit, dst_bit;
+
+    reg = active->immediate >> 6;
+    src_bit = (active->immediate >> 3) & 0x07;
+    dst_bit = active->immediate & 0x07;
+
+    switch ( reg )
+    {
+        case 0:
+            value = get_cc();
+            break;
+
+        case 1:
+            value = active->cpu.a;
+            break;
+
+        case 2:
+            value = active->cpu.b;
+            break;
+
+        default:
+            (*cycles) += trap(MD_ILLEGAL);
+            return;
+    }
+
+    byte = (uint8_t) MEM_READ(eff_addr);
+
+    if ( operation == BIT_STBT )
+    {
+        bit = (value >> src_bit) & 0x01;
+        MEM_WRITE(eff_addr, (byte & ~(1 << dst_bit)) | (bit << dst_bit));
+        return;
+    }
+
+    bit = (byte >> src_bit) & 0x01;
+
+    switch ( operation )
+    {
+        case BIT_AND:
+            bit = bit & (value >> dst_bit);
+            break;
+
+        case BIT_IAND:
+            bit = (bit ^ 0x01) & (value >> dst_bit);
+            break;
+
+        case BIT_OR:
+            bit = bit | (value >> dst_bit);
+            break;
+
+        case BIT_IOR:
+            bit = (bit ^ 0x01) | (value >> dst_bit);
+            break;
+
+        case BIT_EOR:
+            bit = bit ^ (value >> dst_bit);
+            break;
+
+        case BIT_IEOR:
+            bit = (bit ^ 0x01) ^ (value >> dst_bit);
+            break;
+    }
+
+    value = (value & ~(1 << dst_bit)) | ((bit & 0x01) << dst_bit);
+
+    switch ( reg )
+    {
+        case 0:
+            set_cc(value);
+            break;
+
+        case 1:
+            active->cpu.a = value;
+            break;
+
+        default:
+            active->cpu.b = value;
+    }
+}
+
+/*------------------------------------------------
+ * tfm()
+ *
+ *  HD6309 block transfer of W bytes between the addresses in two
+ *  of the D, X, Y, U and S registers, that are incremented,
+ *  decremented or left unchanged after each byte.
+ *  The whole block is moved by one call, so interrupts are
+ *  serviced after the transfer instead of between bytes.
+ *
+ *  param:  Post-byte, source and destination address steps,
+ *          pointer to command cycles count
+ *  return: Nothing
+ */
+static void tfm(uint8_t regs, int src_step, int dst_step, int *cycles)
+{
+    int         src, dst;
+    uint16_t    src_addr, dst_addr;
+
+    src = (int)((regs >> 4) & 0x0f);
+    dst = (int)(regs & 0x0f);
+
+    if ( src > 4 || dst > 4 )
+    {
+        (*cycles) += trap(MD_ILLEGAL);
+        return;
+    }
+
+    src_addr = read_register(src);
+    dst_addr = read_register(dst);
+
+    while ( active->cpu.w )
+    {
+        MEM_WRITE(dst_addr, MEM_READ(src_addr));
+        src_addr += src_step;
+        dst_addr += dst_step;
+        active->cpu.w--;
+        (*cycles) += 3;
+    }
+
+    write_register(src, src_addr);
+    write_register(dst, dst_addr);
+}
+
+/*------------------------------------------------
+ * trap()
+ *
+ *  HD6309 illegal op-code and division by zero trap.
+ *  Set the MD error bit, stack the entire machine state
+ *  and continue at the trap vector.
+ *
+ *  param:  MD error bit
+ *  return: Trap cycles
+ */
+static int trap(uint8_t md_flag)
+{
+    active->cpu.md |= md_flag;
+
+    SET_CC_E(CC_FLAG_SET);
+    push_entire_state();
+
+    SET_CC_I(CC_FLAG_SET);
+    SET_CC_F(CC_FLAG_SET);
+
+    active->cpu.pc = MEM_READ16(VEC_RESERVED);
+
+    return NATIVE_MODE() ? (INT_CYCLES_TRAP + INT_CYCLES_NATIVE) : INT_CYCLES_TRAP;
+}
+#endif  /* CPU_6309 */
+
+#if (CPU_DISPATCH == CPU_DISPATCH_SWITCH)
+/*------------------------------------------------
+ * branch()
+ *
+ *  Implement conditional short branch and long branch.
+ *  The branch opcodes for both short and long variants are
+ *  identical except for the 0x10 byte prefix for long branches.
+ *  Calling code resolves long from short and then calls this function
+ *  to look up the branch condition and apply the offset.
+ *  To use this function with short branches (8-bit signed offset),
+ *  the branch offset must be sign-extended to 16-bit.
+ *
+ *  param:  Branch opcode, long ('1') or short ('0') branch, 16-bit sign-extended offset, 
+ *          pointer to opcode cycles.
+ *  return: Nothing
+ */
+static void branch(int instruction, int long_short, uint16_t effective_address, int *cycles)
+{
+    /* Look up the branch condition and apply
+       offset if branch is taken.
+     */
+    if ( BRANCH_TAKEN(instruction) )
+        do_branch(long_short, effective_address, cycles);
+}
+
+/*------------------------------------------------
+ * do_branch()
+ *
+ *  Helper function to do the actual branch
+ *  by stacking the PC and changing to the target address.
+ *
+ *  param:  Long ('1') or short ('0') branch, 16-bit sign-extended offset,
+ *          pointer to opcode cycles.
+ *  return: Nothing
+ */
+static void do_branch(int long_short, uint16_t effective_address, int *cycles)
+{
+    active->cpu.pc = effective_address;
+    (*cycles) += long_short;
+}
+#endif
+
+/*------------------------------------------------
+ * get_eff_addr()
+ *
+ *  Calculate and return effective address.
+ *  Resolve addressing mode, calculate effective address.
+ *  Modifies 'pc' and appropriate index register.
+ *
+ *  param:  Command addressing mode and command cycles and bytes count to update if needed.
+ *  return: Effective Address, '0' if error
+ */
+static int get_eff_addr(int mode, int *cycles, int *bytes)
+{
+    uint16_t                operand;
+    uint16_t               *index_reg;
+    const index_decode_t   *index;
+    uint16_t                effective_addr = 0;
+
+    switch ( mode )
+    {
+        case ADDR_DIRECT:
+            effective_addr = (active->cpu.dp << 8) + MEM_READ(active->cpu.pc);
+            active->cpu.pc++;
+            break;
+
+        case ADDR_RELATIVE:
+            operand = MEM_READ(active->cpu.pc);
+            active->cpu.pc++;
+            effective_addr = active->cpu.pc + SIG_EXTEND(operand);
+            break;
+
+        case ADDR_LRELATIVE:
+            operand = MEM_READ16(active->cpu.pc);
+            active->cpu.pc += 2;
+            effective_addr = active->cpu.pc + operand;
+            break;
+
+        case ADDR_INDEXED:
+            index = &index_decode[MEM_READ(active->cpu.pc)];
+            active->cpu.pc++;
+
+            index_reg = (uint16_t *)((uint8_t *) &active->cpu + index->reg);
+            (*cycles) += index->cycles;
+            (*bytes) += index->bytes;
+
+            switch ( index->offset )
+            {
+                case INDX_OFFSET_NONE:
+                    effective_addr = *index_reg;
+                    break;
+
+                case INDX_OFFSET_POST_INC:
+                    effective_addr = *index_reg;
+                    (*index_reg) += index->inc_dec;
+                    break;
+
+                case INDX_OFFSET_PRE_DEC:
+                    (*index_reg) += index->inc_dec;
+                    effective_addr = *index_reg;
+                    break;
+
+                case INDX_OFFSET_5BIT:
+                    effective_addr = *index_reg + index->offset5;
+                    break;
+
+                case INDX_OFFSET_ACCB:
+                    effective_addr = *index_reg + SIG_EXTEND(active->cpu.b);
+                    break;
+
+                case INDX_OFFSET_ACCA:
+                    effective_addr = *index_reg + SIG_EXTEND(active->cpu.a);
+                    break;
+
+                case INDX_OFFSET_ACCD:
+                    effective_addr = *index_reg + active->cpu.d;
+                    break;
+
+#if (CPU_6309)
+                case INDX_OFFSET_ACCE:
+                    effective_addr = *index_reg + SIG_EXTEND(active->cpu.e);
+                    break;
+
+                case INDX_OFFSET_ACCF:
+                    effective_addr = *index_reg + SIG_EXTEND(active->cpu.f);
+                    break;
+
+                case INDX_OFFSET_ACCW:
+                    effective_addr = *index_reg + active->cpu.w;
+                    break;
+#endif
+
+                case INDX_OFFSET_8BIT:
+                    effective_addr = *index_reg + SIG_EXTEND(MEM_READ(active->cpu.pc));
+                    active->cpu.pc++;
+                    break;
+
+                case INDX_OFFSET_16BIT:
+                    effective_addr = *index_reg + MEM_READ16(active->cpu.pc);
+                    active->cpu.pc += 2;
+                    break;
+
+                case INDX_OFFSET_PC8:
+                    effective_addr = SIG_EXTEND(MEM_READ(active->cpu.pc));
+                    active->cpu.pc++;
+                    effective_addr += active->cpu.pc;
+                    break;
+
+                case INDX_OFFSET_PC16:
+                    effective_addr = MEM_READ16(active->cpu.pc);
+                    active->cpu.pc += 2;
+                    effective_addr += active->cpu.pc;
+                    break;
+
+                case INDX_OFFSET_EXTENDED:
+                    effective_addr = MEM_READ16(active->cpu.pc);
+                    active->cpu.pc += 2;
+                    break;
+
+                default:
+                    /* Exception: Illegal indexing mode get_eff_addr()
+                     */
+                    set_state(CPU_EXCEPTION);
+                    active->cpu.exception_line_num = __LINE__;
+            }
+
+            /* Resolve indirect addresses
+             * Rely on assembler-generated code to reliably include the indirect bit
+             * i.e. not for auto inc/dec by one.
+             */
+            if ( index->indirect )
+            {
+                effective_addr = MEM_READ16(effective_addr);
+            }
+            break;
+
+        case ADDR_EXTENDED:
+            effective_addr = MEM_READ16(active->cpu.pc);
+            active->cpu.pc += 2;
+            break;
+
+        case ADDR_IMMEDIATE:
+            effective_addr = active->cpu.pc;
+            active->cpu.pc += 1;
+            break;
+
+        case ADDR_LIMMEDIATE:
+            effective_addr = active->cpu.pc;
+            active->cpu.pc += 2;
+            break;
+
+        case ADDR_INHERENT:
+            break;
+
+        default:
+            /* Exception: Illegal address mode get_eff_addr()
+             */
+            set_state(CPU_EXCEPTION);
+            active->cpu.exception_line_num = __LINE__;
+    }
+
+    return effective_addr;
+}
+
+/*------------------------------------------------
+ * push_registers()
+ *
+ *  Push a register list onto a stack.
+ *  The registers are copied to a stack frame in memory order, CC at the
+ *  lowest address. A frame that is all in RAM is written with one memory
+ *  block write, otherwise it is written byte by byte from the highest
+ *  address down, in the push order of the MC6809E.
+ *
+ *  param:  Pointer to stack register, push-list post-byte,
+ *          value of the other stack register for post-byte bit 6,
+ *          '1' to stack W after DP in an HD6309 native mode entire state
+ *  return: Nothing
+ */
+static void push_registers(uint16_t *stack, uint8_t push_list, uint16_t other_stack, int push_w)
+{
+    uint8_t     frame[STACK_FRAME_MAX];
+    uint16_t    address;
+    int         length = 0, i;
+
+    if ( push_list & 0x01 )
+        frame[length++] = get_cc();
+
+    if ( push_list & 0x02 )
+        frame[length++] = active->cpu.a;
+
+    if ( push_list & 0x04 )
+        frame[length++] = active->cpu.b;
+
+    if ( push_w )
+    {
+        frame[length++] = active->cpu.e;
+        frame[length++] = active->cpu.f;
+    }
+
+    if ( push_list & 0x08 )
+        frame[length++] = active->cpu.dp;
+
+    if ( push_list & 0x10 )
+    {
+        frame[length++] = GET_REG_HIGH(active->cpu.x);
+        frame[length++] = GET_REG_LOW(active->cpu.x);
+    }
+
+    if ( push_list & 0x20 )
+    {
+        frame[length++] = GET_REG_HIGH(active->cpu.y);
+        frame[length++] = GET_REG_LOW(active->cpu.y);
+    }
+
+    if ( push_list & 0x40 )
+    {
+        frame[length++] = GET_REG_HIGH(other_stack);
+        frame[length++] = GET_REG_LOW(other_stack);
+    }
+
+    if ( push_list & 0x80 )
+    {
+        frame[length++] = GET_REG_HIGH(active->cpu.pc);
+        frame[length++] = GET_REG_LOW(active->cpu.pc);
+    }
+
+    address = *stack - length;
+    *stack = address;
+
+    if ( mem_ctx_write_block(active->mem, address, frame, length) == MEM_OK )
+        return;
+
+    for ( i = length - 1; i >= 0; i-- )
+    {
+        MEM_WRITE((uint16_t) (address + i), frame[i]);
+    }
+}
+
+/*------------------------------------------------
+ * pull_registers()
+ *
+ *  Pull a register list from a stack.
+ *  A frame that is all in RAM or ROM is read with one memory block read,
+ *  otherwise it is read byte by byte from the lowest address up, in the
+ *  pull order of the MC6809E.
+ *
+ *  param:  Pointer to stack register, pull-list post-byte,
+ *          pointer to the other stack register for post-byte bit 6,
+ *          '1' to pull W after B from an HD6309 native mode entire state
+ *  return: Nothing
+ */
+static void pull_registers(uint16_t *stack, uint8_t pull_list, uint16_t *other_stack, int pull_w)
+{
+    uint8_t     frame[STACK_FRAME_MAX];
+    uint16_t    address;
+    int         length, i;
+
+    address = *stack;
+    length = stack_list[pull_list].bytes + (pull_w ? 2 : 0);
+    *stack = address + length;
+
+    if ( mem_ctx_read_block(active->mem, address, frame, length) != MEM_OK )
+    {
+        for ( i = 0; i < length; i++ )
+        {
+            frame[i] = (uint8_t) MEM_READ((uint16_t) (address + i));
+        }
+    }
+
+    i = 0;
+
+    if ( pull_list & 0x01 )
+        set_cc(frame[i++]);
+
+    if ( pull_list & 0x02 )
+        active->cpu.a = frame[i++];
+
+    if ( pull_list & 0x04 )
+        active->cpu.b = frame[i++];
+
+    if ( pull_w )
+    {
+        active->cpu.e = frame[i++];
+        active->cpu.f = frame[i++];
+    }
+
+    if ( pull_list & 0x08 )
+        active->cpu.dp = frame[i++];
+
+    if ( pull_list & 0x10 )
+    {
+        active->cpu.x = (frame[i] << 8) + frame[i + 1];
+        i += 2;
+    }
+
+    if ( pull_list & 0x20 )
+    {
+        active->cpu.y = (frame[i] << 8) + frame[i + 1];
+        i += 2;
+    }
+
+    if ( pull_list & 0x40 )
+    {
+        *other_stack = (frame[i] << 8) + frame[i + 1];
+        i += 2;
+    }
+
+    if ( pull_list & 0x80 )
+        active->cpu.pc = (frame[i] << 8) + frame[i + 1];
+}
+
+/*------------------------------------------------
+ * push_entire_state()
+ *
+ *  Stack the entire machine state for NMI, IRQ, SWI, CWAI, and
+ *  HD6309 traps and FIRQ with the MD FIRQ mode bit set.
+ *  The caller sets the CC.E flag.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+static void push_entire_state(void)
+{
+#if (CPU_6309)
+    push_registers(&active->cpu.s, 0xff, active->cpu.u, NATIVE_MODE() != 0);
+#else
+    push_registers(&active->cpu.s, 0xff, active->cpu.u, 0);
+#endif
+}
+
+/*------------------------------------------------
+ * decode_tables_init()
+ *
+ *  Build the decode tables once, on the first call.
+ *  With CPU contexts the first call can come from several threads
+ *  creating contexts at the same time, and pthread_once() builds
+ *  the tables in one of them while the others wait.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+static void decode_tables_init(void)
+{
+#if (CPU_CONTEXTS)
+    static pthread_once_t   tables_once = PTHREAD_ONCE_INIT;
+
+    pthread_once(&tables_once, decode_tables_build);
+#else
+    static int  tables_ready = 0;
+
+    if ( tables_ready )
+        return;
+
+    decode_tables_build();
+    tables_ready = 1;
+#endif
+}
+
+/*------------------------------------------------
+ * decode_tables_build()
+ *
+ *  Build the direct-indexed decode tables of the 0x10 and 0x11
+ *  double-byte op-code pages from the machine_code[] list.
+ *  Op-codes that are not listed are marked as illegal.
+ *  Build the indexed addressing post-byte decode table, the
+ *  conditional branch table, and the stack register list table
+ *  of PSHS/PULS/PSHU/PULU.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+static void decode_tables_build(void)
+{
+    /* Index modes of post-bytes with bit 7 set, by post-byte mode field:
+     * offset kind, auto increment/decrement, cycles, indirect cycles, offset bytes
+     */
+    static const int8_t index_modes[16][5] =
+    {
+        { INDX_OFFSET_POST_INC,  1, 2, 2, 0 },  // ,R+
+        { INDX_OFFSET_POST_INC,  2, 3, 6, 0 },  // ,R++
+        { INDX_OFFSET_PRE_DEC,  -1, 2, 2, 0 },  // ,-R
+        { INDX_OFFSET_PRE_DEC,  -2, 3, 6, 0 },  // ,--R
+        { INDX_OFFSET_NONE,      0, 0, 3, 0 },  // ,R
+        { INDX_OFFSET_ACCB,      0, 1, 4, 0 },  // B,R
+        { INDX_OFFSET_ACCA,      0, 1, 4, 0 },  // A,R
+#if (CPU_6309)
+        { INDX_OFFSET_ACCE,      0, 1, 4, 0 },  // E,R
+#else
+        { INDX_OFFSET_ILLEGAL,   0, 0, 0, 0 },
+#endif
+        { INDX_OFFSET_8BIT,      0, 1, 4, 1 },  // n,R 8-bit offset
+        { INDX_OFFSET_16BIT,     0, 4, 7, 2 },  // n,R 16-bit offset
+#if (CPU_6309)
+        { INDX_OFFSET_ACCF,      0, 1, 4, 0 },  // F,R
+#else
+        { INDX_OFFSET_ILLEGAL,   0, 0, 0, 0 },
+#endif
+        { INDX_OFFSET_ACCD,      0, 4, 7, 0 },  // D,R
+        { INDX_OFFSET_PC8,       0, 1, 4, 1 },  // n,PCR 8-bit offset
+        { INDX_OFFSET_PC16,      0, 5, 8, 2 },  // n,PCR 16-bit offset
+#if (CPU_6309)
+        { INDX_OFFSET_ACCW,      0, 4, 7, 0 },  // W,R
+#else
+        { INDX_OFFSET_ILLEGAL,   0, 0, 0, 0 },
+#endif
+        { INDX_OFFSET_EXTENDED,  0, 5, 5, 2 },  // [n]
+    };
+
+#if (CPU_6309)
+    /* HD6309 W register index modes, that take the post-bytes of
+     * the MC6809E mode 0xf and indirect mode 0x0 with any register field:
+     * post-byte, offset kind, auto increment/decrement, indirect, cycles, offset bytes
+     */
+    static const int index_modes_w[8][6] =
+    {
+        { 0x8f, INDX_OFFSET_NONE,      0, 0, 0, 0 },    // ,W
+        { 0x90, INDX_OFFSET_NONE,      0, 1, 3, 0 },    // [,W]
+        { 0xaf, INDX_OFFSET_16BIT,     0, 0, 4, 2 },    // n,W 16-bit offset
+        { 0xb0, INDX_OFFSET_16BIT,     0, 1, 7, 2 },    // [n,W]
+        { 0xcf, INDX_OFFSET_POST_INC,  2, 0, 3, 0 },    // ,W++
+        { 0xd0, INDX_OFFSET_POST_INC,  2, 1, 6, 0 },    // [,W++]
+        { 0xef, INDX_OFFSET_PRE_DEC,  -2, 0, 3, 0 },    // ,--W
+        { 0xf0, INDX_OFFSET_PRE_DEC,  -2, 1, 6, 0 },    // [,--W]
+    };
+#endif
+
+    /* Index registers in post-byte register field order
+     */
+    static const uint8_t index_regs[4] =
+    {
+        offsetof(cpu_state_t, x),
+        offsetof(cpu_state_t, y),
+        offsetof(cpu_state_t, u),
+        offsetof(cpu_state_t, s),
+    };
+
+    int         i, mode, indirect, bit;
+    int         c, v, z, n;
+
+    /* Conditional branches by the low nibble of
+     * the branch op-code 0x20 to 0x2f and the CC register
+     */
+    for ( i = 0; i < 256; i++ )
+    {
+        c = (i & CC_C) != 0;
+        v = (i & CC_V) != 0;
+        z = (i & CC_Z) != 0;
+        n = (i & CC_N) != 0;
+
+        branch_taken[0x0][i] = 1;                   // BRA
+        branch_taken[0x1][i] = 0;                   // BRN
+        branch_taken[0x2][i] = !c && !z;            // BHI
+        branch_taken[0x3][i] = c || z;              // BLS
+        branch_taken[0x4][i] = !c;                  // BHS, BCC
+        branch_taken[0x5][i] = c;                   // BLO, BCS
+        branch_taken[0x6][i] = !z;                  // BNE
+        branch_taken[0x7][i] = z;                   // BEQ
+        branch_taken[0x8][i] = !v;                  // BVC
+        branch_taken[0x9][i] = v;                   // BVS
+        branch_taken[0xa][i] = !n;                  // BPL
+        branch_taken[0xb][i] = n;                   // BMI
+        branch_taken[0xc][i] = (n == v);            // BGE
+        branch_taken[0xd][i] = (n != v);            // BLT
+        branch_taken[0xe][i] = (n == v) && !z;      // BGT
+        branch_taken[0xf][i] = (n != v) || z;       // BLE
+    }
+
+    /* Stack register lists: one byte for CC, A, B and DP,
+     * two bytes for X, Y, U or S, and PC, and one cycle per byte
+     */
+    for ( i = 0; i < 256; i++ )
+    {
+        stack_list[i].bytes = 0;
+
+        for ( bit = 0; bit < 8; bit++ )
         {
-            cpu.cpu_state = CPU_EXEC;
-            cc.e = CC_FLAG_SET;
-
-            cpu.s--;
-            mem_write(cpu.s, cpu.pc & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.u & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.u >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.y & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.y >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.x & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.x >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.dp);
-            cpu.s--;
-            mem_write(cpu.s, cpu.b);
-            cpu.s--;
-            mem_write(cpu.s, cpu.a);
-            cpu.s--;
-            mem_write(cpu.s, get_cc());
-
-            cpu.nmi_latched = 0;
-
-            cc.f = CC_FLAG_SET;
-            cc.i = CC_FLAG_SET;
-
-            cpu.pc = (mem_read(VEC_NMI) << 8) + mem_read(VEC_NMI+1);
+            if ( !(i & (1 << bit)) )
+                continue;
+
+            stack_list[i].bytes += (bit < 4) ? 1 : 2;
         }
-        else if ( !(cc.f) && (intr_latch & INT_FIRQ) )
-        {
-            cpu.cpu_state = CPU_EXEC;
-            cc.e = CC_FLAG_CLR;
 
-            cpu.s--;
-            mem_write(cpu.s, cpu.pc & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, get_cc());
+        stack_list[i].cycles = stack_list[i].bytes;
+    }
+
+    for ( i = 0; i < 256; i++ )
+    {
+        op_code_page2[i].mode = ILLEGAL_OP;
+        op_code_page2[i].cycles = 0;
+        op_code_page2[i].cycles_native = 0;
+        op_code_page2[i].bytes = 2;
+        op_code_page2[i].index = -1;
 
-            cc.f = CC_FLAG_SET;
-            cc.i = CC_FLAG_SET;
+        op_code_page3[i] = op_code_page2[i];
+    }
 
-            cpu.pc = (mem_read(VEC_FIRQ) << 8) + mem_read(VEC_FIRQ+1);
-        }
-        else if ( !(cc.i) && (intr_latch & INT_IRQ) )
+    for ( i = OP_CODE10; i < OP_CODE11; i++ )
+    {
+        op_code_page2[machine_code[i].op].mode = machine_code[i].mode;
+        op_code_page2[machine_code[i].op].cycles = machine_code[i].cycles;
+        op_code_page2[machine_code[i].op].cycles_native = machine_code[i].cycles_native;
+        op_code_page2[machine_code[i].op].bytes = machine_code[i].bytes;
+        op_code_page2[machine_code[i].op].index = i;
+    }
+
+    for ( i = OP_CODE11; i < (int)(sizeof(machine_code)/sizeof(machine_code_t)); i++ )
+    {
+        op_code_page3[machine_code[i].op].mode = machine_code[i].mode;
+        op_code_page3[machine_code[i].op].cycles = machine_code[i].cycles;
+        op_code_page3[machine_code[i].op].cycles_native = machine_code[i].cycles_native;
+        op_code_page3[machine_code[i].op].bytes = machine_code[i].bytes;
+        op_code_page3[machine_code[i].op].index = i;
+    }
+
+    for ( i = 0; i < 256; i++ )
+    {
+        index_decode[i].reg = index_regs[(i & INDX_POST_REG) >> 5];
+
+        if ( !(i & INDX_POST_5BIT_OFF) )
         {
-            cpu.cpu_state = CPU_EXEC;
-            cc.e = CC_FLAG_SET;
-
-            cpu.s--;
-            mem_write(cpu.s, cpu.pc & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.u & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.u >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.y & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.y >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.x & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, (cpu.x >> 8) & 0xff);
-            cpu.s--;
-            mem_write(cpu.s, cpu.dp);
-            cpu.s--;
-            mem_write(cpu.s, cpu.b);
-            cpu.s--;
-            mem_write(cpu.s, cpu.a);
-            cpu.s--;
-            mem_write(cpu.s, get_cc());
-
-            cc.i = CC_FLAG_SET;
-
-            cpu.pc = (mem_read(VEC_IRQ) << 8) + mem_read(VEC_IRQ+1);
+            index_decode[i].offset = INDX_OFFSET_5BIT;
+            index_decode[i].inc_dec = 0;
+            index_decode[i].indirect = 0;
+            index_decode[i].cycles = 1;
+            index_decode[i].bytes = 0;
+            index_decode[i].offset5 = (i & 0x0010) ? ((i & 0x001f) | 0xfff0) : (i & 0x001f);
+            continue;
         }
 
-        /* CPU now running so fetch instruction.
-         * First we force state to CPU_EXEC so that the
-         * state is defined if we just came out of reset.
-         */
-        cpu.cpu_state = CPU_EXEC;
+        mode = i & INDX_POST_MODE;
+        indirect = (i & INDX_POST_INDIRECT) ? 1 : 0;
 
-        op_code = mem_read(cpu.pc);
-        cpu.pc++;
+        index_decode[i].offset = index_modes[mode][0];
+        index_decode[i].inc_dec = index_modes[mode][1];
+        index_decode[i].indirect = indirect;
+        index_decode[i].cycles = indirect ? index_modes[mode][3] : index_modes[mode][2];
+        index_decode[i].bytes = index_modes[mode][4];
+        index_decode[i].offset5 = 0;
+    }
 
-        /* Double-byte 0x10 prefix
-         */
-        if ( op_code == 0x10 )
-        {
-            op_code = mem_read(cpu.pc);
-            cpu.pc++;
+#if (CPU_6309)
+    for ( i = 0; i < 8; i++ )
+    {
+        mode = index_modes_w[i][0];
+
+        index_decode[mode].reg = offsetof(cpu_state_t, w);
+        index_decode[mode].offset = index_modes_w[i][1];
+        index_decode[mode].inc_dec = index_modes_w[i][2];
+        index_decode[mode].indirect = index_modes_w[i][3];
+        index_decode[mode].cycles = index_modes_w[i][4];
+        index_decode[mode].bytes = index_modes_w[i][5];
+    }
+#endif
+}
 
-            /* Search for 0x10 double byte op-code. If not found
-             * then fall through the loop and catch the issue in the
-             * switch-case below.
-             * TODO change to binary search?
-             */
-            for ( op_code_index = OP_CODE10; op_code_index < OP_CODE11; op_code_index++ )
-            {
-                if ( machine_code[op_code_index].op == op_code )
-                    {
-                        cycles = machine_code[op_code_index].cycles;
-                        bytes = machine_code[op_code_index].bytes;
-                        break;
-                    }
-            }
+/*------------------------------------------------
+ * context_init()
+ *
+ *  Attach a CPU context to a memory context, clear the
+ *  break point, and mark all predecode cache and
+ *  translated block entries empty.
+ *
+ *  param:  Pointer to CPU context, pointer to memory context
+ *  return: Nothing
+ */
+static void context_init(cpu_context_t *ctx, mem_context_t *mem)
+{
+    ctx->mem = mem;
+    ctx->break_point = -1;
+    ctx->event_deadline = CPU_NO_EVENT;
+#if (IDLE_SKIP)
+    ctx->spin_pc = -1;
+#endif
+
+#if (PREDECODE)
+    ctx->page_versions = mem_ctx_page_versions(mem);
+#endif
+
+#if (TRANSLATE)
+    ctx->io_accesses = mem_ctx_io_access_counter(mem);
+#endif
+
+    cache_invalidate(ctx);
+}
 
-            eff_addr = get_eff_addr(op_code_index, &cycles, &bytes);
+/*------------------------------------------------
+ * cache_invalidate()
+ *
+ *  Mark all predecode cache and translated block entries empty.
+ *  Used at context initialization, and by the HD6309 when
+ *  the MD register changes the cycle counts of cached instructions.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+static void cache_invalidate(cpu_context_t *ctx)
+{
+#if (PREDECODE)
+    int     i;
 
-            switch ( op_code )
-            {
-                /* CMPD
-                 */
-                case 0x83:
-                case 0x93:
-                case 0xa3:
-                case 0xb3:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    cmp16(d, operand16);
-                    break;
+    for ( i = 0; i < PREDECODE_ENTRIES; i++ )
+    {
+        ctx->predecode_cache[i].pc = -1;
+    }
+#endif
 
-                /* CMPY
-                 */
-                case 0x8c:
-                case 0x9c:
-                case 0xac:
-                case 0xbc:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    cmp16(cpu.y, operand16);
-                    break;
+#if (TRANSLATE)
+    for ( i = 0; i < BLOCK_ENTRIES; i++ )
+    {
+        ctx->block_cache[i].pc = -1;
+    }
+#endif
+}
 
-                /* LDS
-                 */
-                case 0xce:
-                case 0xde:
-                case 0xee:
-                case 0xfe:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    cpu.s = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    eval_cc_z16(cpu.s);
-                    eval_cc_n16(cpu.s);
-                    cc.v = CC_FLAG_CLR;
-                    cpu.nmi_armed = 1;
-                    break;
+#if (CPU_DISPATCH != CPU_DISPATCH_SWITCH)
+/*------------------------------------------------
+ * ea_inh(), ea_dir(), ea_ext(), ea_imm(), ea_limm(),
+ * ea_idx(), ea_rel(), ea_lrel()
+ * ea_imdir(), ea_imidx(), ea_imext(), ea_qimm() HD6309
+ *
+ *  Effective address of each addressing mode.
+ *  These are the addressing mode specialized forms of
+ *  get_eff_addr() used by the op-code handlers.
+ *  Modifies 'pc' and appropriate index register.
+ *  The HD6309 immediate and memory operand modes save
+ *  the immediate byte for the operation.
+ *
+ *  param:  Command cycles and bytes count to update if needed.
+ *  return: Effective Address, '0' if error
+ */
+static inline int ea_inh(int *cycles, int *bytes)
+{
+    return 0;
+}
 
-                /* LDY
-                 */
-                case 0x8e:
-                case 0x9e:
-                case 0xae:
-                case 0xbe:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    cpu.y = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    eval_cc_z16(cpu.y);
-                    eval_cc_n16(cpu.y);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline int ea_dir(int *cycles, int *bytes)
+{
+    uint16_t    effective_addr;
 
-                /* STS
-                 */
-                case 0xdf:
-                case 0xef:
-                case 0xff:
-                    mem_write(eff_addr, (uint8_t) (cpu.s >> 8));
-                    mem_write(eff_addr + 1, (uint8_t) (cpu.s));
-                    eval_cc_z16(cpu.s);
-                    eval_cc_n16(cpu.s);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+    effective_addr = (active->cpu.dp << 8) + MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
 
-                /* STY
-                 */
-                case 0x9f:
-                case 0xaf:
-                case 0xbf:
-                    mem_write(eff_addr, (uint8_t) (cpu.y >> 8));
-                    mem_write(eff_addr + 1, (uint8_t) (cpu.y));
-                    eval_cc_z16(cpu.y);
-                    eval_cc_n16(cpu.y);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+    return effective_addr;
+}
 
-                /* LBRN
-                 */
-                case 0x21:
-                    // Long branch never
-                    break;
+static inline int ea_ext(int *cycles, int *bytes)
+{
+    uint16_t    effective_addr;
 
-                /* Long conditional branches
-                 */
-                case 0x22 ... 0x2f:
-                    branch(op_code, 1, eff_addr, &cycles);
-                    break;
+    effective_addr = MEM_READ16(active->cpu.pc);
+    active->cpu.pc += 2;
 
-                /* SWI2
-                 */
-                case 0x3f:
-                    swi(2);
-                    break;
+    return effective_addr;
+}
 
-                default:
-                    /* Exception: Illegal 0x10 op-code cpu_run()
-                     */
-                    cpu.cpu_state = CPU_EXCEPTION;
-                    cpu.exception_line_num = __LINE__;
-            }
-        }
-        /* Double-byte 0x11 prefix
-         */
-        else if ( op_code == 0x11 )
-        {
-            op_code = mem_read(cpu.pc);
-            cpu.pc++;
-            /* Search for 0x11 double byte op-code. If not found
-             * then fall through the loop and catch the issue in the
-             * switch-case below.
-             * TODO change to binary search?
-             */
-            for ( op_code_index = OP_CODE11; op_code_index < sizeof(machine_code)/sizeof(machine_code_t); op_code_index++ )
-            {
-                if ( machine_code[op_code_index].op == op_code )
-                    {
-                        cycles = machine_code[op_code_index].cycles;
-                        bytes = machine_code[op_code_index].bytes;
-                        break;
-                    }
-            }
+static inline int ea_imm(int *cycles, int *bytes)
+{
+    uint16_t    effective_addr;
 
-            eff_addr = get_eff_addr(op_code_index, &cycles, &bytes);
+    effective_addr = active->cpu.pc;
+    active->cpu.pc += 1;
 
-            switch ( op_code )
-            {
-                /* CMPU
-                 */
-                case 0x83:
-                case 0x93:
-                case 0xa3:
-                case 0xb3:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    cmp16(cpu.u, operand16);
-                    break;
+    return effective_addr;
+}
 
-                /* CMPS
-                 */
-                case 0x8c:
-                case 0x9c:
-                case 0xac:
-                case 0xbc:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    cmp16(cpu.s, operand16);
-                    break;
+static inline int ea_limm(int *cycles, int *bytes)
+{
+    uint16_t    effective_addr;
 
-                /* SWI3
-                 */
-                case 0x3f:
-                    swi(3);
-                    break;
+    effective_addr = active->cpu.pc;
+    active->cpu.pc += 2;
+
+    return effective_addr;
+}
+
+static inline int ea_idx(int *cycles, int *bytes)
+{
+    return get_eff_addr(ADDR_INDEXED, cycles, bytes);
+}
+
+static inline int ea_rel(int *cycles, int *bytes)
+{
+    uint16_t    operand;
+    uint16_t    effective_addr;
+
+    operand = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+    effective_addr = active->cpu.pc + SIG_EXTEND(operand);
+
+    return effective_addr;
+}
+
+static inline int ea_lrel(int *cycles, int *bytes)
+{
+    uint16_t    operand;
+    uint16_t    effective_addr;
+
+    operand = MEM_READ16(active->cpu.pc);
+    active->cpu.pc += 2;
+    effective_addr = active->cpu.pc + operand;
+
+    return effective_addr;
+}
+
+#if (CPU_6309)
+static inline int ea_imdir(int *cycles, int *bytes)
+{
+    active->immediate = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    return ea_dir(cycles, bytes);
+}
+
+static inline int ea_imidx(int *cycles, int *bytes)
+{
+    active->immediate = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    return ea_idx(cycles, bytes);
+}
+
+static inline int ea_imext(int *cycles, int *bytes)
+{
+    active->immediate = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    return ea_ext(cycles, bytes);
+}
+
+static inline int ea_qimm(int *cycles, int *bytes)
+{
+    uint16_t    effective_addr;
+
+    effective_addr = active->cpu.pc;
+    active->cpu.pc += 4;
+
+    return effective_addr;
+}
+#endif
+
+/*------------------------------------------------
+ * read_word()
+ *
+ *  Read a 16-bit big-endian operand from memory.
+ *
+ *  param:  Operand address
+ *  return: 16-bit operand
+ */
+static inline uint16_t read_word(int address)
+{
+    return MEM_READ16(address);
+}
+
+/*------------------------------------------------
+ * op_*()
+ *
+ *  Op-code operations, one function per mnemonic.
+ *  Each op-code handler combines one of these with an
+ *  effective address function of the op-code's addressing mode.
+ *  The operations match the switch-case bodies of cpu_run().
+ *
+ *  param:  Effective address, pointer to command cycles count
+ *  return: Nothing
+ */
+
+/* Read-modify-write memory operations and their accumulator forms
+ */
+#define     OP_RMW(name) \
+    static inline void op_##name(int eff_addr, int *cycles) \
+    { \
+        MEM_WRITE(eff_addr, name((uint8_t) MEM_READ(eff_addr))); \
+    } \
+    static inline void op_##name##a(int eff_addr, int *cycles) \
+    { \
+        active->cpu.a = name(active->cpu.a); \
+    } \
+    static inline void op_##name##b(int eff_addr, int *cycles) \
+    { \
+        active->cpu.b = name(active->cpu.b); \
+    }
+
+OP_RMW(neg)
+OP_RMW(com)
+OP_RMW(lsr)
+OP_RMW(ror)
+OP_RMW(asr)
+OP_RMW(asl)
+OP_RMW(rol)
+OP_RMW(dec)
+OP_RMW(inc)
+
+/* Accumulator operations with a memory operand
+ */
+#define     OP_ACC(name) \
+    static inline void op_##name##a(int eff_addr, int *cycles) \
+    { \
+        active->cpu.a = name(active->cpu.a, (uint8_t) MEM_READ(eff_addr)); \
+    } \
+    static inline void op_##name##b(int eff_addr, int *cycles) \
+    { \
+        active->cpu.b = name(active->cpu.b, (uint8_t) MEM_READ(eff_addr)); \
+    }
+
+OP_ACC(adc)
+OP_ACC(add)
+OP_ACC(and)
+OP_ACC(eor)
+OP_ACC(or)
+OP_ACC(sbc)
+OP_ACC(sub)
+
+/* Accumulator tests with a memory operand
+ */
+#define     OP_ACC_TEST(name) \
+    static inline void op_##name##a(int eff_addr, int *cycles) \
+    { \
+        name(active->cpu.a, (uint8_t) MEM_READ(eff_addr)); \
+    } \
+    static inline void op_##name##b(int eff_addr, int *cycles) \
+    { \
+        name(active->cpu.b, (uint8_t) MEM_READ(eff_addr)); \
+    }
+
+OP_ACC_TEST(bit)
+OP_ACC_TEST(cmp)
+
+/* 16-bit register load, store and compare
+ */
+#define     OP_LD16(reg) \
+    static inline void op_ld##reg(int eff_addr, int *cycles) \
+    { \
+        active->cpu.reg = read_word(eff_addr); \
+        eval_cc_nz16(active->cpu.reg); \
+        SET_CC_V(CC_FLAG_CLR); \
+    }
 
-                default:
-                    /* Exception: Illegal 0x11 op-code cpu_run()
-                     */
-                    cpu.cpu_state = CPU_EXCEPTION;
-                    cpu.exception_line_num = __LINE__;
-            }
-        }
-        /* Common op-code processing
-         */
-        else
-        {
-            /* 'operand8' will be operand byte, and for a 16-bit operand 'operand8'
-             * will be the high order byte and low order byte should be read separately
-             * and combined into 16-bit value.
-             */
-            cycles = machine_code[op_code].cycles;
-            bytes = machine_code[op_code].bytes;
+#define     OP_ST16(reg) \
+    static inline void op_st##reg(int eff_addr, int *cycles) \
+    { \
+        MEM_WRITE16(eff_addr, active->cpu.reg); \
+        eval_cc_nz16(active->cpu.reg); \
+        SET_CC_V(CC_FLAG_CLR); \
+    }
 
-            eff_addr = get_eff_addr(op_code, &cycles, &bytes);
+#define     OP_CMP16(reg) \
+    static inline void op_cmp##reg(int eff_addr, int *cycles) \
+    { \
+        cmp16(active->cpu.reg, read_word(eff_addr)); \
+    }
 
-            switch ( op_code )
-            {
-                /* ABX
-                 */
-                case 0x3a:
-                    cpu.x += cpu.b;
-                    break;
+OP_LD16(d)
+OP_LD16(x)
+OP_LD16(y)
+OP_LD16(u)
+OP_ST16(d)
+OP_ST16(x)
+OP_ST16(y)
+OP_ST16(u)
+OP_ST16(s)
+OP_CMP16(x)
+OP_CMP16(y)
+OP_CMP16(u)
+OP_CMP16(s)
+
+static inline void op_lds(int eff_addr, int *cycles)
+{
+    active->cpu.s = read_word(eff_addr);
+    eval_cc_nz16(active->cpu.s);
+    SET_CC_V(CC_FLAG_CLR);
+    active->cpu.nmi_armed = 1;
+}
 
-                /* ADCA
-                 */
-                case 0x89:
-                case 0x99:
-                case 0xa9:
-                case 0xb9:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = adc(cpu.a, operand8);
-                    break;
+/* Short and long conditional branches. Both share branch_cond(),
+ * that adds the extra cycle of a taken long branch.
+ */
+static inline void branch_cond(int op_code, int eff_addr, int *cycles, int long_branch)
+{
+    if ( BRANCH_TAKEN(op_code) )
+    {
+        active->cpu.pc = eff_addr;
+        (*cycles) += long_branch;
+    }
+}
 
-                /* ADCB
-                 */
-                case 0xc9:
-                case 0xd9:
-                case 0xe9:
-                case 0xf9:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = adc(cpu.b, operand8);
-                    break;
+#define     OP_BRANCH(name, op_code) \
+    static inline void op_b##name(int eff_addr, int *cycles) \
+    { \
+        branch_cond(op_code, eff_addr, cycles, 0); \
+    } \
+    static inline void op_lb##name(int eff_addr, int *cycles) \
+    { \
+        branch_cond(op_code, eff_addr, cycles, 1); \
+    }
 
-                /* ADDA
-                 */
-                case 0x8b:
-                case 0x9b:
-                case 0xab:
-                case 0xbb:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = add(cpu.a, operand8);
-                    break;
+OP_BRANCH(rn, 0x21)
+OP_BRANCH(hi, 0x22)
+OP_BRANCH(ls, 0x23)
+OP_BRANCH(cc, 0x24)
+OP_BRANCH(cs, 0x25)
+OP_BRANCH(ne, 0x26)
+OP_BRANCH(eq, 0x27)
+OP_BRANCH(vc, 0x28)
+OP_BRANCH(vs, 0x29)
+OP_BRANCH(pl, 0x2a)
+OP_BRANCH(mi, 0x2b)
+OP_BRANCH(ge, 0x2c)
+OP_BRANCH(lt, 0x2d)
+OP_BRANCH(gt, 0x2e)
+OP_BRANCH(le, 0x2f)
+
+static inline void op_abx(int eff_addr, int *cycles)
+{
+    active->cpu.x += active->cpu.b;
+}
 
-                /* ADDB
-                 */
-                case 0xcb:
-                case 0xdb:
-                case 0xeb:
-                case 0xfb:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = add(cpu.b, operand8);
-                    break;
+static inline void op_addd(int eff_addr, int *cycles)
+{
+    addd(read_word(eff_addr));
+}
 
-                /* ADDD
-                 */
-                case 0xc3:
-                case 0xd3:
-                case 0xe3:
-                case 0xf3:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    addd(operand16);
-                    break;
+static inline void op_andcc(int eff_addr, int *cycles)
+{
+    andcc((uint8_t) MEM_READ(eff_addr));
+}
 
-                /* ANDA
-                 */
-                case 0x84:
-                case 0x94:
-                case 0xa4:
-                case 0xb4:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = and(cpu.a, operand8);
-                    break;
+static inline void op_bra(int eff_addr, int *cycles)
+{
+    active->cpu.pc = eff_addr;
+}
 
-                /* ADDB
-                 */
-                case 0xc4:
-                case 0xd4:
-                case 0xe4:
-                case 0xf4:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = and(cpu.b, operand8);
-                    break;
+static inline void op_bsr(int eff_addr, int *cycles)
+{
+    active->cpu.s--;
+    MEM_WRITE(active->cpu.s, GET_REG_LOW(active->cpu.pc));
+    active->cpu.s--;
+    MEM_WRITE(active->cpu.s, GET_REG_HIGH(active->cpu.pc));
+    active->cpu.pc = eff_addr;
+}
 
-                /* ANDCC
-                 */
-                case 0x1c:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    andcc(operand8);
-                    break;
+static inline void op_clr(int eff_addr, int *cycles)
+{
+    MEM_WRITE(eff_addr, clr());
+}
 
-                /* ASL, ASLA, ASLB
-                 * LSL, LSLA, LSLB
-                 */
-                case 0x08:
-                case 0x68:
-                case 0x78:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = asl(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_clra(int eff_addr, int *cycles)
+{
+    active->cpu.a = clr();
+}
 
-                case 0x48:
-                    cpu.a = asl(cpu.a);
-                    break;
+static inline void op_clrb(int eff_addr, int *cycles)
+{
+    active->cpu.b = clr();
+}
 
-                case 0x58:
-                    cpu.b = asl(cpu.b);
-                    break;
+static inline void op_cmpd(int eff_addr, int *cycles)
+{
+    cmp16(active->cpu.d, read_word(eff_addr));
+}
 
-                /* ASR, ASRA, ASRB
-                 */
-                case 0x07:
-                case 0x67:
-                case 0x77:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = asr(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_cwai(int eff_addr, int *cycles)
+{
+    cwai((uint8_t) MEM_READ(eff_addr));
+}
 
-                case 0x47:
-                    cpu.a = asr(cpu.a);
-                    break;
+static inline void op_daa(int eff_addr, int *cycles)
+{
+    daa();
+}
 
-                case 0x57:
-                    cpu.b = asr(cpu.b);
-                    break;
+static inline void op_exg(int eff_addr, int *cycles)
+{
+    exg((uint8_t) MEM_READ(eff_addr));
+}
 
-                /* BITA
-                 */
-                case 0x85:
-                case 0x95:
-                case 0xa5:
-                case 0xb5:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    bit(cpu.a, operand8);
-                    break;
+static inline void op_jmp(int eff_addr, int *cycles)
+{
+    active->cpu.pc = eff_addr;
+}
 
-                /* BITB
-                 */
-                case 0xc5:
-                case 0xd5:
-                case 0xe5:
-                case 0xf5:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    bit(cpu.b, operand8);
-                    break;
+static inline void op_jsr(int eff_addr, int *cycles)
+{
+    op_bsr(eff_addr, cycles);
+}
 
-                /* CLR, CLRA, CLRB
-                 */
-                case 0x0f:
-                case 0x6f:
-                case 0x7f:
-                    operand8 = clr();
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_lbra(int eff_addr, int *cycles)
+{
+    active->cpu.pc = eff_addr;
+}
 
-                case 0x4f:
-                    cpu.a = clr();
-                    break;
+static inline void op_lbsr(int eff_addr, int *cycles)
+{
+    op_bsr(eff_addr, cycles);
+}
 
-                case 0x5f:
-                    cpu.b = clr();
-                    break;
+static inline void op_lda(int eff_addr, int *cycles)
+{
+    active->cpu.a = (uint8_t) MEM_READ(eff_addr);
+    eval_cc_nz((uint16_t) active->cpu.a);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* CMPA
-                 */
-                case 0x81:
-                case 0x91:
-                case 0xa1:
-                case 0xb1:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cmp(cpu.a, operand8);
-                    break;
+static inline void op_ldb(int eff_addr, int *cycles)
+{
+    active->cpu.b = (uint8_t) MEM_READ(eff_addr);
+    eval_cc_nz((uint16_t) active->cpu.b);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* CMPB
-                 */
-                case 0xc1:
-                case 0xd1:
-                case 0xe1:
-                case 0xf1:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cmp(cpu.b, operand8);
-                    break;
+static inline void op_leax(int eff_addr, int *cycles)
+{
+    active->cpu.x = eff_addr;
+    eval_cc_z16(active->cpu.x);
+}
 
-                /* CMPX
-                 */
-                case 0x8c:
-                case 0x9c:
-                case 0xac:
-                case 0xbc:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    cmp16(cpu.x, operand16);
-                    break;
+static inline void op_leay(int eff_addr, int *cycles)
+{
+    active->cpu.y = eff_addr;
+    eval_cc_z16(active->cpu.y);
+}
 
-                /* COM, COMA, COMB
-                 */
-                case 0x03:
-                case 0x63:
-                case 0x73:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = com(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_leas(int eff_addr, int *cycles)
+{
+    active->cpu.s = eff_addr;
+    active->cpu.nmi_armed = 1;
+}
 
-                case 0x43:
-                    cpu.a = com(cpu.a);
-                    break;
+static inline void op_leau(int eff_addr, int *cycles)
+{
+    active->cpu.u = eff_addr;
+}
 
-                case 0x53:
-                    cpu.b = com(cpu.b);
-                    break;
+static inline void op_mul(int eff_addr, int *cycles)
+{
+    uint16_t    result;
 
-                /* CWAI
-                 */
-                case 0x3c:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cwai(operand8);
-                    break;
+    result = active->cpu.a * active->cpu.b;
+    active->cpu.d = result;
+    eval_cc_z16(result);
+    eval_cc_c(result);
+}
 
-                /* DAA
-                 */
-                case 0x19:
-                    daa();
-                    break;
+static inline void op_nop(int eff_addr, int *cycles)
+{
+}
 
-                /* DEC, DECA, DECB
-                 */
-                case 0x0a:
-                case 0x6a:
-                case 0x7a:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = dec(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_orcc(int eff_addr, int *cycles)
+{
+    orcc((uint8_t) MEM_READ(eff_addr));
+}
 
-                case 0x4a:
-                    cpu.a = dec(cpu.a);
-                    break;
+static inline void op_pshs(int eff_addr, int *cycles)
+{
+    pshs((uint8_t) MEM_READ(eff_addr), cycles);
+}
 
-                case 0x5a:
-                    cpu.b = dec(cpu.b);
-                    break;
+static inline void op_pshu(int eff_addr, int *cycles)
+{
+    pshu((uint8_t) MEM_READ(eff_addr), cycles);
+}
 
-                /* EORA
-                 */
-                case 0x88:
-                case 0x98:
-                case 0xa8:
-                case 0xb8:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = eor(cpu.a, operand8);
-                    break;
+static inline void op_puls(int eff_addr, int *cycles)
+{
+    puls((uint8_t) MEM_READ(eff_addr), cycles);
+}
 
-                /* EORB
-                 */
-                case 0xc8:
-                case 0xd8:
-                case 0xe8:
-                case 0xf8:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = eor(cpu.b, operand8);
-                    break;
+static inline void op_pulu(int eff_addr, int *cycles)
+{
+    pulu((uint8_t) MEM_READ(eff_addr), cycles);
+}
 
-                /* EXG
-                 */
-                case 0x1e:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    exg(operand8);
-                    break;
+static inline void op_rti(int eff_addr, int *cycles)
+{
+    rti(cycles);
+}
 
-                /* INC, INCA, INCB
-                 */
-                case 0x0c:
-                case 0x6c:
-                case 0x7c:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = inc(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_rts(int eff_addr, int *cycles)
+{
+    active->cpu.pc = (uint16_t) MEM_READ(active->cpu.s) << 8;
+    active->cpu.s++;
+    active->cpu.pc += (uint8_t) MEM_READ(active->cpu.s);
+    active->cpu.s++;
+}
 
-                case 0x4c:
-                    cpu.a = inc(cpu.a);
-                    break;
+static inline void op_sex(int eff_addr, int *cycles)
+{
+    sex();
+}
 
-                case 0x5c:
-                    cpu.b = inc(cpu.b);
-                    break;
+static inline void op_sta(int eff_addr, int *cycles)
+{
+    MEM_WRITE(eff_addr, active->cpu.a);
+    eval_cc_nz((uint16_t) active->cpu.a);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* JMP
-                 */
-                case 0x0e:
-                case 0x6e:
-                case 0x7e:
-                    cpu.pc = eff_addr;
-                    break;
+static inline void op_stb(int eff_addr, int *cycles)
+{
+    MEM_WRITE(eff_addr, active->cpu.b);
+    eval_cc_nz((uint16_t) active->cpu.b);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* JSR
-                 */
-                case 0x9d:
-                case 0xad:
-                case 0xbd:
-                    cpu.s--;
-                    mem_write(cpu.s, GET_REG_LOW(cpu.pc));
-                    cpu.s--;
-                    mem_write(cpu.s, GET_REG_HIGH(cpu.pc));
-                    cpu.pc = eff_addr;
-                    break;
+static inline void op_subd(int eff_addr, int *cycles)
+{
+    subd(read_word(eff_addr));
+}
 
-                /* LDA
-                 */
-                case 0x86:
-                case 0x96:
-                case 0xa6:
-                case 0xb6:
-                    cpu.a = (uint8_t) mem_read(eff_addr);;
-                    eval_cc_z((uint16_t) cpu.a);
-                    eval_cc_n((uint16_t) cpu.a);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_swi(int eff_addr, int *cycles)
+{
+    swi(1);
+}
 
-                /* LDB
-                 */
-                case 0xc6:
-                case 0xd6:
-                case 0xe6:
-                case 0xf6:
-                    cpu.b = (uint8_t) mem_read(eff_addr);;
-                    eval_cc_z((uint16_t) cpu.b);
-                    eval_cc_n((uint16_t) cpu.b);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_swi2(int eff_addr, int *cycles)
+{
+    swi(2);
+}
 
-                /* LDD
-                 */
-                case 0xcc:
-                case 0xdc:
-                case 0xec:
-                case 0xfc:
-                    cpu.a = (uint8_t) mem_read(eff_addr);;
-                    eff_addr++;
-                    cpu.b = (uint8_t) mem_read(eff_addr);
-                    eval_cc_z16(d);
-                    eval_cc_n16(d);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_swi3(int eff_addr, int *cycles)
+{
+    swi(3);
+}
 
-                /* LDU
-                 */
-                case 0xce:
-                case 0xde:
-                case 0xee:
-                case 0xfe:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    cpu.u = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    eval_cc_z16(cpu.u);
-                    eval_cc_n16(cpu.u);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_sync(int eff_addr, int *cycles)
+{
+    set_state(CPU_SYNC);
+}
 
-                /* LDX
-                 */
-                case 0x8e:
-                case 0x9e:
-                case 0xae:
-                case 0xbe:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    cpu.x = ((uint16_t) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    eval_cc_z16(cpu.x);
-                    eval_cc_n16(cpu.x);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_tfr(int eff_addr, int *cycles)
+{
+    tfr((uint8_t) MEM_READ(eff_addr));
+}
 
-                /* LEA
-                 */
-                case 0x30:
-                    cpu.x = eff_addr;
-                    eval_cc_z16(cpu.x);
-                    break;
+static inline void op_tst(int eff_addr, int *cycles)
+{
+    tst((uint8_t) MEM_READ(eff_addr));
+}
 
-                case 0x31:
-                    cpu.y = eff_addr;
-                    eval_cc_z16(cpu.y);
-                    break;
+static inline void op_tsta(int eff_addr, int *cycles)
+{
+    tst(active->cpu.a);
+}
 
-                case 0x32:
-                    cpu.s = eff_addr;
-                    cpu.nmi_armed = 1;
-                    break;
+static inline void op_tstb(int eff_addr, int *cycles)
+{
+    tst(active->cpu.b);
+}
 
-                case 0x33:
-                    cpu.u = eff_addr;
-                    break;
+#if (CPU_6309)
+/* HD6309 operations.
+ * Q is the 32-bit accumulator D:W.
+ */
+static inline uint32_t get_q(void)
+{
+    return ((uint32_t) active->cpu.d << 16) | active->cpu.w;
+}
 
-                /* LSR, LSRA, LSRB
-                 */
-                case 0x04:
-                case 0x64:
-                case 0x74:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = lsr(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void set_q(uint32_t value)
+{
+    active->cpu.d = (uint16_t) (value >> 16);
+    active->cpu.w = (uint16_t) value;
+}
 
-                case 0x44:
-                    cpu.a = lsr(cpu.a);
-                    break;
+/* Immediate and memory operand logical operations and test
+ */
+#define     OP_IMM_MEM(name, operation) \
+    static inline void op_##name(int eff_addr, int *cycles) \
+    { \
+        MEM_WRITE(eff_addr, operation((uint8_t) MEM_READ(eff_addr), active->immediate)); \
+    }
 
-                case 0x54:
-                    cpu.b = lsr(cpu.b);
-                    break;
+OP_IMM_MEM(oim, or)
+OP_IMM_MEM(aim, and)
+OP_IMM_MEM(eim, eor)
 
-                /* MUL
-                 */
-                case 0x3d:
-                    operand16 = cpu.a * cpu.b;
-                    cpu.a = GET_REG_HIGH(operand16);
-                    cpu.b = GET_REG_LOW(operand16);
-                    eval_cc_z16(operand16);
-                    eval_cc_c(operand16);;
-                    break;
+static inline void op_tim(int eff_addr, int *cycles)
+{
+    and((uint8_t) MEM_READ(eff_addr), active->immediate);
+}
 
-                /* NEG, NEGA, NEGB
-                 */
-                case 0x00:
-                case 0x60:
-                case 0x70:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = neg(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+/* D and W register inherent operations
+ */
+#define     OP_INH_D(name) \
+    static inline void op_##name##d(int eff_addr, int *cycles) \
+    { \
+        active->cpu.d = name##16(active->cpu.d); \
+    }
 
-                case 0x40:
-                    cpu.a = neg(cpu.a);
-                    break;
+#define     OP_INH_W(name) \
+    static inline void op_##name##w(int eff_addr, int *cycles) \
+    { \
+        active->cpu.w = name##16(active->cpu.w); \
+    }
 
-                case 0x50:
-                    cpu.b = neg(cpu.b);
-                    break;
+OP_INH_D(neg)
+OP_INH_D(com)
+OP_INH_D(lsr)
+OP_INH_D(ror)
+OP_INH_D(asr)
+OP_INH_D(asl)
+OP_INH_D(rol)
+OP_INH_D(dec)
+OP_INH_D(inc)
+OP_INH_W(com)
+OP_INH_W(lsr)
+OP_INH_W(ror)
+OP_INH_W(rol)
+OP_INH_W(dec)
+OP_INH_W(inc)
+
+static inline void op_tstd(int eff_addr, int *cycles)
+{
+    tst16(active->cpu.d);
+}
 
-                /* NOP
-                 */
-                case 0x12:
-                    break;
+static inline void op_tstw(int eff_addr, int *cycles)
+{
+    tst16(active->cpu.w);
+}
 
-                /* ORA, ORB
-                 */
-                case 0x8a:
-                case 0x9a:
-                case 0xaa:
-                case 0xba:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = or(cpu.a, operand8);
-                    break;
+static inline void op_clrd(int eff_addr, int *cycles)
+{
+    active->cpu.d = clr();
+}
 
-                case 0xca:
-                case 0xda:
-                case 0xea:
-                case 0xfa:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = or(cpu.b, operand8);
-                    break;
+static inline void op_clrw(int eff_addr, int *cycles)
+{
+    active->cpu.w = clr();
+}
 
-                /* ORCC
-                 */
-                case 0x1a:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    orcc(operand8);
-                    break;
+/* E and F register inherent operations
+ */
+#define     OP_INH_EF(name) \
+    static inline void op_##name##e(int eff_addr, int *cycles) \
+    { \
+        active->cpu.e = name(active->cpu.e); \
+    } \
+    static inline void op_##name##f(int eff_addr, int *cycles) \
+    { \
+        active->cpu.f = name(active->cpu.f); \
+    }
 
-                /* PSHS, PSHU
-                 */
-                case 0x34:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    pshs(operand8, &cycles);
-                    break;
+OP_INH_EF(com)
+OP_INH_EF(dec)
+OP_INH_EF(inc)
 
-                case 0x36:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    pshu(operand8, &cycles);
-                    break;
+static inline void op_tste(int eff_addr, int *cycles)
+{
+    tst(active->cpu.e);
+}
 
-                /* PULS, PULU
-                 */
-                case 0x35:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    puls(operand8, &cycles);
-                    break;
+static inline void op_tstf(int eff_addr, int *cycles)
+{
+    tst(active->cpu.f);
+}
 
-                case 0x37:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    pulu(operand8, &cycles);
-                    break;
+static inline void op_clre(int eff_addr, int *cycles)
+{
+    active->cpu.e = clr();
+}
 
-                /* ROL, ROLA, ROLB
-                 */
-                case 0x09:
-                case 0x69:
-                case 0x79:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = rol(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_clrf(int eff_addr, int *cycles)
+{
+    active->cpu.f = clr();
+}
 
-                case 0x49:
-                    cpu.a = rol(cpu.a);
-                    break;
+/* E and F accumulator operations with a memory operand
+ */
+#define     OP_ACC_EF(name) \
+    static inline void op_##name##e(int eff_addr, int *cycles) \
+    { \
+        active->cpu.e = name(active->cpu.e, (uint8_t) MEM_READ(eff_addr)); \
+    } \
+    static inline void op_##name##f(int eff_addr, int *cycles) \
+    { \
+        active->cpu.f = name(active->cpu.f, (uint8_t) MEM_READ(eff_addr)); \
+    }
 
-                case 0x59:
-                    cpu.b = rol(cpu.b);
-                    break;
+OP_ACC_EF(add)
+OP_ACC_EF(sub)
 
-                /* ROR, RORA, RORB
-                 */
-                case 0x06:
-                case 0x66:
-                case 0x76:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    operand8 = ror(operand8);
-                    mem_write(eff_addr, operand8);
-                    break;
+static inline void op_cmpe(int eff_addr, int *cycles)
+{
+    cmp(active->cpu.e, (uint8_t) MEM_READ(eff_addr));
+}
 
-                case 0x46:
-                    cpu.a = ror(cpu.a);
-                    break;
+static inline void op_cmpf(int eff_addr, int *cycles)
+{
+    cmp(active->cpu.f, (uint8_t) MEM_READ(eff_addr));
+}
 
-                case 0x56:
-                    cpu.b = ror(cpu.b);
-                    break;
+static inline void op_lde(int eff_addr, int *cycles)
+{
+    active->cpu.e = MEM_READ(eff_addr);
+    eval_cc_nz((uint16_t) active->cpu.e);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* RTI
-                 */
-                case 0x3b:
-                    rti(&cycles);
-                    break;
+static inline void op_ldf(int eff_addr, int *cycles)
+{
+    active->cpu.f = MEM_READ(eff_addr);
+    eval_cc_nz((uint16_t) active->cpu.f);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* RTS
-                 */
-                case 0x39:
-                     /* Restore PC and return
-                      */
-                     operand8 = mem_read(cpu.s);
-                     cpu.s++;
-                     cpu.pc = (uint16_t) operand8 << 8;
-                     operand8 = mem_read(cpu.s);
-                     cpu.s++;
-                     cpu.pc += operand8;
-                     break;
+static inline void op_ste(int eff_addr, int *cycles)
+{
+    MEM_WRITE(eff_addr, active->cpu.e);
+    eval_cc_nz((uint16_t) active->cpu.e);
+    SET_CC_V(CC_FLAG_CLR);
+}
+
+static inline void op_stf(int eff_addr, int *cycles)
+{
+    MEM_WRITE(eff_addr, active->cpu.f);
+    eval_cc_nz((uint16_t) active->cpu.f);
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* SBCA
-                 */
-                case 0x82:
-                case 0x92:
-                case 0xa2:
-                case 0xb2:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = sbc(cpu.a, operand8);
-                    break;
+/* D and W accumulator operations with a memory operand
+ */
+#define     OP_ACC_D(name, operation) \
+    static inline void op_##name(int eff_addr, int *cycles) \
+    { \
+        active->cpu.d = operation(active->cpu.d, read_word(eff_addr)); \
+    }
 
-                /* SBCB
-                 */
-                case 0xc2:
-                case 0xd2:
-                case 0xe2:
-                case 0xf2:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = sbc(cpu.b, operand8);
-                    break;
+#define     OP_ACC_W(name, operation) \
+    static inline void op_##name(int eff_addr, int *cycles) \
+    { \
+        active->cpu.w = operation(active->cpu.w, read_word(eff_addr)); \
+    }
 
-                /* SEX
-                 */
-                case 0x1d:
-                    sex();
-                    break;
+OP_ACC_D(adcd, adc16)
+OP_ACC_D(andd, and16)
+OP_ACC_D(eord, eor16)
+OP_ACC_D(ord,  or16)
+OP_ACC_D(sbcd, sbc16)
+OP_ACC_W(addw, add16)
+OP_ACC_W(subw, sub16)
 
-                /* STA
-                 */
-                case 0x97:
-                case 0xa7:
-                case 0xb7:
-                    mem_write(eff_addr, cpu.a);
-                    eval_cc_z((uint16_t) cpu.a);
-                    eval_cc_n((uint16_t) cpu.a);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+OP_LD16(w)
+OP_ST16(w)
 
-                /* STB
-                 */
-                case 0xd7:
-                case 0xe7:
-                case 0xf7:
-                    mem_write(eff_addr, cpu.b);
-                    eval_cc_z((uint16_t) cpu.b);
-                    eval_cc_n((uint16_t) cpu.b);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_bitd(int eff_addr, int *cycles)
+{
+    and16(active->cpu.d, read_word(eff_addr));
+}
 
-                /* STD
-                 */
-                case 0xdd:
-                case 0xed:
-                case 0xfd:
-                    mem_write(eff_addr, cpu.a);
-                    mem_write(eff_addr + 1, cpu.b);
-                    eval_cc_z16(d);
-                    eval_cc_n16(d);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_cmpw(int eff_addr, int *cycles)
+{
+    cmp16(active->cpu.w, read_word(eff_addr));
+}
 
-                /* STU
-                 */
-                case 0xdf:
-                case 0xef:
-                case 0xff:
-                    mem_write(eff_addr, (uint8_t) (cpu.u >> 8));
-                    mem_write(eff_addr + 1, (uint8_t) (cpu.u));
-                    eval_cc_z16(cpu.u);
-                    eval_cc_n16(cpu.u);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_ldq(int eff_addr, int *cycles)
+{
+    set_q(((uint32_t) read_word(eff_addr) << 16) | read_word(eff_addr + 2));
+    eval_cc_nz32(get_q());
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* STX
-                 */
-                case 0x9f:
-                case 0xaf:
-                case 0xbf:
-                    mem_write(eff_addr, (uint8_t) (cpu.x >> 8));
-                    mem_write(eff_addr + 1, (uint8_t) (cpu.x));
-                    eval_cc_z16(cpu.x);
-                    eval_cc_n16(cpu.x);
-                    cc.v = CC_FLAG_CLR;
-                    break;
+static inline void op_stq(int eff_addr, int *cycles)
+{
+    MEM_WRITE16(eff_addr, active->cpu.d);
+    MEM_WRITE(eff_addr + 2, active->cpu.e);
+    MEM_WRITE(eff_addr + 3, active->cpu.f);
+    eval_cc_nz32(get_q());
+    SET_CC_V(CC_FLAG_CLR);
+}
 
-                /* SUBA
-                 */
-                case 0x80:
-                case 0x90:
-                case 0xa0:
-                case 0xb0:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.a = sub(cpu.a, operand8);
-                    break;
+static inline void op_sexw(int eff_addr, int *cycles)
+{
+    active->cpu.d = (active->cpu.w & 0x8000) ? 0xffff : 0;
+    eval_cc_nz32(get_q());
+}
 
-                /* SUBB
-                 */
-                case 0xc0:
-                case 0xd0:
-                case 0xe0:
-                case 0xf0:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    cpu.b = sub(cpu.b, operand8);
-                    break;
+/* Register to register operations
+ */
+static inline void op_addr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), add, add16, 1);
+}
 
-                /* SUBD
-                 */
-                case 0x83:
-                case 0x93:
-                case 0xa3:
-                case 0xb3:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    eff_addr++;
-                    operand16 = ((uint16_t ) operand8 << 8) + (uint16_t) mem_read(eff_addr);
-                    subd(operand16);
-                    break;
+static inline void op_adcr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), adc, adc16, 1);
+}
 
-                /* SWI
-                 */
-                case 0x3f:
-                    swi(1);
-                    break;
+static inline void op_subr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), sub, sub16, 1);
+}
 
-                /* SYNC
-                 *
-                 * The SYNC instruction allows software to synchronize with an external hardware
-                 * event (interrupt). When executed, SYNC stops executing instructions and waits
-                 * for an interrupt. None of the CC flags are directly affected.
-                 */
-                case 0x13:
-                    cpu.cpu_state = CPU_SYNC;
-                    break;
+static inline void op_sbcr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), sbc, sbc16, 1);
+}
 
-                /* TFR
-                 */
-                case 0x1f:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    tfr(operand8);
-                    break;
+static inline void op_andr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), and, and16, 1);
+}
 
-                /* TSTA
-                 */
-                case 0x4d:
-                    tst(cpu.a);
-                    break;
+static inline void op_orr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), or, or16, 1);
+}
 
-                /* TSTB
-                 */
-                case 0x5d:
-                    tst(cpu.b);
-                    break;
+static inline void op_eorr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), eor, eor16, 1);
+}
 
-                /* TST
-                 */
-                case 0x0d:
-                case 0x6d:
-                case 0x7d:
-                    operand8 = (uint8_t) mem_read(eff_addr);
-                    tst(operand8);
-                    break;
+static inline void op_cmpr(int eff_addr, int *cycles)
+{
+    reg_alu((uint8_t) MEM_READ(eff_addr), sub, sub16, 0);
+}
 
-                /* BRA / LBRA
-                 */
-                case 0x20:
-                case 0x16:
-                    cpu.pc = eff_addr;
-                    break;
+/* W register stack operations
+ */
+static inline void op_pshsw(int eff_addr, int *cycles)
+{
+    active->cpu.s--;
+    MEM_WRITE(active->cpu.s, active->cpu.f);
+    active->cpu.s--;
+    MEM_WRITE(active->cpu.s, active->cpu.e);
+}
 
-                /* BRN
-                 */
-                case 0x21:
-                    // Branch never
-                    break;
+static inline void op_pulsw(int eff_addr, int *cycles)
+{
+    active->cpu.w = read_word(active->cpu.s);
+    active->cpu.s += 2;
+}
 
-                /* BSR / LBSR
-                 */
-                case 0x8d:
-                case 0x17:
-                    cpu.s--;
-                    mem_write(cpu.s, GET_REG_LOW(cpu.pc));
-                    cpu.s--;
-                    mem_write(cpu.s, GET_REG_HIGH(cpu.pc));
-                    cpu.pc = eff_addr;
-                    break;
+static inline void op_pshuw(int eff_addr, int *cycles)
+{
+    active->cpu.u--;
+    MEM_WRITE(active->cpu.u, active->cpu.f);
+    active->cpu.u--;
+    MEM_WRITE(active->cpu.u, active->cpu.e);
+}
 
-                /* Short conditional branches
-                 */
-                case 0x22 ... 0x2f:
-                    branch(op_code, 0, eff_addr, &cycles);
-                    break;
+static inline void op_puluw(int eff_addr, int *cycles)
+{
+    active->cpu.w = read_word(active->cpu.u);
+    active->cpu.u += 2;
+}
 
-                default:
-                    /* Exception: Illegal op-code cpu_run()
-                     */
-                    cpu.cpu_state = CPU_EXCEPTION;
-                    cpu.exception_line_num = __LINE__;
-            }
-        }
+/* Bit transfers
+ */
+#define     OP_BIT(name, operation) \
+    static inline void op_##name(int eff_addr, int *cycles) \
+    { \
+        bit_transfer(eff_addr, operation, cycles); \
     }
 
-    /* Preserves for other uses such as
-     * single step etc.
-     */
-    cpu.last_opcode_bytes = bytes;
-    cpu.last_opcode_cycles = cycles;
-    cpu.cc = get_cc();
+OP_BIT(band,  BIT_AND)
+OP_BIT(biand, BIT_IAND)
+OP_BIT(bor,   BIT_OR)
+OP_BIT(bior,  BIT_IOR)
+OP_BIT(beor,  BIT_EOR)
+OP_BIT(bieor, BIT_IEOR)
+OP_BIT(ldbt,  BIT_LDBT)
+OP_BIT(stbt,  BIT_STBT)
 
-    return cpu.cpu_state;
+/* Block transfers TFM r0+,r1+ / r0-,r1- / r0+,r1 / r0,r1+
+ */
+static inline void op_tfmpp(int eff_addr, int *cycles)
+{
+    tfm((uint8_t) MEM_READ(eff_addr), 1, 1, cycles);
 }
 
-/*------------------------------------------------
- * cpu_get_state()
- *
- *  Get the state of the CPU.
- *
- *  param:  Pointer to CPU state data structure
- *  return: CPU running state
- */
-cpu_run_state_t cpu_get_state(cpu_state_t* cpu_state)
+static inline void op_tfmmm(int eff_addr, int *cycles)
 {
-    memcpy(cpu_state, &cpu, sizeof(cpu_state_t));
+    tfm((uint8_t) MEM_READ(eff_addr), -1, -1, cycles);
+}
 
-    return cpu.cpu_state;
+static inline void op_tfmpn(int eff_addr, int *cycles)
+{
+    tfm((uint8_t) MEM_READ(eff_addr), 1, 0, cycles);
 }
 
-/*------------------------------------------------
- * cpu_get_menmonic()
- *
- *  Return a pointer to a constant string representing the
- *  op-code's mnemonic at the input memory address.
- *
- *  param:  Memory address
- *  return: Pointer to constant mnemonic string
- */
-const char* cpu_get_menmonic(uint16_t address)
+static inline void op_tfmnp(int eff_addr, int *cycles)
 {
-    int     i, op_code;
-    char   *mnemonic = 0;
+    tfm((uint8_t) MEM_READ(eff_addr), 0, 1, cycles);
+}
 
-    op_code = mem_read(address);
+/* Multiply and divide
+ */
+static inline void op_muld(int eff_addr, int *cycles)
+{
+    set_q((uint32_t) ((int32_t) (int16_t) active->cpu.d * (int16_t) read_word(eff_addr)));
+    eval_cc_nz32(get_q());
+    SET_CC_V(CC_FLAG_CLR);
+    SET_CC_C(CC_FLAG_CLR);
+}
 
-    if ( op_code == 0x10 )
-    {
-        op_code = mem_read(address + 1);
-        for ( i = OP_CODE10; i < OP_CODE11; i++ )
-        {
-            if ( op_code == machine_code[i].op )
-            {
-                mnemonic = machine_code[i].mnem;
-                break;
-            }
-        }
-    }
-    else if ( op_code == 0x11 )
-    {
-        op_code = mem_read(address + 1);
-        for ( i = OP_CODE11; i < sizeof(machine_code)/sizeof(machine_code_t); i++ )
-        {
-            if ( op_code == machine_code[i].op )
-            {
-                mnemonic = machine_code[i].mnem;
-                break;
-            }
-        }
-    }
-    else
-    {
-        mnemonic = machine_code[op_code].mnem;
-    }
+static inline void op_divd(int eff_addr, int *cycles)
+{
+    divd((int8_t) MEM_READ(eff_addr), cycles);
+}
 
-    return mnemonic;
+static inline void op_divq(int eff_addr, int *cycles)
+{
+    divq((int16_t) read_word(eff_addr), cycles);
 }
 
-/*------------------------------------------------
- * adc()
- *
- *  Add with carry.
- *
- *  acc+byte+carry
+/* Mode and error register
  */
-static uint8_t adc(uint8_t acc, uint8_t byte)
+static inline void op_bitmd(int eff_addr, int *cycles)
 {
-    uint16_t result;
+    uint8_t     bits;
 
-    result = (acc + byte + cc.c);
+    bits = active->cpu.md & (uint8_t) MEM_READ(eff_addr) & (MD_ILLEGAL | MD_DIV0);
+    SET_CC_Z(bits ? CC_FLAG_CLR : CC_FLAG_SET);
+    active->cpu.md &= ~bits;
+}
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(acc, byte, result);
-    eval_cc_h(acc, byte, result);
+static inline void op_ldmd(int eff_addr, int *cycles)
+{
+    uint8_t     md;
 
-    return (uint8_t) result;
+    md = (active->cpu.md & (MD_ILLEGAL | MD_DIV0)) |
+         ((uint8_t) MEM_READ(eff_addr) & (MD_NATIVE | MD_FIRQ_ALL));
+
+    /* Cached instructions hold the cycle counts of the other mode
+     */
+    if ( (md ^ active->cpu.md) & MD_NATIVE )
+        cache_invalidate(active);
+
+    active->cpu.md = md;
 }
+#endif  /* CPU_6309 */
+
+#endif  /* CPU_DISPATCH != CPU_DISPATCH_SWITCH */
 
+#if (CPU_DISPATCH == CPU_DISPATCH_TABLE)
 /*------------------------------------------------
- * add()
+ * Op-code handler functions and dispatch tables.
  *
- *  Add.
+ *  One handler function is generated per op-code from the
+ *  op-code lists in mc6809e_ops.h. Each handler combines the
+ *  op-code's effective address function and operation.
  *
- *  acc+byte
+ *  param:  Pointer to command cycles and bytes count
+ *  return: Nothing
  */
-static uint8_t add(uint8_t acc, uint8_t byte)
+#define     HANDLER(page, op_code, operation, mode) \
+    static void op_##page##_##op_code(int *cycles, int *bytes) \
+    { \
+        op_##operation(ea_##mode(cycles, bytes), cycles); \
+    }
+
+#define     HANDLER_PAGE1(op_code, operation, mode)     HANDLER(p1, op_code, operation, mode)
+#define     HANDLER_PAGE2(op_code, operation, mode)     HANDLER(p2, op_code, operation, mode)
+#define     HANDLER_PAGE3(op_code, operation, mode)     HANDLER(p3, op_code, operation, mode)
+
+#define     ENTRY_PAGE1(op_code, operation, mode)       [op_code] = op_p1_##op_code,
+#define     ENTRY_PAGE2(op_code, operation, mode)       [op_code] = op_p2_##op_code,
+#define     ENTRY_PAGE3(op_code, operation, mode)       [op_code] = op_p3_##op_code,
+
+OP_CODES_PAGE1(HANDLER_PAGE1)
+OP_CODES_PAGE2(HANDLER_PAGE2)
+OP_CODES_PAGE3(HANDLER_PAGE3)
+
+static void op_illegal(int *cycles, int *bytes)
+{
+#if (CPU_6309)
+    *cycles = trap(MD_ILLEGAL);
+#else
+    /* Exception: Illegal op-code execute_table()
+     */
+    set_state(CPU_EXCEPTION);
+    active->cpu.exception_line_num = __LINE__;
+#endif
+}
+
+static const op_handler_t op_handlers_page2[256] =
+{
+    [0 ... 255] = op_illegal,
+    OP_CODES_PAGE2(ENTRY_PAGE2)
+};
+
+static const op_handler_t op_handlers_page3[256] =
+{
+    [0 ... 255] = op_illegal,
+    OP_CODES_PAGE3(ENTRY_PAGE3)
+};
+
+static void op_page2(int *cycles, int *bytes)
 {
-    uint16_t result;
+    int     op_code;
 
-    result = (acc + byte);
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(acc, byte, result);
-    eval_cc_h(acc, byte, result);
+    *cycles = CYCLES(op_code_page2[op_code]);
+    *bytes = op_code_page2[op_code].bytes;
 
-    return (uint8_t) result;
+    op_handlers_page2[op_code](cycles, bytes);
 }
 
-/*------------------------------------------------
- * addd()
- *
- *  Add 16-bit operand to Acc-D
- *
- *  acc+word
- */
-static void addd(uint16_t word)
+static void op_page3(int *cycles, int *bytes)
 {
-    uint16_t acc;
-    uint32_t result;
+    int     op_code;
 
-    acc = (cpu.a << 8) + cpu.b;
-    result = acc + word;
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
 
-    cpu.a = result >> 8;
-    cpu.b = result & 0xff;
+    *cycles = CYCLES(op_code_page3[op_code]);
+    *bytes = op_code_page3[op_code].bytes;
 
-    eval_cc_c16(result);
-    eval_cc_z16(result);
-    eval_cc_v16(acc, word, result);
-    eval_cc_n16(result);
+    op_handlers_page3[op_code](cycles, bytes);
 }
 
+static const op_handler_t op_handlers_page1[256] =
+{
+    [0 ... 255] = op_illegal,
+    [0x10] = op_page2,
+    [0x11] = op_page3,
+    OP_CODES_PAGE1(ENTRY_PAGE1)
+};
+
 /*------------------------------------------------
- * and()
+ * execute_table()
  *
- *  Logical AND accumulator with byte operand.
+ *  Fetch and execute one instruction through the
+ *  op-code handler function tables.
  *
+ *  param:  Pointer to command cycles and bytes count
+ *  return: Nothing
  */
-static uint8_t and(uint8_t acc, uint8_t byte)
+static void execute_table(int *cycles, int *bytes)
 {
-    uint8_t result;
+    int     op_code;
 
-    result = (acc & byte);
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
 
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
-    cc.v = CC_FLAG_CLR;
+    *cycles = CYCLES(machine_code[op_code]);
+    *bytes = machine_code[op_code].bytes;
 
-    return result;
+    op_handlers_page1[op_code](cycles, bytes);
 }
+#endif  /* CPU_DISPATCH == CPU_DISPATCH_TABLE */
 
+#if (CPU_DISPATCH == CPU_DISPATCH_GOTO)
 /*------------------------------------------------
- * andcc()
+ * execute_goto()
  *
- *  Logical AND condition-code register with operand.
+ *  Fetch and execute one instruction through computed-goto
+ *  label tables (GCC 'labels as values' extension).
+ *  One label is generated per op-code from the op-code lists
+ *  in mc6809e_ops.h, and each label combines the op-code's
+ *  effective address function and operation.
  *
+ *  param:  Pointer to command cycles and bytes count
+ *  return: Nothing
  */
-static void andcc(uint8_t byte)
-{
-    uint8_t temp_cc;
+#define     LABEL_PAGE1(op_code, operation, mode)       [op_code] = &&p1_##op_code,
+#define     LABEL_PAGE2(op_code, operation, mode)       [op_code] = &&p2_##op_code,
+#define     LABEL_PAGE3(op_code, operation, mode)       [op_code] = &&p3_##op_code,
 
-    temp_cc = get_cc();
-    temp_cc &= byte;
-    set_cc(temp_cc);
-}
+#define     BODY(page, op_code, operation, mode) \
+    page##_##op_code: \
+        op_##operation(ea_##mode(cycles, bytes), cycles); \
+        return;
 
-/*------------------------------------------------
- * asl()
- *
- *  Arithmetic shift left.
- *
- *  'byte' shift left, MSB into carry flag.
- */
-static uint8_t asl(uint8_t byte)
+#define     BODY_PAGE1(op_code, operation, mode)        BODY(p1, op_code, operation, mode)
+#define     BODY_PAGE2(op_code, operation, mode)        BODY(p2, op_code, operation, mode)
+#define     BODY_PAGE3(op_code, operation, mode)        BODY(p3, op_code, operation, mode)
+
+static void execute_goto(int *cycles, int *bytes)
 {
-    uint16_t result;
+    static const void * const labels_page1[256] =
+    {
+        [0 ... 255] = &&illegal,
+        [0x10] = &&page2,
+        [0x11] = &&page3,
+        OP_CODES_PAGE1(LABEL_PAGE1)
+    };
 
-    result = ((uint16_t) byte) << 1;
+    static const void * const labels_page2[256] =
+    {
+        [0 ... 255] = &&illegal,
+        OP_CODES_PAGE2(LABEL_PAGE2)
+    };
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(byte, byte, result);
+    static const void * const labels_page3[256] =
+    {
+        [0 ... 255] = &&illegal,
+        OP_CODES_PAGE3(LABEL_PAGE3)
+    };
 
-    return (uint8_t) result;
+    int     op_code;
+
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    *cycles = CYCLES(machine_code[op_code]);
+    *bytes = machine_code[op_code].bytes;
+
+    goto *labels_page1[op_code];
+
+page2:
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    *cycles = CYCLES(op_code_page2[op_code]);
+    *bytes = op_code_page2[op_code].bytes;
+
+    goto *labels_page2[op_code];
+
+page3:
+    op_code = MEM_READ(active->cpu.pc);
+    active->cpu.pc++;
+
+    *cycles = CYCLES(op_code_page3[op_code]);
+    *bytes = op_code_page3[op_code].bytes;
+
+    goto *labels_page3[op_code];
+
+    OP_CODES_PAGE1(BODY_PAGE1)
+    OP_CODES_PAGE2(BODY_PAGE2)
+    OP_CODES_PAGE3(BODY_PAGE3)
+
+illegal:
+#if (CPU_6309)
+    *cycles = trap(MD_ILLEGAL);
+#else
+    /* Exception: Illegal op-code execute_goto()
+     */
+    set_state(CPU_EXCEPTION);
+    active->cpu.exception_line_num = __LINE__;
+#endif
 }
+#endif  /* CPU_DISPATCH == CPU_DISPATCH_GOTO */
 
+#if (PREDECODE)
 /*------------------------------------------------
- * asr()
- *
- *  Arithmetic shift right.
- *
- *  'byte' shift right, MSB replicated b7, LSB into carry flag.
+ * Predecoded instruction cache.
+ *
+ *  Instructions are decoded once into a cache entry that holds
+ *  the op-code operation, the effective address recipe, the next PC,
+ *  and the cycle and byte counts. Later executions of the same
+ *  address skip the op-code and operand fetch and the decode.
+ *  An entry is valid while the write version of its memory page
+ *  is unchanged. The instruction bytes are marked as code in the memory
+ *  module, and writes to code bytes advance the page version, so
+ *  self-modifying code invalidates the page's entries. Instructions
+ *  in IO pages or crossing a page boundary are not cached, and run
+ *  through the dispatch engine.
  */
-static uint8_t asr(uint8_t byte)
+#define     MODE_inh                ADDR_INHERENT
+#define     MODE_dir                ADDR_DIRECT
+#define     MODE_ext                ADDR_EXTENDED
+#define     MODE_imm                ADDR_IMMEDIATE
+#define     MODE_limm               ADDR_LIMMEDIATE
+#define     MODE_idx                ADDR_INDEXED
+#define     MODE_rel                ADDR_RELATIVE
+#define     MODE_lrel               ADDR_LRELATIVE
+#define     MODE_imdir              ADDR_IMDIRECT
+#define     MODE_imidx              ADDR_IMINDEXED
+#define     MODE_imext              ADDR_IMEXTENDED
+#define     MODE_qimm               ADDR_QIMMEDIATE
+
+#define     RECIPE(op_code, operation, mode)    [op_code] = { op_##operation, MODE_##mode },
+
+static const op_recipe_t op_recipes_page1[256] =
 {
-    uint8_t result;
+    OP_CODES_PAGE1(RECIPE)
+};
 
-    result = (byte >> 1) | (byte & 0x80);
+static const op_recipe_t op_recipes_page2[256] =
+{
+    OP_CODES_PAGE2(RECIPE)
+};
 
-    cc.c = byte & 0x01 ? CC_FLAG_SET : CC_FLAG_CLR;
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
+static const op_recipe_t op_recipes_page3[256] =
+{
+    OP_CODES_PAGE3(RECIPE)
+};
 
-    return result;
-}
+#if (CPU_DISPATCH == CPU_DISPATCH_TABLE)
+#define     EXECUTE_ENGINE(c, b)    execute_table(c, b)
+#else
+#define     EXECUTE_ENGINE(c, b)    execute_goto(c, b)
+#endif
 
 /*------------------------------------------------
- * bit()
+ * execute_predecoded()
  *
- *  Bit test accumulator with operand by AND
- *  without changing accumulator.
- *  Change flag bit appropriately.
+ *  Fetch and execute one instruction through the predecoded
+ *  instruction cache. Decode the instruction on a cache miss,
+ *  or execute it through the dispatch engine if it cannot be cached.
  *
- *  acc AND byte
+ *  param:  Pointer to command cycles and bytes count
+ *  return: Nothing
  */
-static void bit(uint8_t acc, uint8_t byte)
+static void execute_predecoded(int *cycles, int *bytes)
 {
-    uint8_t result;
+    predecode_t    *entry;
 
-    result = acc & byte;
+    entry = &active->predecode_cache[active->cpu.pc & PREDECODE_MASK];
 
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
-    cc.v = CC_FLAG_CLR;
+    if ( entry->pc == active->cpu.pc &&
+         entry->version == active->page_versions[active->cpu.pc / MEM_PAGE_SIZE] )
+    {
+        active->predecode_stats.hits++;
+    }
+    else if ( predecode(entry, active->cpu.pc) )
+    {
+        active->predecode_stats.misses++;
+    }
+    else
+    {
+        active->predecode_stats.uncached++;
+        EXECUTE_ENGINE(cycles, bytes);
+        return;
+    }
+
+    execute_entry(entry, cycles, bytes);
 }
 
 /*------------------------------------------------
- * clr()
+ * indexed_address()
  *
- *  Clear (zero) bits in operand.
- *  Change flag bit appropriately.
+ *  Effective address of a predecoded indexed instruction.
+ *  Same as get_eff_addr() with the offset and cycles
+ *  resolved by predecode(). Modifies the index register
+ *  of auto increment and decrement modes.
  *
+ *  param:  Pointer to predecoded instruction
+ *  return: Effective address
  */
-static uint8_t clr(void)
+static inline uint16_t indexed_address(predecode_t *entry)
 {
-    cc.c = CC_FLAG_CLR;
-    cc.v = CC_FLAG_CLR;
-    cc.z = CC_FLAG_SET;
-    cc.n = CC_FLAG_CLR;
+    const index_decode_t   *index;
+    uint16_t               *index_reg;
+    uint16_t                effective_addr;
 
-    return 0;
+    index = &index_decode[entry->post_byte];
+    index_reg = (uint16_t *)((uint8_t *) &active->cpu + index->reg);
+
+    switch ( index->offset )
+    {
+        case INDX_OFFSET_NONE:
+            effective_addr = *index_reg;
+            break;
+
+        case INDX_OFFSET_POST_INC:
+            effective_addr = *index_reg;
+            (*index_reg) += index->inc_dec;
+            break;
+
+        case INDX_OFFSET_PRE_DEC:
+            (*index_reg) += index->inc_dec;
+            effective_addr = *index_reg;
+            break;
+
+        case INDX_OFFSET_ACCB:
+            effective_addr = *index_reg + SIG_EXTEND(active->cpu.b);
+            break;
+
+        case INDX_OFFSET_ACCA:
+            effective_addr = *index_reg + SIG_EXTEND(active->cpu.a);
+            break;
+
+        case INDX_OFFSET_ACCD:
+            effective_addr = *index_reg + active->cpu.d;
+            break;
+
+#if (CPU_6309)
+        case INDX_OFFSET_ACCE:
+            effective_addr = *index_reg + SIG_EXTEND(active->cpu.e);
+            break;
+
+        case INDX_OFFSET_ACCF:
+            effective_addr = *index_reg + SIG_EXTEND(active->cpu.f);
+            break;
+
+        case INDX_OFFSET_ACCW:
+            effective_addr = *index_reg + active->cpu.w;
+            break;
+#endif
+
+        case INDX_OFFSET_PC8:
+        case INDX_OFFSET_PC16:
+        case INDX_OFFSET_EXTENDED:
+            effective_addr = entry->operand;
+            break;
+
+        default: // 5-bit, 8-bit and 16-bit offsets
+            effective_addr = *index_reg + entry->operand;
+    }
+
+    if ( index->indirect )
+    {
+        effective_addr = MEM_READ16(effective_addr);
+    }
+
+    return effective_addr;
 }
 
 /*------------------------------------------------
- * cmp()
+ * execute_entry()
  *
- *  Compare 'arg' to 'byte' by subtracting
- *  the byte from the argument and updating the
- *  flags.
+ *  Execute a predecoded instruction. Resolve the effective
+ *  address from the entry's recipe and call the operation.
  *
+ *  param:  Pointer to predecoded instruction,
+ *          pointer to command cycles and bytes count
+ *  return: Nothing
  */
-static void cmp(uint8_t arg, uint8_t byte)
+static inline void execute_entry(predecode_t *entry, int *cycles, int *bytes)
 {
-    uint16_t result;
+    uint16_t                effective_addr;
 
-    result = arg - byte;
+    active->cpu.pc = entry->next_pc;
+    *cycles = entry->cycles;
+    *bytes = entry->bytes;
+#if (CPU_6309)
+    active->immediate = entry->immediate;
+#endif
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(arg, ~byte, result);
+    switch ( entry->ea_recipe )
+    {
+        case EA_DIRECT:
+            effective_addr = (active->cpu.dp << 8) + entry->operand;
+            break;
+
+        case EA_INDEXED:
+            effective_addr = indexed_address(entry);
+            break;
+
+        default:
+            effective_addr = entry->operand;
+    }
+
+    entry->operation(effective_addr, cycles);
 }
 
 /*------------------------------------------------
- * cmp16()
+ * predecode()
  *
- *  Compare 'arg' to 'word' by subtracting
- *  the a 16-bit value from the argument and updating the
- *  flags.
+ *  Decode the instruction at an address into a predecoded
+ *  instruction cache entry. The entry is left empty if the
+ *  instruction cannot be cached: it is in an IO page, crosses
+ *  a page boundary, or has an illegal op-code or index mode.
  *
+ *  param:  Pointer to cache entry, instruction address
+ *  return: '1' if decoded, '0' if the instruction cannot be cached
  */
-static void cmp16(uint16_t arg, uint16_t word)
+static int predecode(predecode_t *entry, int address)
 {
-    uint32_t result;
+    const op_recipe_t      *recipe;
+    const index_decode_t   *index;
+    int                     op_code, cycles, bytes, post_byte = 0;
+    int                     pc, mode;
+    uint16_t                operand = 0;
+    int                     ea_recipe = EA_CONSTANT;
+#if (CPU_6309)
+    uint8_t                 immediate = 0;
+#endif
 
-    result = arg - word;
+    entry->pc = -1;
 
-    eval_cc_c16(result);
-    eval_cc_z16(result);
-    eval_cc_v16(arg, ~word, result);
-    eval_cc_n16(result);
+    if ( mem_ctx_page_is_io(active->mem, address / MEM_PAGE_SIZE) )
+        return 0;
+
+    pc = address;
+    op_code = MEM_READ(pc++);
+
+    if ( op_code == 0x10 )
+    {
+        op_code = MEM_READ(pc++);
+        recipe = &op_recipes_page2[op_code];
+        cycles = CYCLES(op_code_page2[op_code]);
+        bytes = op_code_page2[op_code].bytes;
+    }
+    else if ( op_code == 0x11 )
+    {
+        op_code = MEM_READ(pc++);
+        recipe = &op_recipes_page3[op_code];
+        cycles = CYCLES(op_code_page3[op_code]);
+        bytes = op_code_page3[op_code].bytes;
+    }
+    else
+    {
+        recipe = &op_recipes_page1[op_code];
+        cycles = CYCLES(machine_code[op_code]);
+        bytes = machine_code[op_code].bytes;
+    }
+
+    if ( recipe->operation == 0 )
+        return 0;
+
+    mode = recipe->mode;
+
+#if (CPU_6309)
+    /* HD6309 immediate byte ahead of the memory operand
+     */
+    if ( mode == ADDR_IMDIRECT || mode == ADDR_IMINDEXED || mode == ADDR_IMEXTENDED )
+    {
+        immediate = MEM_READ(pc++);
+
+        if ( mode == ADDR_IMDIRECT )
+            mode = ADDR_DIRECT;
+        else if ( mode == ADDR_IMINDEXED )
+            mode = ADDR_INDEXED;
+        else
+            mode = ADDR_EXTENDED;
+    }
+#endif
+
+    switch ( mode )
+    {
+        case ADDR_DIRECT:
+            operand = MEM_READ(pc++);
+            ea_recipe = EA_DIRECT;
+            break;
+
+        case ADDR_EXTENDED:
+            operand = MEM_READ16(pc);
+            pc += 2;
+            break;
+
+        case ADDR_IMMEDIATE:
+            operand = pc;
+            pc += 1;
+            break;
+
+        case ADDR_LIMMEDIATE:
+            operand = pc;
+            pc += 2;
+            break;
+
+        case ADDR_QIMMEDIATE:
+            operand = pc;
+            pc += 4;
+            break;
+
+        case ADDR_RELATIVE:
+            operand = SIG_EXTEND(MEM_READ(pc));
+            pc += 1;
+            operand += pc;
+            break;
+
+        case ADDR_LRELATIVE:
+            operand = MEM_READ16(pc);
+            pc += 2;
+            operand += pc;
+            break;
+
+        case ADDR_INDEXED:
+            post_byte = MEM_READ(pc++);
+            ea_recipe = EA_INDEXED;
+
+            /* Resolve offsets and cycle counts of get_eff_addr()
+             */
+            index = &index_decode[post_byte];
+
+            switch ( index->offset )
+            {
+                case INDX_OFFSET_5BIT:
+                    operand = index->offset5;
+                    break;
+
+                case INDX_OFFSET_8BIT:
+                    operand = SIG_EXTEND(MEM_READ(pc));
+                    break;
+
+                case INDX_OFFSET_16BIT:
+                case INDX_OFFSET_EXTENDED:
+                    operand = MEM_READ16(pc);
+                    break;
+
+                case INDX_OFFSET_PC8:
+                    operand = SIG_EXTEND(MEM_READ(pc)) + pc + 1;
+                    break;
+
+                case INDX_OFFSET_PC16:
+                    operand = MEM_READ16(pc) + pc + 2;
+                    break;
+
+                case INDX_OFFSET_ILLEGAL:
+                    /* Illegal index mode, the dispatch engine
+                     * will raise the exception.
+                     */
+                    return 0;
+            }
+
+            pc += index->bytes;
+            cycles += index->cycles;
+            bytes += index->bytes;
+            break;
+    }
+
+    /* The instruction must be within one page so that
+     * the page write version covers all of its bytes
+     */
+    if ( (address / MEM_PAGE_SIZE) != ((pc - 1) / MEM_PAGE_SIZE) )
+        return 0;
+
+    mem_ctx_mark_code(active->mem, address, pc - 1);
+
+    entry->version = active->page_versions[address / MEM_PAGE_SIZE];
+    entry->operation = recipe->operation;
+    entry->next_pc = (uint16_t) pc;
+    entry->operand = operand;
+    entry->ea_recipe = ea_recipe;
+    entry->post_byte = post_byte;
+    entry->cycles = cycles;
+    entry->bytes = bytes;
+#if (CPU_6309)
+    entry->immediate = immediate;
+#endif
+    entry->pc = address;
+
+    return 1;
 }
+#endif  /* PREDECODE */
 
+#if (TRANSLATE)
 /*------------------------------------------------
- * com()
+ * Basic block translation.
+ *
+ *  A block start address that is executed BLOCK_HOT_COUNT times
+ *  is translated into an array of predecoded instructions, up to
+ *  and including the first unconditional change of flow, the end of
+ *  the memory page, or BLOCK_INSTRUCTIONS instructions.
+ *  execute_block() runs the array without per-instruction fetch,
+ *  decode and run_instruction() processing, and exits to the
+ *  interpreter loop after any instruction that:
+ *    - changes flow away from the next instruction in the block
+ *    - uses up the cycle budget or reaches the break point
+ *    - changes an interrupt line, or makes an interrupt serviceable
+ *    - changes the CPU state (SYNC, CWAI, exception), or asserts RESET or HALT
+ *    - accesses an IO address
+ *    - writes to code in the block's memory page
+ *  so cycle counts and interrupt timing are the same as instruction
+ *  by instruction execution.
+ */
+
+/*------------------------------------------------
+ * block_lookup()
  *
- *  Complement (bit-wise NOT) a byte.
+ *  Find the translated block that starts at an address.
+ *  Count executions of block start addresses, and translate
+ *  the block when it becomes hot.
  *
- *  ~byte
+ *  param:  Block start address
+ *  return: Pointer to translated block, '0' if none
  */
-static uint8_t com(uint8_t byte)
+static block_t *block_lookup(int address)
 {
-    uint8_t result;
+    block_t    *block;
 
-    result = ~byte;
+    block = &active->block_cache[address & BLOCK_MASK];
 
-    cc.c = CC_FLAG_SET;
-    cc.v = CC_FLAG_CLR;
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
+    if ( block->pc != address ||
+         block->version != active->page_versions[address / MEM_PAGE_SIZE] )
+    {
+        block->pc = address;
+        block->version = active->page_versions[address / MEM_PAGE_SIZE];
+        block->count = 0;
+        block->length = 0;
+#if (NATIVE)
+        block->native = 0;
+#endif
+    }
 
-    return result;
+    if ( block->length > 0 )
+        return block;
+
+    if ( block->length < 0 )
+        return 0;
+
+    block->count++;
+    if ( block->count < BLOCK_HOT_COUNT )
+        return 0;
+
+    block->length = translate_block(block, address);
+    if ( block->length == 0 )
+    {
+        block->length = -1;
+        return 0;
+    }
+
+    active->predecode_stats.blocks++;
+
+#if (NATIVE)
+    block->native = native_translate(block);
+#endif
+
+    return block;
 }
 
 /*------------------------------------------------
- * cwai()
+ * translate_block()
  *
- *  This instruction logically ANDs the contents of the Condition Codes register with the 8-
- *  bit value specified by the immediate operand. The result is placed back into the
- *  Condition Codes register. The E flag in the CC register is then set and the entire machine
- *  state is pushed onto the hardware stack (S). The CPU then halts execution and waits for
- *  an unmasked interrupt to occur. When such an interrupt occurs, the CPU resumes
- *  execution at the address obtained from the corresponding interrupt vector.
+ *  Translate a basic block into an array of predecoded instructions.
  *
+ *  param:  Pointer to block, block start address
+ *  return: Number of instructions in the block
  */
-static void cwai(uint8_t byte)
+static int translate_block(block_t *block, int address)
 {
-    uint8_t temp_cc;
+    predecode_t    *entry;
+    int             length = 0;
+    int             pc = address;
+#if (FUSION)
+    int             i;
+#endif
+
+    while ( length < BLOCK_INSTRUCTIONS &&
+            (pc / MEM_PAGE_SIZE) == (address / MEM_PAGE_SIZE) )
+    {
+        entry = &block->code[length];
+
+        if ( !predecode(entry, pc) )
+            break;
+
+        pc = entry->next_pc;
+        length++;
+
+        /* Unconditional change of flow ends the block
+         */
+        if ( entry->operation == op_bra  || entry->operation == op_lbra ||
+             entry->operation == op_bsr  || entry->operation == op_lbsr ||
+             entry->operation == op_jmp  || entry->operation == op_jsr  ||
+             entry->operation == op_rts  || entry->operation == op_rti  ||
+             entry->operation == op_swi  || entry->operation == op_swi2 ||
+             entry->operation == op_swi3 || entry->operation == op_sync ||
+             entry->operation == op_cwai )
+            break;
+
+#if (CPU_6309)
+        /* LDMD can empty the block cache when it changes mode
+         */
+        if ( entry->operation == op_ldmd )
+            break;
+#endif
+    }
 
-    temp_cc = get_cc();
-    temp_cc &= byte;
-    temp_cc |= 0x80;
-    set_cc(temp_cc);
+    /* Mark fused instruction pairs, a pair's second
+     * instruction does not start another pair
+     */
+#if (FUSION)
+    memset(block->fusion, FUSION_NONE, sizeof(block->fusion));
 
-    cpu.s--;
-    mem_write(cpu.s, cpu.pc & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.u & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.u >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.y & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.y >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.x & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.x >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.dp);
-    cpu.s--;
-    mem_write(cpu.s, cpu.b);
-    cpu.s--;
-    mem_write(cpu.s, cpu.a);
-    cpu.s--;
-    mem_write(cpu.s, temp_cc);
-
-    cpu.cpu_state = CPU_SYNC;
+    for ( i = 0; i < length - 1; i++ )
+    {
+        block->fusion[i] = fusion_match(&block->code[i], &block->code[i + 1]);
+        if ( block->fusion[i] != FUSION_NONE )
+            i++;
+    }
+#endif
+
+#if (IDLE_SKIP)
+    block->idle = idle_match(block, length);
+#endif
+
+    return length;
 }
 
 /*------------------------------------------------
- * daa()
+ * execute_block()
  *
- *  Decimal adjust accumulator A
+ *  Run a translated block until its end, or until an
+ *  instruction requires the interpreter loop.
  *
+ *  param:  Pointer to block, cycle budget
+ *  return: Cycles used
  */
-static void daa(void)
+static int execute_block(block_t *block, int cycle_budget)
 {
-    uint16_t    temp;
-    uint16_t    high_nibble;
-    uint16_t    low_nibble;
+    predecode_t    *entry = block->code;
+    predecode_t    *last = &block->code[block->length - 1];
+    uint32_t        io_count = *active->io_accesses;
+    int             cycles_used = 0;
+    int             cycles, bytes;
+#if (FUSION)
+    uint8_t        *fusion = block->fusion;
+#endif
+
+#if (NATIVE)
+    if ( block->native )
+        return execute_native(block, cycle_budget);
+#endif
+
+    for (;;)
+    {
+        active->cpu.last_pc = active->cpu.pc;
 
-    temp = cpu.a;
-    high_nibble = temp & 0xf0;
-    low_nibble = temp & 0x0f;
+#if (FUSION)
+        /* Run a fused pair if the budget and break point
+         * would not stop execution after its first instruction
+         */
+        if ( *fusion != FUSION_NONE &&
+             (cycles_used + entry->cycles) < cycle_budget &&
+             entry->next_pc != active->break_point )
+        {
+            if ( fused_handlers[*fusion](entry) == 2 )
+            {
+                cycles_used += entry->cycles;
+                active->cpu.cycles += entry->cycles;
+                active->predecode_stats.translated++;
+#if (PROFILE)
+                profile_count(entry->pc, entry->cycles);
+#endif
+                active->fusion_fired[*fusion]++;
+                entry++;
+                fusion++;
+                active->cpu.last_pc = entry->pc;
+            }
 
-    if ( low_nibble > 0x09 || cc.h )
-        temp += 0x06;
-    if ( high_nibble > 0x80 && low_nibble > 0x09 )
-        temp += 0x60;
-    if (high_nibble > 0x90 || cc.c)
-        temp += 0x60;
+            cycles = entry->cycles;
+            bytes = entry->bytes;
+        }
+        else
+#endif
+        execute_entry(entry, &cycles, &bytes);
+
+        cycles_used += cycles;
+        active->cpu.cycles += cycles;
+        active->predecode_stats.translated++;
+#if (PROFILE)
+        profile_count(entry->pc, cycles);
+#endif
+
+        if ( entry == last ||
+             active->cpu.pc != entry->next_pc ||
+             cycles_used >= cycle_budget ||
+             active->cpu.pc == active->break_point ||
+             active->int_line_change ||
+             *active->io_accesses != io_count ||
+             block->version != active->page_versions[block->pc / MEM_PAGE_SIZE] ||
+             EVENT_PENDING() )
+            break;
 
-    cpu.a = temp;
+        entry++;
+#if (FUSION)
+        fusion++;
+#endif
+    }
 
-    eval_cc_c(temp);
-    eval_cc_z(temp);
-    eval_cc_n(temp);
-    cc.v = CC_FLAG_CLR;
+    active->cpu.last_opcode_bytes = bytes;
+    active->cpu.last_opcode_cycles = cycles;
+
+    return cycles_used;
 }
+#endif  /* TRANSLATE */
 
+#if (NATIVE)
 /*------------------------------------------------
- * dec()
+ * x86-64 host code of translated blocks.
+ *
+ *  native_translate() compiles a translated block into x86-64 machine
+ *  code in the block cache entry's slot of host code. The code is called
+ *  with the cycle budget and the CPU context, and keeps the cycles used
+ *  in ebx, the budget in r12d and the context in r13. For each instruction
+ *  it does what execute_entry() and execute_block() do, with the entry's
+ *  addresses, cycles, bytes and operand as constants:
+ *    - store the instruction address in 'last_pc', and the next
+ *      instruction address in 'pc'
+ *    - compute the effective address: a constant, DP and the direct page
+ *      offset, or a call to native_indexed() for indexed modes
+ *    - call the op-code's operation with the effective address and
+ *      a pointer to the cycle count on the host stack
+ *    - add the cycles to the cycles used and the cycle counter, and set
+ *      the last instruction cycles and bytes
+ *    - check the stop conditions of execute_block(), and leave the block
+ *      if one of them is met: a change of flow, the break point, an
+ *      interrupt line change, an IO access, a write to the block's memory
+ *      page, an event that needs run_instruction(), or the end of the budget
+ *
+ *  The stop conditions are the same as execute_block(), so cycle counts,
+ *  interrupt timing, IO accesses and writes to code leave the block at
+ *  the same instruction. Fused pairs run as two instructions.
+ *  The host code slots are allocated with mmap() on the first
+ *  translation. If the host does not allow executable memory,
+ *  blocks run with execute_block().
+ */
+
+/*------------------------------------------------
+ * native_translate()
  *
- *  Decrement the operand.
+ *  Compile a translated block into x86-64 host code.
  *
- *  byte = byte - 1
+ *  param:  Pointer to translated block
+ *  return: Pointer to host code, '0' if none
  */
-static uint8_t dec(uint8_t byte)
+static native_block_t native_translate(block_t *block)
 {
-    uint16_t result;
+    static const uint8_t prologue[] = { 0x53,                   // push rbx
+                                        0x41, 0x54,             // push r12
+                                        0x41, 0x55,             // push r13
+                                        0x48, 0x83, 0xec, 0x10, // sub  rsp, 16
+                                        0x41, 0x89, 0xfc,       // mov  r12d, edi
+                                        0x49, 0x89, 0xf5,       // mov  r13, rsi
+                                        0x31, 0xdb };           // xor  ebx, ebx
+    static const uint8_t epilogue[] = { 0x89, 0xd8,             // mov  eax, ebx
+                                        0x48, 0x83, 0xc4, 0x10, // add  rsp, 16
+                                        0x41, 0x5d,             // pop  r13
+                                        0x41, 0x5c,             // pop  r12
+                                        0x5b,                   // pop  rbx
+                                        0xc3 };                 // ret
+
+    /* Op-code and ModRM bytes of the [r13+disp32] operands
+     */
+    static const uint8_t mov_m16_imm[] = { 0x66, 0x41, 0xc7, 0x85 };    // mov  word [r13+d], imm16
+#if (CPU_6309)
+    static const uint8_t mov_m8_imm[] =  { 0x41, 0xc6, 0x85 };          // mov  byte [r13+d], imm8
+#endif
+    static const uint8_t movzx_edi_m8[] = { 0x41, 0x0f, 0xb6, 0xbd };   // movzx edi, byte [r13+d]
+    static const uint8_t add_m64_rax[] = { 0x49, 0x01, 0x85 };          // add  [r13+d], rax
+    static const uint8_t mov_m32_eax[] = { 0x41, 0x89, 0x85 };          // mov  [r13+d], eax
+    static const uint8_t mov_m32_imm[] = { 0x41, 0xc7, 0x85 };          // mov  dword [r13+d], imm32
+    static const uint8_t add_m64_imm8[] = { 0x49, 0x83, 0x85 };         // add  qword [r13+d], imm8
+    static const uint8_t cmp_m16_imm[] = { 0x66, 0x41, 0x81, 0xbd };    // cmp  word [r13+d], imm16
+    static const uint8_t cmp_m32_imm[] = { 0x41, 0x81, 0xbd };          // cmp  dword [r13+d], imm32
+    static const uint8_t cmp_m32_imm8[] = { 0x41, 0x83, 0xbd };         // cmp  dword [r13+d], imm8
+    static const uint8_t mov_rax_m64[] = { 0x49, 0x8b, 0x85 };          // mov  rax, [r13+d]
+    static const uint8_t cmp_eax_m32[] = { 0x41, 0x3b, 0x85 };          // cmp  eax, [r13+d]
+
+    static const uint8_t shl_edi_8[] =   { 0xc1, 0xe7, 0x08 };          // shl  edi, 8
+    static const uint8_t lea_rsi_rsp[] = { 0x48, 0x8d, 0x34, 0x24 };    // lea  rsi, [rsp]
+    static const uint8_t call_rax[] =    { 0xff, 0xd0 };                // call rax
+    static const uint8_t mov_eax_rsp[] = { 0x8b, 0x04, 0x24 };          // mov  eax, [rsp]
+    static const uint8_t add_ebx_eax[] = { 0x01, 0xc3 };                // add  ebx, eax
+    static const uint8_t mov_eax_rax[] = { 0x8b, 0x00 };                // mov  eax, [rax]
+    static const uint8_t test_eax_eax[] = { 0x85, 0xc0 };               // test eax, eax
+    static const uint8_t cmp_ebx_r12d[] = { 0x44, 0x39, 0xe3 };         // cmp  ebx, r12d
+
+    uint8_t        *start, *code, *skip;
+    uint8_t        *exits[NATIVE_EXITS * BLOCK_INSTRUCTIONS];
+    int             exit_count = 0;
+    predecode_t    *entry;
+    void           *slots;
+    int             i;
+
+    if ( active->native_code == 0L )
+    {
+        if ( active->native_failed )
+            return 0;
 
-    result = byte - 1;
+        slots = mmap(0L, BLOCK_ENTRIES * NATIVE_SLOT_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if ( slots == MAP_FAILED )
+        {
+            active->native_failed = 1;
+            return 0;
+        }
 
-    eval_cc_v(byte, 0xfe, result);
-    eval_cc_z(result);
-    eval_cc_n(result);
+        active->native_code = (uint8_t *) slots;
+    }
 
-    return (uint8_t) result;
+    start = &active->native_code[(block - active->block_cache) * NATIVE_SLOT_SIZE];
+    code = emit_bytes(start, prologue, sizeof(prologue));
+
+    for ( i = 0; i < block->length; i++ )
+    {
+        entry = &block->code[i];
+
+        /* Instruction addresses, immediate byte and cycles
+         */
+        code = emit_ctx(code, mov_m16_imm, sizeof(mov_m16_imm), offsetof(cpu_context_t, cpu.last_pc));
+        code = emit_imm(code, entry->pc, 2);
+        code = emit_ctx(code, mov_m16_imm, sizeof(mov_m16_imm), offsetof(cpu_context_t, cpu.pc));
+        code = emit_imm(code, entry->next_pc, 2);
+#if (CPU_6309)
+        code = emit_ctx(code, mov_m8_imm, sizeof(mov_m8_imm), offsetof(cpu_context_t, immediate));
+        code = emit_imm(code, entry->immediate, 1);
+#endif
+        *code++ = 0xc7;                                         // mov  dword [rsp], imm32
+        *code++ = 0x04;
+        *code++ = 0x24;
+        code = emit_imm(code, entry->cycles, 4);
+
+        /* Effective address in edi
+         */
+        switch ( entry->ea_recipe )
+        {
+            case EA_DIRECT:
+                code = emit_ctx(code, movzx_edi_m8, sizeof(movzx_edi_m8), offsetof(cpu_context_t, cpu.dp));
+                code = emit_bytes(code, shl_edi_8, sizeof(shl_edi_8));
+                *code++ = 0x81;                                 // add  edi, imm32
+                *code++ = 0xc7;
+                code = emit_imm(code, entry->operand, 4);
+                break;
+
+            case EA_INDEXED:
+                *code++ = 0x48;                                 // mov  rdi, imm64
+                *code++ = 0xbf;
+                code = emit_imm(code, (uint64_t) entry, 8);
+                *code++ = 0x48;                                 // mov  rax, imm64
+                *code++ = 0xb8;
+                code = emit_imm(code, (uint64_t) native_indexed, 8);
+                code = emit_bytes(code, call_rax, sizeof(call_rax));
+                *code++ = 0x89;                                 // mov  edi, eax
+                *code++ = 0xc7;
+                break;
+
+            default:
+                *code++ = 0xbf;                                 // mov  edi, imm32
+                code = emit_imm(code, entry->operand, 4);
+        }
+
+        /* Operation, and cycle counts
+         */
+        code = emit_bytes(code, lea_rsi_rsp, sizeof(lea_rsi_rsp));
+        *code++ = 0x48;                                         // mov  rax, imm64
+        *code++ = 0xb8;
+        code = emit_imm(code, (uint64_t) entry->operation, 8);
+        code = emit_bytes(code, call_rax, sizeof(call_rax));
+        code = emit_bytes(code, mov_eax_rsp, sizeof(mov_eax_rsp));
+        code = emit_bytes(code, add_ebx_eax, sizeof(add_ebx_eax));
+        code = emit_ctx(code, add_m64_rax, sizeof(add_m64_rax), offsetof(cpu_context_t, cpu.cycles));
+        code = emit_ctx(code, mov_m32_eax, sizeof(mov_m32_eax), offsetof(cpu_context_t, cpu.last_opcode_cycles));
+        code = emit_ctx(code, mov_m32_imm, sizeof(mov_m32_imm), offsetof(cpu_context_t, cpu.last_opcode_bytes));
+        code = emit_imm(code, entry->bytes, 4);
+        code = emit_ctx(code, add_m64_imm8, sizeof(add_m64_imm8), offsetof(cpu_context_t, predecode_stats.translated));
+        *code++ = 1;
+
+        if ( i == block->length - 1 )
+            break;
+
+        /* Stop conditions
+         */
+        code = emit_ctx(code, cmp_m16_imm, sizeof(cmp_m16_imm), offsetof(cpu_context_t, cpu.pc));
+        code = emit_imm(code, entry->next_pc, 2);
+        code = emit_exit(code, 0x85, exits, &exit_count);       // jne  exit
+
+        code = emit_ctx(code, cmp_m32_imm, sizeof(cmp_m32_imm), offsetof(cpu_context_t, break_point));
+        code = emit_imm(code, entry->next_pc, 4);
+        code = emit_exit(code, 0x84, exits, &exit_count);       // je   exit
+
+        code = emit_ctx(code, cmp_m32_imm8, sizeof(cmp_m32_imm8), offsetof(cpu_context_t, int_line_change));
+        *code++ = 0;
+        code = emit_exit(code, 0x85, exits, &exit_count);       // jne  exit
+
+        code = emit_ctx(code, mov_rax_m64, sizeof(mov_rax_m64), offsetof(cpu_context_t, io_accesses));
+        code = emit_bytes(code, mov_eax_rax, sizeof(mov_eax_rax));
+        code = emit_ctx(code, cmp_eax_m32, sizeof(cmp_eax_m32), offsetof(cpu_context_t, native_io_count));
+        code = emit_exit(code, 0x85, exits, &exit_count);       // jne  exit
+
+        code = emit_ctx(code, mov_rax_m64, sizeof(mov_rax_m64), offsetof(cpu_context_t, page_versions));
+        *code++ = 0x81;                                         // cmp  dword [rax+disp32], imm32
+        *code++ = 0xb8;
+        code = emit_imm(code, (block->pc / MEM_PAGE_SIZE) * sizeof(uint32_t), 4);
+        code = emit_imm(code, block->version, 4);
+        code = emit_exit(code, 0x85, exits, &exit_count);       // jne  exit
+
+        /* Pending events are rare, check them with a call
+         */
+        code = emit_ctx(code, cmp_m32_imm8, sizeof(cmp_m32_imm8), offsetof(cpu_context_t, events));
+        *code++ = 0;
+        *code++ = 0x74;                                         // je   skip
+        skip = code++;
+        *code++ = 0x48;                                         // mov  rax, imm64
+        *code++ = 0xb8;
+        code = emit_imm(code, (uint64_t) native_events, 8);
+        code = emit_bytes(code, call_rax, sizeof(call_rax));
+        code = emit_bytes(code, test_eax_eax, sizeof(test_eax_eax));
+        code = emit_exit(code, 0x85, exits, &exit_count);       // jne  exit
+        *skip = (uint8_t) (code - (skip + 1));
+
+        code = emit_bytes(code, cmp_ebx_r12d, sizeof(cmp_ebx_r12d));
+        code = emit_exit(code, 0x8d, exits, &exit_count);       // jge  exit
+    }
+
+    /* All exits jump to the epilogue
+     */
+    for ( i = 0; i < exit_count; i++ )
+    {
+        emit_imm(exits[i], (uint32_t) (code - (exits[i] + 4)), 4);
+    }
+
+    code = emit_bytes(code, epilogue, sizeof(epilogue));
+
+    __builtin___clear_cache((char *) start, (char *) code);
+
+    return (native_block_t) start;
 }
 
 /*------------------------------------------------
- * eor()
+ * execute_native()
  *
- *  Exclusive OR accumulator with operand.
+ *  Run the host code of a translated block.
  *
- *  acc ^ byte
+ *  param:  Pointer to block, cycle budget
+ *  return: Cycles used
  */
-static uint8_t eor(uint8_t acc, uint8_t byte)
+static int execute_native(block_t *block, int cycle_budget)
 {
-    uint8_t result;
+    active->native_io_count = *active->io_accesses;
 
-    result = acc ^ byte;
-
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
-    cc.v = CC_FLAG_CLR;
-
-    return result;
+    return block->native(cycle_budget, active);
 }
 
 /*------------------------------------------------
- * exg()
- *
- *  Exchange like-sized registers.
+ * native_indexed()
  *
- *  NOTE: The function relies on the assembler to not mix
- *  8-bit registers with 16-bit register, otherwise
- *  results are unexpected.
- *  Check: if (((regs ^ (regs << 4)) & 0x80) == 0) {...}
+ *  Effective address of an indexed instruction, called by host code.
  *
+ *  param:  Pointer to predecoded instruction
+ *  return: Effective address
  */
-static void exg(uint8_t regs)
+static int native_indexed(predecode_t *entry)
 {
-    int         src, dst;
-    uint16_t    temp1, temp2;
-
-    src = (int)((regs >> 4) & 0x0f);
-    dst = (int)(regs & 0x0f);
-
-    temp1 = read_register(src);
-    temp2 = read_register(dst);
-
-    write_register(dst, temp1);
-    write_register(src, temp2);
+    return indexed_address(entry);
 }
 
 /*------------------------------------------------
- * inc()
+ * native_events()
  *
- *  Increment the operand.
+ *  Check for events that need run_instruction(), called by
+ *  host code when the pending event word is not '0'.
  *
- *  byte = byte + 1
+ *  param:  Nothing
+ *  return: '1' leave the block, '0' continue
  */
-static uint8_t inc(uint8_t byte)
+static int native_events(void)
 {
-    uint16_t result;
-
-    result = byte + 1;
-
-    eval_cc_v(byte, 1, result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-
-    return (uint8_t) result;
+    return EVENT_PENDING() ? 1 : 0;
 }
 
 /*------------------------------------------------
- * lsr()
+ * emit_bytes()
  *
- *  Logic shift right.
+ *  Copy host code bytes.
  *
- *  'byte' shift right, MSB replicated with zero, LSB into carry flag.
+ *  param:  Code address, pointer to bytes, byte count
+ *  return: Code address after the bytes
  */
-static uint8_t lsr(uint8_t byte)
+static uint8_t *emit_bytes(uint8_t *code, const uint8_t *bytes, int length)
 {
-    uint8_t result;
+    memcpy(code, bytes, length);
 
-    result = (byte >> 1) & 0x7f;
-
-    cc.c = byte & 0x01 ? CC_FLAG_SET : CC_FLAG_CLR;
-    eval_cc_z((uint16_t) result);
-    cc.n = CC_FLAG_CLR;
-
-    return result;
+    return code + length;
 }
 
 /*------------------------------------------------
- * neg()
+ * emit_ctx()
  *
- *  Negate byte.
- *  Two's complement: ~byte+1
+ *  Emit an instruction with a [r13+disp32] operand,
+ *  an offset into the CPU context.
  *
+ *  param:  Code address, pointer to op-code and ModRM bytes,
+ *          byte count, context offset
+ *  return: Code address after the displacement
  */
-static uint8_t neg(uint8_t byte)
+static uint8_t *emit_ctx(uint8_t *code, const uint8_t *op, int length, int offset)
 {
-    uint16_t result;
-
-    result =  0 - byte;
+    code = emit_bytes(code, op, length);
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(0, ~byte, result);
-
-    return (uint8_t) result;
+    return emit_imm(code, (uint32_t) offset, 4);
 }
 
 /*------------------------------------------------
- * or()
+ * emit_imm()
  *
- *  Bit-wise logical OR between 'acc' and 'byte'
+ *  Store an immediate operand or displacement, little-endian.
  *
+ *  param:  Code address, value, byte count 1, 2, 4 or 8
+ *  return: Code address after the operand
  */
-static uint8_t or(uint8_t acc, uint8_t byte)
+static uint8_t *emit_imm(uint8_t *code, uint64_t value, int length)
 {
-    uint8_t result;
-
-    result = acc | byte;
+    int     i;
 
-    cc.v = CC_FLAG_CLR;
-    eval_cc_z((uint16_t) result);
-    eval_cc_n((uint16_t) result);
+    for ( i = 0; i < length; i++ )
+    {
+        code[i] = (uint8_t) (value >> (8 * i));
+    }
 
-    return result;
+    return code + length;
 }
 
 /*------------------------------------------------
- * orcc()
+ * emit_exit()
  *
- *  Logical OR condition-code register with operand.
+ *  Emit a conditional jump to the block exit. The displacement
+ *  is recorded and set when the exit address is known.
  *
+ *  param:  Code address, condition op-code byte following 0x0f,
+ *          exit displacement list, pointer to list count
+ *  return: Code address after the jump
  */
-static void orcc(uint8_t byte)
+static uint8_t *emit_exit(uint8_t *code, uint8_t condition, uint8_t **exits, int *exit_count)
 {
-    uint8_t temp_cc;
+    *code++ = 0x0f;
+    *code++ = condition;
+    exits[(*exit_count)++] = code;
 
-    temp_cc = get_cc();
-    temp_cc |= byte;
-    set_cc(temp_cc);
+    return code + 4;
 }
+#endif  /* NATIVE */
 
+#if (FUSION)
 /*------------------------------------------------
- * pshs()
+ * Superinstruction fusion.
+ *
+ *  translate_block() marks instruction pairs that match a fusion
+ *  type, and execute_block() runs a marked pair with one fused handler.
+ *  The first instruction of every fused pair only reads memory and sets
+ *  registers and flags, so of the stop conditions checked by execute_block()
+ *  after each instruction, only an IO access can be triggered by it.
+ *  The fused handler checks for it between the two instructions, and
+ *  execute_block() checks the budget and break point before calling the
+ *  handler. All other checks are done after the pair as usual.
+ *  Fused pairs use fixed instruction cycle counts, so architectural state
+ *  and cycle counts are the same as instruction by instruction execution.
+ */
+
+/*------------------------------------------------
+ * fusion_match()
  *
- *  Push registers onto stack S (systems)
- *  Modifies 's' stack register.
+ *  Match a pair of predecoded instructions to a fusion type.
  *
- *  param:  Push-list operand, and command cycles to update if needed.
- *  return: Nothing
+ *  param:  Pointers to the first and second instruction
+ *  return: Fusion type, FUSION_NONE if the pair cannot be fused
  */
-static void pshs(uint8_t push_list, int *cycles)
+static int fusion_match(predecode_t *first, predecode_t *second)
 {
-    (*cycles)++;
+    static const op_operation_t loads[] = { op_lda, op_ldb, op_ldd, op_ldx, op_ldy, op_ldu };
+    static const op_operation_t stores[] = { op_sta, op_stb, op_std, op_stx, op_sty, op_stu };
 
-    if ( push_list & 0x80 )
-    {
-        (*cycles)++;
-        cpu.s--;
-        mem_write(cpu.s, cpu.pc & 0xff);
-        cpu.s--;
-        mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-    }
+    op_operation_t  op = first->operation;
+    int             i, short_branch = 0;
 
-    if ( push_list & 0x40 )
+    /* Short conditional branches, op-codes 0x22 to 0x2f
+     */
+    for ( i = 0x22; i <= 0x2f; i++ )
     {
-        (*cycles)++;
-        cpu.s--;
-        mem_write(cpu.s, cpu.u & 0xff);
-        cpu.s--;
-        mem_write(cpu.s, (cpu.u >> 8) & 0xff);
+        if ( second->operation == op_recipes_page1[i].operation )
+            short_branch = 1;
     }
 
-    if ( push_list & 0x20 )
+    if ( short_branch )
     {
-        (*cycles)++;
-        cpu.s--;
-        mem_write(cpu.s, cpu.y & 0xff);
-        cpu.s--;
-        mem_write(cpu.s, (cpu.y >> 8) & 0xff);
-    }
+        if ( op == op_cmpa || op == op_cmpb || op == op_cmpd || op == op_cmpx ||
+             op == op_cmpy || op == op_cmpu || op == op_cmps )
+            return FUSION_CMP_BCC;
 
-    if ( push_list & 0x10 )
-    {
-        (*cycles)++;
-        cpu.s--;
-        mem_write(cpu.s, cpu.x & 0xff);
-        cpu.s--;
-        mem_write(cpu.s, (cpu.x >> 8) & 0xff);
-    }
+        if ( op == op_tsta || op == op_tstb || op == op_tst )
+            return FUSION_TST_BCC;
 
-    if ( push_list & 0x08 )
-    {
-        cpu.s--;
-        mem_write(cpu.s, cpu.dp);
-    }
+        if ( op == op_leax || op == op_leay || op == op_deca || op == op_decb ||
+             op == op_inca || op == op_incb )
+            return FUSION_CNT_BCC;
 
-    if ( push_list & 0x04 )
-    {
-        cpu.s--;
-        mem_write(cpu.s, cpu.b);
-    }
+        for ( i = 0; i < sizeof(loads)/sizeof(op_operation_t); i++ )
+        {
+            if ( op == loads[i] )
+                return FUSION_LD_BCC;
+        }
 
-    if ( push_list & 0x02 )
-    {
-        cpu.s--;
-        mem_write(cpu.s, cpu.a);
+        return FUSION_NONE;
     }
 
-    if ( push_list & 0x01 )
+    /* Load and store of the same register, both with
+     * non-indirect auto increment index modes
+     */
+    if ( first->ea_recipe != EA_INDEXED || second->ea_recipe != EA_INDEXED ||
+         (first->post_byte & (INDX_POST_5BIT_OFF | INDX_POST_INDIRECT | 0x0e)) != INDX_POST_5BIT_OFF ||
+         (second->post_byte & (INDX_POST_5BIT_OFF | INDX_POST_INDIRECT | 0x0e)) != INDX_POST_5BIT_OFF )
+        return FUSION_NONE;
+
+    for ( i = 0; i < sizeof(loads)/sizeof(op_operation_t); i++ )
     {
-        cpu.s--;
-        mem_write(cpu.s, (int) get_cc());
+        if ( op == loads[i] && second->operation == stores[i] )
+            return FUSION_COPY;
     }
+
+    return FUSION_NONE;
 }
 
 /*------------------------------------------------
- * pshu()
+ * fused_branch()
  *
- *  Push registers onto stack U (user)
- *  Modifies 'u' stack register.
+ *  Execute a fused pair of a compare, test, count or load
+ *  instruction and a short conditional branch.
  *
- *  param:  Push-list operand, and command cycles to update if needed.
- *  return: Nothing
+ *  param:  Pointer to the first predecoded instruction of the pair
+ *  return: Count of instructions executed, '1' if the first
+ *          instruction accessed an IO address
  */
-static void pshu(uint8_t push_list, int *cycles)
+static int fused_branch(predecode_t *entry)
 {
-    (*cycles)++;
+    uint32_t    io_count = *active->io_accesses;
+    int         cycles, bytes;
 
-    if ( push_list & 0x80 )
+    /* Immediate, extended and inherent modes need
+     * no effective address calculation
+     */
+    if ( entry->ea_recipe == EA_CONSTANT )
     {
-        (*cycles)++;
-        cpu.u--;
-        mem_write(cpu.u, cpu.pc & 0xff);
-        cpu.u--;
-        mem_write(cpu.u, (cpu.pc >> 8) & 0xff);
+        active->cpu.pc = entry->next_pc;
+        entry->operation(entry->operand, &cycles);
     }
-
-    if ( push_list & 0x40 )
+    else
     {
-        (*cycles)++;
-        cpu.u--;
-        mem_write(cpu.u, cpu.s & 0xff);
-        cpu.u--;
-        mem_write(cpu.u, (cpu.s >> 8) & 0xff);
+        execute_entry(entry, &cycles, &bytes);
     }
 
-    if ( push_list & 0x20 )
-    {
-        (*cycles)++;
-        cpu.u--;
-        mem_write(cpu.u, cpu.y & 0xff);
-        cpu.u--;
-        mem_write(cpu.u, (cpu.y >> 8) & 0xff);
-    }
+    if ( *active->io_accesses != io_count )
+        return 1;
 
-    if ( push_list & 0x10 )
-    {
-        (*cycles)++;
-        cpu.u--;
-        mem_write(cpu.u, cpu.x & 0xff);
-        cpu.u--;
-        mem_write(cpu.u, (cpu.x >> 8) & 0xff);
-    }
+    /* The branch target is the constant effective address
+     */
+    entry++;
+    active->cpu.pc = entry->next_pc;
+    entry->operation(entry->operand, &cycles);
 
-    if ( push_list & 0x08 )
-    {
-        cpu.u--;
-        mem_write(cpu.u, cpu.dp);
-    }
+    return 2;
+}
 
-    if ( push_list & 0x04 )
-    {
-        cpu.u--;
-        mem_write(cpu.u, cpu.b);
-    }
+/*------------------------------------------------
+ * fused_copy()
+ *
+ *  Execute a fused pair of an auto increment indexed load
+ *  and store of the same register.
+ *
+ *  param:  Pointer to the first predecoded instruction of the pair
+ *  return: Count of instructions executed, '1' if the load
+ *          accessed an IO address
+ */
+static int fused_copy(predecode_t *entry)
+{
+    uint32_t    io_count = *active->io_accesses;
+    int         cycles, bytes;
 
-    if ( push_list & 0x02 )
-    {
-        cpu.u--;
-        mem_write(cpu.u, cpu.a);
-    }
+    execute_entry(entry, &cycles, &bytes);
 
-    if ( push_list & 0x01 )
-    {
-        cpu.u--;
-        mem_write(cpu.u, get_cc());
-    }
+    if ( *active->io_accesses != io_count )
+        return 1;
+
+    execute_entry(entry + 1, &cycles, &bytes);
+
+    return 2;
 }
+#endif  /* FUSION */
 
+#if (IDLE_SKIP)
 /*------------------------------------------------
- * puls()
- *
- *  Pull registers from stack S (systems)
- *  Modifies 's' stack register.
- *
- *  param:  Pull-list operand, and command cycles to update if needed.
- *  return: Nothing
+ * Guest idle loop skipping.
+ *
+ *  translate_block() marks blocks that loop to their own start
+ *  address with a short branch, and whose instructions before the
+ *  branch either count a register down (IDLE_COUNTDOWN), or only read
+ *  memory and IO (IDLE_SPIN). The final state of a run of countdown
+ *  iterations is computed from the register value. A polling loop
+ *  that reaches its start with the same registers one iteration later,
+ *  in the same cpu_run_cycles() run, repeats the same reads and will
+ *  keep looping until memory changes, which device events do between
+ *  runs. A polling loop that reads an IO address is skipped only if
+ *  the address is declared with mem_ctx_define_io_pure(), because
+ *  other IO handlers can count or react to every read.
+ *  idle_skip() adds the cycles of the skipped iterations and leaves
+ *  the last iteration within the budget to execute_block(), so runs
+ *  stop at the same state as when the iterations are executed.
+ *  Both loop types make cpu_is_idle() report an idle guest. A countdown
+ *  loop paces the guest, for example the cursor blink and the sound
+ *  delays between DAC writes of the Dragon ROM, so its idle time ends
+ *  with the loop, see cpu_idle_cycles_left(). Iterations are skipped
+ *  only within the budget of the current run.
+ *------------------------------------------------
+ * idle_match()
+ *
+ *  Find the idle loop type of a translated block.
+ *
+ *  param:  Pointer to block, instructions in the block
+ *  return: Idle loop type
  */
-static void puls(uint8_t pull_list, int *cycles)
+static int idle_match(block_t *block, int length)
 {
-    uint16_t    val;
+    static const op_operation_t reads[] = { op_lda, op_ldb, op_ldd, op_ldx, op_ldy, op_ldu,
+                                            op_cmpa, op_cmpb, op_cmpd, op_cmpx, op_cmpy, op_cmpu, op_cmps,
+                                            op_tsta, op_tstb, op_tst, op_bita, op_bitb };
 
-    (*cycles)++;
+    predecode_t    *code = block->code;
+    int             i, j, loop = -1;
 
-    if ( pull_list & 0x01 )
-    {
-        val = mem_read(cpu.s);
-        cpu.s++;
-        set_cc((uint8_t) val);
-    }
+    block->idle_length = 0;
+    block->idle_cycles = 0;
 
-    if ( pull_list & 0x02 )
+    /* Short branch to the block start, op-codes 0x20 and 0x22 to 0x2f
+     */
+    for ( i = 0; i < length && loop < 0; i++ )
     {
-        val = mem_read(cpu.s);
-        cpu.s++;
-        cpu.a = val;
+        for ( j = 0x20; j <= 0x2f; j++ )
+        {
+            if ( j != 0x21 && code[i].operation == op_recipes_page1[j].operation &&
+                 code[i].operand == block->pc )
+                loop = i;
+        }
     }
 
-    if ( pull_list & 0x04 )
-    {
-        val = mem_read(cpu.s);
-        cpu.s++;
-        cpu.b = val;
-    }
+    if ( loop < 0 )
+        return IDLE_NONE;
 
-    if ( pull_list & 0x08 )
+    block->idle_length = loop + 1;
+    for ( i = 0; i <= loop; i++ )
     {
-        val = mem_read(cpu.s);
-        cpu.s++;
-        cpu.dp = val;
+        block->idle_cycles += code[i].cycles;
     }
 
-    if ( pull_list & 0x10 )
-    {
-        (*cycles)++;
-        val = mem_read(cpu.s) << 8;
-        cpu.s++;
-        val += mem_read(cpu.s);
-        cpu.s++;
-        cpu.x = val;
-    }
+    if ( loop == 1 && code[1].operation == op_bne &&
+         ((code[0].operation == op_leax && code[0].ea_recipe == EA_INDEXED && code[0].post_byte == 0x1f) ||
+          (code[0].operation == op_leay && code[0].ea_recipe == EA_INDEXED && code[0].post_byte == 0x3f) ||
+          code[0].operation == op_deca || code[0].operation == op_decb) )
+        return IDLE_COUNTDOWN;
 
-    if ( pull_list & 0x20 )
+    /* Every instruction before the loop branch reads, or
+     * is a short conditional branch out of the loop
+     */
+    for ( i = 0; i < loop; i++ )
     {
-        (*cycles)++;
-        val = mem_read(cpu.s) << 8;
-        cpu.s++;
-        val += mem_read(cpu.s);
-        cpu.s++;
-        cpu.y = val;
-    }
+        for ( j = 0; j < sizeof(reads)/sizeof(op_operation_t); j++ )
+        {
+            if ( code[i].operation == reads[j] )
+                break;
+        }
+
+        if ( j < sizeof(reads)/sizeof(op_operation_t) )
+            continue;
+
+        for ( j = 0x22; j <= 0x2f; j++ )
+        {
+            if ( code[i].operation == op_recipes_page1[j].operation )
+                break;
+        }
 
-    if ( pull_list & 0x40 )
-    {
-        (*cycles)++;
-        val = mem_read(cpu.s) << 8;
-        cpu.s++;
-        val += mem_read(cpu.s);
-        cpu.s++;
-        cpu.u = val;
+        if ( j > 0x2f )
+            return IDLE_NONE;
     }
 
-    if ( pull_list & 0x80 )
-    {
-        (*cycles)++;
-        val = mem_read(cpu.s) << 8;
-        cpu.s++;
-        val += mem_read(cpu.s);
-        cpu.s++;
-        cpu.pc = val;
-    }
+    return IDLE_SPIN;
 }
 
 /*------------------------------------------------
- * pulu()
+ * idle_skip()
  *
- *  Pull registers from stack U (user)
- *  Modifies 'u' stack register.
+ *  Skip whole iterations of an idle loop at the start of its block.
  *
- *  param:  Pull-list operand, and command cycles to update if needed.
- *  return: Nothing
+ *  param:  Pointer to block, cycle budget
+ *  return: Cycles skipped
  */
-static void pulu(uint8_t pull_list, int *cycles)
+static int idle_skip(block_t *block, int cycle_budget)
 {
-    uint16_t    val;
-
-    (*cycles)++;
+    predecode_t    *code = block->code;
+    op_operation_t  op = code[0].operation;
+    idle_regs_t     regs;
+    int             i, count, iterations, cycles;
 
-    if ( pull_list & 0x01 )
+    /* A break point in the loop stops every iteration
+     */
+    for ( i = 0; i < block->idle_length; i++ )
     {
-        val = mem_read(cpu.u);
-        cpu.u++;
-        set_cc((uint8_t) val);
+        if ( code[i].pc == active->break_point )
+            return 0;
     }
 
-    if ( pull_list & 0x02 )
-    {
-        val = mem_read(cpu.u);
-        cpu.u++;
-        cpu.a = val;
-    }
+    count = (cycle_budget - 1) / block->idle_cycles;
+    if ( count <= 0 )
+        return 0;
 
-    if ( pull_list & 0x04 )
+    if ( block->idle == IDLE_COUNTDOWN )
     {
-        val = mem_read(cpu.u);
-        cpu.u++;
-        cpu.b = val;
-    }
+        /* Iterations before the one that counts down to zero
+         */
+        if ( op == op_leax )
+            iterations = (active->cpu.x ? active->cpu.x : 0x10000) - 1;
+        else if ( op == op_leay )
+            iterations = (active->cpu.y ? active->cpu.y : 0x10000) - 1;
+        else if ( op == op_deca )
+            iterations = (active->cpu.a ? active->cpu.a : 0x100) - 1;
+        else
+            iterations = (active->cpu.b ? active->cpu.b : 0x100) - 1;
 
-    if ( pull_list & 0x08 )
-    {
-        val = mem_read(cpu.u);
-        cpu.u++;
-        cpu.dp = val;
-    }
+        if ( count > iterations )
+            count = iterations;
 
-    if ( pull_list & 0x10 )
-    {
-        (*cycles)++;
-        val = mem_read(cpu.u) << 8;
-        cpu.u++;
-        val += mem_read(cpu.u);
-        cpu.u++;
-        cpu.x = val;
-    }
+        if ( count <= 0 )
+            return 0;
 
-    if ( pull_list & 0x20 )
-    {
-        (*cycles)++;
-        val = mem_read(cpu.u) << 8;
-        cpu.u++;
-        val += mem_read(cpu.u);
-        cpu.u++;
-        cpu.y = val;
-    }
+        /* Registers and flags as left by the last skipped iteration
+         */
+        if ( op == op_leax )
+        {
+            active->cpu.x -= count;
+            eval_cc_z16(active->cpu.x);
+        }
+        else if ( op == op_leay )
+        {
+            active->cpu.y -= count;
+            eval_cc_z16(active->cpu.y);
+        }
+        else if ( op == op_deca )
+            active->cpu.a = dec((uint8_t)(active->cpu.a - count + 1));
+        else
+            active->cpu.b = dec((uint8_t)(active->cpu.b - count + 1));
 
-    if ( pull_list & 0x40 )
+        /* The loop ends after the skipped and the remaining iterations
+         */
+        active->idle = 1;
+        active->idle_end = active->cpu.cycles + (uint64_t)(iterations + 1) * block->idle_cycles;
+    }
+    else
     {
-        (*cycles)++;
-        val = mem_read(cpu.u) << 8;
-        cpu.u++;
-        val += mem_read(cpu.u);
-        cpu.u++;
-        cpu.s = val;
+        idle_regs(&regs);
+
+        if ( active->spin_pc != block->pc ||
+             active->cpu.cycles - active->spin_time != block->idle_cycles ||
+             memcmp(&regs, &active->spin_regs, sizeof(idle_regs_t)) != 0 )
+        {
+            active->spin_pc = block->pc;
+            active->spin_time = active->cpu.cycles;
+            active->spin_regs = regs;
+            return 0;
+        }
+
+        if ( idle_reads_io(block) )
+            return 0;
+
+        active->idle = 1;
+        active->idle_end = CPU_NO_EVENT;
     }
 
-    if ( pull_list & 0x80 )
+    cycles = count * block->idle_cycles;
+
+#if (PROFILE)
+    for ( i = 0; i < block->idle_length; i++ )
     {
-        (*cycles)++;
-        val = mem_read(cpu.u) << 8;
-        cpu.u++;
-        val += mem_read(cpu.u);
-        cpu.u++;
-        cpu.pc = val;
+        active->profile.count[code[i].pc].executions += count;
+        active->profile.count[code[i].pc].cycles += count * code[i].cycles;
     }
+#endif
+
+    active->cpu.cycles += cycles;
+    active->idle_cycles += cycles;
+    active->spin_time = active->cpu.cycles;
+
+    return cycles;
 }
 
 /*------------------------------------------------
- * rol()
+ * idle_regs()
  *
- *  Rotate left through Carry
+ *  Copy the registers compared between polling loop iterations.
  *
+ *  param:  Pointer to registers
+ *  return: Nothing
  */
-static uint8_t rol(uint8_t byte)
+static void idle_regs(idle_regs_t *regs)
 {
-    uint16_t    result;
-
-    result = (byte << 1);
-
-    if ( cc.c )
-        result |= 0x0001;
-    else
-        result &= 0xfffe;
-
-    eval_cc_c(result);
-    eval_cc_v(byte, byte, result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-
-    return (uint8_t) result;
+    regs->x = active->cpu.x;
+    regs->y = active->cpu.y;
+    regs->u = active->cpu.u;
+    regs->s = active->cpu.s;
+    regs->a = active->cpu.a;
+    regs->b = active->cpu.b;
+    regs->dp = active->cpu.dp;
+    regs->cc = get_cc();
 }
 
 /*------------------------------------------------
- * ror()
+ * idle_reads_io()
  *
- *  Rotate right through Carry
+ *  Check if a polling loop reads an IO address with side effects, with
+ *  the effective addresses of the current registers. IO addresses
+ *  declared with mem_ctx_define_io_pure() have no side effects.
+ *  Auto increment and decrement index modes are treated
+ *  as IO reads, and the loop is not skipped.
  *
+ *  param:  Pointer to block
+ *  return: '1' if an instruction of the loop reads an IO address
+ *          with side effects, '0' if not
  */
-static uint8_t ror(uint8_t byte)
+static int idle_reads_io(block_t *block)
 {
-    uint16_t    result;
+    predecode_t            *code = block->code;
+    const index_decode_t   *index;
+    uint16_t                index_reg;
+    uint16_t                effective_addr;
+    op_operation_t          op;
+    int                     i, j, indirect, bytes;
+
+    for ( i = 0; i < block->idle_length - 1; i++ )
+    {
+        /* TSTA, TSTB and the short branches out of the loop do not read memory
+         */
+        if ( code[i].operation == op_tsta || code[i].operation == op_tstb )
+            continue;
 
+        for ( j = 0x22; j <= 0x2f; j++ )
+        {
+            if ( code[i].operation == op_recipes_page1[j].operation )
+                break;
+        }
 
-    result = byte;
+        if ( j <= 0x2f )
+            continue;
 
-    if ( cc.c )
-        result |= 0x0100;
-    else
-        result &= 0xfeff;
+        indirect = 0;
 
-    if ( byte & 0x01 )
-        cc.c = CC_FLAG_SET;
-    else
-        cc.c = CC_FLAG_CLR;
+        switch ( code[i].ea_recipe )
+        {
+            case EA_DIRECT:
+                effective_addr = (active->cpu.dp << 8) + code[i].operand;
+                break;
 
-    result = (result >> 1);
+            case EA_INDEXED:
+                index = &index_decode[code[i].post_byte];
+                index_reg = *(uint16_t *)((uint8_t *) &active->cpu + index->reg);
+                indirect = index->indirect;
 
-    eval_cc_z(result);
-    eval_cc_n(result);
+                switch ( index->offset )
+                {
+                    case INDX_OFFSET_POST_INC:
+                    case INDX_OFFSET_PRE_DEC:
+                    case INDX_OFFSET_ILLEGAL:
+                        return 1;
 
-    return (uint8_t) result;
-}
+                    case INDX_OFFSET_NONE:
+                        effective_addr = index_reg;
+                        break;
 
-/*------------------------------------------------
- * rti()
- *
- *  Return from interrupt
- *
- */
-static void rti(int *cycles)
-{
-    uint8_t byte;
+                    case INDX_OFFSET_ACCB:
+                        effective_addr = index_reg + SIG_EXTEND(active->cpu.b);
+                        break;
 
-    /* Restore CCR
-     */
-    byte = mem_read(cpu.s);
-    cpu.s++;
-    set_cc(byte);
+                    case INDX_OFFSET_ACCA:
+                        effective_addr = index_reg + SIG_EXTEND(active->cpu.a);
+                        break;
 
-    /* Restore registers if this is an extended
-     * interrupt frame (IRQ, NMI, SWIx)
-     */
-    if ( cc.e )
-    {
-        cpu.a = mem_read(cpu.s);
-        cpu.s++;
-        cpu.b = mem_read(cpu.s);
-        cpu.s++;
-        cpu.dp = mem_read(cpu.s);
-        cpu.s++;
-        cpu.x = mem_read(cpu.s) << 8;
-        cpu.s++;
-        cpu.x += mem_read(cpu.s);
-        cpu.s++;
-        cpu.y = mem_read(cpu.s) << 8;
-        cpu.s++;
-        cpu.y += mem_read(cpu.s);
-        cpu.s++;
-        cpu.u = mem_read(cpu.s) << 8;
-        cpu.s++;
-        cpu.u += mem_read(cpu.s);
-        cpu.s++;
+                    case INDX_OFFSET_ACCD:
+                        effective_addr = index_reg + active->cpu.d;
+                        break;
 
-        (*cycles) += 9;
-    }
+#if (CPU_6309)
+                    case INDX_OFFSET_ACCE:
+                        effective_addr = index_reg + SIG_EXTEND(active->cpu.e);
+                        break;
 
-    /* Restore PC and return
-     */
-    byte = mem_read(cpu.s);
-    cpu.s++;
-    cpu.pc = (uint16_t) byte << 8;
+                    case INDX_OFFSET_ACCF:
+                        effective_addr = index_reg + SIG_EXTEND(active->cpu.f);
+                        break;
 
-    byte = mem_read(cpu.s);
-    cpu.s++;
-    cpu.pc += (uint16_t) byte;
-}
+                    case INDX_OFFSET_ACCW:
+                        effective_addr = index_reg + active->cpu.w;
+                        break;
+#endif
 
-/*------------------------------------------------
- * sbc()
- *
- *  Subtract with carry.
- *
- *  acc-byte-carry
- */
-static uint8_t sbc(uint8_t acc, uint8_t byte)
-{
-    uint16_t result;
+                    case INDX_OFFSET_PC8:
+                    case INDX_OFFSET_PC16:
+                    case INDX_OFFSET_EXTENDED:
+                        effective_addr = code[i].operand;
+                        break;
 
-    result = acc - byte - cc.c;
+                    default: // 5-bit, 8-bit and 16-bit offsets
+                        effective_addr = index_reg + code[i].operand;
+                }
+                break;
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(acc, ~byte, result);
+            default: // Extended and immediate operands
+                effective_addr = code[i].operand;
+        }
 
-    return (uint8_t) result;
+        /* Pointer of an indirect index mode, then the
+         * operand of one or two bytes
+         */
+        if ( indirect )
+        {
+            if ( !mem_ctx_read_is_pure(active->mem, effective_addr) ||
+                 !mem_ctx_read_is_pure(active->mem, (uint16_t)(effective_addr + 1)) )
+                return 1;
+
+            effective_addr = MEM_READ16(effective_addr);
+        }
+
+        op = code[i].operation;
+        bytes = (op == op_ldd  || op == op_ldx  || op == op_ldy  || op == op_ldu  ||
+                 op == op_cmpd || op == op_cmpx || op == op_cmpy || op == op_cmpu || op == op_cmps) ? 2 : 1;
+
+        for ( j = 0; j < bytes; j++ )
+        {
+            if ( !mem_ctx_read_is_pure(active->mem, (uint16_t)(effective_addr + j)) )
+                return 1;
+        }
+    }
+
+    return 0;
 }
+#endif  /* IDLE_SKIP */
 
+#if (PROFILE || CALL_GRAPH)
 /*------------------------------------------------
- * sex()
+ * peek_op_code()
  *
- *  Sign extend Acc-B to Acc-A
+ *  Read the op-code at an address without
+ *  calling IO handlers.
  *
+ *  param:  Instruction address
+ *  return: Op-code, 0x10nn and 0x11nn for pages 2 and 3,
+ *          PROFILE_OP_UNKNOWN if the address is in an IO page
  */
-static void sex(void)
+static int peek_op_code(int address)
 {
-    if ( cpu.b & 0x80 )
-        cpu.a = 0xff;
-    else
-        cpu.a = 0;
+    int     op_code;
+    int     next = (address + 1) & (MEMORY - 1);
+
+    if ( mem_ctx_page_is_io(active->mem, address / MEM_PAGE_SIZE) )
+        return PROFILE_OP_UNKNOWN;
 
-    cc.v = CC_FLAG_CLR;
-    eval_cc_z((uint16_t) cpu.a);
-    eval_cc_n((uint16_t) cpu.a);
+    op_code = MEM_READ(address);
+
+    if ( op_code == 0x10 || op_code == 0x11 )
+    {
+        if ( mem_ctx_page_is_io(active->mem, next / MEM_PAGE_SIZE) )
+            return PROFILE_OP_UNKNOWN;
+
+        op_code = (op_code << 8) + MEM_READ(next);
+    }
+
+    return op_code;
 }
 
 /*------------------------------------------------
- * sub()
+ * sort_compare()
  *
- *  Subtract byte from Acc and set flags
+ *  qsort() compare function, orders indexes into
+ *  sort_key[] by descending count.
  *
+ *  param:  Pointers to two indexes
+ *  return: <0, 0, >0 qsort() order
  */
-static uint8_t sub(uint8_t acc, uint8_t byte)
+static int sort_compare(const void *a, const void *b)
 {
-    uint16_t result;
-
-    result = acc - byte;
+    uint64_t    count_a = sort_key[*(const int *) a];
+    uint64_t    count_b = sort_key[*(const int *) b];
 
-    eval_cc_c(result);
-    eval_cc_z(result);
-    eval_cc_n(result);
-    eval_cc_v(acc, ~byte, result);
+    if ( count_a != count_b )
+        return count_a < count_b ? 1 : -1;
 
-    return (uint8_t) result;
+    return *(const int *) a - *(const int *) b;
 }
+#endif
 
+#if (PROFILE)
 /*------------------------------------------------
- * subd()
+ * profile_count()
  *
- *  Subtract word from D accumulator and set flags
- *  Using 2's complement addition.
+ *  Count an instruction execution and its cycles at an address.
  *
+ *  param:  Instruction address, cycles
+ *  return: Nothing
  */
-static void subd(uint16_t word)
+static inline void profile_count(int address, int cycles)
 {
-    uint16_t acc;
-    uint32_t result;
+    profile_count_t *count = &active->profile.count[address];
 
-    acc = (cpu.a << 8) + cpu.b;
-    result = acc - word;
-
-    cpu.a = result >> 8;
-    cpu.b = result & 0xff;
+    if ( count->executions++ == 0 )
+        active->profile.op_code[address] = peek_op_code(address);
 
-    eval_cc_c16(result);
-    eval_cc_z16(result);
-    eval_cc_v16(acc, ~word, result);
-    eval_cc_n16(result);
+    count->cycles += cycles;
 }
 
 /*------------------------------------------------
- * swi()
+ * profile_mnemonic()
  *
- *  Software interrupt.
- *  SWI type is input to the function:
- *  SWI=1, SWI2=2, SWI3=3
+ *  Mnemonic of a profiled op-code.
  *
+ *  param:  Op-code, 0x10nn and 0x11nn for pages 2 and 3
+ *  return: Pointer to constant mnemonic string
  */
-static void swi(int swi_id)
+static const char *profile_mnemonic(int op_code)
 {
-    cc.e = CC_FLAG_SET;
-
-    cpu.s--;
-    mem_write(cpu.s, cpu.pc & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.pc >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.u & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.u >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.y & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.y >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.x & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, (cpu.x >> 8) & 0xff);
-    cpu.s--;
-    mem_write(cpu.s, cpu.dp);
-    cpu.s--;
-    mem_write(cpu.s, cpu.b);
-    cpu.s--;
-    mem_write(cpu.s, cpu.a);
-    cpu.s--;
-    mem_write(cpu.s, get_cc());
-
-    switch ( swi_id )
-    {
-        case 1:
-            cc.i = CC_FLAG_SET;
-            cc.f = CC_FLAG_SET;
-            cpu.pc = (mem_read(VEC_SWI) << 8) + mem_read(VEC_SWI+1);
-            break;
-
-        case 2:
-            cpu.pc = (mem_read(VEC_SWI2) << 8) + mem_read(VEC_SWI2+1);
-            break;
+    int     index;
+
+    if ( op_code == PROFILE_OP_UNKNOWN )
+        return "?";
+    else if ( (op_code >> 8) == 0x10 )
+        index = op_code_page2[op_code & 0xff].index;
+    else if ( (op_code >> 8) == 0x11 )
+        index = op_code_page3[op_code & 0xff].index;
+    else
+        index = op_code;
 
-        case 3:
-            cpu.pc = (mem_read(VEC_SWI3) << 8) + mem_read(VEC_SWI3+1);
-            break;
+    if ( index == -1 )
+        return "???";
 
-        default:
-            /* Exception: Illegal SWI type swi()
-             */
-            cpu.cpu_state = CPU_EXCEPTION;
-            cpu.exception_line_num = __LINE__;
-    }
+    return machine_code[index].mnem;
 }
 
 /*------------------------------------------------
- * tfr()
- *
- *  Transfer value from source register to destination register
+ * profile_op_name()
  *
- *  NOTE: The function relies on the assembler to not mix
- *  8-bit registers with 16-bit register, otherwise
- *  results are unexpected.
- *  Check: if (((regs ^ (regs << 4)) & 0x80) == 0) {...}
+ *  Hexadecimal text of a profiled op-code.
  *
+ *  param:  Op-code, 0x10nn and 0x11nn for pages 2 and 3
+ *  return: Pointer to static string
  */
-static void tfr(uint8_t regs)
+static const char *profile_op_name(int op_code)
 {
-    int         src, dst;
-    uint16_t    temp1;
+    static char name[16];
 
-    src = (int)((regs >> 4) & 0x0f);
-    dst = (int)(regs & 0x0f);
+    if ( op_code >> 8 )
+        snprintf(name, sizeof(name), "0x%02x 0x%02x", op_code >> 8, op_code & 0xff);
+    else
+        snprintf(name, sizeof(name), "0x%02x", op_code);
 
-    temp1 = read_register(src);
-    write_register(dst, temp1);
+    return name;
 }
 
 /*------------------------------------------------
- * tst()
+ * profile_exit()
  *
- *  Test 8 bit operand and set V,Z,N flags.
+ *  Write the profile files registered with cpu_profile_on_exit().
  *
+ *  param:  Nothing
+ *  return: Nothing
  */
-static void tst(uint8_t byte)
+static void profile_exit(void)
 {
-    eval_cc_z((uint16_t) byte);
-    eval_cc_n((uint16_t) byte);
-    cc.v = CC_FLAG_CLR;
+    if ( profile_report_file )
+        cpu_profile_report(profile_report_file);
+
+    if ( profile_dump_file )
+        cpu_profile_dump(profile_dump_file);
 }
+#endif  /* PROFILE */
 
+#if (CALL_GRAPH)
 /*------------------------------------------------
- * branch()
+ * call_graph_step()
  *
- *  Implement conditional short branch and long branch.
- *  The branch opcodes for both short and long variants are
- *  identical except for the 0x10 byte prefix for long branches.
- *  Calling code resolves long from short and then calls this function
- *  to resolve branch condition and apply the offset.
- *  To use this function with short branches (8-bit signed offset),
- *  the branch offset must be sign-extended to 16-bit.
+ *  Follow the shadow stack after an instruction: charge the
+ *  cycles since the last step to the routine being run, leave
+ *  routines whose return address or interrupt state was pulled
+ *  off the stack, and enter the routine called by JSR, BSR, LBSR
+ *  or SWI. Leaving by the stack pointer also follows routines
+ *  that return with PULS PC, or drop their return address with
+ *  LEAS or PULS and exit with a jump.
  *
- *  param:  Branch opcode, long ('1') or short ('0') branch, 16-bit sign-extended offset, 
- *          pointer to opcode cycles.
+ *  param:  Address of the instruction
  *  return: Nothing
  */
-static void branch(int instruction, int long_short, uint16_t effective_address, int *cycles)
+static void call_graph_step(int op_pc)
 {
-    /* Parse the branch condition and apply
-       offset if branch is taken.
-     */
-    switch ( instruction )
-    {
-        /* BHI / LBHI
-         */
-        case 0x22:
-            if ( cc.c == CC_FLAG_CLR && cc.z == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    call_graph_t   *graph = &active->call_graph;
 
-        /* BLS / LBLS
-         */
-        case 0x23:
-            if ( cc.c == CC_FLAG_SET || cc.z == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    if ( graph->depth == 1 )
+        call_graph_enter(op_pc, CALL_ENTRY, CALL_GRAPH_TOP);
 
-        /* BHS / LBHS / BCC / LBCC
-         */
-        case 0x24:
-            if ( cc.c == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    call_graph_charge(active);
 
-        /* BLO / LBLO / BCS / LBCS
-         */
-        case 0x25:
-            if ( cc.c == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    while ( graph->depth > 1 && graph->frame[graph->depth - 1].stack < active->cpu.s )
+    {
+        graph->depth--;
+    }
 
-        /* BNE / LBNE
-         */
-        case 0x26:
-            if ( cc.z == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
+    switch ( peek_op_code(op_pc) )
+    {
+        case 0x17:      // LBSR
+        case 0x8d:      // BSR
+        case 0x9d:      // JSR
+        case 0xad:
+        case 0xbd:
+            call_graph_enter(active->cpu.pc, CALL_SUBROUTINE, active->cpu.s);
             break;
 
-        /* BEQ / LBEQ
-         */
-        case 0x27:
-            if ( cc.z == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
+        case 0x3f:      // SWI
+        case 0x103f:    // SWI2
+        case 0x113f:    // SWI3
+            call_graph_enter(active->cpu.pc, CALL_SWI, active->cpu.s);
             break;
+    }
+}
 
-        /* BVC / LBVC
-         */
-        case 0x28:
-            if ( cc.v == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
-            break;
+/*------------------------------------------------
+ * call_graph_interrupt()
+ *
+ *  Enter an interrupt service routine into the shadow stack,
+ *  called after the interrupt state is pushed and PC is
+ *  loaded from the vector.
+ *
+ *  param:  CALL_NMI, CALL_FIRQ or CALL_IRQ
+ *  return: Nothing
+ */
+static void call_graph_interrupt(int kind)
+{
+    if ( active->call_graph.depth == 1 )
+        call_graph_enter(active->cpu.last_pc, CALL_ENTRY, CALL_GRAPH_TOP);
 
-        /* BVS / LBVS
-         */
-        case 0x29:
-            if ( cc.v == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    call_graph_charge(active);
+
+    call_graph_enter(active->cpu.pc, kind, active->cpu.s);
+}
+
+/*------------------------------------------------
+ * call_graph_enter()
+ *
+ *  Push a routine onto the shadow stack and count a call
+ *  on the call path from the routine at the top of the stack.
+ *  When the call tree is full the call is charged to the caller,
+ *  and when the shadow stack is full the routine is not pushed.
+ *
+ *  param:  Routine address, CALL_* call type,
+ *          stack address of the return address or interrupt state
+ *  return: Nothing
+ */
+static void call_graph_enter(int routine, int kind, int stack)
+{
+    call_graph_t   *graph = &active->call_graph;
+    int             parent = graph->frame[graph->depth - 1].node;
+    int             node;
 
-        /* BPL / LBPL
-         */
-        case 0x2a:
-            if ( cc.n == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
+    for ( node = graph->node[parent].child; node != -1; node = graph->node[node].sibling )
+    {
+        if ( graph->node[node].routine == routine && graph->node[node].kind == kind )
             break;
+    }
 
-        /* BMI / LBMI
-         */
-        case 0x2b:
-            if ( cc.n == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    if ( node == -1 && graph->nodes < CALL_GRAPH_NODES )
+    {
+        node = graph->nodes++;
+        graph->node[node].routine = routine;
+        graph->node[node].kind = kind;
+        graph->node[node].parent = parent;
+        graph->node[node].child = -1;
+        graph->node[node].sibling = graph->node[parent].child;
+        graph->node[node].calls = 0;
+        graph->node[node].cycles = 0;
+        graph->node[parent].child = node;
+    }
 
-        /* BGE / LBGE
-         */
-        case 0x2c:
-            if ( cc.n == cc.v )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    if ( node == -1 || graph->depth == CALL_GRAPH_DEPTH )
+    {
+        graph->lost++;
+        node = parent;
+    }
+    else
+    {
+        graph->node[node].calls++;
+    }
 
-        /* BLT / LBLT
-         */
-        case 0x2d:
-            if ( cc.n != cc.v )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    if ( graph->depth < CALL_GRAPH_DEPTH )
+    {
+        graph->frame[graph->depth].node = node;
+        graph->frame[graph->depth].stack = stack;
+        graph->depth++;
+    }
+}
 
-        /* BGT / LBGT
-         */
-        case 0x2e:
-            if ( cc.n == cc.v && cc.z == CC_FLAG_CLR )
-                do_branch(long_short, effective_address, cycles);
-            break;
+/*------------------------------------------------
+ * call_graph_charge()
+ *
+ *  Charge the emulated time since the last charge to the
+ *  routine at the top of the shadow stack.
+ *
+ *  param:  Pointer to CPU context
+ *  return: Nothing
+ */
+static void call_graph_charge(cpu_context_t *ctx)
+{
+    call_graph_t   *graph = &ctx->call_graph;
 
-        /* BLE / LBLE
-         */
-        case 0x2f:
-            if ( cc.n != cc.v || cc.z == CC_FLAG_SET )
-                do_branch(long_short, effective_address, cycles);
-            break;
+    if ( ctx->cpu.cycles > graph->charged )
+        graph->node[graph->frame[graph->depth - 1].node].cycles += ctx->cpu.cycles - graph->charged;
 
-        /* Exception: Illegal branch code branch()
-         *
-         * There should be no exception here because this function is always
-         * called from within a switch/case for a valid opcode range.
-         */
-        default:
-            cpu.cpu_state = CPU_EXCEPTION;
-            cpu.exception_line_num = __LINE__;
-    }
+    graph->charged = ctx->cpu.cycles;
 }
 
 /*------------------------------------------------
- * do_branch()
+ * call_graph_restart()
  *
- *  Helper function to do the actual branch
- *  by stacking the PC and changing to the target address.
+ *  Empty the shadow stack, at CPU initialization and RESET.
+ *  The next instruction enters the routine it is in.
  *
- *  param:  Long ('1') or short ('0') branch, 16-bit sign-extended offset,
- *          pointer to opcode cycles.
+ *  param:  Pointer to CPU context
  *  return: Nothing
  */
-static void do_branch(int long_short, uint16_t effective_address, int *cycles)
+static void call_graph_restart(cpu_context_t *ctx)
 {
-    cpu.pc = effective_address;
-    (*cycles) += long_short;
+    call_graph_t   *graph = &ctx->call_graph;
+
+    if ( graph->nodes == 0 )
+    {
+        graph->node[0].routine = 0;
+        graph->node[0].kind = CALL_ROOT;
+        graph->node[0].parent = -1;
+        graph->node[0].child = -1;
+        graph->node[0].sibling = -1;
+        graph->node[0].calls = 0;
+        graph->node[0].cycles = 0;
+        graph->nodes = 1;
+        graph->frame[0].node = 0;
+        graph->frame[0].stack = CALL_GRAPH_TOP;
+        graph->depth = 1;
+        graph->charged = ctx->cpu.cycles;
+    }
+
+    call_graph_charge(ctx);
+    graph->depth = 1;
 }
 
 /*------------------------------------------------
- * get_eff_addr()
+ * call_graph_frame_name()
  *
- *  Calculate and return effective address.
- *  Resolve addressing mode, calculate effective address.
- *  Modifies 'pc' and appropriate index register.
+ *  Folded stack frame name of a call tree node: the routine
+ *  symbol name or address, with the interrupt type of
+ *  interrupt and SWI service routines.
  *
- *  param:  Command op code and command cycles and bytes count to update if needed.
- *  return: Effective Address, '0' if error
+ *  param:  Pointer to call tree node, symbol name function or NULL
+ *  return: Pointer to static string
  */
-static int get_eff_addr(int op_code, int *cycles, int *bytes)
+static const char *call_graph_frame_name(call_node_t *node, cpu_symbol_t symbol)
 {
-    uint16_t    operand;
-    uint16_t   *index_reg = 0;
-    uint16_t    effective_addr = 0;
+    static char     name[64];
+    const char     *prefix = "";
+    const char     *routine_name = symbol ? symbol(node->routine) : 0L;
 
-    switch ( machine_code[op_code].mode )
+    switch ( node->kind )
     {
-        case ADDR_DIRECT:
-            effective_addr = (cpu.dp << 8) + mem_read(cpu.pc);
-            cpu.pc++;
-            break;
+        case CALL_SWI:  prefix = "SWI:";  break;
+        case CALL_NMI:  prefix = "NMI:";  break;
+        case CALL_FIRQ: prefix = "FIRQ:"; break;
+        case CALL_IRQ:  prefix = "IRQ:";  break;
+    }
 
-        case ADDR_RELATIVE:
-            operand = mem_read(cpu.pc);
-            cpu.pc++;
-            effective_addr = cpu.pc + SIG_EXTEND(operand);
-            break;
+    if ( routine_name )
+        snprintf(name, sizeof(name), "%s%s", prefix, routine_name);
+    else
+        snprintf(name, sizeof(name), "%s0x%04x", prefix, node->routine);
 
-        case ADDR_LRELATIVE:
-            operand = (mem_read(cpu.pc) << 8);
-            cpu.pc++;
-            operand += mem_read(cpu.pc);
-            cpu.pc++;
-            effective_addr = cpu.pc + operand;
-            break;
+    return name;
+}
+#endif  /* CALL_GRAPH */
 
-        case ADDR_INDEXED:
-            operand = mem_read(cpu.pc);
-            cpu.pc++;
+#if (CYCLE_AUDIT)
+/*------------------------------------------------
+ * audit_reference()
+ *
+ *  Read the instruction at an address before it is executed,
+ *  and calculate its reference cycles from the op-code and
+ *  post-byte cycles of mc6809e_cycles.h and the CPU state:
+ *  the register list of stack instructions, the E flag of the CC
+ *  pulled by RTI, and the condition of long branches.
+ *  Instructions read from IO pages are not checked.
+ *
+ *  param:  Pointer to audited instruction, instruction address
+ *  return: Nothing
+ */
+static void audit_reference(audit_op_t *op, int address)
+{
+    int     page = 0, op_code, post_byte, cycles, bit;
 
-            switch ( operand & INDX_POST_REG )
-            {
-                case 0x00:
-                    index_reg = &cpu.x;
-                    break;
+    op->pc = address;
+    op->op_code = 0;
+    op->post_byte = -1;
+    op->expected = AUDIT_UNCHECKED;
 
-                case 0x20:
-                    index_reg = &cpu.y;
-                    break;
+    if ( mem_ctx_page_is_io(active->mem, address / MEM_PAGE_SIZE) )
+        return;
 
-                case 0x40:
-                    index_reg = &cpu.u;
-                    break;
+    op_code = MEM_READ(address);
+    op->op_code = op_code;
 
-                case 0x60:
-                    index_reg = &cpu.s;
-                    break;
-            }
+    if ( op_code == 0x10 || op_code == 0x11 )
+    {
+        page = op_code - 0x0f;
+        address = (address + 1) & (MEMORY - 1);
 
-            if ( index_reg == 0 )
-            {
-                cpu.cpu_state = CPU_EXCEPTION;
-                cpu.exception_line_num = __LINE__;
-                break;
-            }
+        if ( mem_ctx_page_is_io(active->mem, address / MEM_PAGE_SIZE) )
+            return;
 
-            /* Check if 5-bit offset is in the post-byte
-             * then process more index address bytes if not.
-             */
-            if ( operand & INDX_POST_5BIT_OFF )
-            {
-                switch ( operand & INDX_POST_MODE )
-                {
-                    case 0: // EA = ,index+ Auto post-increment by 1
-                        effective_addr = *index_reg;
-                        (*index_reg) += 1;
-                        (*cycles) += 2;
-                        break;
+        op_code = MEM_READ(address);
+        op->op_code = (op->op_code << 8) + op_code;
+    }
 
-                    case 1: // EA = ,index++ Auto post-increment by 2
-                        effective_addr = *index_reg;
-                        (*index_reg) += 2;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 6 : 3;
-                        break;
+    cycles = cycle_reference[page][op_code];
+    if ( cycles < 0 )
+    {
+        op->expected = -1;
+        return;
+    }
 
-                    case 2: // EA = ,-index Auto pre-decrement by 1
-                        (*index_reg) -= 1;
-                        effective_addr = *index_reg;
-                        (*cycles) += 2;
-                        break;
+    /* Indexed addressing and stack instructions add the
+     * cycles of the post-byte that follows the op-code
+     */
+    address = (address + 1) & (MEMORY - 1);
 
-                    case 3: // EA = ,--index Auto pre-decrement by 2
-                        (*index_reg) -= 2;
-                        effective_addr = *index_reg;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 6 : 3;
-                        break;
+    if ( (op_code & 0xf0) == 0x60 || (op_code & 0xf0) == 0xa0 || (op_code & 0xf0) == 0xe0 ||
+         (page == 0 && op_code >= 0x30 && op_code <= 0x37) )
+    {
+        if ( mem_ctx_page_is_io(active->mem, address / MEM_PAGE_SIZE) )
+            return;
 
-                    case 4: // EA = 0,index Zero offset
-                        effective_addr = *index_reg;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 3 : 0;
-                        break;
+        post_byte = MEM_READ(address);
+        op->post_byte = post_byte;
 
-                    case 5: // EA = B,index Acc-B with index
-                        effective_addr = *index_reg + SIG_EXTEND(cpu.b);
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 4 : 1;
-                        break;
+        if ( op_code >= 0x34 && op_code <= 0x37 )
+        {
+            /* One cycle per byte of CC, A, B, DP,
+             * and two per X, Y, S or U, and PC
+             */
+            for ( bit = 0; bit < 8; bit++ )
+            {
+                if ( post_byte & (1 << bit) )
+                    cycles += (bit < 4) ? 1 : 2;
+            }
+        }
+        else if ( post_byte & 0x80 )
+        {
+            if ( cycle_reference_index[post_byte & 0x1f] < 0 )
+            {
+                op->expected = -1;
+                return;
+            }
 
-                    case 6: // EA = A,index Acc-A with index
-                        effective_addr = *index_reg + SIG_EXTEND(cpu.a);
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 4 : 1;
-                        break;
+            cycles += cycle_reference_index[post_byte & 0x1f];
+        }
+        else
+        {
+            cycles++;
+        }
+    }
 
-                    case 8: // EA = 8-bit,index 8-bit offset
-                        effective_addr = SIG_EXTEND(mem_read(cpu.pc));
-                        cpu.pc++;
-                        effective_addr += *index_reg;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 4 : 1;
-                        (*bytes) += 1;
-                        break;
+    /* RTI pulls the entire state when the stacked E flag is set
+     */
+    else if ( page == 0 && op_code == 0x3b )
+    {
+        if ( mem_ctx_page_is_io(active->mem, active->cpu.s / MEM_PAGE_SIZE) )
+            return;
 
-                    case 9: // EA = 16-bit,index 16-bit offset
-                        effective_addr = (mem_read(cpu.pc) << 8);
-                        cpu.pc++;
-                        effective_addr += mem_read(cpu.pc);
-                        cpu.pc++;
-                        effective_addr += *index_reg;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 7 : 4;
-                        (*bytes) += 2;
-                        break;
+        if ( MEM_READ(active->cpu.s) & CC_E )
+            cycles += 9;
+    }
 
-                    case 11: // EA = D,index Acc-D with index
-                        effective_addr = *index_reg + d;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 7 : 4;
-                        break;
+    /* A taken long conditional branch uses one more cycle
+     */
+    else if ( page == 1 && op_code >= 0x22 && op_code <= 0x2f )
+    {
+        cycles += audit_branch_taken(get_cc(), op_code);
+    }
 
-                    case 12: // EA = 8-bit,pc PC relative
-                        effective_addr = SIG_EXTEND(mem_read(cpu.pc));
-                        cpu.pc++;
-                        effective_addr += cpu.pc;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 4 : 1;
-                        (*bytes) += 1;
-                        break;
+    op->expected = cycles;
+}
 
-                    case 13: // EA = 16-bit,pc PC relative
-                        effective_addr = (mem_read(cpu.pc) << 8);
-                        cpu.pc++;
-                        effective_addr += mem_read(cpu.pc);
-                        cpu.pc++;
-                        effective_addr += cpu.pc;
-                        (*cycles) += (operand & INDX_POST_INDIRECT) ? 8 : 5;
-                        (*bytes) += 2;
-                        break;
+/*------------------------------------------------
+ * audit_branch_taken()
+ *
+ *  Evaluate a branch condition with the
+ *  data sheet branch test of each condition.
+ *
+ *  param:  Packed CC register, branch op-code 0x20 to 0x2f
+ *  return: '1' branch taken, '0' not taken
+ */
+static int audit_branch_taken(uint8_t cc, int op_code)
+{
+    int     c = (cc & CC_C) != 0;
+    int     v = (cc & CC_V) != 0;
+    int     z = (cc & CC_Z) != 0;
+    int     n = (cc & CC_N) != 0;
 
-                    case 15: // EA = [addr] Extended Indirect will always be indirect.
-                        effective_addr = (mem_read(cpu.pc) << 8);
-                        cpu.pc++;
-                        effective_addr += mem_read(cpu.pc);
-                        cpu.pc++;
-                        (*cycles) += 5;
-                        (*bytes) += 2;
-                        break;
+    switch ( op_code )
+    {
+        case 0x20: return 1;                    // BRA
+        case 0x21: return 0;                    // BRN
+        case 0x22: return (c | z) == 0;         // BHI
+        case 0x23: return (c | z) == 1;         // BLS
+        case 0x24: return c == 0;               // BHS, BCC
+        case 0x25: return c == 1;               // BLO, BCS
+        case 0x26: return z == 0;               // BNE
+        case 0x27: return z == 1;               // BEQ
+        case 0x28: return v == 0;               // BVC
+        case 0x29: return v == 1;               // BVS
+        case 0x2a: return n == 0;               // BPL
+        case 0x2b: return n == 1;               // BMI
+        case 0x2c: return (n ^ v) == 0;         // BGE
+        case 0x2d: return (n ^ v) == 1;         // BLT
+        case 0x2e: return (z | (n ^ v)) == 0;   // BGT
+        case 0x2f: return (z | (n ^ v)) == 1;   // BLE
+    }
 
-                    default:
-                        /* Exception: Illegal indexing mode get_eff_addr()
-                         */
-                        cpu.cpu_state = CPU_EXCEPTION;
-                        cpu.exception_line_num = __LINE__;
-                }
+    return 0;
+}
 
-                /* Resolve indirect addresses
-                 * Rely on assembler-generated code to reliably include the indirect bit
-                 * i.e. not for auto inc/dec by one.
-                 */
-                if ( operand & INDX_POST_INDIRECT )
-                {
-                    effective_addr = (mem_read(effective_addr) << 8) + mem_read(effective_addr + 1);
-                }
-            }
-            /* 5-bit offset is in the post-bytes
-             */
-            else
-            {
-                operand &= 0x001f;
-                if ( operand & 0x0010 )
-                    operand |= 0xfff0;  // Extend the sign of the 5-bit offset into 16-bit
-                effective_addr = *index_reg + operand;
-                (*cycles)++;
-            }
-            break;
+/*------------------------------------------------
+ * audit_check()
+ *
+ *  Check the cycles of an executed instruction against its
+ *  reference cycles, and log a mismatch by address, op-code
+ *  and cycles. Instructions that raised an exception
+ *  are not checked.
+ *
+ *  param:  Pointer to audited instruction, cycles counted by the CPU module
+ *  return: Nothing
+ */
+static void audit_check(audit_op_t *op, int cycles)
+{
+    cpu_cycle_audit_t      *audit = &active->audit;
+    cpu_audit_mismatch_t   *entry;
+    int                     i;
 
-        case ADDR_EXTENDED:
-            effective_addr = (mem_read(cpu.pc) << 8);
-            cpu.pc++;
-            effective_addr += mem_read(cpu.pc);
-            cpu.pc++;
-            break;
+    if ( op->expected == AUDIT_UNCHECKED || active->cpu.cpu_state == CPU_EXCEPTION )
+        return;
 
-        case ADDR_IMMEDIATE:
-            effective_addr = cpu.pc;
-            cpu.pc += 1;
-            break;
+    audit->instructions++;
 
-        case ADDR_LIMMEDIATE:
-            effective_addr = cpu.pc;
-            cpu.pc += 2;
-            break;
+    if ( cycles == op->expected )
+        return;
 
-        case ADDR_INHERENT:
-            break;
+    audit->mismatches++;
 
-        default:
-            /* Exception: Illegal address mode get_eff_addr()
-             */
-            cpu.cpu_state = CPU_EXCEPTION;
-            cpu.exception_line_num = __LINE__;
+    for ( i = 0; i < audit->logged; i++ )
+    {
+        entry = &audit->log[i];
+        if ( entry->pc == op->pc && entry->op_code == op->op_code &&
+             entry->post_byte == op->post_byte && entry->cycles == cycles )
+        {
+            entry->count++;
+            return;
+        }
     }
 
-    return effective_addr;
+    if ( audit->logged == CPU_AUDIT_LOG )
+    {
+        audit->lost++;
+        return;
+    }
+
+    entry = &audit->log[audit->logged++];
+    entry->pc = op->pc;
+    entry->op_code = op->op_code;
+    entry->post_byte = op->post_byte;
+    entry->expected = op->expected;
+    entry->cycles = cycles;
+    entry->count = 1;
 }
+#endif  /* CYCLE_AUDIT */
 
 /*------------------------------------------------
  * read_register()
@@ -2943,59 +8515,30 @@ static int get_eff_addr(int op_code, int *cycles, int *bytes)
  */
 static uint16_t read_register(int reg)
 {
-    uint16_t    temp;
+    const register_decode_t *entry = &register_decode[reg & 0x0f];
+    uint8_t *reg_addr = (uint8_t *) &active->cpu + entry->offset;
 
-    switch ( reg )
+    switch ( entry->kind )
     {
-        case 0:
-            temp = d;
-            break;
-
-        case 1:
-            temp = cpu.x;
-            break;
-
-        case 2:
-            temp = cpu.y;
-            break;
-
-        case 3:
-            temp = cpu.u;
-            break;
-
-        case 4:
-            temp = cpu.s;
-            break;
-
-        case 5:
-            temp = cpu.pc;
-            break;
-
-        case 8:
-            temp = cpu.a;
-            break;
-
-        case 9:
-            temp = cpu.b;
-            break;
+        case REG_WORD:
+            return *(uint16_t *) reg_addr;
 
-        case 10:
-            temp = (uint16_t) get_cc();
-            break;
+        case REG_BYTE:
+            return *reg_addr;
 
-        case 11:
-            temp = cpu.dp;
-            break;
+        case REG_CC:
+            return get_cc();
 
-        default:
-            temp = 0;
-            /* Exception: Illegal register read_register()
-             */
-            cpu.cpu_state = CPU_EXCEPTION;
-            cpu.exception_line_num = __LINE__;
+        case REG_ZERO:
+            return 0;
     }
 
-    return temp;
+    /* Exception: Illegal register read_register()
+     */
+    set_state(CPU_EXCEPTION);
+    active->cpu.exception_line_num = __LINE__;
+
+    return 0;
 }
 
 /*------------------------------------------------
@@ -3003,62 +8546,40 @@ static uint16_t read_register(int reg)
  *
  *  Write value to a register.
  *  Register number is as defined for EXG and TFR op-codes.
+ *  8-bit registers are written with the low byte of the value.
  *
  *  param:  Register number and data to write into it.
  *  return: Nothing
  */
 static void write_register(int reg, uint16_t data)
 {
-    switch ( reg )
-    {
-        case 0:
-            cpu.a = (uint8_t)((data & 0xff00) >> 8);
-            cpu.b = (uint8_t)(data & 0x00ff);
-            break;
-
-        case 1:
-            cpu.x = data;
-            break;
-
-        case 2:
-            cpu.y = data;
-            break;
-
-        case 3:
-            cpu.u = data;
-            break;
-
-        case 4:
-            cpu.s = data;
-            cpu.nmi_armed = 1;
-            break;
-
-        case 5:
-            cpu.pc = data;
-            break;
+    const register_decode_t *entry = &register_decode[reg & 0x0f];
+    uint8_t *reg_addr = (uint8_t *) &active->cpu + entry->offset;
 
-        case 8:
-            cpu.a = (uint8_t)(data & 0x00ff);
-            break;
+    switch ( entry->kind )
+    {
+        case REG_WORD:
+            *(uint16_t *) reg_addr = data;
+            if ( reg == 4 )
+                active->cpu.nmi_armed = 1;
+            return;
 
-        case 9:
-            cpu.b = (uint8_t)(data & 0x00ff);
-            break;
+        case REG_BYTE:
+            *reg_addr = (uint8_t) data;
+            return;
 
-        case 10:
+        case REG_CC:
             set_cc((uint8_t) data);
-            break;
-
-        case 11:
-            cpu.dp = (uint8_t)(data & 0x00ff);
-            break;
+            return;
 
-        default:
-            /* Exception: Illegal register write_register()
-             */
-            cpu.cpu_state = CPU_EXCEPTION;
-            cpu.exception_line_num = __LINE__;
+        case REG_ZERO:
+            return;
     }
+
+    /* Exception: Illegal register write_register()
+     */
+    set_state(CPU_EXCEPTION);
+    active->cpu.exception_line_num = __LINE__;
 }
 
 /*------------------------------------------------
@@ -3071,9 +8592,14 @@ static void write_register(int reg, uint16_t data)
  */
 static void eval_cc_c(uint16_t value)
 {
-    cc.c = (value & 0x100) ? CC_FLAG_SET : CC_FLAG_CLR;
+#if (CPU_LAZY_CC)
+    active->cc.c = value << 8;
+#else
+    active->cpu.cc = (active->cpu.cc & ~CC_C) | ((value >> 8) & CC_C);
+#endif
 }
 
+#if (CPU_LAZY_CC)
 /*------------------------------------------------
  * eval_cc_c16()
  *
@@ -3084,8 +8610,9 @@ static void eval_cc_c(uint16_t value)
  */
 static void eval_cc_c16(uint32_t value)
 {
-    cc.c = (value & 0x00010000) ? CC_FLAG_SET : CC_FLAG_CLR;
+    active->cc.c = value;
 }
+#endif
 
 /*------------------------------------------------
  * eval_cc_z()
@@ -3097,7 +8624,11 @@ static void eval_cc_c16(uint32_t value)
  */
 static void eval_cc_z(uint16_t value)
 {
-    cc.z = !(value & 0x00ff) ? CC_FLAG_SET : CC_FLAG_CLR;
+#if (CPU_LAZY_CC)
+    active->cc.z = value & 0x00ff;
+#else
+    active->cpu.cc = (active->cpu.cc & ~CC_Z) | (!(value & 0x00ff) ? CC_Z : 0);
+#endif
 }
 
 /*------------------------------------------------
@@ -3110,35 +8641,69 @@ static void eval_cc_z(uint16_t value)
  */
 static void eval_cc_z16(uint32_t value)
 {
-    cc.z = !(value & 0x0000ffff) ? CC_FLAG_SET : CC_FLAG_CLR;
+#if (CPU_LAZY_CC)
+    active->cc.z = value & 0x0000ffff;
+#else
+    active->cpu.cc = (active->cpu.cc & ~CC_Z) | (!(value & 0x0000ffff) ? CC_Z : 0);
+#endif
+}
+
+/*------------------------------------------------
+ * eval_cc_nz()
+ *
+ *  Evaluate sign bit and zero value of input and set/clear
+ *  CC.N and CC.Z flags.
+ *
+ *  param:  Input value
+ *  return: Nothing
+ */
+static void eval_cc_nz(uint16_t value)
+{
+#if (CPU_LAZY_CC)
+    active->cc.n = (uint16_t) (value << 8);
+    active->cc.z = active->cc.n;
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z)) | ((value >> 4) & CC_N) | (!(value & 0x00ff) ? CC_Z : 0);
+#endif
 }
 
 /*------------------------------------------------
- * eval_cc_n()
+ * eval_cc_nz16()
  *
- *  Evaluate sign bit value of input and set/clear CC.N flag.
+ *  Evaluate sign bit and zero value of 16-bit input and set/clear
+ *  CC.N and CC.Z flags.
  *
  *  param:  Input value
  *  return: Nothing
  */
-static void eval_cc_n(uint16_t value)
+static void eval_cc_nz16(uint32_t value)
 {
-    cc.n = (value & 0x0080) ? CC_FLAG_SET : CC_FLAG_CLR;
+#if (CPU_LAZY_CC)
+    active->cc.n = value & 0x0000ffff;
+    active->cc.z = active->cc.n;
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z)) | ((value >> 12) & CC_N) | (!(value & 0x0000ffff) ? CC_Z : 0);
+#endif
 }
 
+#if (CPU_6309)
 /*------------------------------------------------
- * eval_cc_n16()
+ * eval_cc_nz32()
  *
- *  Evaluate sign bit value of input and set/clear CC.N flag.
+ *  Evaluate sign bit and zero value of HD6309 32-bit
+ *  input and set/clear CC.N and CC.Z flags.
  *
  *  param:  Input value
  *  return: Nothing
  */
-static void eval_cc_n16(uint32_t value)
+static void eval_cc_nz32(uint32_t value)
 {
-    cc.n = (value & 0x00008000) ? CC_FLAG_SET : CC_FLAG_CLR;
+    SET_CC_N((value & 0x80000000) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_Z(!value ? CC_FLAG_SET : CC_FLAG_CLR);
 }
+#endif
 
+#if (CPU_LAZY_CC)
 /*------------------------------------------------
  * eval_cc_v()
  *
@@ -3153,9 +8718,11 @@ static void eval_cc_n16(uint32_t value)
  */
 static void eval_cc_v(uint8_t val1, uint8_t val2, uint16_t result)
 {
-    cc.v = ((val1 ^ result) & (val2 ^ result) & 0x0080) ? CC_FLAG_SET : CC_FLAG_CLR;
+    active->cc.v = ((val1 ^ result) & (val2 ^ result)) << 8;
 }
+#endif
 
+#if (CPU_LAZY_CC)
 /*------------------------------------------------
  * eval_cc_v16()
  *
@@ -3170,9 +8737,11 @@ static void eval_cc_v(uint8_t val1, uint8_t val2, uint16_t result)
  */
 static void eval_cc_v16(uint16_t val1, uint16_t val2, uint32_t result)
 {
-    cc.v = ((val1 ^ result) & (val2 ^ result) & 0x00008000) ? CC_FLAG_SET : CC_FLAG_CLR;
+    active->cc.v = (val1 ^ result) & (val2 ^ result);
 }
+#endif
 
+#if (CPU_LAZY_CC)
 /*------------------------------------------------
  * eval_cc_h()
  *
@@ -3186,7 +8755,97 @@ static void eval_cc_h(uint8_t val1, uint8_t val2, uint8_t result)
 {
     /* Half carry in 6809 is only relevant/valid for additions ADD and ADC
      */
-    cc.h = (((val1 ^ val2) ^ result) & 0x10) ? CC_FLAG_SET : CC_FLAG_CLR;
+    active->cc.h = (val1 ^ val2) ^ result;
+}
+#endif
+
+/*------------------------------------------------
+ * eval_cc_nzv()
+ * eval_cc_nzvc()
+ * eval_cc_hnzvc()
+ *
+ *  Evaluate the flags of an 8-bit arithmetic result: N, Z and V,
+ *  N, Z, V and C, or H, N, Z, V and C. The CC register is read
+ *  and written once.
+ *
+ *  param:  Input operands and result, as for eval_cc_v()
+ *  return: Nothing
+ */
+static void eval_cc_nzv(uint8_t val1, uint8_t val2, uint16_t result)
+{
+#if (CPU_LAZY_CC)
+    eval_cc_nz(result);
+    eval_cc_v(val1, val2, result);
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z | CC_V)) |
+                     ((result >> 4) & CC_N) | (!(result & 0x00ff) ? CC_Z : 0) |
+                     ((((val1 ^ result) & (val2 ^ result)) >> 6) & CC_V);
+#endif
+}
+
+static void eval_cc_nzvc(uint8_t val1, uint8_t val2, uint16_t result)
+{
+#if (CPU_LAZY_CC)
+    eval_cc_c(result);
+    eval_cc_nz(result);
+    eval_cc_v(val1, val2, result);
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z | CC_V | CC_C)) |
+                     ((result >> 4) & CC_N) | (!(result & 0x00ff) ? CC_Z : 0) |
+                     ((((val1 ^ result) & (val2 ^ result)) >> 6) & CC_V) | ((result >> 8) & CC_C);
+#endif
+}
+
+static void eval_cc_hnzvc(uint8_t val1, uint8_t val2, uint16_t result)
+{
+#if (CPU_LAZY_CC)
+    eval_cc_c(result);
+    eval_cc_nz(result);
+    eval_cc_v(val1, val2, result);
+    eval_cc_h(val1, val2, result);
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_H | CC_N | CC_Z | CC_V | CC_C)) |
+                     ((((val1 ^ val2) ^ result) << 1) & CC_H) |
+                     ((result >> 4) & CC_N) | (!(result & 0x00ff) ? CC_Z : 0) |
+                     ((((val1 ^ result) & (val2 ^ result)) >> 6) & CC_V) | ((result >> 8) & CC_C);
+#endif
+}
+
+/*------------------------------------------------
+ * eval_cc_nzv16()
+ * eval_cc_nzvc16()
+ *
+ *  Evaluate the flags of a 16-bit arithmetic result: N, Z and V,
+ *  or N, Z, V and C. The CC register is read and written once.
+ *
+ *  param:  Input operands and result, as for eval_cc_v16()
+ *  return: Nothing
+ */
+#if (CPU_6309)
+static void eval_cc_nzv16(uint16_t val1, uint16_t val2, uint32_t result)
+{
+#if (CPU_LAZY_CC)
+    eval_cc_nz16(result);
+    eval_cc_v16(val1, val2, result);
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z | CC_V)) |
+                     ((result >> 12) & CC_N) | (!(result & 0x0000ffff) ? CC_Z : 0) |
+                     ((((val1 ^ result) & (val2 ^ result)) >> 14) & CC_V);
+#endif
+}
+#endif
+
+static void eval_cc_nzvc16(uint16_t val1, uint16_t val2, uint32_t result)
+{
+#if (CPU_LAZY_CC)
+    eval_cc_c16(result);
+    eval_cc_nz16(result);
+    eval_cc_v16(val1, val2, result);
+#else
+    active->cpu.cc = (active->cpu.cc & ~(CC_N | CC_Z | CC_V | CC_C)) |
+                     ((result >> 12) & CC_N) | (!(result & 0x0000ffff) ? CC_Z : 0) |
+                     ((((val1 ^ result) & (val2 ^ result)) >> 14) & CC_V) | ((result >> 16) & CC_C);
+#endif
 }
 
 /*------------------------------------------------
@@ -3199,8 +8858,12 @@ static void eval_cc_h(uint8_t val1, uint8_t val2, uint8_t result)
  */
 static uint8_t get_cc(void)
 {
-    return (uint8_t) ((cc.e << 7) + (cc.f << 6) + (cc.h << 5) + (cc.i << 4) + \
-                      (cc.n << 3) + (cc.z << 2) + (cc.v << 1) + cc.c );
+#if (CPU_LAZY_CC)
+    return (uint8_t) ((GET_CC_E() << 7) + (GET_CC_F() << 6) + (GET_CC_H() << 5) + (GET_CC_I() << 4) + \
+                      (GET_CC_N() << 3) + (GET_CC_Z() << 2) + (GET_CC_V() << 1) + GET_CC_C() );
+#else
+    return active->cpu.cc;
+#endif
 }
 
 /*------------------------------------------------
@@ -3213,12 +8876,16 @@ static uint8_t get_cc(void)
  */
 static void set_cc(uint8_t value)
 {
-    cc.c = (value & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.v = (value & 0x02) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.z = (value & 0x04) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.n = (value & 0x08) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.i = (value & 0x10) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.h = (value & 0x20) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.f = (value & 0x40) ? CC_FLAG_SET : CC_FLAG_CLR;
-    cc.e = (value & 0x80) ? CC_FLAG_SET : CC_FLAG_CLR;
+#if (CPU_LAZY_CC)
+    SET_CC_C((value & 0x01) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_V((value & 0x02) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_Z((value & 0x04) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_N((value & 0x08) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_I((value & 0x10) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_H((value & 0x20) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_F((value & 0x40) ? CC_FLAG_SET : CC_FLAG_CLR);
+    SET_CC_E((value & 0x80) ? CC_FLAG_SET : CC_FLAG_CLR);
+#else
+    active->cpu.cc = value;
+#endif
 }
@@ -3,6 +3,9 @@
  *
  *  DRAGON DATA computer emulator, main module.
  *  With MC6809E CPU emulation.
+ *  The SAM, PIA and VDG modules keep their state in module globals
+ *  and use the default CPU and memory contexts, so one Dragon
+ *  machine runs per process.
  *
  *  February 6, 2021
  *
@@ -18,6 +21,7 @@
 #include    "vdg.h"
 #include    "pia.h"
 #include    "loader.h"
+#include    "symbols.h"
 
 /* -----------------------------------------
    Dragon 32 ROM image
@@ -30,14 +34,22 @@
 #define     DRAGON_ROM_START        0x8000
 #define     DRAGON_ROM_END          0xfeff
 #define     ESCAPE_LOADER           1       // Pressing F1
+#define     ESCAPE_CALL_GRAPH       2       // Pressing F2
 #define     LONG_RESET_DELAY        1500000 // Micro-seconds to force cold start
-#define     VDG_RENDER_CYCLES       4450    // CPU cycle count for ~50mSec screen refresh rate
-#define     CPU_TIME_WASTE          300     // Results in a CPU cycle of 4uSec
+#define     VDG_RENDER_CYCLES       17784   // CPU cycle count for 50Hz screen refresh rate (312 lines x 57 cycles)
+#define     CPU_BATCH_CYCLES        20      // CPU cycles per cpu_run_cycles() call, keep low for DAC audio timing
+#define     CPU_TIME_WASTE          75      // Per CPU cycle, results in a CPU cycle of ~1uSec
+#define     CPU_CYCLE_USEC          1       // Host sleep time per skipped or fast forwarded CPU cycle
+#define     CPU_SLEEP_CYCLES        1000    // Minimum idle cycles of a host sleep or fast forward
+#define     SYMBOL_FILE             "dragon.lst"        // Optional as9 listing of guest machine code
+#define     CALL_GRAPH_FOLDED       "dragon.folded"     // Call graph folded stacks
+#define     CALL_GRAPH_REPORT       "dragon-calls.txt"  // Call graph routine report
 
 /* -----------------------------------------
    Module functions
 ----------------------------------------- */
 static int get_reset_state(uint32_t time);
+static void host_time(int cycles);
 
 /*------------------------------------------------
  * main()
@@ -51,7 +63,9 @@ static int get_reset_state(uint32_t time);
 {
     int     i;
     int     emulator_escape_code;
-    int     vdg_render_cycles = 0;
+    uint64_t vdg_render_time = VDG_RENDER_CYCLES;
+    uint64_t idle_cycles;
+    int     cycles;
 
     if ( rpi_gpio_init() == -1 )
     {
@@ -80,8 +94,17 @@ static int get_reset_state(uint32_t time);
     pia_init();
     vdg_init();
 
+    /* Guest symbols for the call graph
+     */
+    i = sym_load_dragon_rom();
+    printf("Loaded %i ROM symbols.\n", i);
+    i = sym_load_lst(SYMBOL_FILE, 0);
+    if ( i >= 0 )
+        printf("Loaded %i symbols from %s.\n", i, SYMBOL_FILE);
+
     printf("Initializing CPU.\n");
     cpu_init(RUN_ADDRESS);
+    cpu_set_event(vdg_render_time);
 
     /* CPU endless execution loop.
      */
@@ -91,10 +114,22 @@ static int get_reset_state(uint32_t time);
     for (;;)
     {
         //rpi_testpoint_on();
-        cpu_run();
+        cycles = cpu_run_cycles(CPU_BATCH_CYCLES);
         //rpi_testpoint_off();
 
-        for ( i = 0; i < CPU_TIME_WASTE; i++);
+        host_time(cycles);
+
+        /* An idle guest, in a delay or polling loop or waiting in SYNC or CWAI,
+         * is fast forwarded to the end of the loop or the next event
+         * while the host sleeps.
+         */
+        idle_cycles = cpu_idle_cycles_left();
+        if ( cpu_get_run_state() != CPU_RESET &&
+             idle_cycles >= CPU_SLEEP_CYCLES && idle_cycles <= VDG_RENDER_CYCLES )
+        {
+            cycles = cpu_run_cycles((int) idle_cycles);
+            host_time(cycles);
+        }
 
         switch ( get_reset_state(LONG_RESET_DELAY) )
         {
@@ -121,14 +156,29 @@ static int get_reset_state(uint32_t time);
         if ( emulator_escape_code == ESCAPE_LOADER )
             loader();
 
-        vdg_render_cycles++;
-        if ( vdg_render_cycles == VDG_RENDER_CYCLES )
+        /* Write the call graph since the last F2 press, if built with CPU_CALL_GRAPH
+         */
+        if ( emulator_escape_code == ESCAPE_CALL_GRAPH )
+        {
+            if ( cpu_call_graph_folded(CALL_GRAPH_FOLDED, sym_name) == 0 &&
+                 cpu_call_graph_report(CALL_GRAPH_REPORT, sym_name) == 0 )
+                printf("Call graph written to %s and %s.\n", CALL_GRAPH_FOLDED, CALL_GRAPH_REPORT);
+            else
+                printf("Call graph not written.\n");
+
+            cpu_call_graph_clear();
+        }
+
+        /* The CPU run stops at the frame time set as the event deadline.
+         */
+        if ( cpu_cycles_to_event() == 0 )
         {
             //rpi_testpoint_on();
             vdg_render();
             //rpi_testpoint_off();
             pia_vsync_irq();
-            vdg_render_cycles = 0;
+            vdg_render_time += VDG_RENDER_CYCLES;
+            cpu_set_event(vdg_render_time);
         }
     }
 
@@ -171,3 +221,35 @@ static int get_reset_state(uint32_t time)
 
     return reset_type;
 }
+
+/*------------------------------------------------
+ * host_time()
+ *
+ * Pace the host to the emulated time of a CPU run. Executed
+ * cycles are paced by the time-waste loop. Cycles that the CPU
+ * skipped in idle loops or waited are added up and slept with
+ * rpi_sleep() once they reach CPU_SLEEP_CYCLES.
+ *
+ * param:  CPU cycles of the run
+ * return: Nothing
+ *
+ */
+static void host_time(int cycles)
+{
+    static int          sleep_cycles = 0;
+    cpu_idle_stats_t    idle;
+    volatile int        i;
+
+    cpu_get_idle_stats(&idle, 1);
+
+    /* The loop counter is volatile so that the compiler keeps the loop
+     */
+    for ( i = 0; i < (cycles - (int) idle.idle) * CPU_TIME_WASTE; i++);
+
+    sleep_cycles += (int) idle.idle;
+    if ( sleep_cycles >= CPU_SLEEP_CYCLES )
+    {
+        rpi_sleep(sleep_cycles * CPU_CYCLE_USEC);
+        sleep_cycles = 0;
+    }
+}
@@ -23,6 +23,9 @@
 //#include    "test/stack.h"
 //#include    "test/addr.h"
 //#include    "test/branch.h"
+//#include    "test/smc.h"
+//#include    "test/fusion.h"
+//#include    "test/hd6309.h"      // Requires CPU_6309
 #include    "test/swi.h"
 
 /* -----------------------------------------
@@ -0,0 +1,337 @@
+/********************************************************************
+ * idle09.c
+ *
+ *  Guest idle loop skipping test.
+ *  Checks polling loops on IO addresses with and without side
+ *  effects, and that the Dragon 32 ROM is idle at the BASIC 'OK'
+ *  prompt, with the dragon.c main loop fast forward.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "config.h"
+#include    "mem.h"
+#include    "cpu.h"
+#include    "sam.h"
+#include    "vdg.h"
+
+/* -----------------------------------------
+   Dragon 32 ROM image
+----------------------------------------- */
+#include    "dragon/dragon.h"
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     ROM_START               0x8000
+#define     ROM_END                 0xfeff
+#define     PIA_START               0xff00
+#define     PIA_END                 0xff3f
+#define     PIA_MASK                0x3f        // PIA registers, 0xff00 to 0xff3f
+#define     PIA_PORT_MASK           0x23        // PIA and register, without the mirror address bits
+#define     PIA0_PA                 0x00
+#define     PIA0_PB                 0x02
+#define     PIA0_PA_IDLE            0x7f        // No key pressed, joystick comparator low
+
+#define     POLL_START              0x1000      // Polling loop test program
+#define     POLL_FLAG               0xff03      // Polled IO address, PIA0 control register B
+#define     POLL_CYCLES             20000
+#define     POLL_BATCH_CYCLES       1000
+
+#define     FRAME_CYCLES            17784       // dragon.c video frame and batch cycles
+#define     BATCH_CYCLES            20
+#define     SLEEP_CYCLES            1000        // dragon.c minimum fast forward
+#define     BOOT_FRAMES             100         // Frames to the prompt
+#define     PROMPT_FRAMES           50          // Frames at the prompt
+#define     BOOT_SCREEN             0x0400      // Text screen
+#define     BOOT_SCREEN_COLUMNS     32
+#define     BOOT_SCREEN_ROWS        16
+
+#define     CHECK(c)                check((c), #c, __LINE__)
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+int     test_poll(int pure);
+int     test_prompt(void);
+int     find_prompt(void);
+int     check(int condition, const char *text, int line);
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+int     failures = 0;
+uint8_t pia_registers[PIA_MASK + 1];
+long    pia_reads = 0;
+
+/* Polling loop, waits for bit 7 of the PIA0 control
+ * register B, the field sync IRQ flag
+ */
+const uint8_t code_poll[] =
+{
+    0xb6, 0xff, 0x03,           // LDA  $FF03
+    0x2a, 0xfb,                 // BPL  $1000
+    0x20, 0xfe,                 // BRA  *
+};
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: idle09
+ *
+ *  Returns '1' if any check failed.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    printf("Guest idle loop skipping test.\n");
+
+#if (CPU_IDLE_SKIP && CPU_TRANSLATE)
+    printf("%-32s %s\n", "polling, IO with side effects", test_poll(0) ? "failed" : "ok");
+    printf("%-32s %s\n", "polling, IO without side effects", test_poll(1) ? "failed" : "ok");
+    printf("%-32s %s\n", "Dragon ROM 'OK' prompt", test_prompt() ? "failed" : "ok");
+#else
+    printf("Built without CPU_IDLE_SKIP or CPU_TRANSLATE, no tests run.\n");
+#endif
+
+    return (failures != 0);
+}
+
+/*------------------------------------------------
+ * test_poll()
+ *
+ *  Run a polling loop on a PIA register that never changes. The
+ *  loop is skipped only if the register is declared without side
+ *  effects, otherwise every read calls the IO handler.
+ *
+ *  param:  '1' declare the register without side effects, '0' not
+ *  return: Count of failed checks
+ */
+int test_poll(int pure)
+{
+    int     cycles = 0, idle = 0, start = failures;
+
+    mem_init();
+    mem_define_io(PIA_START, PIA_END, io_handler_pia);
+    if ( pure )
+        mem_define_io_pure(POLL_FLAG, POLL_FLAG);
+    mem_load(POLL_START, (uint8_t *) code_poll, sizeof(code_poll));
+
+    memset(pia_registers, 0, sizeof(pia_registers));
+    pia_reads = 0;
+
+    cpu_init(POLL_START);
+
+    while ( cycles < POLL_CYCLES )
+    {
+        cycles += cpu_run_cycles(POLL_BATCH_CYCLES);
+        idle |= cpu_is_idle();
+    }
+
+    CHECK(mem_ctx_read_is_pure(mem_default_context(), POLL_FLAG) == pure);
+    CHECK(mem_ctx_read_is_pure(mem_default_context(), PIA_START + PIA0_PB) == 0);
+
+    if ( pure )
+    {
+        /* At most a few iterations of every batch are run
+         */
+        CHECK(idle);
+        CHECK(pia_reads < POLL_CYCLES / POLL_BATCH_CYCLES * 4);
+        CHECK(cpu_idle_cycles_left() > 0);
+    }
+    else
+    {
+        /* LDA extended and BPL, 8 cycles per iteration
+         */
+        CHECK(!idle);
+        CHECK(pia_reads >= cycles / 8);
+        CHECK(cpu_idle_cycles_left() == 0);
+    }
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * test_prompt()
+ *
+ *  Boot the Dragon 32 ROM to the 'OK' prompt with the dragon.c
+ *  main loop: batches of 20 cycles, a fast forward to the end of the
+ *  idle time when the guest is idle for at least 1000 cycles, and a
+ *  field sync IRQ every video frame. At the prompt, the ROM blinks
+ *  the cursor with a delay loop between keyboard scans, and must be
+ *  reported idle for most of its time.
+ *
+ *  param:  Nothing
+ *  return: Count of failed checks
+ */
+int test_prompt(void)
+{
+    cpu_idle_stats_t    stats;
+    uint64_t            deadline = FRAME_CYCLES, idle_cycles;
+    int                 i, frame = 0, idle_runs = 0, fast_forwards = 0;
+    int                 start = failures;
+
+    mem_init();
+    for ( i = 0; code[i] != -1; i++ )
+        mem_write(LOAD_ADDRESS + i, code[i]);
+    mem_define_rom(ROM_START, ROM_END);
+    sam_init();
+
+    /* The keyboard row input and control registers read like pia.c
+     */
+    mem_define_io(PIA_START, PIA_END, io_handler_pia);
+    mem_define_io_pure(PIA_START + PIA0_PA, PIA_START + PIA0_PA);
+    mem_define_io_pure(PIA_START + 0x01, PIA_START + 0x01);
+    mem_define_io_pure(PIA_START + 0x03, PIA_START + 0x03);
+    memset(pia_registers, 0, sizeof(pia_registers));
+
+    cpu_init(RUN_ADDRESS);
+    cpu_reset(1);
+    cpu_run();
+    cpu_reset(0);
+    cpu_set_event(deadline);
+
+    while ( frame < BOOT_FRAMES + PROMPT_FRAMES )
+    {
+        cpu_run_cycles(BATCH_CYCLES);
+
+        idle_cycles = cpu_idle_cycles_left();
+        if ( frame >= BOOT_FRAMES && cpu_is_idle() )
+            idle_runs++;
+
+        if ( idle_cycles >= SLEEP_CYCLES && idle_cycles <= FRAME_CYCLES )
+        {
+            cpu_run_cycles((int) idle_cycles);
+            if ( frame >= BOOT_FRAMES )
+                fast_forwards++;
+        }
+
+        if ( cpu_cycles_to_event() == 0 )
+        {
+            frame++;
+            if ( frame == BOOT_FRAMES )
+                cpu_get_idle_stats(&stats, 1);
+
+            deadline += FRAME_CYCLES;
+            cpu_set_event(deadline);
+        }
+    }
+
+    cpu_get_idle_stats(&stats, 0);
+
+    printf("%-32s %.1f%% idle, %i fast forwards in %i frames\n", "", stats.idle_ratio, fast_forwards, PROMPT_FRAMES);
+
+    CHECK(find_prompt());
+    CHECK(cpu_get_run_state() == CPU_EXEC);
+    CHECK(idle_runs > 0);
+    CHECK(fast_forwards > 0);
+    CHECK(stats.idle_ratio > 50.0);
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * find_prompt()
+ *
+ *  Find a text screen row starting with the 'OK' prompt,
+ *  characters in VDG code 0x40 to 0x7f.
+ *
+ *  param:  Nothing
+ *  return: '1' if found, '0' if not
+ */
+int find_prompt(void)
+{
+    static const char  prompt[] = "OK";
+
+    int     row, column;
+
+    for ( row = 0; row < BOOT_SCREEN_ROWS; row++ )
+    {
+        for ( column = 0; prompt[column]; column++ )
+        {
+            if ( mem_read(BOOT_SCREEN + row * BOOT_SCREEN_COLUMNS + column) != ((prompt[column] & 0x3f) | 0x40) )
+                break;
+        }
+
+        if ( !prompt[column] )
+            return 1;
+    }
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * check()
+ *
+ *  Count and print a failed check.
+ *
+ *  param:  Check result, check text and source line
+ *  return: Check result
+ */
+int check(int condition, const char *text, int line)
+{
+    if ( !condition )
+    {
+        printf("  check failed, idle09.c line %i: %s\n", line, text);
+        failures++;
+    }
+
+    return condition;
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub. The keyboard row input of PIA0 port A reads
+ *  no key pressed and a low joystick comparator, other
+ *  registers read the last value written to them.
+ *  Reads are counted.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    if ( op == MEM_WRITE )
+    {
+        pia_registers[address & PIA_MASK] = data;
+        return data;
+    }
+
+    pia_reads++;
+
+    if ( (address & PIA_PORT_MASK) == PIA0_PA )
+        return PIA0_PA_IDLE;
+
+    return pia_registers[address & PIA_MASK];
+}
+
+/*------------------------------------------------
+ * vdg_set_mode_sam()
+ *
+ *  VDG stub.
+ *
+ *  param:  SAM video mode
+ *  return: Nothing
+ */
+void vdg_set_mode_sam(int sam_mode)
+{
+}
+
+/*------------------------------------------------
+ * vdg_set_video_offset()
+ *
+ *  VDG stub.
+ *
+ *  param:  Display offset in 512 byte units
+ *  return: Nothing
+ */
+void vdg_set_video_offset(uint8_t offset)
+{
+}
@@ -18,4 +18,136 @@
 
 #define     RPI_BARE_METAL          0
 
+/********************************************************************
+ *  CPU emulation
+ *
+ *  Instruction dispatch engine of cpu_run(). Select with
+ *  -DCPU_DISPATCH=<n> on the compiler command line.
+ */
+#define     CPU_DISPATCH_SWITCH     0           // Single switch-case on op-code
+#define     CPU_DISPATCH_TABLE      1           // Op-code handler function tables
+#define     CPU_DISPATCH_GOTO       2           // Computed-goto op-code labels (GCC only)
+
+#ifndef     CPU_DISPATCH
+#define     CPU_DISPATCH            CPU_DISPATCH_GOTO
+#endif
+
+/* Lazy condition-code evaluation. Instructions record the result
+ * terms of the N, Z, V, C and H flags, and the flag bits are extracted
+ * only when read by a conditional branch, ADC/SBC/rotate/DAA, or when CC
+ * is packed for PSHS, TFR/EXG, interrupt stacking and cpu_get_state().
+ * Select with -DCPU_LAZY_CC=<0|1>, off by default (see README).
+ */
+#ifndef     CPU_LAZY_CC
+#define     CPU_LAZY_CC             0
+#endif
+
+/* Predecoded instruction cache. Decoded op-codes, operands and effective
+ * address recipes are cached by PC and invalidated when memory pages
+ * holding them are written. Used with the table and computed-goto
+ * dispatch engines, ignored by the switch engine.
+ * Select with -DCPU_PREDECODE=<0|1>.
+ */
+#ifndef     CPU_PREDECODE
+#define     CPU_PREDECODE           1
+#endif
+
+/* Basic block translation. Frequently executed basic blocks are
+ * translated into arrays of predecoded instructions that cpu_run_cycles()
+ * runs without per-instruction fetch, decode and interrupt processing.
+ * Requires CPU_PREDECODE. Select with -DCPU_TRANSLATE=<0|1>.
+ */
+#ifndef     CPU_TRANSLATE
+#define     CPU_TRANSLATE           1
+#endif
+
+/* Superinstruction fusion. Common instruction pairs in translated
+ * blocks, such as compare or test and conditional branch, and load and
+ * store copy loops, run as one fused handler with the same architectural
+ * state and cycle counts. Requires CPU_TRANSLATE.
+ * Select with -DCPU_FUSION=<0|1>.
+ */
+#ifndef     CPU_FUSION
+#define     CPU_FUSION              1
+#endif
+
+/* x86-64 host code for translated blocks. Each translated block is
+ * compiled into x86-64 machine code that calls the instruction handlers
+ * directly and checks the block's stop conditions inline, instead of
+ * looping over the block in execute_block(). Used only on x86-64 Linux
+ * hosts and not with CPU_PROFILE, elsewhere translated blocks run as
+ * before. Requires CPU_TRANSLATE.
+ * Select with -DCPU_TRANSLATE_X86=<0|1>, off by default (see README).
+ */
+#ifndef     CPU_TRANSLATE_X86
+#define     CPU_TRANSLATE_X86       0
+#endif
+
+/* Guest idle loop skipping. Translated blocks that loop on themselves
+ * are checked for countdown delay loops (LEAX -1,X / LEAY -1,Y / DECA /
+ * DECB and BNE) and for polling loops that only read memory, or IO
+ * declared with mem_define_io_pure(). cpu_run_cycles() skips whole
+ * iterations of such loops with the same result as running them, and
+ * cpu_is_idle() reports an idle guest so the caller can fast forward to
+ * the end of the delay loop or the next event. Requires CPU_TRANSLATE.
+ * Select with -DCPU_IDLE_SKIP=<0|1>.
+ */
+#ifndef     CPU_IDLE_SKIP
+#define     CPU_IDLE_SKIP           1
+#endif
+
+/* Execution profiler. Counts executions and cycles of every guest
+ * address and op-code, for a report and a raw dump written by
+ * cpu_profile_report() / cpu_profile_dump() or on exit. Costs 1.1MB
+ * per CPU context and some speed, so it is off by default.
+ * Select with -DCPU_PROFILE=<0|1>.
+ */
+#ifndef     CPU_PROFILE
+#define     CPU_PROFILE             0
+#endif
+
+/* Guest call graph. Keeps a shadow call stack of guest routines
+ * entered by JSR, BSR, LBSR, SWI and interrupts, and left when their
+ * return address is pulled off the stack, and charges emulated cycles
+ * to the call paths. Written as folded stacks for flame graph tools by
+ * cpu_call_graph_folded(). Translated blocks are not used with it.
+ * Select with -DCPU_CALL_GRAPH=<0|1>.
+ */
+#ifndef     CPU_CALL_GRAPH
+#define     CPU_CALL_GRAPH          0
+#endif
+
+/* Cycle accounting audit. Every executed instruction's cycle count
+ * is checked against an independent reference of the op-code and
+ * indexed addressing post-byte cycles in mc6809e_cycles.h, and
+ * mismatches are logged with their address and op-code for
+ * cpu_get_cycle_audit(). Translated blocks are not used with it.
+ * MC6809E only, not with CPU_6309.
+ * Select with -DCPU_CYCLE_AUDIT=<0|1>.
+ */
+#ifndef     CPU_CYCLE_AUDIT
+#define     CPU_CYCLE_AUDIT         0
+#endif
+
+/* Multiple CPU contexts. CPU contexts created with cpu_create() can
+ * run on separate threads. The CPU module reaches the register file
+ * through a per thread context pointer, which costs time in builds
+ * without compiler optimization. Without it only the default context
+ * is available, and cpu_create() returns it once.
+ * Select with -DCPU_CONTEXTS=<0|1>.
+ */
+#ifndef     CPU_CONTEXTS
+#define     CPU_CONTEXTS            1
+#endif
+
+/* Hitachi HD6309 variant. Adds the HD6309 registers (W, E, F, V, MD),
+ * instructions, index modes and traps. The MD register selects the
+ * MC6809E compatible cycle counts or the HD6309 native mode cycle
+ * counts and interrupt frames. Requires the table or computed-goto
+ * dispatch engine. Select with -DCPU_6309=<0|1>.
+ */
+#ifndef     CPU_6309
+#define     CPU_6309                0
+#endif
+
 #endif  /* __config_h__ */
@@ -12,6 +12,8 @@
 
 #include    <stdint.h>
 
+#include    "mem.h"
+
 /********************************************************************
  *  CPU run state
  */
@@ -25,8 +27,18 @@ typedef enum
     CPU_EXCEPTION   = 5,    // Signal an emulation exception (bad op-code)
 } cpu_run_state_t;
 
-/* MC6809E CPU state
+/* MC6809E CPU state.
+ * The state of the last command, the cycle count and the register file
+ * fit in the first 64 bytes, one cache line with the CPU context aligned
+ * to a cache line. A and B alias the high and low bytes of D, and
+ * E and F the high and low bytes of W, in host byte order.
  */
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define     CPU_REG_PAIR(w, h, l)   union { uint16_t w; struct { uint8_t h; uint8_t l; }; }
+#else
+#define     CPU_REG_PAIR(w, h, l)   union { uint16_t w; struct { uint8_t l; uint8_t h; }; }
+#endif
+
 typedef struct
 {
     /* Last command executed
@@ -36,6 +48,11 @@ typedef struct
     int             last_opcode_bytes;
     int             last_opcode_cycles;
 
+    /* Emulated time in clock cycles since initialization,
+     * including interrupt entry and SYNC/CWAI/HALT wait cycles
+     */
+    uint64_t        cycles;
+
     /* Registers reflecting
      * machine state after last command execution
      */
@@ -44,11 +61,16 @@ typedef struct
     uint16_t    u;
     uint16_t    s;
     uint16_t    pc;
-    uint8_t     a;
-    uint8_t     b;
+    CPU_REG_PAIR(d, a, b);
     uint8_t     dp;
     uint8_t     cc;
 
+    /* HD6309 registers, used with CPU_6309
+     */
+    CPU_REG_PAIR(w, e, f);
+    uint16_t    v;
+    uint8_t     md;
+
     /* State after last command execution
      */
     int     int_latch;
@@ -61,8 +83,79 @@ typedef struct
     int     exception_line_num;
 } cpu_state_t;
 
+/* Predecoded instruction cache and block translation statistics
+ */
+typedef struct
+{
+    unsigned long   hits;       // Instructions executed from the cache
+    unsigned long   misses;     // Instructions decoded into the cache
+    unsigned long   uncached;   // Instructions that cannot be cached (IO page, page crossing, illegal)
+    unsigned long   translated; // Instructions executed in translated blocks
+    unsigned long   blocks;     // Blocks translated
+    double          hit_ratio;  // Hits and translated instructions as percent of all instructions
+    double          block_ratio;// Translated instructions as percent of all instructions
+} cpu_predecode_stats_t;
+
+/* Superinstruction fusion statistics
+ */
+#define     CPU_FUSION_TYPES        5
+
+typedef struct
+{
+    const char     *name[CPU_FUSION_TYPES];     // Fused instruction sequence
+    unsigned long   fired[CPU_FUSION_TYPES];    // Fused sequence executions
+    unsigned long   dispatches_saved;           // Instruction dispatches saved by fusion
+} cpu_fusion_stats_t;
+
+/* Guest idle statistics
+ */
+typedef struct
+{
+    uint64_t        cycles;     // Emulated cycles
+    uint64_t        idle;       // Cycles skipped in idle loops, or waited in SYNC, CWAI, HALT or reset
+    double          idle_ratio; // Idle cycles as percent of emulated cycles
+} cpu_idle_stats_t;
+
+/* Cycle audit, instructions checked against the cycle reference
+ * and a log of the mismatches by address and op-code
+ */
+#define     CPU_AUDIT_LOG           32
+
+typedef struct
+{
+    uint16_t        pc;         // Instruction address
+    uint16_t        op_code;    // Op-code, 0x10nn and 0x11nn for pages 2 and 3
+    int             post_byte;  // Index or register list post-byte, '-1' if none
+    int             expected;   // Reference cycles, '-1' if the op-code has no reference
+    int             cycles;     // Cycles counted by the CPU module
+    unsigned long   count;      // Executions with this mismatch
+} cpu_audit_mismatch_t;
+
+typedef struct
+{
+    uint64_t        instructions;   // Instructions checked
+    uint64_t        mismatches;     // Instructions with other cycles than the reference
+    int             logged;         // Mismatches in log[]
+    unsigned long   lost;           // Mismatch executions not logged, log[] full
+    cpu_audit_mismatch_t log[CPU_AUDIT_LOG];
+} cpu_cycle_audit_t;
+
+/* Event deadline value when no event is scheduled
+ */
+#define     CPU_NO_EVENT            UINT64_MAX
+
+/* Symbol name of a guest address, NULL if the address has no symbol
+ */
+typedef const char* (*cpu_symbol_t)(int address);
+
+/* CPU context, the register file and run state of one CPU
+ * and the memory context it runs code from
+ */
+typedef struct cpu_context_t cpu_context_t;
+
 /********************************************************************
  *  CPU module API
+ *  The functions without a context parameter use the default context.
  */
 int  cpu_init(int address);
 
@@ -73,8 +166,68 @@ void cpu_firq(int state);
 void cpu_irq(int state);
 
 cpu_run_state_t cpu_run(void);
+int             cpu_run_cycles(int cycle_budget);
+void            cpu_break_point(int address);
+
+uint64_t        cpu_get_cycles(void);
+void            cpu_set_event(uint64_t deadline);
+uint64_t        cpu_cycles_to_event(void);
+int             cpu_is_idle(void);
+uint64_t        cpu_idle_cycles_left(void);
+void            cpu_get_idle_stats(cpu_idle_stats_t* stats, int clear);
+void            cpu_profile_clear(void);
+int             cpu_profile_report(const char *file_name);
+int             cpu_profile_dump(const char *file_name);
+int             cpu_profile_on_exit(const char *report_file_name, const char *dump_file_name);
+void            cpu_call_graph_clear(void);
+int             cpu_call_graph_folded(const char *file_name, cpu_symbol_t symbol);
+int             cpu_call_graph_report(const char *file_name, cpu_symbol_t symbol);
+int             cpu_get_cycle_audit(cpu_cycle_audit_t *audit, int clear);
 
 cpu_run_state_t cpu_get_state(cpu_state_t* cpu_state);
+cpu_run_state_t cpu_get_run_state(void);
 const char*     cpu_get_menmonic(uint16_t address);
+void            cpu_get_predecode_stats(cpu_predecode_stats_t* stats, int clear);
+void            cpu_get_fusion_stats(cpu_fusion_stats_t* stats, int clear);
+
+/********************************************************************
+ *  CPU context API
+ *  Different contexts can be run by different threads.
+ */
+cpu_context_t  *cpu_create(mem_context_t *mem);
+void            cpu_destroy(cpu_context_t *ctx);
+cpu_context_t  *cpu_default_context(void);
+
+int  cpu_ctx_init(cpu_context_t *ctx, int address);
+
+void cpu_ctx_halt(cpu_context_t *ctx, int state);
+void cpu_ctx_reset(cpu_context_t *ctx, int state);
+void cpu_ctx_nmi_trigger(cpu_context_t *ctx);
+void cpu_ctx_firq(cpu_context_t *ctx, int state);
+void cpu_ctx_irq(cpu_context_t *ctx, int state);
+
+cpu_run_state_t cpu_ctx_run(cpu_context_t *ctx);
+int             cpu_ctx_run_cycles(cpu_context_t *ctx, int cycle_budget);
+void            cpu_ctx_break_point(cpu_context_t *ctx, int address);
+
+uint64_t        cpu_ctx_get_cycles(cpu_context_t *ctx);
+void            cpu_ctx_set_event(cpu_context_t *ctx, uint64_t deadline);
+uint64_t        cpu_ctx_cycles_to_event(cpu_context_t *ctx);
+int             cpu_ctx_is_idle(cpu_context_t *ctx);
+uint64_t        cpu_ctx_idle_cycles_left(cpu_context_t *ctx);
+void            cpu_ctx_get_idle_stats(cpu_context_t *ctx, cpu_idle_stats_t* stats, int clear);
+void            cpu_ctx_profile_clear(cpu_context_t *ctx);
+int             cpu_ctx_profile_report(cpu_context_t *ctx, const char *file_name);
+int             cpu_ctx_profile_dump(cpu_context_t *ctx, const char *file_name);
+void            cpu_ctx_call_graph_clear(cpu_context_t *ctx);
+int             cpu_ctx_call_graph_folded(cpu_context_t *ctx, const char *file_name, cpu_symbol_t symbol);
+int             cpu_ctx_call_graph_report(cpu_context_t *ctx, const char *file_name, cpu_symbol_t symbol);
+int             cpu_ctx_get_cycle_audit(cpu_context_t *ctx, cpu_cycle_audit_t *audit, int clear);
+
+cpu_run_state_t cpu_ctx_get_state(cpu_context_t *ctx, cpu_state_t* cpu_state);
+cpu_run_state_t cpu_ctx_get_run_state(cpu_context_t *ctx);
+const char*     cpu_ctx_get_menmonic(cpu_context_t *ctx, uint16_t address);
+void            cpu_ctx_get_predecode_stats(cpu_context_t *ctx, cpu_predecode_stats_t* stats, int clear);
+void            cpu_ctx_get_fusion_stats(cpu_context_t *ctx, cpu_fusion_stats_t* stats, int clear);
 
 #endif  /* __CPU_H__ */
@@ -0,0 +1,78 @@
+/********************************************************************
+ * cpu_ref.h
+ *
+ *  Header file that defines the MC6809E reference interpreter
+ *  module interface.
+ *
+ *  cpu_ref.c is a separate copy of the original switch-case CPU
+ *  module, used for lockstep runs against cpu.c. It runs on the
+ *  default memory context, and its API is the original CPU module
+ *  API renamed with a 'ref_' prefix, with an emulated cycle counter.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#ifndef __CPU_REF_H__
+#define __CPU_REF_H__
+
+#include    <stdint.h>
+
+#include    "cpu.h"
+
+/* MC6809E reference interpreter CPU state,
+ * the original CPU state without the cycle counter
+ * and the HD6309 registers.
+ */
+typedef struct
+{
+    /* Last command executed
+     */
+    cpu_run_state_t cpu_state;
+    uint16_t        last_pc;
+    int             last_opcode_bytes;
+    int             last_opcode_cycles;
+
+    /* Registers reflecting
+     * machine state after last command execution
+     */
+    uint16_t    x;
+    uint16_t    y;
+    uint16_t    u;
+    uint16_t    s;
+    uint16_t    pc;
+    uint8_t     a;
+    uint8_t     b;
+    uint8_t     dp;
+    uint8_t     cc;
+
+    /* State after last command execution
+     */
+    int     int_latch;
+    int     nmi_armed;
+    int     nmi_latched;
+    int     halt_asserted;
+    int     reset_asserted;
+    int     irq_asserted;
+    int     firq_asserted;
+    int     exception_line_num;
+} ref_cpu_state_t;
+
+/********************************************************************
+ *  Reference interpreter module API
+ */
+int  ref_cpu_init(int address);
+
+void ref_cpu_halt(int state);
+void ref_cpu_reset(int state);
+void ref_cpu_nmi_trigger(void);
+void ref_cpu_firq(int state);
+void ref_cpu_irq(int state);
+
+cpu_run_state_t ref_cpu_run(void);
+
+cpu_run_state_t ref_cpu_get_state(ref_cpu_state_t* cpu_state);
+uint64_t        ref_cpu_get_cycles(void);
+const char*     ref_cpu_get_menmonic(uint16_t address);
+
+#endif  /* __CPU_REF_H__ */
@@ -8,6 +8,11 @@
  * This static data structure is based on CPU data sheet
  * Motorola INC. 1984 DS9846-R2.
  *
+ * The second cycle count is the HD6309 native mode cycle count,
+ * and the HD6309 op-codes are listed when CPU_6309 is set.
+ * HD6309 data is based on the Hitachi HD63B09EP data sheet
+ * and the HD6309 technical reference by Chris Burke.
+ *
  *  July 4, 2020
  *
  */
@@ -17,6 +22,8 @@
 
 #include    <stdint.h>
 
+#include    "config.h"
+
 #define     ADDR_DIRECT             1
 #define     ADDR_INHERENT           2
 #define     ADDR_RELATIVE           3           // 8-bit address offset
@@ -27,10 +34,18 @@
 #define     ADDR_LIMMEDIATE         8           // 16-bit immediate
 #define     DOUBLE_BYTE             9           // Double byte commands starting with 0x10 or 0x10
 #define     ILLEGAL_OP              10
+#define     ADDR_IMDIRECT           11          // HD6309 8-bit immediate followed by direct address
+#define     ADDR_IMINDEXED          12          // HD6309 8-bit immediate followed by index post-byte
+#define     ADDR_IMEXTENDED         13          // HD6309 8-bit immediate followed by extended address
+#define     ADDR_QIMMEDIATE         14          // HD6309 32-bit immediate
 
 #define     OP_CODE                 0
 #define     OP_CODE10               256
+#if (CPU_6309)
+#define     OP_CODE11               374
+#else
 #define     OP_CODE11               294
+#endif
 
 typedef struct
 {
@@ -38,336 +53,550 @@ typedef struct
     char mnem[6];
     int  mode;
     int  cycles;
+    int  cycles_native;
     int  bytes;
 } machine_code_t;
 
 machine_code_t machine_code[] = {
-    {0x00, "neg"  , ADDR_DIRECT    , 6 , 2},
-    {0x01, "???"  , ILLEGAL_OP     , 0 , 1},    // Zero cycles and "???" notes illegal op-code
-    {0x02, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x03, "com"  , ADDR_DIRECT    , 6 , 2},
-    {0x04, "lsr"  , ADDR_DIRECT    , 6 , 2},
-    {0x05, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x06, "ror"  , ADDR_DIRECT    , 6 , 2},
-    {0x07, "asr"  , ADDR_DIRECT    , 6 , 2},
-    {0x08, "asl"  , ADDR_DIRECT    , 6 , 2},    // lsl
-    {0x09, "rol"  , ADDR_DIRECT    , 6 , 2},
-    {0x0a, "dec"  , ADDR_DIRECT    , 6 , 2},
-    {0x0b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x0c, "inc"  , ADDR_DIRECT    , 6 , 2},
-    {0x0d, "tst"  , ADDR_DIRECT    , 6 , 2},
-    {0x0e, "jmp"  , ADDR_DIRECT    , 3 , 2},
-    {0x0f, "clr"  , ADDR_DIRECT    , 6 , 2},
+    {0x00, "neg"  , ADDR_DIRECT    , 6 , 5 , 2},
+#if (CPU_6309)
+    {0x01, "oim"  , ADDR_IMDIRECT  , 6 , 6 , 3},
+    {0x02, "aim"  , ADDR_IMDIRECT  , 6 , 6 , 3},
+#else
+    {0x01, "???"  , ILLEGAL_OP     , 0 , 0 , 1},    // Zero cycles and "???" notes illegal op-code
+    {0x02, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x03, "com"  , ADDR_DIRECT    , 6 , 5 , 2},
+    {0x04, "lsr"  , ADDR_DIRECT    , 6 , 5 , 2},
+#if (CPU_6309)
+    {0x05, "eim"  , ADDR_IMDIRECT  , 6 , 6 , 3},
+#else
+    {0x05, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x06, "ror"  , ADDR_DIRECT    , 6 , 5 , 2},
+    {0x07, "asr"  , ADDR_DIRECT    , 6 , 5 , 2},
+    {0x08, "asl"  , ADDR_DIRECT    , 6 , 5 , 2},    // lsl
+    {0x09, "rol"  , ADDR_DIRECT    , 6 , 5 , 2},
+    {0x0a, "dec"  , ADDR_DIRECT    , 6 , 5 , 2},
+#if (CPU_6309)
+    {0x0b, "tim"  , ADDR_IMDIRECT  , 4 , 4 , 3},
+#else
+    {0x0b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x0c, "inc"  , ADDR_DIRECT    , 6 , 5 , 2},
+    {0x0d, "tst"  , ADDR_DIRECT    , 6 , 4 , 2},
+    {0x0e, "jmp"  , ADDR_DIRECT    , 3 , 2 , 2},
+    {0x0f, "clr"  , ADDR_DIRECT    , 6 , 5 , 2},
 
-    {0x10, "0x10" , DOUBLE_BYTE    , 0 , 0},
-    {0x11, "0x11" , DOUBLE_BYTE    , 0 , 0},
-    {0x12, "nop"  , ADDR_INHERENT  , 2 , 1},
-    {0x13, "sync" , ADDR_INHERENT  , 4 , 1},
-    {0x14, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x15, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x16, "lbra" , ADDR_LRELATIVE , 5 , 3},
-    {0x17, "lbsr" , ADDR_LRELATIVE , 9 , 3},
-    {0x18, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x19, "daa"  , ADDR_INHERENT  , 2 , 1},
-    {0x1a, "orcc" , ADDR_IMMEDIATE , 3 , 2},
-    {0x1b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x1c, "andcc", ADDR_IMMEDIATE , 3 , 2},
-    {0x1d, "sex"  , ADDR_INHERENT  , 2 , 1},
-    {0x1e, "exg"  , ADDR_IMMEDIATE , 8 , 2},
-    {0x1f, "tfr"  , ADDR_IMMEDIATE , 6 , 2},
+    {0x10, "0x10" , DOUBLE_BYTE    , 0 , 0 , 0},
+    {0x11, "0x11" , DOUBLE_BYTE    , 0 , 0 , 0},
+    {0x12, "nop"  , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x13, "sync" , ADDR_INHERENT  , 4 , 3 , 1},
+#if (CPU_6309)
+    {0x14, "sexw" , ADDR_INHERENT  , 4 , 4 , 1},
+#else
+    {0x14, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x15, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x16, "lbra" , ADDR_LRELATIVE , 5 , 4 , 3},
+    {0x17, "lbsr" , ADDR_LRELATIVE , 9 , 7 , 3},
+    {0x18, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x19, "daa"  , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x1a, "orcc" , ADDR_IMMEDIATE , 3 , 2 , 2},
+    {0x1b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x1c, "andcc", ADDR_IMMEDIATE , 3 , 3 , 2},
+    {0x1d, "sex"  , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x1e, "exg"  , ADDR_IMMEDIATE , 8 , 5 , 2},
+    {0x1f, "tfr"  , ADDR_IMMEDIATE , 6 , 4 , 2},
 
-    {0x20, "bra"  , ADDR_RELATIVE  , 3 , 2},
-    {0x21, "brn"  , ADDR_RELATIVE  , 3 , 2},
-    {0x22, "bhi"  , ADDR_RELATIVE  , 3 , 2},
-    {0x23, "bls"  , ADDR_RELATIVE  , 3 , 2},
-    {0x24, "bcc"  , ADDR_RELATIVE  , 3 , 2},    // bhs
-    {0x25, "bcs"  , ADDR_RELATIVE  , 3 , 2},    // blo
-    {0x26, "bne"  , ADDR_RELATIVE  , 3 , 2},
-    {0x27, "beq"  , ADDR_RELATIVE  , 3 , 2},
-    {0x28, "bvc"  , ADDR_RELATIVE  , 3 , 2},
-    {0x29, "bvs"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2a, "bpl"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2b, "bmi"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2c, "bge"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2d, "blt"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2e, "bgt"  , ADDR_RELATIVE  , 3 , 2},
-    {0x2f, "ble"  , ADDR_RELATIVE  , 3 , 2},
+    {0x20, "bra"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x21, "brn"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x22, "bhi"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x23, "bls"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x24, "bcc"  , ADDR_RELATIVE  , 3 , 3 , 2},    // bhs
+    {0x25, "bcs"  , ADDR_RELATIVE  , 3 , 3 , 2},    // blo
+    {0x26, "bne"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x27, "beq"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x28, "bvc"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x29, "bvs"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2a, "bpl"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2b, "bmi"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2c, "bge"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2d, "blt"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2e, "bgt"  , ADDR_RELATIVE  , 3 , 3 , 2},
+    {0x2f, "ble"  , ADDR_RELATIVE  , 3 , 3 , 2},
 
-    {0x30, "leax" , ADDR_INDEXED   , 4 , 2},
-    {0x31, "leay" , ADDR_INDEXED   , 4 , 2},
-    {0x32, "leas" , ADDR_INDEXED   , 4 , 2},
-    {0x33, "leau" , ADDR_INDEXED   , 4 , 2},
-    {0x34, "pshs" , ADDR_IMMEDIATE , 5 , 2},
-    {0x35, "puls" , ADDR_IMMEDIATE , 5 , 2},
-    {0x36, "pshu" , ADDR_IMMEDIATE , 5 , 2},
-    {0x37, "pulu" , ADDR_IMMEDIATE , 5 , 2},
-    {0x38, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x39, "rts"  , ADDR_INHERENT  , 5 , 1},
-    {0x3a, "abx"  , ADDR_INHERENT  , 3 , 1},
-    {0x3b, "rti"  , ADDR_INHERENT  , 6 , 1},
-    {0x3c, "cwai" , ADDR_INHERENT  , 20, 2},
-    {0x3d, "mul"  , ADDR_INHERENT  , 11, 1},
-    {0x3e, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x3f, "swi"  , ADDR_INHERENT  , 19, 1},
+    {0x30, "leax" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0x31, "leay" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0x32, "leas" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0x33, "leau" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0x34, "pshs" , ADDR_IMMEDIATE , 5 , 4 , 2},
+    {0x35, "puls" , ADDR_IMMEDIATE , 5 , 4 , 2},
+    {0x36, "pshu" , ADDR_IMMEDIATE , 5 , 4 , 2},
+    {0x37, "pulu" , ADDR_IMMEDIATE , 5 , 4 , 2},
+    {0x38, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x39, "rts"  , ADDR_INHERENT  , 5 , 4 , 1},
+    {0x3a, "abx"  , ADDR_INHERENT  , 3 , 1 , 1},
+    {0x3b, "rti"  , ADDR_INHERENT  , 6 , 6 , 1},
+    {0x3c, "cwai" , ADDR_INHERENT  , 20, 22, 2},
+    {0x3d, "mul"  , ADDR_INHERENT  , 11, 10, 1},
+    {0x3e, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x3f, "swi"  , ADDR_INHERENT  , 19, 21, 1},
 
-    {0x40, "nega" , ADDR_INHERENT  , 2 , 1},
-    {0x41, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x42, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x43, "coma" , ADDR_INHERENT  , 2 , 1},
-    {0x44, "lsra" , ADDR_INHERENT  , 2 , 1},
-    {0x45, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x46, "rora" , ADDR_INHERENT  , 2 , 1},
-    {0x47, "asra" , ADDR_INHERENT  , 2 , 1},
-    {0x48, "asla" , ADDR_INHERENT  , 2 , 1},    // lsla
-    {0x49, "rola" , ADDR_INHERENT  , 2 , 1},
-    {0x4a, "deca" , ADDR_INHERENT  , 2 , 1},
-    {0x4b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x4c, "inca" , ADDR_INHERENT  , 2 , 1},
-    {0x4d, "tsta" , ADDR_INHERENT  , 2 , 1},
-    {0x4e, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x4f, "clra" , ADDR_INHERENT  , 2 , 1},
+    {0x40, "nega" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x41, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x42, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x43, "coma" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x44, "lsra" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x45, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x46, "rora" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x47, "asra" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x48, "asla" , ADDR_INHERENT  , 2 , 1 , 1},    // lsla
+    {0x49, "rola" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x4a, "deca" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x4b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x4c, "inca" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x4d, "tsta" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x4e, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x4f, "clra" , ADDR_INHERENT  , 2 , 1 , 1},
 
-    {0x50, "negb" , ADDR_INHERENT  , 2 , 1},
-    {0x51, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x52, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x53, "comb" , ADDR_INHERENT  , 2 , 1},
-    {0x54, "lsrb" , ADDR_INHERENT  , 2 , 1},
-    {0x55, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x56, "rorb" , ADDR_INHERENT  , 2 , 1},
-    {0x57, "asrb" , ADDR_INHERENT  , 2 , 1},
-    {0x58, "aslb" , ADDR_INHERENT  , 2 , 1},    // lslb
-    {0x59, "rolb" , ADDR_INHERENT  , 2 , 1},
-    {0x5a, "decb" , ADDR_INHERENT  , 2 , 1},
-    {0x5b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x5c, "incb" , ADDR_INHERENT  , 2 , 1},
-    {0x5d, "tstb" , ADDR_INHERENT  , 2 , 1},
-    {0x5e, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x5f, "clrb" , ADDR_INHERENT  , 2 , 1},
+    {0x50, "negb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x51, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x52, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x53, "comb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x54, "lsrb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x55, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x56, "rorb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x57, "asrb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x58, "aslb" , ADDR_INHERENT  , 2 , 1 , 1},    // lslb
+    {0x59, "rolb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x5a, "decb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x5b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x5c, "incb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x5d, "tstb" , ADDR_INHERENT  , 2 , 1 , 1},
+    {0x5e, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x5f, "clrb" , ADDR_INHERENT  , 2 , 1 , 1},
 
-    {0x60, "neg"  , ADDR_INDEXED   , 6 , 2},
-    {0x61, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x62, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x63, "com"  , ADDR_INDEXED   , 6 , 2},
-    {0x64, "lsr"  , ADDR_INDEXED   , 6 , 2},
-    {0x65, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x66, "ror"  , ADDR_INDEXED   , 6 , 2},
-    {0x67, "asr"  , ADDR_INDEXED   , 6 , 2},
-    {0x68, "asl"  , ADDR_INDEXED   , 6 , 2},    // lsl
-    {0x69, "rol"  , ADDR_INDEXED   , 6 , 2},
-    {0x6a, "dec"  , ADDR_INDEXED   , 6 , 2},
-    {0x6b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x6c, "inc"  , ADDR_INDEXED   , 6 , 2},
-    {0x6d, "tst"  , ADDR_INDEXED   , 6 , 2},
-    {0x6e, "jmp"  , ADDR_INDEXED   , 3 , 2},
-    {0x6f, "clr"  , ADDR_INDEXED   , 6 , 2},
+    {0x60, "neg"  , ADDR_INDEXED   , 6 , 6 , 2},
+#if (CPU_6309)
+    {0x61, "oim"  , ADDR_IMINDEXED , 7 , 7 , 3},
+    {0x62, "aim"  , ADDR_IMINDEXED , 7 , 7 , 3},
+#else
+    {0x61, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x62, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x63, "com"  , ADDR_INDEXED   , 6 , 6 , 2},
+    {0x64, "lsr"  , ADDR_INDEXED   , 6 , 6 , 2},
+#if (CPU_6309)
+    {0x65, "eim"  , ADDR_IMINDEXED , 7 , 7 , 3},
+#else
+    {0x65, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x66, "ror"  , ADDR_INDEXED   , 6 , 6 , 2},
+    {0x67, "asr"  , ADDR_INDEXED   , 6 , 6 , 2},
+    {0x68, "asl"  , ADDR_INDEXED   , 6 , 6 , 2},    // lsl
+    {0x69, "rol"  , ADDR_INDEXED   , 6 , 6 , 2},
+    {0x6a, "dec"  , ADDR_INDEXED   , 6 , 6 , 2},
+#if (CPU_6309)
+    {0x6b, "tim"  , ADDR_IMINDEXED , 5 , 5 , 3},
+#else
+    {0x6b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x6c, "inc"  , ADDR_INDEXED   , 6 , 6 , 2},
+    {0x6d, "tst"  , ADDR_INDEXED   , 6 , 5 , 2},
+    {0x6e, "jmp"  , ADDR_INDEXED   , 3 , 3 , 2},
+    {0x6f, "clr"  , ADDR_INDEXED   , 6 , 6 , 2},
 
-    {0x70, "neg"  , ADDR_EXTENDED  , 7 , 3},
-    {0x71, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x72, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x73, "com"  , ADDR_EXTENDED  , 7 , 3},
-    {0x74, "lsr"  , ADDR_EXTENDED  , 7 , 3},
-    {0x75, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x76, "ror"  , ADDR_EXTENDED  , 7 , 3},
-    {0x77, "asr"  , ADDR_EXTENDED  , 7 , 3},
-    {0x78, "asl"  , ADDR_EXTENDED  , 7 , 3},    // lsl
-    {0x79, "rol"  , ADDR_EXTENDED  , 7 , 3},
-    {0x7a, "dec"  , ADDR_EXTENDED  , 7 , 3},
-    {0x7b, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x7c, "inc"  , ADDR_EXTENDED  , 7 , 3},
-    {0x7d, "tst"  , ADDR_EXTENDED  , 7 , 3},
-    {0x7e, "jmp"  , ADDR_EXTENDED  , 4 , 3},
-    {0x7f, "clr"  , ADDR_EXTENDED  , 7 , 3},
+    {0x70, "neg"  , ADDR_EXTENDED  , 7 , 6 , 3},
+#if (CPU_6309)
+    {0x71, "oim"  , ADDR_IMEXTENDED, 7 , 7 , 4},
+    {0x72, "aim"  , ADDR_IMEXTENDED, 7 , 7 , 4},
+#else
+    {0x71, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x72, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x73, "com"  , ADDR_EXTENDED  , 7 , 6 , 3},
+    {0x74, "lsr"  , ADDR_EXTENDED  , 7 , 6 , 3},
+#if (CPU_6309)
+    {0x75, "eim"  , ADDR_IMEXTENDED, 7 , 7 , 4},
+#else
+    {0x75, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x76, "ror"  , ADDR_EXTENDED  , 7 , 6 , 3},
+    {0x77, "asr"  , ADDR_EXTENDED  , 7 , 6 , 3},
+    {0x78, "asl"  , ADDR_EXTENDED  , 7 , 6 , 3},    // lsl
+    {0x79, "rol"  , ADDR_EXTENDED  , 7 , 6 , 3},
+    {0x7a, "dec"  , ADDR_EXTENDED  , 7 , 6 , 3},
+#if (CPU_6309)
+    {0x7b, "tim"  , ADDR_IMEXTENDED, 5 , 5 , 4},
+#else
+    {0x7b, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0x7c, "inc"  , ADDR_EXTENDED  , 7 , 6 , 3},
+    {0x7d, "tst"  , ADDR_EXTENDED  , 7 , 5 , 3},
+    {0x7e, "jmp"  , ADDR_EXTENDED  , 4 , 3 , 3},
+    {0x7f, "clr"  , ADDR_EXTENDED  , 7 , 6 , 3},
 
-    {0x80, "suba" , ADDR_IMMEDIATE , 2 , 2},
-    {0x81, "cmpa" , ADDR_IMMEDIATE , 2 , 2},
-    {0x82, "sbca" , ADDR_IMMEDIATE , 2 , 2},
-    {0x83, "subd" , ADDR_LIMMEDIATE, 4 , 3},
-    {0x84, "anda" , ADDR_IMMEDIATE , 2 , 2},
-    {0x85, "bita" , ADDR_IMMEDIATE , 2 , 2},
-    {0x86, "lda"  , ADDR_IMMEDIATE , 2 , 2},
-    {0x87, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0x88, "eora" , ADDR_IMMEDIATE , 2 , 2},
-    {0x89, "adca" , ADDR_IMMEDIATE , 2 , 2},
-    {0x8a, "ora"  , ADDR_IMMEDIATE , 2 , 2},
-    {0x8b, "adda" , ADDR_IMMEDIATE , 2 , 2},
-    {0x8c, "cmpx" , ADDR_LIMMEDIATE, 4 , 3},
-    {0x8d, "bsr"  , ADDR_RELATIVE  , 7 , 2},
-    {0x8e, "ldx"  , ADDR_LIMMEDIATE, 3 , 3},
-    {0x8f, "???"  , ILLEGAL_OP     , 0 , 1},
+    {0x80, "suba" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x81, "cmpa" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x82, "sbca" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x83, "subd" , ADDR_LIMMEDIATE, 4 , 3 , 3},
+    {0x84, "anda" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x85, "bita" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x86, "lda"  , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x87, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0x88, "eora" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x89, "adca" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x8a, "ora"  , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x8b, "adda" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0x8c, "cmpx" , ADDR_LIMMEDIATE, 4 , 3 , 3},
+    {0x8d, "bsr"  , ADDR_RELATIVE  , 7 , 6 , 2},
+    {0x8e, "ldx"  , ADDR_LIMMEDIATE, 3 , 3 , 3},
+    {0x8f, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
 
-    {0x90, "suba" , ADDR_DIRECT    , 4 , 2},
-    {0x91, "cmpa" , ADDR_DIRECT    , 4 , 2},
-    {0x92, "sbca" , ADDR_DIRECT    , 4 , 2},
-    {0x93, "subd" , ADDR_DIRECT    , 6 , 2},
-    {0x94, "anda" , ADDR_DIRECT    , 4 , 2},
-    {0x95, "bita" , ADDR_DIRECT    , 4 , 2},
-    {0x96, "lda"  , ADDR_DIRECT    , 4 , 2},
-    {0x97, "sta"  , ADDR_DIRECT    , 4 , 2},
-    {0x98, "eora" , ADDR_DIRECT    , 4 , 2},
-    {0x99, "adca" , ADDR_DIRECT    , 4 , 2},
-    {0x9a, "ora"  , ADDR_DIRECT    , 4 , 2},
-    {0x9b, "adda" , ADDR_DIRECT    , 4 , 2},
-    {0x9c, "cmpx" , ADDR_DIRECT    , 6 , 2},
-    {0x9d, "jsr"  , ADDR_DIRECT    , 7 , 2},
-    {0x9e, "ldx"  , ADDR_DIRECT    , 5 , 2},
-    {0x9f, "stx"  , ADDR_DIRECT    , 5 , 2},
+    {0x90, "suba" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x91, "cmpa" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x92, "sbca" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x93, "subd" , ADDR_DIRECT    , 6 , 4 , 2},
+    {0x94, "anda" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x95, "bita" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x96, "lda"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x97, "sta"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x98, "eora" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x99, "adca" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x9a, "ora"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x9b, "adda" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0x9c, "cmpx" , ADDR_DIRECT    , 6 , 4 , 2},
+    {0x9d, "jsr"  , ADDR_DIRECT    , 7 , 6 , 2},
+    {0x9e, "ldx"  , ADDR_DIRECT    , 5 , 4 , 2},
+    {0x9f, "stx"  , ADDR_DIRECT    , 5 , 4 , 2},
 
-    {0xa0, "suba" , ADDR_INDEXED   , 4 , 2},
-    {0xa1, "cmpa" , ADDR_INDEXED   , 4 , 2},
-    {0xa2, "sbca" , ADDR_INDEXED   , 4 , 2},
-    {0xa3, "subd" , ADDR_INDEXED   , 6 , 2},
-    {0xa4, "anda" , ADDR_INDEXED   , 4 , 2},
-    {0xa5, "bita" , ADDR_INDEXED   , 4 , 2},
-    {0xa6, "lda"  , ADDR_INDEXED   , 4 , 2},
-    {0xa7, "sta"  , ADDR_INDEXED   , 4 , 2},
-    {0xa8, "eora" , ADDR_INDEXED   , 4 , 2},
-    {0xa9, "adca" , ADDR_INDEXED   , 4 , 2},
-    {0xaa, "ora"  , ADDR_INDEXED   , 4 , 2},
-    {0xab, "adda" , ADDR_INDEXED   , 4 , 2},
-    {0xac, "cmpx" , ADDR_INDEXED   , 6 , 2},
-    {0xad, "jsr"  , ADDR_INDEXED   , 7 , 2},
-    {0xae, "ldx"  , ADDR_INDEXED   , 5 , 2},
-    {0xaf, "stx"  , ADDR_INDEXED   , 5 , 2},
+    {0xa0, "suba" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa1, "cmpa" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa2, "sbca" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa3, "subd" , ADDR_INDEXED   , 6 , 5 , 2},
+    {0xa4, "anda" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa5, "bita" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa6, "lda"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa7, "sta"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa8, "eora" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xa9, "adca" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xaa, "ora"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xab, "adda" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xac, "cmpx" , ADDR_INDEXED   , 6 , 5 , 2},
+    {0xad, "jsr"  , ADDR_INDEXED   , 7 , 6 , 2},
+    {0xae, "ldx"  , ADDR_INDEXED   , 5 , 5 , 2},
+    {0xaf, "stx"  , ADDR_INDEXED   , 5 , 5 , 2},
 
-    {0xb0, "suba" , ADDR_EXTENDED  , 5 , 3},
-    {0xb1, "cmpa" , ADDR_EXTENDED  , 5 , 3},
-    {0xb2, "sbca" , ADDR_EXTENDED  , 5 , 3},
-    {0xb3, "subd" , ADDR_EXTENDED  , 7 , 3},
-    {0xb4, "anda" , ADDR_EXTENDED  , 5 , 3},
-    {0xb5, "bita" , ADDR_EXTENDED  , 5 , 3},
-    {0xb6, "lda"  , ADDR_EXTENDED  , 5 , 3},
-    {0xb7, "sta"  , ADDR_EXTENDED  , 5 , 3},
-    {0xb8, "eora" , ADDR_EXTENDED  , 5 , 3},
-    {0xb9, "adca" , ADDR_EXTENDED  , 5 , 3},
-    {0xba, "ora"  , ADDR_EXTENDED  , 5 , 3},
-    {0xbb, "adda" , ADDR_EXTENDED  , 5 , 3},
-    {0xbc, "cmpx" , ADDR_EXTENDED  , 7 , 3},
-    {0xbd, "jsr"  , ADDR_EXTENDED  , 8 , 3},
-    {0xbe, "ldx"  , ADDR_EXTENDED  , 6 , 3},
-    {0xbf, "stx"  , ADDR_EXTENDED  , 6 , 3},
+    {0xb0, "suba" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb1, "cmpa" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb2, "sbca" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb3, "subd" , ADDR_EXTENDED  , 7 , 5 , 3},
+    {0xb4, "anda" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb5, "bita" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb6, "lda"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb7, "sta"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb8, "eora" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xb9, "adca" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xba, "ora"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xbb, "adda" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xbc, "cmpx" , ADDR_EXTENDED  , 7 , 5 , 3},
+    {0xbd, "jsr"  , ADDR_EXTENDED  , 8 , 7 , 3},
+    {0xbe, "ldx"  , ADDR_EXTENDED  , 6 , 5 , 3},
+    {0xbf, "stx"  , ADDR_EXTENDED  , 6 , 5 , 3},
 
-    {0xc0, "subb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc1, "cmpb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc2, "sbcb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc3, "addd" , ADDR_LIMMEDIATE, 4 , 3},
-    {0xc4, "andb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc5, "bitb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc6, "ldb"  , ADDR_IMMEDIATE , 2 , 2},
-    {0xc7, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0xc8, "eorb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xc9, "adcb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xca, "orb"  , ADDR_IMMEDIATE , 2 , 2},
-    {0xcb, "addb" , ADDR_IMMEDIATE , 2 , 2},
-    {0xcc, "ldd"  , ADDR_LIMMEDIATE, 3 , 3},
-    {0xcd, "???"  , ILLEGAL_OP     , 0 , 1},
-    {0xce, "ldu"  , ADDR_LIMMEDIATE, 3 , 3},
-    {0xcf, "???"  , ILLEGAL_OP     , 0 , 1},
+    {0xc0, "subb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc1, "cmpb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc2, "sbcb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc3, "addd" , ADDR_LIMMEDIATE, 4 , 3 , 3},
+    {0xc4, "andb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc5, "bitb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc6, "ldb"  , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc7, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+    {0xc8, "eorb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xc9, "adcb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xca, "orb"  , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xcb, "addb" , ADDR_IMMEDIATE , 2 , 2 , 2},
+    {0xcc, "ldd"  , ADDR_LIMMEDIATE, 3 , 3 , 3},
+#if (CPU_6309)
+    {0xcd, "ldq"  , ADDR_QIMMEDIATE, 5 , 5 , 5},
+#else
+    {0xcd, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
+#endif
+    {0xce, "ldu"  , ADDR_LIMMEDIATE, 3 , 3 , 3},
+    {0xcf, "???"  , ILLEGAL_OP     , 0 , 0 , 1},
 
-    {0xd0, "subb" , ADDR_DIRECT    , 4 , 2},
-    {0xd1, "cmpb" , ADDR_DIRECT    , 4 , 2},
-    {0xd2, "sbcb" , ADDR_DIRECT    , 4 , 2},
-    {0xd3, "addd" , ADDR_DIRECT    , 6 , 2},
-    {0xd4, "andb" , ADDR_DIRECT    , 4 , 2},
-    {0xd5, "bitb" , ADDR_DIRECT    , 4 , 2},
-    {0xd6, "ldb"  , ADDR_DIRECT    , 4 , 2},
-    {0xd7, "stb"  , ADDR_DIRECT    , 4 , 2},
-    {0xd8, "eorb" , ADDR_DIRECT    , 4 , 2},
-    {0xd9, "adcb" , ADDR_DIRECT    , 4 , 2},
-    {0xda, "orb"  , ADDR_DIRECT    , 4 , 2},
-    {0xdb, "addb" , ADDR_DIRECT    , 4 , 2},
-    {0xdc, "ldd"  , ADDR_DIRECT    , 5 , 2},
-    {0xdd, "std"  , ADDR_DIRECT    , 5 , 2},
-    {0xde, "ldu"  , ADDR_DIRECT    , 5 , 2},
-    {0xdf, "stu"  , ADDR_DIRECT    , 5 , 2},
+    {0xd0, "subb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd1, "cmpb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd2, "sbcb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd3, "addd" , ADDR_DIRECT    , 6 , 4 , 2},
+    {0xd4, "andb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd5, "bitb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd6, "ldb"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd7, "stb"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd8, "eorb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xd9, "adcb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xda, "orb"  , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xdb, "addb" , ADDR_DIRECT    , 4 , 3 , 2},
+    {0xdc, "ldd"  , ADDR_DIRECT    , 5 , 4 , 2},
+    {0xdd, "std"  , ADDR_DIRECT    , 5 , 4 , 2},
+    {0xde, "ldu"  , ADDR_DIRECT    , 5 , 4 , 2},
+    {0xdf, "stu"  , ADDR_DIRECT    , 5 , 4 , 2},
 
-    {0xe0, "subb" , ADDR_INDEXED   , 4 , 2},
-    {0xe1, "cmpb" , ADDR_INDEXED   , 4 , 2},
-    {0xe2, "sbcb" , ADDR_INDEXED   , 4 , 2},
-    {0xe3, "addd" , ADDR_INDEXED   , 6 , 2},
-    {0xe4, "andb" , ADDR_INDEXED   , 4 , 2},
-    {0xe5, "bitb" , ADDR_INDEXED   , 4 , 2},
-    {0xe6, "ldb"  , ADDR_INDEXED   , 4 , 2},
-    {0xe7, "stb"  , ADDR_INDEXED   , 4 , 2},
-    {0xe8, "eorb" , ADDR_INDEXED   , 4 , 2},
-    {0xe9, "adcb" , ADDR_INDEXED   , 4 , 2},
-    {0xea, "orb"  , ADDR_INDEXED   , 4 , 2},
-    {0xeb, "addb" , ADDR_INDEXED   , 4 , 2},
-    {0xec, "ldd"  , ADDR_INDEXED   , 5 , 2},
-    {0xed, "std"  , ADDR_INDEXED   , 5 , 2},
-    {0xee, "ldu"  , ADDR_INDEXED   , 5 , 2},
-    {0xef, "stu"  , ADDR_INDEXED   , 5 , 2},
+    {0xe0, "subb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe1, "cmpb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe2, "sbcb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe3, "addd" , ADDR_INDEXED   , 6 , 5 , 2},
+    {0xe4, "andb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe5, "bitb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe6, "ldb"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe7, "stb"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe8, "eorb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xe9, "adcb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xea, "orb"  , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xeb, "addb" , ADDR_INDEXED   , 4 , 4 , 2},
+    {0xec, "ldd"  , ADDR_INDEXED   , 5 , 5 , 2},
+    {0xed, "std"  , ADDR_INDEXED   , 5 , 5 , 2},
+    {0xee, "ldu"  , ADDR_INDEXED   , 5 , 5 , 2},
+    {0xef, "stu"  , ADDR_INDEXED   , 5 , 5 , 2},
 
-    {0xf0, "subb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf1, "cmpb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf2, "sbcb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf3, "addd" , ADDR_EXTENDED  , 7 , 3},
-    {0xf4, "andb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf5, "bitb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf6, "ldb"  , ADDR_EXTENDED  , 5 , 3},
-    {0xf7, "stb"  , ADDR_EXTENDED  , 5 , 3},
-    {0xf8, "eorb" , ADDR_EXTENDED  , 5 , 3},
-    {0xf9, "adcb" , ADDR_EXTENDED  , 5 , 3},
-    {0xfa, "orb"  , ADDR_EXTENDED  , 5 , 3},
-    {0xfb, "addb" , ADDR_EXTENDED  , 5 , 3},
-    {0xfc, "ldd"  , ADDR_EXTENDED  , 6 , 3},
-    {0xfd, "std"  , ADDR_EXTENDED  , 6 , 3},
-    {0xfe, "ldu"  , ADDR_EXTENDED  , 6 , 3},
-    {0xff, "stu"  , ADDR_EXTENDED  , 6 , 3},
+    {0xf0, "subb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf1, "cmpb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf2, "sbcb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf3, "addd" , ADDR_EXTENDED  , 7 , 5 , 3},
+    {0xf4, "andb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf5, "bitb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf6, "ldb"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf7, "stb"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf8, "eorb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xf9, "adcb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xfa, "orb"  , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xfb, "addb" , ADDR_EXTENDED  , 5 , 4 , 3},
+    {0xfc, "ldd"  , ADDR_EXTENDED  , 6 , 5 , 3},
+    {0xfd, "std"  , ADDR_EXTENDED  , 6 , 5 , 3},
+    {0xfe, "ldu"  , ADDR_EXTENDED  , 6 , 5 , 3},
+    {0xff, "stu"  , ADDR_EXTENDED  , 6 , 5 , 3},
 
     /* Double byte 0x10 op-codes
      * Index 256 to 293
      */
-    {0x21, "lbrn" , ADDR_LRELATIVE , 5 , 4},
-    {0x22, "lbhi" , ADDR_LRELATIVE , 5 , 4},
-    {0x23, "lbls" , ADDR_LRELATIVE , 5 , 4},
-    {0x24, "lbcc" , ADDR_LRELATIVE , 5 , 4},    // lbhs
-    {0x25, "lbcs" , ADDR_LRELATIVE , 5 , 4},    // lblo
-    {0x26, "lbne" , ADDR_LRELATIVE , 5 , 4},
-    {0x27, "lbeq" , ADDR_LRELATIVE , 5 , 4},
-    {0x28, "lbvc" , ADDR_LRELATIVE , 5 , 4},
-    {0x29, "lbvs" , ADDR_LRELATIVE , 5 , 4},
-    {0x2a, "lbpl" , ADDR_LRELATIVE , 5 , 4},
-    {0x2b, "lbmi" , ADDR_LRELATIVE , 5 , 4},
-    {0x2c, "lbge" , ADDR_LRELATIVE , 5 , 4},
-    {0x2d, "lblt" , ADDR_LRELATIVE , 5 , 4},
-    {0x2e, "lbgt" , ADDR_LRELATIVE , 5 , 4},
-    {0x2f, "lble" , ADDR_LRELATIVE , 5 , 4},
-    {0x3f, "swi2" , ADDR_INHERENT  , 20, 2},
-    {0x83, "cmpd" , ADDR_LIMMEDIATE, 5 , 4},
-    {0x8c, "cmpy" , ADDR_LIMMEDIATE, 5 , 4},
-    {0x8e, "ldy"  , ADDR_LIMMEDIATE, 4 , 4},
-    {0x93, "cmpd" , ADDR_DIRECT    , 7 , 3},
-    {0x9c, "cmpy" , ADDR_DIRECT    , 7 , 3},
-    {0x9e, "ldy"  , ADDR_DIRECT    , 6 , 3},
-    {0x9f, "sty"  , ADDR_DIRECT    , 6 , 3},
-    {0xa3, "cmpd" , ADDR_INDEXED   , 7 , 3},
-    {0xac, "cmpy" , ADDR_INDEXED   , 7 , 3},
-    {0xae, "ldy"  , ADDR_INDEXED   , 6 , 3},
-    {0xaf, "sty"  , ADDR_INDEXED   , 6 , 3},
-    {0xb3, "cmpd" , ADDR_EXTENDED  , 8 , 4},
-    {0xbc, "cmpy" , ADDR_EXTENDED  , 8 , 4},
-    {0xbe, "ldy"  , ADDR_EXTENDED  , 7 , 4},
-    {0xbf, "sty"  , ADDR_EXTENDED  , 7 , 4},
-    {0xce, "lds"  , ADDR_LIMMEDIATE, 4 , 4},
-    {0xde, "lds"  , ADDR_DIRECT    , 6 , 3},
-    {0xdf, "sts"  , ADDR_DIRECT    , 6 , 3},
-    {0xee, "lds"  , ADDR_INDEXED   , 6 , 3},
-    {0xef, "sts"  , ADDR_INDEXED   , 6 , 3},
-    {0xfe, "lds"  , ADDR_EXTENDED  , 7 , 4},
-    {0xff, "sts"  , ADDR_EXTENDED  , 7 , 4},
+    {0x21, "lbrn" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x22, "lbhi" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x23, "lbls" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x24, "lbcc" , ADDR_LRELATIVE , 5 , 5 , 4},    // lbhs
+    {0x25, "lbcs" , ADDR_LRELATIVE , 5 , 5 , 4},    // lblo
+    {0x26, "lbne" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x27, "lbeq" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x28, "lbvc" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x29, "lbvs" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2a, "lbpl" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2b, "lbmi" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2c, "lbge" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2d, "lblt" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2e, "lbgt" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x2f, "lble" , ADDR_LRELATIVE , 5 , 5 , 4},
+    {0x3f, "swi2" , ADDR_INHERENT  , 20, 22, 2},
+    {0x83, "cmpd" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x8c, "cmpy" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x8e, "ldy"  , ADDR_LIMMEDIATE, 4 , 4 , 4},
+    {0x93, "cmpd" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x9c, "cmpy" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x9e, "ldy"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0x9f, "sty"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0xa3, "cmpd" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xac, "cmpy" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xae, "ldy"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xaf, "sty"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xb3, "cmpd" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xbc, "cmpy" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xbe, "ldy"  , ADDR_EXTENDED  , 7 , 6 , 4},
+    {0xbf, "sty"  , ADDR_EXTENDED  , 7 , 6 , 4},
+    {0xce, "lds"  , ADDR_LIMMEDIATE, 4 , 4 , 4},
+    {0xde, "lds"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0xdf, "sts"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0xee, "lds"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xef, "sts"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xfe, "lds"  , ADDR_EXTENDED  , 7 , 6 , 4},
+    {0xff, "sts"  , ADDR_EXTENDED  , 7 , 6 , 4},
+
+    /* HD6309 double byte 0x10 op-codes
+     * Index 294 to 373
+     */
+#if (CPU_6309)
+    {0x30, "addr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x31, "adcr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x32, "subr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x33, "sbcr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x34, "andr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x35, "orr"  , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x36, "eorr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x37, "cmpr" , ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x38, "pshsw", ADDR_INHERENT  , 6 , 6 , 2},
+    {0x39, "pulsw", ADDR_INHERENT  , 6 , 6 , 2},
+    {0x3a, "pshuw", ADDR_INHERENT  , 6 , 6 , 2},
+    {0x3b, "puluw", ADDR_INHERENT  , 6 , 6 , 2},
+    {0x40, "negd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x43, "comd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x44, "lsrd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x46, "rord" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x47, "asrd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x48, "asld" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x49, "rold" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4a, "decd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4c, "incd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4d, "tstd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4f, "clrd" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x53, "comw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x54, "lsrw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x56, "rorw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x59, "rolw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5a, "decw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5c, "incw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5d, "tstw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5f, "clrw" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x80, "subw" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x81, "cmpw" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x82, "sbcd" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x84, "andd" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x85, "bitd" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x86, "ldw"  , ADDR_LIMMEDIATE, 4 , 4 , 4},
+    {0x88, "eord" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x89, "adcd" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x8a, "ord"  , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x8b, "addw" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x90, "subw" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x91, "cmpw" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x92, "sbcd" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x94, "andd" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x95, "bitd" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x96, "ldw"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0x97, "stw"  , ADDR_DIRECT    , 6 , 5 , 3},
+    {0x98, "eord" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x99, "adcd" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x9a, "ord"  , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x9b, "addw" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0xa0, "subw" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa1, "cmpw" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa2, "sbcd" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa4, "andd" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa5, "bitd" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa6, "ldw"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xa7, "stw"  , ADDR_INDEXED   , 6 , 6 , 3},
+    {0xa8, "eord" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xa9, "adcd" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xaa, "ord"  , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xab, "addw" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xb0, "subw" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb1, "cmpw" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb2, "sbcd" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb4, "andd" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb5, "bitd" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb6, "ldw"  , ADDR_EXTENDED  , 7 , 6 , 4},
+    {0xb7, "stw"  , ADDR_EXTENDED  , 7 , 6 , 4},
+    {0xb8, "eord" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xb9, "adcd" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xba, "ord"  , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xbb, "addw" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xdc, "ldq"  , ADDR_DIRECT    , 8 , 7 , 3},
+    {0xdd, "stq"  , ADDR_DIRECT    , 8 , 7 , 3},
+    {0xec, "ldq"  , ADDR_INDEXED   , 8 , 8 , 3},
+    {0xed, "stq"  , ADDR_INDEXED   , 8 , 8 , 3},
+    {0xfc, "ldq"  , ADDR_EXTENDED  , 9 , 8 , 4},
+    {0xfd, "stq"  , ADDR_EXTENDED  , 9 , 8 , 4},
+#endif
 
     /* Double byte 0x11 op-codes
-     * Index 294 to 302
+     * Index 294 to 302, or 374 to 382 with the HD6309 op-codes
+     */
+    {0x3f, "swi3" , ADDR_INHERENT  , 20, 22, 2},
+    {0x83, "cmpu" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x8c, "cmps" , ADDR_LIMMEDIATE, 5 , 4 , 4},
+    {0x93, "cmpu" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0x9c, "cmps" , ADDR_DIRECT    , 7 , 5 , 3},
+    {0xa3, "cmpu" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xac, "cmps" , ADDR_INDEXED   , 7 , 6 , 3},
+    {0xb3, "cmpu" , ADDR_EXTENDED  , 8 , 6 , 4},
+    {0xbc, "cmps" , ADDR_EXTENDED  , 8 , 6 , 4},
+
+    /* HD6309 double byte 0x11 op-codes
+     * Index 383 to 456
      */
-    {0xef, "swi3" , ADDR_INHERENT  , 20, 2},
-    {0x83, "cmpu" , ADDR_LIMMEDIATE, 5 , 4},
-    {0x8c, "cmps" , ADDR_LIMMEDIATE, 5 , 4},
-    {0x93, "cmpu" , ADDR_DIRECT    , 7 , 3},
-    {0x9c, "cmps" , ADDR_DIRECT    , 7 , 3},
-    {0xa3, "cmpu" , ADDR_INDEXED   , 7 , 3},
-    {0xac, "cmps" , ADDR_INDEXED   , 7 , 3},
-    {0xb3, "cmpu" , ADDR_EXTENDED  , 8 , 4},
-    {0xbc, "cmps" , ADDR_EXTENDED  , 8 , 4},
+#if (CPU_6309)
+    {0x30, "band" , ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x31, "biand", ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x32, "bor"  , ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x33, "bior" , ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x34, "beor" , ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x35, "bieor", ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x36, "ldbt" , ADDR_IMDIRECT  , 7 , 6 , 4},
+    {0x37, "stbt" , ADDR_IMDIRECT  , 8 , 7 , 4},
+    {0x38, "tfm"  , ADDR_IMMEDIATE , 6 , 6 , 3},
+    {0x39, "tfm"  , ADDR_IMMEDIATE , 6 , 6 , 3},
+    {0x3a, "tfm"  , ADDR_IMMEDIATE , 6 , 6 , 3},
+    {0x3b, "tfm"  , ADDR_IMMEDIATE , 6 , 6 , 3},
+    {0x3c, "bitmd", ADDR_IMMEDIATE , 4 , 4 , 3},
+    {0x3d, "ldmd" , ADDR_IMMEDIATE , 5 , 5 , 3},
+    {0x43, "come" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4a, "dece" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4c, "ince" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4d, "tste" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x4f, "clre" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x53, "comf" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5a, "decf" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5c, "incf" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5d, "tstf" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x5f, "clrf" , ADDR_INHERENT  , 3 , 2 , 2},
+    {0x80, "sube" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0x81, "cmpe" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0x86, "lde"  , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0x8b, "adde" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0x8d, "divd" , ADDR_IMMEDIATE , 25, 25, 3},
+    {0x8e, "divq" , ADDR_LIMMEDIATE, 34, 34, 4},
+    {0x8f, "muld" , ADDR_LIMMEDIATE, 28, 28, 4},
+    {0x90, "sube" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0x91, "cmpe" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0x96, "lde"  , ADDR_DIRECT    , 5 , 4 , 3},
+    {0x97, "ste"  , ADDR_DIRECT    , 5 , 4 , 3},
+    {0x9b, "adde" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0x9d, "divd" , ADDR_DIRECT    , 27, 26, 3},
+    {0x9e, "divq" , ADDR_DIRECT    , 36, 35, 3},
+    {0x9f, "muld" , ADDR_DIRECT    , 30, 29, 3},
+    {0xa0, "sube" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xa1, "cmpe" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xa6, "lde"  , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xa7, "ste"  , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xab, "adde" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xad, "divd" , ADDR_INDEXED   , 27, 27, 3},
+    {0xae, "divq" , ADDR_INDEXED   , 36, 36, 3},
+    {0xaf, "muld" , ADDR_INDEXED   , 30, 30, 3},
+    {0xb0, "sube" , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xb1, "cmpe" , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xb6, "lde"  , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xb7, "ste"  , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xbb, "adde" , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xbd, "divd" , ADDR_EXTENDED  , 28, 27, 4},
+    {0xbe, "divq" , ADDR_EXTENDED  , 37, 36, 4},
+    {0xbf, "muld" , ADDR_EXTENDED  , 31, 30, 4},
+    {0xc0, "subf" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0xc1, "cmpf" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0xc6, "ldf"  , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0xcb, "addf" , ADDR_IMMEDIATE , 3 , 3 , 3},
+    {0xd0, "subf" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0xd1, "cmpf" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0xd6, "ldf"  , ADDR_DIRECT    , 5 , 4 , 3},
+    {0xd7, "stf"  , ADDR_DIRECT    , 5 , 4 , 3},
+    {0xdb, "addf" , ADDR_DIRECT    , 5 , 4 , 3},
+    {0xe0, "subf" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xe1, "cmpf" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xe6, "ldf"  , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xe7, "stf"  , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xeb, "addf" , ADDR_INDEXED   , 5 , 5 , 3},
+    {0xf0, "subf" , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xf1, "cmpf" , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xf6, "ldf"  , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xf7, "stf"  , ADDR_EXTENDED  , 6 , 5 , 4},
+    {0xfb, "addf" , ADDR_EXTENDED  , 6 , 5 , 4},
+#endif
 };
 
 #endif  /* __MC6809E_H__ */
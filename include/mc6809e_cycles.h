@@ -0,0 +1,99 @@
+/*
+ * mc6809e_cycles.h
+ *
+ * This header file lists the MC6809E clock cycles of every op-code
+ * and indexed addressing post-byte, for the cycle audit build.
+ *
+ * The tables are written from the CPU data sheet
+ * Motorola INC. 1984 DS9846-R2, independently of the cycle
+ * counts in mc6809e.h, so that the audit checks the cycle
+ * counts the CPU module uses against a second source.
+ *
+ * Op-codes that are not listed are marked '-1'. The 0x10 and 0x11
+ * page cycle counts include the prefix byte. The cycles of the
+ * 0x10 and 0x11 prefixes in the first page are '0'.
+ * Cycles that depend on the instruction are added to the table
+ * cycles:
+ *   Indexed addressing   cycle_reference_index[] cycles of the post-byte
+ *   PSHS/PULS/PSHU/PULU  one cycle per byte pushed or pulled
+ *   RTI                  nine cycles when the pulled CC has E set
+ *   Long Bcc             one cycle when the branch is taken
+ *
+ *  October 17, 2026
+ *
+ */
+
+#ifndef __MC6809E_CYCLES_H__
+#define __MC6809E_CYCLES_H__
+
+#include    <stdint.h>
+
+/* Op-code cycles of the three op-code pages
+ */
+const int8_t cycle_reference[3][256] = {
+  {
+     6, -1, -1,  6,  6, -1,  6,  6,  6,  6,  6, -1,  6,  6,  3,  6,   // 0x00
+     0,  0,  2,  4, -1, -1,  5,  9, -1,  2,  3, -1,  3,  2,  8,  6,   // 0x10
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,   // 0x20
+     4,  4,  4,  4,  5,  5,  5,  5, -1,  5,  3,  6, 20, 11, -1, 19,   // 0x30
+     2, -1, -1,  2,  2, -1,  2,  2,  2,  2,  2, -1,  2,  2, -1,  2,   // 0x40
+     2, -1, -1,  2,  2, -1,  2,  2,  2,  2,  2, -1,  2,  2, -1,  2,   // 0x50
+     6, -1, -1,  6,  6, -1,  6,  6,  6,  6,  6, -1,  6,  6,  3,  6,   // 0x60
+     7, -1, -1,  7,  7, -1,  7,  7,  7,  7,  7, -1,  7,  7,  4,  7,   // 0x70
+     2,  2,  2,  4,  2,  2,  2, -1,  2,  2,  2,  2,  4,  7,  3, -1,   // 0x80
+     4,  4,  4,  6,  4,  4,  4,  4,  4,  4,  4,  4,  6,  7,  5,  5,   // 0x90
+     4,  4,  4,  6,  4,  4,  4,  4,  4,  4,  4,  4,  6,  7,  5,  5,   // 0xa0
+     5,  5,  5,  7,  5,  5,  5,  5,  5,  5,  5,  5,  7,  8,  6,  6,   // 0xb0
+     2,  2,  2,  4,  2,  2,  2, -1,  2,  2,  2,  2,  3, -1,  3, -1,   // 0xc0
+     4,  4,  4,  6,  4,  4,  4,  4,  4,  4,  4,  4,  5,  5,  5,  5,   // 0xd0
+     4,  4,  4,  6,  4,  4,  4,  4,  4,  4,  4,  4,  5,  5,  5,  5,   // 0xe0
+     5,  5,  5,  7,  5,  5,  5,  5,  5,  5,  5,  5,  6,  6,  6,  6,   // 0xf0
+  },
+  {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x00
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x10
+    -1,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,   // 0x20
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 20,   // 0x30
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x40
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x50
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x60
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x70
+    -1, -1, -1,  5, -1, -1, -1, -1, -1, -1, -1, -1,  5, -1,  4, -1,   // 0x80
+    -1, -1, -1,  7, -1, -1, -1, -1, -1, -1, -1, -1,  7, -1,  6,  6,   // 0x90
+    -1, -1, -1,  7, -1, -1, -1, -1, -1, -1, -1, -1,  7, -1,  6,  6,   // 0xa0
+    -1, -1, -1,  8, -1, -1, -1, -1, -1, -1, -1, -1,  8, -1,  7,  7,   // 0xb0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  4, -1,   // 0xc0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  6,  6,   // 0xd0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  6,  6,   // 0xe0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  7,  7,   // 0xf0
+  },
+  {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x00
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x10
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x20
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 20,   // 0x30
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x40
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x50
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x60
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0x70
+    -1, -1, -1,  5, -1, -1, -1, -1, -1, -1, -1, -1,  5, -1, -1, -1,   // 0x80
+    -1, -1, -1,  7, -1, -1, -1, -1, -1, -1, -1, -1,  7, -1, -1, -1,   // 0x90
+    -1, -1, -1,  7, -1, -1, -1, -1, -1, -1, -1, -1,  7, -1, -1, -1,   // 0xa0
+    -1, -1, -1,  8, -1, -1, -1, -1, -1, -1, -1, -1,  8, -1, -1, -1,   // 0xb0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0xc0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0xd0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0xe0
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,   // 0xf0
+  },
+};
+
+/* Indexed addressing cycles added to the op-code cycles,
+ * by the low five post-byte bits of post-bytes 0x80 to 0xff.
+ * Post-bytes 0x00 to 0x7f, the 5-bit offsets, add one cycle.
+ */
+const int8_t cycle_reference_index[32] = {
+     2,  3,  2,  3,  0,  1,  1, -1,  1,  4, -1,  4,  1,  5, -1, -1,   // ,R+ ,R++ ,-R ,--R ,R B,R A,R - n8,R n16,R - D,R n8,PC n16,PC - -
+    -1,  6, -1,  6,  3,  4,  4, -1,  4,  7, -1,  7,  4,  8, -1,  5,   // Indirect, and [n16] extended indirect
+};
+
+#endif  /* __MC6809E_CYCLES_H__ */
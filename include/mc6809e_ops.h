@@ -0,0 +1,496 @@
+/*
+ * mc6809e_ops.h
+ *
+ * This header file lists the MC6809E op-codes with the
+ * operation and addressing mode of each op-code.
+ * The lists are used by cpu.c to build the op-code handler
+ * dispatch tables, where each op-code is handled by a function
+ * or label that is specialized for its operation and addressing mode.
+ *
+ * Each entry is OP(op_code, operation, addressing_mode) where
+ * 'operation' selects an op_<operation>() function and 'addressing_mode'
+ * selects an ea_<addressing_mode>() effective address function.
+ * The 0x10 and 0x11 prefixes are dispatched separately and are
+ * not listed in the first page.
+ *
+ *  October 17, 2026
+ *
+ */
+
+#ifndef __MC6809E_OPS_H__
+#define __MC6809E_OPS_H__
+
+#include    "config.h"
+
+/* HD6309 op-codes, included in the op-code lists with CPU_6309.
+ * The 'imdir', 'imidx' and 'imext' modes have an immediate byte
+ * ahead of the memory operand, and 'qimm' is a 32-bit immediate.
+ */
+#if (CPU_6309)
+
+#define     OP_CODES_PAGE1_6309(OP) \
+    OP(0x01, oim,   imdir) \
+    OP(0x02, aim,   imdir) \
+    OP(0x05, eim,   imdir) \
+    OP(0x0b, tim,   imdir) \
+    OP(0x14, sexw,  inh)   \
+    OP(0x61, oim,   imidx) \
+    OP(0x62, aim,   imidx) \
+    OP(0x65, eim,   imidx) \
+    OP(0x6b, tim,   imidx) \
+    OP(0x71, oim,   imext) \
+    OP(0x72, aim,   imext) \
+    OP(0x75, eim,   imext) \
+    OP(0x7b, tim,   imext) \
+    OP(0xcd, ldq,   qimm)
+
+#define     OP_CODES_PAGE2_6309(OP) \
+    OP(0x30, addr,  imm)   \
+    OP(0x31, adcr,  imm)   \
+    OP(0x32, subr,  imm)   \
+    OP(0x33, sbcr,  imm)   \
+    OP(0x34, andr,  imm)   \
+    OP(0x35, orr,   imm)   \
+    OP(0x36, eorr,  imm)   \
+    OP(0x37, cmpr,  imm)   \
+    OP(0x38, pshsw, inh)   \
+    OP(0x39, pulsw, inh)   \
+    OP(0x3a, pshuw, inh)   \
+    OP(0x3b, puluw, inh)   \
+    OP(0x40, negd,  inh)   \
+    OP(0x43, comd,  inh)   \
+    OP(0x44, lsrd,  inh)   \
+    OP(0x46, rord,  inh)   \
+    OP(0x47, asrd,  inh)   \
+    OP(0x48, asld,  inh)   \
+    OP(0x49, rold,  inh)   \
+    OP(0x4a, decd,  inh)   \
+    OP(0x4c, incd,  inh)   \
+    OP(0x4d, tstd,  inh)   \
+    OP(0x4f, clrd,  inh)   \
+    OP(0x53, comw,  inh)   \
+    OP(0x54, lsrw,  inh)   \
+    OP(0x56, rorw,  inh)   \
+    OP(0x59, rolw,  inh)   \
+    OP(0x5a, decw,  inh)   \
+    OP(0x5c, incw,  inh)   \
+    OP(0x5d, tstw,  inh)   \
+    OP(0x5f, clrw,  inh)   \
+    OP(0x80, subw,  limm)  \
+    OP(0x81, cmpw,  limm)  \
+    OP(0x82, sbcd,  limm)  \
+    OP(0x84, andd,  limm)  \
+    OP(0x85, bitd,  limm)  \
+    OP(0x86, ldw,   limm)  \
+    OP(0x88, eord,  limm)  \
+    OP(0x89, adcd,  limm)  \
+    OP(0x8a, ord,   limm)  \
+    OP(0x8b, addw,  limm)  \
+    OP(0x90, subw,  dir)   \
+    OP(0x91, cmpw,  dir)   \
+    OP(0x92, sbcd,  dir)   \
+    OP(0x94, andd,  dir)   \
+    OP(0x95, bitd,  dir)   \
+    OP(0x96, ldw,   dir)   \
+    OP(0x97, stw,   dir)   \
+    OP(0x98, eord,  dir)   \
+    OP(0x99, adcd,  dir)   \
+    OP(0x9a, ord,   dir)   \
+    OP(0x9b, addw,  dir)   \
+    OP(0xa0, subw,  idx)   \
+    OP(0xa1, cmpw,  idx)   \
+    OP(0xa2, sbcd,  idx)   \
+    OP(0xa4, andd,  idx)   \
+    OP(0xa5, bitd,  idx)   \
+    OP(0xa6, ldw,   idx)   \
+    OP(0xa7, stw,   idx)   \
+    OP(0xa8, eord,  idx)   \
+    OP(0xa9, adcd,  idx)   \
+    OP(0xaa, ord,   idx)   \
+    OP(0xab, addw,  idx)   \
+    OP(0xb0, subw,  ext)   \
+    OP(0xb1, cmpw,  ext)   \
+    OP(0xb2, sbcd,  ext)   \
+    OP(0xb4, andd,  ext)   \
+    OP(0xb5, bitd,  ext)   \
+    OP(0xb6, ldw,   ext)   \
+    OP(0xb7, stw,   ext)   \
+    OP(0xb8, eord,  ext)   \
+    OP(0xb9, adcd,  ext)   \
+    OP(0xba, ord,   ext)   \
+    OP(0xbb, addw,  ext)   \
+    OP(0xdc, ldq,   dir)   \
+    OP(0xdd, stq,   dir)   \
+    OP(0xec, ldq,   idx)   \
+    OP(0xed, stq,   idx)   \
+    OP(0xfc, ldq,   ext)   \
+    OP(0xfd, stq,   ext)
+
+#define     OP_CODES_PAGE3_6309(OP) \
+    OP(0x30, band,  imdir) \
+    OP(0x31, biand, imdir) \
+    OP(0x32, bor,   imdir) \
+    OP(0x33, bior,  imdir) \
+    OP(0x34, beor,  imdir) \
+    OP(0x35, bieor, imdir) \
+    OP(0x36, ldbt,  imdir) \
+    OP(0x37, stbt,  imdir) \
+    OP(0x38, tfmpp, imm)   \
+    OP(0x39, tfmmm, imm)   \
+    OP(0x3a, tfmpn, imm)   \
+    OP(0x3b, tfmnp, imm)   \
+    OP(0x3c, bitmd, imm)   \
+    OP(0x3d, ldmd,  imm)   \
+    OP(0x43, come,  inh)   \
+    OP(0x4a, dece,  inh)   \
+    OP(0x4c, ince,  inh)   \
+    OP(0x4d, tste,  inh)   \
+    OP(0x4f, clre,  inh)   \
+    OP(0x53, comf,  inh)   \
+    OP(0x5a, decf,  inh)   \
+    OP(0x5c, incf,  inh)   \
+    OP(0x5d, tstf,  inh)   \
+    OP(0x5f, clrf,  inh)   \
+    OP(0x80, sube,  imm)   \
+    OP(0x81, cmpe,  imm)   \
+    OP(0x86, lde,   imm)   \
+    OP(0x8b, adde,  imm)   \
+    OP(0x8d, divd,  imm)   \
+    OP(0x8e, divq,  limm)  \
+    OP(0x8f, muld,  limm)  \
+    OP(0x90, sube,  dir)   \
+    OP(0x91, cmpe,  dir)   \
+    OP(0x96, lde,   dir)   \
+    OP(0x97, ste,   dir)   \
+    OP(0x9b, adde,  dir)   \
+    OP(0x9d, divd,  dir)   \
+    OP(0x9e, divq,  dir)   \
+    OP(0x9f, muld,  dir)   \
+    OP(0xa0, sube,  idx)   \
+    OP(0xa1, cmpe,  idx)   \
+    OP(0xa6, lde,   idx)   \
+    OP(0xa7, ste,   idx)   \
+    OP(0xab, adde,  idx)   \
+    OP(0xad, divd,  idx)   \
+    OP(0xae, divq,  idx)   \
+    OP(0xaf, muld,  idx)   \
+    OP(0xb0, sube,  ext)   \
+    OP(0xb1, cmpe,  ext)   \
+    OP(0xb6, lde,   ext)   \
+    OP(0xb7, ste,   ext)   \
+    OP(0xbb, adde,  ext)   \
+    OP(0xbd, divd,  ext)   \
+    OP(0xbe, divq,  ext)   \
+    OP(0xbf, muld,  ext)   \
+    OP(0xc0, subf,  imm)   \
+    OP(0xc1, cmpf,  imm)   \
+    OP(0xc6, ldf,   imm)   \
+    OP(0xcb, addf,  imm)   \
+    OP(0xd0, subf,  dir)   \
+    OP(0xd1, cmpf,  dir)   \
+    OP(0xd6, ldf,   dir)   \
+    OP(0xd7, stf,   dir)   \
+    OP(0xdb, addf,  dir)   \
+    OP(0xe0, subf,  idx)   \
+    OP(0xe1, cmpf,  idx)   \
+    OP(0xe6, ldf,   idx)   \
+    OP(0xe7, stf,   idx)   \
+    OP(0xeb, addf,  idx)   \
+    OP(0xf0, subf,  ext)   \
+    OP(0xf1, cmpf,  ext)   \
+    OP(0xf6, ldf,   ext)   \
+    OP(0xf7, stf,   ext)   \
+    OP(0xfb, addf,  ext)
+
+#else
+
+#define     OP_CODES_PAGE1_6309(OP)
+#define     OP_CODES_PAGE2_6309(OP)
+#define     OP_CODES_PAGE3_6309(OP)
+
+#endif
+
+/* Single byte op-codes
+ */
+#define     OP_CODES_PAGE1(OP) \
+    OP(0x00, neg,   dir)   \
+    OP(0x03, com,   dir)   \
+    OP(0x04, lsr,   dir)   \
+    OP(0x06, ror,   dir)   \
+    OP(0x07, asr,   dir)   \
+    OP(0x08, asl,   dir)   \
+    OP(0x09, rol,   dir)   \
+    OP(0x0a, dec,   dir)   \
+    OP(0x0c, inc,   dir)   \
+    OP(0x0d, tst,   dir)   \
+    OP(0x0e, jmp,   dir)   \
+    OP(0x0f, clr,   dir)   \
+    OP(0x12, nop,   inh)   \
+    OP(0x13, sync,  inh)   \
+    OP(0x16, lbra,  lrel)  \
+    OP(0x17, lbsr,  lrel)  \
+    OP(0x19, daa,   inh)   \
+    OP(0x1a, orcc,  imm)   \
+    OP(0x1c, andcc, imm)   \
+    OP(0x1d, sex,   inh)   \
+    OP(0x1e, exg,   imm)   \
+    OP(0x1f, tfr,   imm)   \
+    OP(0x20, bra,   rel)   \
+    OP(0x21, brn,   rel)   \
+    OP(0x22, bhi,   rel)   \
+    OP(0x23, bls,   rel)   \
+    OP(0x24, bcc,   rel)   \
+    OP(0x25, bcs,   rel)   \
+    OP(0x26, bne,   rel)   \
+    OP(0x27, beq,   rel)   \
+    OP(0x28, bvc,   rel)   \
+    OP(0x29, bvs,   rel)   \
+    OP(0x2a, bpl,   rel)   \
+    OP(0x2b, bmi,   rel)   \
+    OP(0x2c, bge,   rel)   \
+    OP(0x2d, blt,   rel)   \
+    OP(0x2e, bgt,   rel)   \
+    OP(0x2f, ble,   rel)   \
+    OP(0x30, leax,  idx)   \
+    OP(0x31, leay,  idx)   \
+    OP(0x32, leas,  idx)   \
+    OP(0x33, leau,  idx)   \
+    OP(0x34, pshs,  imm)   \
+    OP(0x35, puls,  imm)   \
+    OP(0x36, pshu,  imm)   \
+    OP(0x37, pulu,  imm)   \
+    OP(0x39, rts,   inh)   \
+    OP(0x3a, abx,   inh)   \
+    OP(0x3b, rti,   inh)   \
+    OP(0x3c, cwai,  inh)   \
+    OP(0x3d, mul,   inh)   \
+    OP(0x3f, swi,   inh)   \
+    OP(0x40, nega,  inh)   \
+    OP(0x43, coma,  inh)   \
+    OP(0x44, lsra,  inh)   \
+    OP(0x46, rora,  inh)   \
+    OP(0x47, asra,  inh)   \
+    OP(0x48, asla,  inh)   \
+    OP(0x49, rola,  inh)   \
+    OP(0x4a, deca,  inh)   \
+    OP(0x4c, inca,  inh)   \
+    OP(0x4d, tsta,  inh)   \
+    OP(0x4f, clra,  inh)   \
+    OP(0x50, negb,  inh)   \
+    OP(0x53, comb,  inh)   \
+    OP(0x54, lsrb,  inh)   \
+    OP(0x56, rorb,  inh)   \
+    OP(0x57, asrb,  inh)   \
+    OP(0x58, aslb,  inh)   \
+    OP(0x59, rolb,  inh)   \
+    OP(0x5a, decb,  inh)   \
+    OP(0x5c, incb,  inh)   \
+    OP(0x5d, tstb,  inh)   \
+    OP(0x5f, clrb,  inh)   \
+    OP(0x60, neg,   idx)   \
+    OP(0x63, com,   idx)   \
+    OP(0x64, lsr,   idx)   \
+    OP(0x66, ror,   idx)   \
+    OP(0x67, asr,   idx)   \
+    OP(0x68, asl,   idx)   \
+    OP(0x69, rol,   idx)   \
+    OP(0x6a, dec,   idx)   \
+    OP(0x6c, inc,   idx)   \
+    OP(0x6d, tst,   idx)   \
+    OP(0x6e, jmp,   idx)   \
+    OP(0x6f, clr,   idx)   \
+    OP(0x70, neg,   ext)   \
+    OP(0x73, com,   ext)   \
+    OP(0x74, lsr,   ext)   \
+    OP(0x76, ror,   ext)   \
+    OP(0x77, asr,   ext)   \
+    OP(0x78, asl,   ext)   \
+    OP(0x79, rol,   ext)   \
+    OP(0x7a, dec,   ext)   \
+    OP(0x7c, inc,   ext)   \
+    OP(0x7d, tst,   ext)   \
+    OP(0x7e, jmp,   ext)   \
+    OP(0x7f, clr,   ext)   \
+    OP(0x80, suba,  imm)   \
+    OP(0x81, cmpa,  imm)   \
+    OP(0x82, sbca,  imm)   \
+    OP(0x83, subd,  limm)  \
+    OP(0x84, anda,  imm)   \
+    OP(0x85, bita,  imm)   \
+    OP(0x86, lda,   imm)   \
+    OP(0x88, eora,  imm)   \
+    OP(0x89, adca,  imm)   \
+    OP(0x8a, ora,   imm)   \
+    OP(0x8b, adda,  imm)   \
+    OP(0x8c, cmpx,  limm)  \
+    OP(0x8d, bsr,   rel)   \
+    OP(0x8e, ldx,   limm)  \
+    OP(0x90, suba,  dir)   \
+    OP(0x91, cmpa,  dir)   \
+    OP(0x92, sbca,  dir)   \
+    OP(0x93, subd,  dir)   \
+    OP(0x94, anda,  dir)   \
+    OP(0x95, bita,  dir)   \
+    OP(0x96, lda,   dir)   \
+    OP(0x97, sta,   dir)   \
+    OP(0x98, eora,  dir)   \
+    OP(0x99, adca,  dir)   \
+    OP(0x9a, ora,   dir)   \
+    OP(0x9b, adda,  dir)   \
+    OP(0x9c, cmpx,  dir)   \
+    OP(0x9d, jsr,   dir)   \
+    OP(0x9e, ldx,   dir)   \
+    OP(0x9f, stx,   dir)   \
+    OP(0xa0, suba,  idx)   \
+    OP(0xa1, cmpa,  idx)   \
+    OP(0xa2, sbca,  idx)   \
+    OP(0xa3, subd,  idx)   \
+    OP(0xa4, anda,  idx)   \
+    OP(0xa5, bita,  idx)   \
+    OP(0xa6, lda,   idx)   \
+    OP(0xa7, sta,   idx)   \
+    OP(0xa8, eora,  idx)   \
+    OP(0xa9, adca,  idx)   \
+    OP(0xaa, ora,   idx)   \
+    OP(0xab, adda,  idx)   \
+    OP(0xac, cmpx,  idx)   \
+    OP(0xad, jsr,   idx)   \
+    OP(0xae, ldx,   idx)   \
+    OP(0xaf, stx,   idx)   \
+    OP(0xb0, suba,  ext)   \
+    OP(0xb1, cmpa,  ext)   \
+    OP(0xb2, sbca,  ext)   \
+    OP(0xb3, subd,  ext)   \
+    OP(0xb4, anda,  ext)   \
+    OP(0xb5, bita,  ext)   \
+    OP(0xb6, lda,   ext)   \
+    OP(0xb7, sta,   ext)   \
+    OP(0xb8, eora,  ext)   \
+    OP(0xb9, adca,  ext)   \
+    OP(0xba, ora,   ext)   \
+    OP(0xbb, adda,  ext)   \
+    OP(0xbc, cmpx,  ext)   \
+    OP(0xbd, jsr,   ext)   \
+    OP(0xbe, ldx,   ext)   \
+    OP(0xbf, stx,   ext)   \
+    OP(0xc0, subb,  imm)   \
+    OP(0xc1, cmpb,  imm)   \
+    OP(0xc2, sbcb,  imm)   \
+    OP(0xc3, addd,  limm)  \
+    OP(0xc4, andb,  imm)   \
+    OP(0xc5, bitb,  imm)   \
+    OP(0xc6, ldb,   imm)   \
+    OP(0xc8, eorb,  imm)   \
+    OP(0xc9, adcb,  imm)   \
+    OP(0xca, orb,   imm)   \
+    OP(0xcb, addb,  imm)   \
+    OP(0xcc, ldd,   limm)  \
+    OP(0xce, ldu,   limm)  \
+    OP(0xd0, subb,  dir)   \
+    OP(0xd1, cmpb,  dir)   \
+    OP(0xd2, sbcb,  dir)   \
+    OP(0xd3, addd,  dir)   \
+    OP(0xd4, andb,  dir)   \
+    OP(0xd5, bitb,  dir)   \
+    OP(0xd6, ldb,   dir)   \
+    OP(0xd7, stb,   dir)   \
+    OP(0xd8, eorb,  dir)   \
+    OP(0xd9, adcb,  dir)   \
+    OP(0xda, orb,   dir)   \
+    OP(0xdb, addb,  dir)   \
+    OP(0xdc, ldd,   dir)   \
+    OP(0xdd, std,   dir)   \
+    OP(0xde, ldu,   dir)   \
+    OP(0xdf, stu,   dir)   \
+    OP(0xe0, subb,  idx)   \
+    OP(0xe1, cmpb,  idx)   \
+    OP(0xe2, sbcb,  idx)   \
+    OP(0xe3, addd,  idx)   \
+    OP(0xe4, andb,  idx)   \
+    OP(0xe5, bitb,  idx)   \
+    OP(0xe6, ldb,   idx)   \
+    OP(0xe7, stb,   idx)   \
+    OP(0xe8, eorb,  idx)   \
+    OP(0xe9, adcb,  idx)   \
+    OP(0xea, orb,   idx)   \
+    OP(0xeb, addb,  idx)   \
+    OP(0xec, ldd,   idx)   \
+    OP(0xed, std,   idx)   \
+    OP(0xee, ldu,   idx)   \
+    OP(0xef, stu,   idx)   \
+    OP(0xf0, subb,  ext)   \
+    OP(0xf1, cmpb,  ext)   \
+    OP(0xf2, sbcb,  ext)   \
+    OP(0xf3, addd,  ext)   \
+    OP(0xf4, andb,  ext)   \
+    OP(0xf5, bitb,  ext)   \
+    OP(0xf6, ldb,   ext)   \
+    OP(0xf7, stb,   ext)   \
+    OP(0xf8, eorb,  ext)   \
+    OP(0xf9, adcb,  ext)   \
+    OP(0xfa, orb,   ext)   \
+    OP(0xfb, addb,  ext)   \
+    OP(0xfc, ldd,   ext)   \
+    OP(0xfd, std,   ext)   \
+    OP(0xfe, ldu,   ext)   \
+    OP(0xff, stu,   ext)   \
+    OP_CODES_PAGE1_6309(OP)
+
+/* Double byte 0x10 op-codes
+ */
+#define     OP_CODES_PAGE2(OP) \
+    OP(0x21, lbrn,  lrel)  \
+    OP(0x22, lbhi,  lrel)  \
+    OP(0x23, lbls,  lrel)  \
+    OP(0x24, lbcc,  lrel)  \
+    OP(0x25, lbcs,  lrel)  \
+    OP(0x26, lbne,  lrel)  \
+    OP(0x27, lbeq,  lrel)  \
+    OP(0x28, lbvc,  lrel)  \
+    OP(0x29, lbvs,  lrel)  \
+    OP(0x2a, lbpl,  lrel)  \
+    OP(0x2b, lbmi,  lrel)  \
+    OP(0x2c, lbge,  lrel)  \
+    OP(0x2d, lblt,  lrel)  \
+    OP(0x2e, lbgt,  lrel)  \
+    OP(0x2f, lble,  lrel)  \
+    OP(0x3f, swi2,  inh)   \
+    OP(0x83, cmpd,  limm)  \
+    OP(0x8c, cmpy,  limm)  \
+    OP(0x8e, ldy,   limm)  \
+    OP(0x93, cmpd,  dir)   \
+    OP(0x9c, cmpy,  dir)   \
+    OP(0x9e, ldy,   dir)   \
+    OP(0x9f, sty,   dir)   \
+    OP(0xa3, cmpd,  idx)   \
+    OP(0xac, cmpy,  idx)   \
+    OP(0xae, ldy,   idx)   \
+    OP(0xaf, sty,   idx)   \
+    OP(0xb3, cmpd,  ext)   \
+    OP(0xbc, cmpy,  ext)   \
+    OP(0xbe, ldy,   ext)   \
+    OP(0xbf, sty,   ext)   \
+    OP(0xce, lds,   limm)  \
+    OP(0xde, lds,   dir)   \
+    OP(0xdf, sts,   dir)   \
+    OP(0xee, lds,   idx)   \
+    OP(0xef, sts,   idx)   \
+    OP(0xfe, lds,   ext)   \
+    OP(0xff, sts,   ext)   \
+    OP_CODES_PAGE2_6309(OP)
+
+/* Double byte 0x11 op-codes
+ */
+#define     OP_CODES_PAGE3(OP) \
+    OP(0x3f, swi3,  inh)   \
+    OP(0x83, cmpu,  limm)  \
+    OP(0x8c, cmps,  limm)  \
+    OP(0x93, cmpu,  dir)   \
+    OP(0x9c, cmps,  dir)   \
+    OP(0xa3, cmpu,  idx)   \
+    OP(0xac, cmps,  idx)   \
+    OP(0xb3, cmpu,  ext)   \
+    OP(0xbc, cmps,  ext)   \
+    OP_CODES_PAGE3_6309(OP)
+
+#endif  /* __MC6809E_OPS_H__ */
@@ -13,11 +13,18 @@
 #include    <stdint.h>
 
 #define     MEMORY                  65536       // 64K Byte
+#define     MEM_PAGE_SIZE           256         // Write tracking page size
+#define     MEM_PAGES               (MEMORY/MEM_PAGE_SIZE)
+#define     MEM_BANK_SIZE           32768       // RAM bank for remapped pages, Dragon 64 upper 32K
+#define     MEM_BANK_PHYSICAL       (MEMORY-MEM_BANK_SIZE)  // Physical RAM address of the RAM bank
+#define     MEM_WATCH_LINE          32          // Dirty line size of a watch range
+#define     MEM_WATCH_WORDS         (MEMORY/MEM_WATCH_LINE/32)  // 32-bit words of a dirty line bitmap
 
 #define     MEM_OK                  0           // Operation ok
 #define     MEM_ADD_RANGE          -1           // Address out of range
 #define     MEM_ROM                -2           // Location is ROM
 #define     MEM_HANDLER_ERR        -3           // Cannot hook IO handler
+#define     MEM_NOT_RAM            -4           // Block has ROM or IO locations
 
 typedef enum
 {
@@ -27,16 +34,169 @@ typedef enum
 
 typedef uint8_t (*io_handler_callback)(uint16_t, uint8_t, mem_operation_t);
 
+/* IO handler with a user pointer: user pointer, address, data and operation
+ */
+typedef uint8_t (*mem_io_handler_t)(void *, uint16_t, uint8_t, mem_operation_t);
+
+/* Memory write log, the address and data of every write to a memory
+ * context in order, including writes to ROM and IO addresses.
+ * The log owner clears it by setting 'count' and 'lost' to '0'.
+ */
+#define     MEM_WRITE_LOG           256
+
+typedef struct
+{
+    int             count;                      // Writes in the log
+    unsigned long   lost;                       // Writes not logged, log full
+    uint16_t        address[MEM_WRITE_LOG];
+    uint8_t         data[MEM_WRITE_LOG];
+} mem_write_log_t;
+
+/* Memory context, a 64K memory map with its ROM and IO
+ * address ranges and IO handlers, and a RAM bank that
+ * pages of the memory map can be remapped to
+ */
+typedef struct mem_context_t mem_context_t;
+
+/* Page table of direct read and write data at the start of every
+ * memory context, used by the inline accessors. A NULL pointer
+ * sends the access to mem_ctx_read() or mem_ctx_write().
+ */
+typedef struct
+{
+    uint8_t    *page_read[MEM_PAGES];
+    uint8_t    *page_write[MEM_PAGES];
+} mem_page_table_t;
+
+#define     MEM_PAGE_TABLE(mem)     ((const mem_page_table_t *) (mem))
+
 /********************************************************************
  *  Memory module API
+ *  The functions without a context parameter use the default context.
  */
 
 void mem_init(void);
 
 int  mem_read(int address);
+int  mem_read_physical(int address);
 int  mem_write(int address, int data);
+int  mem_read_block(int address, uint8_t *buffer, int length);
+int  mem_write_block(int address, const uint8_t *buffer, int length);
 int  mem_define_rom(int addr_start, int addr_end);
 int  mem_define_io(int addr_start, int addr_end, io_handler_callback io_handler);
+int  mem_define_io_pure(int addr_start, int addr_end);
+int  mem_define_alias(int addr_start, int addr_end, int target);
 int  mem_load(int addr_start, uint8_t *buffer, int length);
 
+uint16_t mem_read16(uint16_t address);
+void     mem_write16(uint16_t address, uint16_t data);
+
+int  mem_bank_map(int addr_start, int addr_end, int bank_address);
+int  mem_bank_unmap(int addr_start, int addr_end);
+
+int  mem_watch(int addr_start, int addr_end);
+int  mem_watch_dirty(uint32_t *lines);
+
+int             mem_mark_code(int addr_start, int addr_end);
+const uint32_t *mem_page_versions(void);
+const uint32_t *mem_io_access_counter(void);
+int             mem_page_is_io(int page);
+
+/********************************************************************
+ *  Memory context API
+ *  Different contexts can be used by different threads.
+ */
+mem_context_t  *mem_create(void);
+void            mem_destroy(mem_context_t *mem);
+mem_context_t  *mem_default_context(void);
+
+void mem_ctx_init(mem_context_t *mem);
+
+int  mem_ctx_read(mem_context_t *mem, int address);
+int  mem_ctx_read_physical(mem_context_t *mem, int address);
+int  mem_ctx_write(mem_context_t *mem, int address, int data);
+int  mem_ctx_read_block(mem_context_t *mem, int address, uint8_t *buffer, int length);
+int  mem_ctx_write_block(mem_context_t *mem, int address, const uint8_t *buffer, int length);
+int  mem_ctx_define_rom(mem_context_t *mem, int addr_start, int addr_end);
+int  mem_ctx_define_io(mem_context_t *mem, int addr_start, int addr_end, mem_io_handler_t io_handler, void *user);
+int  mem_ctx_define_io_pure(mem_context_t *mem, int addr_start, int addr_end);
+int  mem_ctx_define_alias(mem_context_t *mem, int addr_start, int addr_end, int target);
+int  mem_ctx_load(mem_context_t *mem, int addr_start, uint8_t *buffer, int length);
+
+int  mem_ctx_bank_map(mem_context_t *mem, int addr_start, int addr_end, int bank_address);
+int  mem_ctx_bank_unmap(mem_context_t *mem, int addr_start, int addr_end);
+
+int  mem_ctx_watch(mem_context_t *mem, int addr_start, int addr_end);
+int  mem_ctx_watch_dirty(mem_context_t *mem, uint32_t *lines);
+
+int             mem_ctx_mark_code(mem_context_t *mem, int addr_start, int addr_end);
+const uint32_t *mem_ctx_page_versions(mem_context_t *mem);
+const uint32_t *mem_ctx_io_access_counter(mem_context_t *mem);
+int             mem_ctx_page_is_io(mem_context_t *mem, int page);
+int             mem_ctx_read_is_pure(mem_context_t *mem, int address);
+void            mem_ctx_write_log(mem_context_t *mem, mem_write_log_t *log);
+
+/********************************************************************
+ *  Inline memory context accessors
+ *  One page table lookup and a direct load or store for pages
+ *  without IO addresses, ROM, code bytes or a watch range, other accesses call
+ *  mem_ctx_read() or mem_ctx_write(). Addresses wrap at 64K.
+ *  16-bit accesses are big-endian and access the high byte first.
+ */
+static inline uint8_t mem_ctx_read8(mem_context_t *mem, uint16_t address)
+{
+    const uint8_t  *data;
+
+    data = MEM_PAGE_TABLE(mem)->page_read[address / MEM_PAGE_SIZE];
+
+    if ( data )
+        return data[address % MEM_PAGE_SIZE];
+
+    return (uint8_t) mem_ctx_read(mem, address);
+}
+
+static inline void mem_ctx_write8(mem_context_t *mem, uint16_t address, uint8_t data)
+{
+    uint8_t    *page_data;
+
+    page_data = MEM_PAGE_TABLE(mem)->page_write[address / MEM_PAGE_SIZE];
+
+    if ( page_data )
+        page_data[address % MEM_PAGE_SIZE] = data;
+    else
+        mem_ctx_write(mem, address, data);
+}
+
+static inline uint16_t mem_ctx_read16(mem_context_t *mem, uint16_t address)
+{
+    const uint8_t  *data;
+    uint16_t        high;
+
+    data = MEM_PAGE_TABLE(mem)->page_read[address / MEM_PAGE_SIZE];
+
+    if ( data && (address % MEM_PAGE_SIZE) != (MEM_PAGE_SIZE - 1) )
+        return ((uint16_t) data[address % MEM_PAGE_SIZE] << 8) + data[address % MEM_PAGE_SIZE + 1];
+
+    high = mem_ctx_read8(mem, address);
+
+    return (high << 8) + mem_ctx_read8(mem, (uint16_t) (address + 1));
+}
+
+static inline void mem_ctx_write16(mem_context_t *mem, uint16_t address, uint16_t data)
+{
+    uint8_t    *page_data;
+
+    page_data = MEM_PAGE_TABLE(mem)->page_write[address / MEM_PAGE_SIZE];
+
+    if ( page_data && (address % MEM_PAGE_SIZE) != (MEM_PAGE_SIZE - 1) )
+    {
+        page_data[address % MEM_PAGE_SIZE] = (uint8_t) (data >> 8);
+        page_data[address % MEM_PAGE_SIZE + 1] = (uint8_t) data;
+        return;
+    }
+
+    mem_ctx_write8(mem, address, (uint8_t) (data >> 8));
+    mem_ctx_write8(mem, (uint16_t) (address + 1), (uint8_t) data);
+}
+
 #endif  /* __MEM_H__ */
@@ -42,6 +42,7 @@ uint8_t *rpi_fb_init(int h, int v);
 uint8_t *rpi_fb_resolution(int h, int v);
 
 uint32_t rpi_system_timer(void);
+void     rpi_sleep(uint32_t usec);
 
 int      rpi_keyboard_read(void);
 void     rpi_keyboard_reset(void);
@@ -0,0 +1,23 @@
+/********************************************************************
+ * symbols.h
+ *
+ *  Header file for the guest symbol table module
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#ifndef __SYMBOLS_H__
+#define __SYMBOLS_H__
+
+/********************************************************************
+ *  Symbol table module API
+ */
+
+void        sym_clear(void);
+int         sym_add(int address, const char *name);
+int         sym_load_lst(const char *file_name, int offset);
+int         sym_load_dragon_rom(void);
+const char *sym_name(int address);
+
+#endif  /* __SYMBOLS_H__ */
@@ -0,0 +1,96 @@
+;
+; bcc.asm
+;
+; MC6809E emulator benchmark loop for conditional branches.
+; Each pair of complementary short or long branches, such as
+; BHI and BLS, must take one of the two branches. The flags
+; come from compares and additions of a loop counter, so that
+; the first branch of each pair is both taken and not taken
+; over the loop.
+; The test will end with CC.C clear on success,
+; or CC.C set if a check failed.
+;
+            jmp     start
+;
+loops:      equ     128
+;
+count:      fcb     0
+;
+start:      andcc   #0              ; zero CC bits
+            lds     #$2000
+            clr     count
+;
+loop:       lda     count
+;
+; Unsigned compare
+;
+            cmpa    #loops/2
+            bhi     br1
+            bls     br1
+            lbra    fail
+br1:        bhs     br2
+            blo     br2
+            lbra    fail
+br2:        bne     br3
+            beq     br3
+            lbra    fail
+;
+; Signed compare
+;
+br3:        cmpa    #loops/4
+            bgt     br4
+            ble     br4
+            lbra    fail
+br4:        bge     br5
+            blt     br5
+            lbra    fail
+;
+; Addition with signed overflow
+;
+br5:        adda    #$48
+            bvc     br6
+            bvs     br6
+            lbra    fail
+br6:        bpl     br7
+            bmi     br7
+            lbra    fail
+;
+; Long branches
+;
+br7:        ldb     count
+            addb    #$c0
+            lbhi    br8
+            lbls    br8
+            lbra    fail
+br8:        lbhs    br9
+            lblo    br9
+            lbra    fail
+br9:        lbne    br10
+            lbeq    br10
+            lbra    fail
+br10:       lbgt    br11
+            lble    br11
+            lbra    fail
+br11:       lbge    br12
+            lblt    br12
+            lbra    fail
+br12:       lbvc    br13
+            lbvs    br13
+            lbra    fail
+br13:       lbpl    br14
+            lbmi    br14
+            lbra    fail
+;
+br14:       inc     count
+            lda     count
+            cmpa    #loops
+            lbne    loop
+;
+            andcc   #$fe
+            bra     done
+;
+fail:       orcc    #$01
+;
+done:       nop
+;
+; End of test
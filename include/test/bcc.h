@@ -0,0 +1,112 @@
+/********************************************************************
+ * .h
+ *
+ *  Auto-generated by lst2h.awk
+ *
+ *******************************************************************/
+
+#define     LOAD_ADDRESS    0x0000      // Change as required
+#define     RUN_ADDRESS     0x0000      // Change as required
+
+int code[] =
+{
+    /* Auto generated from bcc.lst
+     */
+                                        //      ;
+                                        //      ; bcc.asm
+                                        //      ;
+                                        //      ; MC6809E emulator benchmark loop for conditional branches.
+                                        //      ; Each pair of complementary short or long branches, such as
+                                        //      ; BHI and BLS, must take one of the two branches. The flags
+                                        //      ; come from compares and additions of a loop counter, so that
+                                        //      ; the first branch of each pair is both taken and not taken
+                                        //      ; over the loop.
+                                        //      ; The test will end with CC.C clear on success,
+                                        //      ; or CC.C set if a check failed.
+                                        //      ;
+    0x7e, 0x00, 0x04,                   // 0000             jmp     start
+                                        //      ;
+                                        // 0080 loops:      equ     128
+                                        //      ;
+    0x00,                               // 0003 count:      fcb     0
+                                        //      ;
+    0x1c, 0x00,                         // 0004 start:      andcc   #0              ; zero CC bits
+    0x10, 0xce, 0x20, 0x00,             // 0006             lds     #$2000
+    0x0f, 0x03,                         // 000a             clr     count
+                                        //      ;
+    0x96, 0x03,                         // 000c loop:       lda     count
+                                        //      ;
+                                        //      ; Unsigned compare
+                                        //      ;
+    0x81, 0x40,                         // 000e             cmpa    #loops/2
+    0x22, 0x05,                         // 0010             bhi     br1
+    0x23, 0x03,                         // 0012             bls     br1
+    0x16, 0x00, 0x8d,                   // 0014             lbra    fail
+    0x24, 0x05,                         // 0017 br1:        bhs     br2
+    0x25, 0x03,                         // 0019             blo     br2
+    0x16, 0x00, 0x86,                   // 001b             lbra    fail
+    0x26, 0x05,                         // 001e br2:        bne     br3
+    0x27, 0x03,                         // 0020             beq     br3
+    0x16, 0x00, 0x7f,                   // 0022             lbra    fail
+                                        //      ;
+                                        //      ; Signed compare
+                                        //      ;
+    0x81, 0x20,                         // 0025 br3:        cmpa    #loops/4
+    0x2e, 0x05,                         // 0027             bgt     br4
+    0x2f, 0x03,                         // 0029             ble     br4
+    0x16, 0x00, 0x76,                   // 002b             lbra    fail
+    0x2c, 0x05,                         // 002e br4:        bge     br5
+    0x2d, 0x03,                         // 0030             blt     br5
+    0x16, 0x00, 0x6f,                   // 0032             lbra    fail
+                                        //      ;
+                                        //      ; Addition with signed overflow
+                                        //      ;
+    0x8b, 0x48,                         // 0035 br5:        adda    #$48
+    0x28, 0x05,                         // 0037             bvc     br6
+    0x29, 0x03,                         // 0039             bvs     br6
+    0x16, 0x00, 0x66,                   // 003b             lbra    fail
+    0x2a, 0x05,                         // 003e br6:        bpl     br7
+    0x2b, 0x03,                         // 0040             bmi     br7
+    0x16, 0x00, 0x5f,                   // 0042             lbra    fail
+                                        //      ;
+                                        //      ; Long branches
+                                        //      ;
+    0xd6, 0x03,                         // 0045 br7:        ldb     count
+    0xcb, 0xc0,                         // 0047             addb    #$c0
+    0x10, 0x22, 0x00, 0x07,             // 0049             lbhi    br8
+    0x10, 0x23, 0x00, 0x03,             // 004d             lbls    br8
+    0x16, 0x00, 0x50,                   // 0051             lbra    fail
+    0x10, 0x24, 0x00, 0x07,             // 0054 br8:        lbhs    br9
+    0x10, 0x25, 0x00, 0x03,             // 0058             lblo    br9
+    0x16, 0x00, 0x45,                   // 005c             lbra    fail
+    0x10, 0x26, 0x00, 0x07,             // 005f br9:        lbne    br10
+    0x10, 0x27, 0x00, 0x03,             // 0063             lbeq    br10
+    0x16, 0x00, 0x3a,                   // 0067             lbra    fail
+    0x10, 0x2e, 0x00, 0x07,             // 006a br10:       lbgt    br11
+    0x10, 0x2f, 0x00, 0x03,             // 006e             lble    br11
+    0x16, 0x00, 0x2f,                   // 0072             lbra    fail
+    0x10, 0x2c, 0x00, 0x07,             // 0075 br11:       lbge    br12
+    0x10, 0x2d, 0x00, 0x03,             // 0079             lblt    br12
+    0x16, 0x00, 0x24,                   // 007d             lbra    fail
+    0x10, 0x28, 0x00, 0x07,             // 0080 br12:       lbvc    br13
+    0x10, 0x29, 0x00, 0x03,             // 0084             lbvs    br13
+    0x16, 0x00, 0x19,                   // 0088             lbra    fail
+    0x10, 0x2a, 0x00, 0x07,             // 008b br13:       lbpl    br14
+    0x10, 0x2b, 0x00, 0x03,             // 008f             lbmi    br14
+    0x16, 0x00, 0x0e,                   // 0093             lbra    fail
+                                        //      ;
+    0x0c, 0x03,                         // 0096 br14:       inc     count
+    0x96, 0x03,                         // 0098             lda     count
+    0x81, 0x80,                         // 009a             cmpa    #loops
+    0x10, 0x26, 0xff, 0x6c,             // 009c             lbne    loop
+                                        //      ;
+    0x1c, 0xfe,                         // 00a0             andcc   #$fe
+    0x20, 0x02,                         // 00a2             bra     done
+                                        //      ;
+    0x1a, 0x01,                         // 00a4 fail:       orcc    #$01
+                                        //      ;
+    0x12,                               // 00a6 done:       nop
+                                        //      ;
+                                        //      ; End of test
+   -1,                                  // --- end of code ---
+};
@@ -0,0 +1,127 @@
+;
+; fusion.asm
+;
+; MC6809E emulator test code for superinstruction fusion.
+; The loops use the instruction pairs that the emulation fuses:
+; compare and branch, test and branch, count and branch,
+; load and branch, and load and store copy loops.
+; The test will end with CC.C clear on success,
+; or CC.C set if a check failed.
+;
+            jmp     start
+;
+loops:      equ     32
+;
+src:        fcb     1,2,3,4,5,6,7,8
+            fcb     9,10,11,12,13,14,15,0
+dst:        fcb     0,0,0,0,0,0,0,0
+            fcb     0,0,0,0,0,0,0,0
+dst16:      fcb     0,0,0,0,0,0,0,0
+            fcb     0,0,0,0,0,0,0,0
+ptrs:       fdb     src,dst,dst16,0
+flag:       fcb     0
+;
+start:      andcc   #0              ; zero CC bits
+            lds     #$2000
+;
+; CMPA # + BNE, CMPB # + BLO, CMPX # + BNE
+;
+            clra
+loop1:      inca
+            cmpa    #loops
+            bne     loop1
+            clrb
+loop2:      incb
+            cmpb    #loops
+            blo     loop2
+            cmpb    #loops
+            lbne    fail
+            ldx     #0
+loop3:      leax    1,x
+            cmpx    #loops*4
+            bne     loop3
+;
+; LEAX + BNE, LEAY + BNE, DECB + BNE, INCA + BNE
+;
+            ldx     #loops
+            clra
+loop4:      inca
+            leax    -1,x
+            bne     loop4
+            cmpa    #loops
+            lbne    fail
+            ldy     #loops
+loop5:      deca
+            leay    -1,y
+            bne     loop5
+            tsta
+            lbne    fail
+            ldb     #loops
+loop6:      inca
+            decb
+            bne     loop6
+            cmpa    #loops
+            lbne    fail
+            lda     #$f0
+loop7:      incb
+            inca
+            bne     loop7
+            cmpb    #$10
+            lbne    fail
+;
+; TSTA + BNE, TST + BNE
+;
+            lda     #loops
+loop8:      deca
+            tsta
+            bne     loop8
+            lda     #loops
+            sta     flag
+loop9:      dec     flag
+            tst     flag
+            bne     loop9
+            tst     flag
+            lbne    fail
+;
+; LDA ,X+ / STA ,Y+ copy, LDD ,X++ / STD ,Y++ copy
+;
+            ldx     #src
+            ldy     #dst
+            ldb     #16
+copy8:      lda     ,x+
+            sta     ,y+
+            decb
+            bne     copy8
+            ldx     #src
+            ldu     #dst16
+copy16:     ldd     ,x++
+            std     ,u++
+            cmpx    #src+16
+            bne     copy16
+;
+; LDX ,U++ + BNE pointer list walk, LDA ,X+ + BNE string scan
+;
+            ldu     #ptrs
+            clrb
+walk:       incb
+            ldx     ,u++
+            bne     walk
+            cmpb    #4
+            lbne    fail
+            ldx     #dst
+            clrb
+scan:       incb
+            lda     ,x+
+            bne     scan
+            cmpb    #16
+            lbne    fail
+            lda     dst16+14
+            cmpa    #15
+            lbne    fail
+;
+            andcc   #$fe
+            bra     done
+;
+fail:       orcc    #$01
+;
+done:       nop
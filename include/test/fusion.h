@@ -0,0 +1,143 @@
+/********************************************************************
+ * .h
+ *
+ *  Auto-generated by lst2h.awk
+ *
+ *******************************************************************/
+
+#define     LOAD_ADDRESS    0x0000      // Change as required
+#define     RUN_ADDRESS     0x0000      // Change as required
+
+int code[] =
+{
+    /* Auto generated from fusion.lst
+     */
+                                        //      ;
+                                        //      ; fusion.asm
+                                        //      ;
+                                        //      ; MC6809E emulator test code for superinstruction fusion.
+                                        //      ; The loops use the instruction pairs that the emulation fuses:
+                                        //      ; compare and branch, test and branch, count and branch,
+                                        //      ; load and branch, and load and store copy loops.
+                                        //      ; The test will end with CC.C clear on success,
+                                        //      ; or CC.C set if a check failed.
+                                        //      ;
+    0x7e, 0x00, 0x3c,                   // 0000             jmp     start
+                                        //      ;
+                                        // 0020 loops:      equ     32
+                                        //      ;
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, // 0003 src:        fcb     1,2,3,4,5,6,7,8
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x00, // 000b             fcb     9,10,11,12,13,14,15,0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0013 dst:        fcb     0,0,0,0,0,0,0,0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 001b             fcb     0,0,0,0,0,0,0,0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0023 dst16:      fcb     0,0,0,0,0,0,0,0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 002b             fcb     0,0,0,0,0,0,0,0
+    0x00, 0x03, 0x00, 0x13, 0x00, 0x23, 0x00, 0x00, // 0033 ptrs:       fdb     src,dst,dst16,0
+    0x00,                               // 003b flag:       fcb     0
+                                        //      ;
+    0x1c, 0x00,                         // 003c start:      andcc   #0              ; zero CC bits
+    0x10, 0xce, 0x20, 0x00,             // 003e             lds     #$2000
+                                        //      ;
+                                        //      ; CMPA # + BNE, CMPB # + BLO, CMPX # + BNE
+                                        //      ;
+    0x4f,                               // 0042             clra
+    0x4c,                               // 0043 loop1:      inca
+    0x81, 0x20,                         // 0044             cmpa    #loops
+    0x26, 0xfb,                         // 0046             bne     loop1
+    0x5f,                               // 0048             clrb
+    0x5c,                               // 0049 loop2:      incb
+    0xc1, 0x20,                         // 004a             cmpb    #loops
+    0x25, 0xfb,                         // 004c             blo     loop2
+    0xc1, 0x20,                         // 004e             cmpb    #loops
+    0x10, 0x26, 0x00, 0x9e,             // 0050             lbne    fail
+    0x8e, 0x00, 0x00,                   // 0054             ldx     #0
+    0x30, 0x01,                         // 0057 loop3:      leax    1,x
+    0x8c, 0x00, 0x80,                   // 0059             cmpx    #loops*4
+    0x26, 0xf9,                         // 005c             bne     loop3
+                                        //      ;
+                                        //      ; LEAX + BNE, LEAY + BNE, DECB + BNE, INCA + BNE
+                                        //      ;
+    0x8e, 0x00, 0x20,                   // 005e             ldx     #loops
+    0x4f,                               // 0061             clra
+    0x4c,                               // 0062 loop4:      inca
+    0x30, 0x1f,                         // 0063             leax    -1,x
+    0x26, 0xfb,                         // 0065             bne     loop4
+    0x81, 0x20,                         // 0067             cmpa    #loops
+    0x10, 0x26, 0x00, 0x85,             // 0069             lbne    fail
+    0x10, 0x8e, 0x00, 0x20,             // 006d             ldy     #loops
+    0x4a,                               // 0071 loop5:      deca
+    0x31, 0x3f,                         // 0072             leay    -1,y
+    0x26, 0xfb,                         // 0074             bne     loop5
+    0x4d,                               // 0076             tsta
+    0x10, 0x26, 0x00, 0x77,             // 0077             lbne    fail
+    0xc6, 0x20,                         // 007b             ldb     #loops
+    0x4c,                               // 007d loop6:      inca
+    0x5a,                               // 007e             decb
+    0x26, 0xfc,                         // 007f             bne     loop6
+    0x81, 0x20,                         // 0081             cmpa    #loops
+    0x10, 0x26, 0x00, 0x6b,             // 0083             lbne    fail
+    0x86, 0xf0,                         // 0087             lda     #$f0
+    0x5c,                               // 0089 loop7:      incb
+    0x4c,                               // 008a             inca
+    0x26, 0xfc,                         // 008b             bne     loop7
+    0xc1, 0x10,                         // 008d             cmpb    #$10
+    0x10, 0x26, 0x00, 0x5f,             // 008f             lbne    fail
+                                        //      ;
+                                        //      ; TSTA + BNE, TST + BNE
+                                        //      ;
+    0x86, 0x20,                         // 0093             lda     #loops
+    0x4a,                               // 0095 loop8:      deca
+    0x4d,                               // 0096             tsta
+    0x26, 0xfc,                         // 0097             bne     loop8
+    0x86, 0x20,                         // 0099             lda     #loops
+    0x97, 0x3b,                         // 009b             sta     flag
+    0x0a, 0x3b,                         // 009d loop9:      dec     flag
+    0x0d, 0x3b,                         // 009f             tst     flag
+    0x26, 0xfa,                         // 00a1             bne     loop9
+    0x0d, 0x3b,                         // 00a3             tst     flag
+    0x10, 0x26, 0x00, 0x49,             // 00a5             lbne    fail
+                                        //      ;
+                                        //      ; LDA ,X+ / STA ,Y+ copy, LDD ,X++ / STD ,Y++ copy
+                                        //      ;
+    0x8e, 0x00, 0x03,                   // 00a9             ldx     #src
+    0x10, 0x8e, 0x00, 0x13,             // 00ac             ldy     #dst
+    0xc6, 0x10,                         // 00b0             ldb     #16
+    0xa6, 0x80,                         // 00b2 copy8:      lda     ,x+
+    0xa7, 0xa0,                         // 00b4             sta     ,y+
+    0x5a,                               // 00b6             decb
+    0x26, 0xf9,                         // 00b7             bne     copy8
+    0x8e, 0x00, 0x03,                   // 00b9             ldx     #src
+    0xce, 0x00, 0x23,                   // 00bc             ldu     #dst16
+    0xec, 0x81,                         // 00bf copy16:     ldd     ,x++
+    0xed, 0xc1,                         // 00c1             std     ,u++
+    0x8c, 0x00, 0x13,                   // 00c3             cmpx    #src+16
+    0x26, 0xf7,                         // 00c6             bne     copy16
+                                        //      ;
+                                        //      ; LDX ,U++ + BNE pointer list walk, LDA ,X+ + BNE string scan
+                                        //      ;
+    0xce, 0x00, 0x33,                   // 00c8             ldu     #ptrs
+    0x5f,                               // 00cb             clrb
+    0x5c,                               // 00cc walk:       incb
+    0xae, 0xc1,                         // 00cd             ldx     ,u++
+    0x26, 0xfb,                         // 00cf             bne     walk
+    0xc1, 0x04,                         // 00d1             cmpb    #4
+    0x10, 0x26, 0x00, 0x1b,             // 00d3             lbne    fail
+    0x8e, 0x00, 0x13,                   // 00d7             ldx     #dst
+    0x5f,                               // 00da             clrb
+    0x5c,                               // 00db scan:       incb
+    0xa6, 0x80,                         // 00dc             lda     ,x+
+    0x26, 0xfb,                         // 00de             bne     scan
+    0xc1, 0x10,                         // 00e0             cmpb    #16
+    0x10, 0x26, 0x00, 0x0c,             // 00e2             lbne    fail
+    0x96, 0x31,                         // 00e6             lda     dst16+14
+    0x81, 0x0f,                         // 00e8             cmpa    #15
+    0x10, 0x26, 0x00, 0x04,             // 00ea             lbne    fail
+                                        //      ;
+    0x1c, 0xfe,                         // 00ee             andcc   #$fe
+    0x20, 0x02,                         // 00f0             bra     done
+                                        //      ;
+    0x1a, 0x01,                         // 00f2 fail:       orcc    #$01
+                                        //      ;
+    0x12,                               // 00f4 done:       nop
+   -1,                                  // --- end of code ---
+};
@@ -0,0 +1,139 @@
+;
+; hd6309.asm
+;
+; HD6309 emulator test code for the native mode and the HD6309 op-codes.
+; Run with an emulator built with CPU_6309, and assemble with an
+; assembler that supports the HD6309 op-codes.
+; Test for command correctness and flag settings.
+;
+            jmp     start
+;
+trapvec:    equ     $fff0
+;
+varstart    equ     *
+;
+var0:       fcb     $55
+var1:       fcb     $aa
+var2:       fdb     $1234
+var3:       fdb     $0000,$0000
+buf1:       fcc     'HD6309'
+buf2:       fcb     $00,$00,$00,$00,$00,$00
+traps:      fcb     $00
+mdbits:     fcb     $00
+;
+varend:     equ     *
+varlen:     equ     varend-varstart
+;
+; Trap handler
+;
+trap:       inc     traps
+            lda     #$80
+            bitmd   #$80            ; division by zero?
+            bne     trapend
+            lda     #$40
+trapend:    ora     mdbits
+            sta     mdbits          ; mdbits = $c0
+            rti
+;
+start:      andcc   #0              ; zero CC bits
+;
+            lds     #$ff00
+            ldx     #trap
+            stx     trapvec
+            ldmd    #$01            ; native mode
+;
+; Memory immediate logic
+;
+            oim     #$0f,var0       ; var0 = $5f
+            aim     #$f0,var0       ; var0 = $50
+            eim     #$ff,var0       ; var0 = $af, N=1
+            tim     #$50,var0       ; Z=1
+            ldx     #var1
+            oim     #$01,0,x        ; var1 = $ab
+            aim     #$0f,>var1      ; var1 = $0b
+;
+; 16 and 32-bit accumulators
+;
+            ldq     #$12345678      ; d = $1234, w = $5678
+            stq     var3            ; var3 = $12345678
+            lde     #$01
+            ldf     #$02            ; w = $0102
+            addw    #$0100          ; w = $0202
+            incw                    ; w = $0203
+            comw                    ; w = $fdfc, N=1
+            negd                    ; d = $edcc
+            tfr     w,y             ; y = $fdfc
+            incf                    ; f = $fd
+            dece                    ; e = $fc
+            clrw                    ; w = $0000, Z=1
+            ldw     #$8000
+            sexw                    ; d = $ffff
+            ldd     var2            ; d = $1234
+            ldw     #$0011
+            subw    #$0001          ; w = $0010
+;
+; Register to register
+;
+            lda     #$10
+            ldb     #$20
+            addr    a,b             ; b = $30
+            ldx     #$1000
+            ldy     #$0234
+            subr    y,x             ; x = $0dcc
+            cmpr    x,x             ; Z=1
+            andr    b,a             ; a = $10
+            orr     a,e             ; e = $10
+;
+; Block transfer
+;
+            ldx     #buf1
+            ldy     #buf2
+            ldw     #6
+            tfm     x+,y+           ; buf2 = 'HD6309', w = 0
+;
+; Multiply and divide
+;
+            ldd     #$0100
+            muld    #$0200          ; q = $00020000
+            ldd     #$0100
+            divd    #$07            ; a = $04 remainder, b = $24 quotient
+            ldq     #$00010000
+            divq    #$0100          ; d = 0 remainder, w = $0100 quotient
+;
+; Bit transfer
+;
+            lda     #$00
+            ldbt    a,7,0,var1      ; a = $00
+            ldbt    a,3,1,var1      ; a = $02
+            bor     a,0,7,var1      ; a = $82
+            stbt    a,7,2,var1      ; var1 = $0f
+;
+; W index modes and accumulator offsets
+;
+            ldw     #buf1
+            lda     ,w              ; a = 'H'
+            lda     2,w             ; a = '6'
+            ldx     #buf1
+            lde     #4
+            lda     e,x             ; a = '0'
+            ldw     #5
+            lda     w,x             ; a = '9'
+;
+; W stack
+;
+            ldw     #$abcd
+            pshsw
+            clrw
+            pulsw                   ; w = $abcd
+;
+; Traps
+;
+            ldd     #$0100
+            divd    #$00            ; trap, division by zero
+            fcb     $87             ; trap, illegal op-code
+            lda     traps           ; a = $02
+            ldmd    #$00            ; emulation mode
+;
+end:        nop
+;
+; End of test
@@ -0,0 +1,155 @@
+/********************************************************************
+ * .h
+ *
+ *  Auto-generated by lst2h.awk
+ *
+ *******************************************************************/
+
+#define     LOAD_ADDRESS    0x0000      // Change as required
+#define     RUN_ADDRESS     0x0000      // Change as required
+
+int code[] =
+{
+    /* Auto generated from hd6309.lst
+     */
+                                        //      ;
+                                        //      ; hd6309.asm
+                                        //      ;
+                                        //      ; HD6309 emulator test code for the native mode and the HD6309 op-codes.
+                                        //      ; Run with an emulator built with CPU_6309, and assemble with an
+                                        //      ; assembler that supports the HD6309 op-codes.
+                                        //      ; Test for command correctness and flag settings.
+                                        //      ;
+    0x7e, 0x00, 0x29,                   // 0000             jmp     start
+                                        //      ;
+                                        // fff0 trapvec:    equ     $fff0
+                                        //      ;
+                                        // 0003 varstart    equ     *
+                                        //      ;
+    0x55,                               // 0003 var0:       fcb     $55
+    0xaa,                               // 0004 var1:       fcb     $aa
+    0x12, 0x34,                         // 0005 var2:       fdb     $1234
+    0x00, 0x00, 0x00, 0x00,             // 0007 var3:       fdb     $0000,$0000
+    0x48, 0x44, 0x36, 0x33, 0x30, 0x39, // 000b buf1:       fcc     'HD6309'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0011 buf2:       fcb     $00,$00,$00,$00,$00,$00
+    0x00,                               // 0017 traps:      fcb     $00
+    0x00,                               // 0018 mdbits:     fcb     $00
+                                        //      ;
+                                        // 0019 varend:     equ     *
+                                        // 0016 varlen:     equ     varend-varstart
+                                        //      ;
+                                        //      ; Trap handler
+                                        //      ;
+    0x0c, 0x17,                         // 0019 trap:       inc     traps
+    0x86, 0x80,                         // 001b             lda     #$80
+    0x11, 0x3c, 0x80,                   // 001d             bitmd   #$80            ; division by zero?
+    0x26, 0x02,                         // 0020             bne     trapend
+    0x86, 0x40,                         // 0022             lda     #$40
+    0x9a, 0x18,                         // 0024 trapend:    ora     mdbits
+    0x97, 0x18,                         // 0026             sta     mdbits          ; mdbits = $c0
+    0x3b,                               // 0028             rti
+                                        //      ;
+    0x1c, 0x00,                         // 0029 start:      andcc   #0              ; zero CC bits
+                                        //      ;
+    0x10, 0xce, 0xff, 0x00,             // 002b             lds     #$ff00
+    0x8e, 0x00, 0x19,                   // 002f             ldx     #trap
+    0xbf, 0xff, 0xf0,                   // 0032             stx     trapvec
+    0x11, 0x3d, 0x01,                   // 0035             ldmd    #$01            ; native mode
+                                        //      ;
+                                        //      ; Memory immediate logic
+                                        //      ;
+    0x01, 0x0f, 0x03,                   // 0038             oim     #$0f,var0       ; var0 = $5f
+    0x02, 0xf0, 0x03,                   // 003b             aim     #$f0,var0       ; var0 = $50
+    0x05, 0xff, 0x03,                   // 003e             eim     #$ff,var0       ; var0 = $af, N=1
+    0x0b, 0x50, 0x03,                   // 0041             tim     #$50,var0       ; Z=1
+    0x8e, 0x00, 0x04,                   // 0044             ldx     #var1
+    0x61, 0x01, 0x84,                   // 0047             oim     #$01,0,x        ; var1 = $ab
+    0x72, 0x0f, 0x00, 0x04,             // 004a             aim     #$0f,>var1      ; var1 = $0b
+                                        //      ;
+                                        //      ; 16 and 32-bit accumulators
+                                        //      ;
+    0xcd, 0x12, 0x34, 0x56, 0x78,       // 004e             ldq     #$12345678      ; d = $1234, w = $5678
+    0x10, 0xdd, 0x07,                   // 0053             stq     var3            ; var3 = $12345678
+    0x11, 0x86, 0x01,                   // 0056             lde     #$01
+    0x11, 0xc6, 0x02,                   // 0059             ldf     #$02            ; w = $0102
+    0x10, 0x8b, 0x01, 0x00,             // 005c             addw    #$0100          ; w = $0202
+    0x10, 0x5c,                         // 0060             incw                    ; w = $0203
+    0x10, 0x53,                         // 0062             comw                    ; w = $fdfc, N=1
+    0x10, 0x40,                         // 0064             negd                    ; d = $edcc
+    0x1f, 0x62,                         // 0066             tfr     w,y             ; y = $fdfc
+    0x11, 0x5c,                         // 0068             incf                    ; f = $fd
+    0x11, 0x4a,                         // 006a             dece                    ; e = $fc
+    0x10, 0x5f,                         // 006c             clrw                    ; w = $0000, Z=1
+    0x10, 0x86, 0x80, 0x00,             // 006e             ldw     #$8000
+    0x14,                               // 0072             sexw                    ; d = $ffff
+    0xdc, 0x05,                         // 0073             ldd     var2            ; d = $1234
+    0x10, 0x86, 0x00, 0x11,             // 0075             ldw     #$0011
+    0x10, 0x80, 0x00, 0x01,             // 0079             subw    #$0001          ; w = $0010
+                                        //      ;
+                                        //      ; Register to register
+                                        //      ;
+    0x86, 0x10,                         // 007d             lda     #$10
+    0xc6, 0x20,                         // 007f             ldb     #$20
+    0x10, 0x30, 0x89,                   // 0081             addr    a,b             ; b = $30
+    0x8e, 0x10, 0x00,                   // 0084             ldx     #$1000
+    0x10, 0x8e, 0x02, 0x34,             // 0087             ldy     #$0234
+    0x10, 0x32, 0x21,                   // 008b             subr    y,x             ; x = $0dcc
+    0x10, 0x37, 0x11,                   // 008e             cmpr    x,x             ; Z=1
+    0x10, 0x34, 0x98,                   // 0091             andr    b,a             ; a = $10
+    0x10, 0x35, 0x8e,                   // 0094             orr     a,e             ; e = $10
+                                        //      ;
+                                        //      ; Block transfer
+                                        //      ;
+    0x8e, 0x00, 0x0b,                   // 0097             ldx     #buf1
+    0x10, 0x8e, 0x00, 0x11,             // 009a             ldy     #buf2
+    0x10, 0x86, 0x00, 0x06,             // 009e             ldw     #6
+    0x11, 0x38, 0x12,                   // 00a2             tfm     x+,y+           ; buf2 = 'HD6309', w = 0
+                                        //      ;
+                                        //      ; Multiply and divide
+                                        //      ;
+    0xcc, 0x01, 0x00,                   // 00a5             ldd     #$0100
+    0x11, 0x8f, 0x02, 0x00,             // 00a8             muld    #$0200          ; q = $00020000
+    0xcc, 0x01, 0x00,                   // 00ac             ldd     #$0100
+    0x11, 0x8d, 0x07,                   // 00af             divd    #$07            ; a = $04 remainder, b = $24 quotient
+    0xcd, 0x00, 0x01, 0x00, 0x00,       // 00b2             ldq     #$00010000
+    0x11, 0x8e, 0x01, 0x00,             // 00b7             divq    #$0100          ; d = 0 remainder, w = $0100 quotient
+                                        //      ;
+                                        //      ; Bit transfer
+                                        //      ;
+    0x86, 0x00,                         // 00bb             lda     #$00
+    0x11, 0x36, 0x78, 0x04,             // 00bd             ldbt    a,7,0,var1      ; a = $00
+    0x11, 0x36, 0x59, 0x04,             // 00c1             ldbt    a,3,1,var1      ; a = $02
+    0x11, 0x32, 0x47, 0x04,             // 00c5             bor     a,0,7,var1      ; a = $82
+    0x11, 0x37, 0x7a, 0x04,             // 00c9             stbt    a,7,2,var1      ; var1 = $0f
+                                        //      ;
+                                        //      ; W index modes and accumulator offsets
+                                        //      ;
+    0x10, 0x86, 0x00, 0x0b,             // 00cd             ldw     #buf1
+    0xa6, 0x8f,                         // 00d1             lda     ,w              ; a = 'H'
+    0xa6, 0xaf, 0x00, 0x02,             // 00d3             lda     2,w             ; a = '6'
+    0x8e, 0x00, 0x0b,                   // 00d7             ldx     #buf1
+    0x11, 0x86, 0x04,                   // 00da             lde     #4
+    0xa6, 0x87,                         // 00dd             lda     e,x             ; a = '0'
+    0x10, 0x86, 0x00, 0x05,             // 00df             ldw     #5
+    0xa6, 0x8e,                         // 00e3             lda     w,x             ; a = '9'
+                                        //      ;
+                                        //      ; W stack
+                                        //      ;
+    0x10, 0x86, 0xab, 0xcd,             // 00e5             ldw     #$abcd
+    0x10, 0x38,                         // 00e9             pshsw
+    0x10, 0x5f,                         // 00eb             clrw
+    0x10, 0x39,                         // 00ed             pulsw                   ; w = $abcd
+                                        //      ;
+                                        //      ; Traps
+                                        //      ;
+    0xcc, 0x01, 0x00,                   // 00ef             ldd     #$0100
+    0x11, 0x8d, 0x00,                   // 00f2             divd    #$00            ; trap, division by zero
+    0x87,                               // 00f5             fcb     $87             ; trap, illegal op-code
+    0x96, 0x17,                         // 00f6             lda     traps           ; a = $02
+    0x11, 0x3d, 0x00,                   // 00f8             ldmd    #$00            ; emulation mode
+                                        //      ;
+    0x12,                               // 00fb end:        nop
+                                        //      ;
+                                        //      ; End of test
+   -1,                                  // --- end of code ---
+};
@@ -0,0 +1,43 @@
+;
+; prefix.asm
+;
+; MC6809E emulator benchmark code for double byte op-codes.
+; Loops over 0x10 and 0x11 prefixed op-codes in order to measure
+; their decode and execution time.
+; The loop count is set in 'loops' and the test will end with
+; CC.C clear on success, or CC.C set if a compare failed.
+;
+            jmp     start
+;
+loops:      equ     500
+;
+var0:       fdb     $1234
+var1:       fdb     $0000
+;
+start:      andcc   #0              ; zero CC bits
+            ldu     #$2000
+            ldd     #$1234
+            ldx     #loops
+;
+loop:       ldy     #var0           ; page 0x10 op-codes
+            ldy     ,y
+            sty     var1
+            cmpd    var1
+            lbne    fail
+            cmpy    #$1234
+            lbne    fail
+            lds     var1
+            sts     var1
+            cmpu    #$2000          ; page 0x11 op-codes
+            lbne    fail
+            cmps    var1
+            lbne    fail
+            leax    -1,x
+            lbne    loop
+;
+            andcc   #$fe
+            bra     done
+;
+fail:       orcc    #$01
+;
+done:       nop
@@ -0,0 +1,59 @@
+/********************************************************************
+ * .h
+ *
+ *  Auto-generated by lst2h.awk
+ *
+ *******************************************************************/
+
+#define     LOAD_ADDRESS    0x0000      // Change as required
+#define     RUN_ADDRESS     0x0000      // Change as required
+
+int code[] =
+{
+    /* Auto generated from prefix.lst
+     */
+                                        //      ;
+                                        //      ; prefix.asm
+                                        //      ;
+                                        //      ; MC6809E emulator benchmark code for double byte op-codes.
+                                        //      ; Loops over 0x10 and 0x11 prefixed op-codes in order to measure
+                                        //      ; their decode and execution time.
+                                        //      ; The loop count is set in 'loops' and the test will end with
+                                        //      ; CC.C clear on success, or CC.C set if a compare failed.
+                                        //      ;
+    0x7e, 0x00, 0x07,                   // 0000             jmp     start
+                                        //      ;
+                                        // 01f4 loops:      equ     500
+                                        //      ;
+    0x12, 0x34,                         // 0003 var0:       fdb     $1234
+    0x00, 0x00,                         // 0005 var1:       fdb     $0000
+                                        //      ;
+    0x1c, 0x00,                         // 0007 start:      andcc   #0              ; zero CC bits
+    0xce, 0x20, 0x00,                   // 0009             ldu     #$2000
+    0xcc, 0x12, 0x34,                   // 000c             ldd     #$1234
+    0x8e, 0x01, 0xf4,                   // 000f             ldx     #loops
+                                        //      ;
+    0x10, 0x8e, 0x00, 0x03,             // 0012 loop:       ldy     #var0           ; page 0x10 op-codes
+    0x10, 0xae, 0xa4,                   // 0016             ldy     ,y
+    0x10, 0x9f, 0x05,                   // 0019             sty     var1
+    0x10, 0x93, 0x05,                   // 001c             cmpd    var1
+    0x10, 0x26, 0x00, 0x27,             // 001f             lbne    fail
+    0x10, 0x8c, 0x12, 0x34,             // 0023             cmpy    #$1234
+    0x10, 0x26, 0x00, 0x1f,             // 0027             lbne    fail
+    0x10, 0xde, 0x05,                   // 002b             lds     var1
+    0x10, 0xdf, 0x05,                   // 002e             sts     var1
+    0x11, 0x83, 0x20, 0x00,             // 0031             cmpu    #$2000          ; page 0x11 op-codes
+    0x10, 0x26, 0x00, 0x11,             // 0035             lbne    fail
+    0x11, 0x9c, 0x05,                   // 0039             cmps    var1
+    0x10, 0x26, 0x00, 0x0a,             // 003c             lbne    fail
+    0x30, 0x1f,                         // 0040             leax    -1,x
+    0x10, 0x26, 0xff, 0xcc,             // 0042             lbne    loop
+                                        //      ;
+    0x1c, 0xfe,                         // 0046             andcc   #$fe
+    0x20, 0x02,                         // 0048             bra     done
+                                        //      ;
+    0x1a, 0x01,                         // 004a fail:       orcc    #$01
+                                        //      ;
+    0x12,                               // 004c done:       nop
+   -1,                                  // --- end of code ---
+};
@@ -0,0 +1,94 @@
+;
+; smc.asm
+;
+; MC6809E emulator test code for self-modifying code.
+; The code rewrites immediate operands, op-codes and branch offsets
+; of instructions it has already executed, to check that the
+; emulation does not run stale instructions.
+; The test will end with CC.C clear on success,
+; or CC.C set if a check failed.
+;
+            jmp     start
+;
+loops:      equ     16
+;
+count:      fcb     0
+;
+start:      andcc   #0              ; zero CC bits
+            lds     #$2000
+            ldx     #loops
+;
+; Immediate operand rewrite, 'addb' operand counts the passes
+;
+loop1:      clrb
+imm:        addb    #0
+            cmpb    count
+            lbne    fail
+            inc     imm+1
+            inc     count
+            leax    -1,x
+            bne     loop1
+;
+; Op-code rewrite, 'nop' replaced by 'inca' after the first pass
+;
+            clra
+            ldx     #loops
+loop2:
+opc:        nop
+            ldb     #$4c            ; 'inca' op-code
+            stb     opc
+            leax    -1,x
+            bne     loop2
+            cmpa    #loops-1
+            lbne    fail
+;
+; Branch offset rewrite, 'bra' target moved after the first pass
+;
+            clra
+            ldx     #2
+loop3:
+br:         bra     br1
+br1:        inca
+br2:        inca
+            ldb     #br2-br1        ; new branch offset
+            stb     br+1
+            leax    -1,x
+            bne     loop3
+            cmpa    #3
+            lbne    fail
+;
+; Code copied to RAM and executed twice with different content
+;
+            ldx     #copy1
+            bsr     run
+            cmpa    #$11
+            lbne    fail
+            ldx     #copy2
+            bsr     run
+            cmpa    #$22
+            lbne    fail
+;
+            andcc   #$fe
+            bra     done
+;
+; Copy 3 bytes of code from X to 'ram' and call it
+;
+run:        ldu     #ram
+            ldb     #3
+copy:       lda     ,x+
+            sta     ,u+
+            decb
+            bne     copy
+            jsr     ram
+            rts
+;
+copy1:      lda     #$11
+            rts
+copy2:      lda     #$22
+            rts
+;
+ram:        fcb     0,0,0
+;
+fail:       orcc    #$01
+;
+done:       nop
@@ -0,0 +1,110 @@
+/********************************************************************
+ * .h
+ *
+ *  Auto-generated by lst2h.awk
+ *
+ *******************************************************************/
+
+#define     LOAD_ADDRESS    0x0000      // Change as required
+#define     RUN_ADDRESS     0x0000      // Change as required
+
+int code[] =
+{
+    /* Auto generated from smc.lst
+     */
+                                        //      ;
+                                        //      ; smc.asm
+                                        //      ;
+                                        //      ; MC6809E emulator test code for self-modifying code.
+                                        //      ; The code rewrites immediate operands, op-codes and branch offsets
+                                        //      ; of instructions it has already executed, to check that the
+                                        //      ; emulation does not run stale instructions.
+                                        //      ; The test will end with CC.C clear on success,
+                                        //      ; or CC.C set if a check failed.
+                                        //      ;
+    0x7e, 0x00, 0x04,                   // 0000             jmp     start
+                                        //      ;
+                                        // 0010 loops:      equ     16
+                                        //      ;
+    0x00,                               // 0003 count:      fcb     0
+                                        //      ;
+    0x1c, 0x00,                         // 0004 start:      andcc   #0              ; zero CC bits
+    0x10, 0xce, 0x20, 0x00,             // 0006             lds     #$2000
+    0x8e, 0x00, 0x10,                   // 000a             ldx     #loops
+                                        //      ;
+                                        //      ; Immediate operand rewrite, 'addb' operand counts the passes
+                                        //      ;
+    0x5f,                               // 000d loop1:      clrb
+    0xcb, 0x00,                         // 000e imm:        addb    #0
+    0xd1, 0x03,                         // 0010             cmpb    count
+    0x10, 0x26, 0x00, 0x64,             // 0012             lbne    fail
+    0x0c, 0x0f,                         // 0016             inc     imm+1
+    0x0c, 0x03,                         // 0018             inc     count
+    0x30, 0x1f,                         // 001a             leax    -1,x
+    0x26, 0xef,                         // 001c             bne     loop1
+                                        //      ;
+                                        //      ; Op-code rewrite, 'nop' replaced by 'inca' after the first pass
+                                        //      ;
+    0x4f,                               // 001e             clra
+    0x8e, 0x00, 0x10,                   // 001f             ldx     #loops
+                                        // 0022 loop2:
+    0x12,                               // 0022 opc:        nop
+    0xc6, 0x4c,                         // 0023             ldb     #$4c            ; 'inca' op-code
+    0xd7, 0x22,                         // 0025             stb     opc
+    0x30, 0x1f,                         // 0027             leax    -1,x
+    0x26, 0xf7,                         // 0029             bne     loop2
+    0x81, 0x0f,                         // 002b             cmpa    #loops-1
+    0x10, 0x26, 0x00, 0x49,             // 002d             lbne    fail
+                                        //      ;
+                                        //      ; Branch offset rewrite, 'bra' target moved after the first pass
+                                        //      ;
+    0x4f,                               // 0031             clra
+    0x8e, 0x00, 0x02,                   // 0032             ldx     #2
+                                        // 0035 loop3:
+    0x20, 0x00,                         // 0035 br:         bra     br1
+    0x4c,                               // 0037 br1:        inca
+    0x4c,                               // 0038 br2:        inca
+    0xc6, 0x01,                         // 0039             ldb     #br2-br1        ; new branch offset
+    0xd7, 0x36,                         // 003b             stb     br+1
+    0x30, 0x1f,                         // 003d             leax    -1,x
+    0x26, 0xf4,                         // 003f             bne     loop3
+    0x81, 0x03,                         // 0041             cmpa    #3
+    0x10, 0x26, 0x00, 0x33,             // 0043             lbne    fail
+                                        //      ;
+                                        //      ; Code copied to RAM and executed twice with different content
+                                        //      ;
+    0x8e, 0x00, 0x71,                   // 0047             ldx     #copy1
+    0x8d, 0x15,                         // 004a             bsr     run
+    0x81, 0x11,                         // 004c             cmpa    #$11
+    0x10, 0x26, 0x00, 0x28,             // 004e             lbne    fail
+    0x8e, 0x00, 0x74,                   // 0052             ldx     #copy2
+    0x8d, 0x0a,                         // 0055             bsr     run
+    0x81, 0x22,                         // 0057             cmpa    #$22
+    0x10, 0x26, 0x00, 0x1d,             // 0059             lbne    fail
+                                        //      ;
+    0x1c, 0xfe,                         // 005d             andcc   #$fe
+    0x20, 0x1b,                         // 005f             bra     done
+                                        //      ;
+                                        //      ; Copy 3 bytes of code from X to 'ram' and call it
+                                        //      ;
+    0xce, 0x00, 0x77,                   // 0061 run:        ldu     #ram
+    0xc6, 0x03,                         // 0064             ldb     #3
+    0xa6, 0x80,                         // 0066 copy:       lda     ,x+
+    0xa7, 0xc0,                         // 0068             sta     ,u+
+    0x5a,                               // 006a             decb
+    0x26, 0xf9,                         // 006b             bne     copy
+    0xbd, 0x00, 0x77,                   // 006d             jsr     ram
+    0x39,                               // 0070             rts
+                                        //      ;
+    0x86, 0x11,                         // 0071 copy1:      lda     #$11
+    0x39,                               // 0073             rts
+    0x86, 0x22,                         // 0074 copy2:      lda     #$22
+    0x39,                               // 0076             rts
+                                        //      ;
+    0x00, 0x00, 0x00,                   // 0077 ram:        fcb     0,0,0
+                                        //      ;
+    0x1a, 0x01,                         // 007a fail:       orcc    #$01
+                                        //      ;
+    0x12,                               // 007c done:       nop
+   -1,                                  // --- end of code ---
+};
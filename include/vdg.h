@@ -13,8 +13,19 @@
 
 #define     VDG_REFRESH_RATE        50      // in Hz
 
+/* Render statistics, frames and bytes of
+ * video memory rendered since cleared
+ */
+typedef struct
+{
+    uint32_t    frames;
+    uint32_t    frames_rendered;
+    uint32_t    bytes_rendered;
+} vdg_render_stats_t;
+
 void vdg_init(void);
 void vdg_render(void);
+void vdg_get_render_stats(vdg_render_stats_t *stats, int clear);
 
 void vdg_set_video_offset(uint8_t offset);
 void vdg_set_mode_sam(int sam_mode);
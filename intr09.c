@@ -32,9 +32,14 @@
 #define     IO_ADDR_FIRQ_ACK    0xf002
 #define     IO_ADDR_IRQ_ACK     0xf003
 
-#define     NMI_INTERVAL        1*CLOCKS_PER_SEC
-#define     FIRQ_INTERVAL       2*CLOCKS_PER_SEC
-#define     IRQ_INTERVAL        4*CLOCKS_PER_SEC
+/* Periodic interrupts in emulated time
+ */
+#define     CPU_CLOCK_RATE      1000000 // Emulated CPU cycles per second
+#define     NMI_INTERVAL        (1*CPU_CLOCK_RATE)
+#define     FIRQ_INTERVAL       (2*CPU_CLOCK_RATE)
+#define     IRQ_INTERVAL        (4*CPU_CLOCK_RATE)
+
+#define     RUN_CYCLES          1000    // CPU cycles per cpu_run_cycles() call
 
 /* Limit emulated ACIA to about 300 BAUD,
  * otherwise RPi serial port is overwhelmed
@@ -45,6 +50,8 @@
 /* -----------------------------------------
    Module functions
 ----------------------------------------- */
+static uint64_t next_event(uint64_t nmi_time, uint64_t firq_time, uint64_t irq_time);
+
 uint8_t io_handler_ACIA6850(uint16_t address, uint8_t data, mem_operation_t op);
 uint8_t io_handler_firq_ack(uint16_t address, uint8_t data, mem_operation_t op);
 uint8_t io_handler_irq_ack(uint16_t address, uint8_t data, mem_operation_t op);
@@ -58,7 +65,7 @@ int main(int argc, char *argv[])
     int             i;
     uint16_t        break_point = 0xffff;
     cpu_state_t     cpu_state;
-    clock_t         nmi_time, firq_time, irq_time;
+    uint64_t        nmi_time, firq_time, irq_time;
 
     if ( uart_init() != 0 )
         return -1;
@@ -87,11 +94,16 @@ int main(int argc, char *argv[])
     printf("Starting CPU.\n");
     cpu_reset(1);
 
-    nmi_time = firq_time = irq_time = clock();
+    nmi_time = NMI_INTERVAL;
+    firq_time = FIRQ_INTERVAL;
+    irq_time = IRQ_INTERVAL;
+
+    cpu_break_point(break_point);
+    cpu_set_event(next_event(nmi_time, firq_time, irq_time));
 
     do
     {
-        cpu_run();
+        cpu_run_cycles(RUN_CYCLES);
 
         if ( cpu_get_state(&cpu_state) == CPU_RESET )
             cpu_reset(0);
@@ -102,22 +114,27 @@ int main(int argc, char *argv[])
 
         /* Trigger periodic interrupts.
          */
-        if ( (clock() - nmi_time) > NMI_INTERVAL)
+        if ( cpu_cycles_to_event() == 0 )
         {
-            cpu_nmi_trigger();
-            nmi_time = clock();
-        }
+            if ( cpu_state.cycles >= nmi_time )
+            {
+                cpu_nmi_trigger();
+                nmi_time += NMI_INTERVAL;
+            }
 
-        if ( (clock() - firq_time) > FIRQ_INTERVAL)
-        {
-            cpu_firq(1);
-            firq_time = clock();
-        }
+            if ( cpu_state.cycles >= firq_time )
+            {
+                cpu_firq(1);
+                firq_time += FIRQ_INTERVAL;
+            }
 
-        if ( (clock() - irq_time) > IRQ_INTERVAL)
-        {
-            cpu_irq(1);
-            irq_time = clock();
+            if ( cpu_state.cycles >= irq_time )
+            {
+                cpu_irq(1);
+                irq_time += IRQ_INTERVAL;
+            }
+
+            cpu_set_event(next_event(nmi_time, firq_time, irq_time));
         }
    }
     while ( cpu_state.pc != break_point );
@@ -129,6 +146,27 @@ int main(int argc, char *argv[])
     return 0;
 }
 
+/*------------------------------------------------
+ * next_event()
+ *
+ *  Find the emulated time of the next periodic interrupt.
+ *
+ *  param:  NMI, FIRQ and IRQ times in clock cycles
+ *  return: Earliest of the three times
+ */
+static uint64_t next_event(uint64_t nmi_time, uint64_t firq_time, uint64_t irq_time)
+{
+    uint64_t    deadline = nmi_time;
+
+    if ( firq_time < deadline )
+        deadline = firq_time;
+
+    if ( irq_time < deadline )
+        deadline = irq_time;
+
+    return deadline;
+}
+
 /* -----------------------------------------
    IO handler call-back functions
 ----------------------------------------- */
@@ -0,0 +1,985 @@
+/********************************************************************
+ * lock09.c
+ *
+ *  MC6809E CPU emulation lockstep run.
+ *  Runs the optimized CPU module and the reference interpreter
+ *  cpu_ref.c side by side, each on its own copy of the memory image,
+ *  through all test code and the Dragon 32 ROM boot.
+ *  Compares registers, CC, the cycle counter and memory writes, and
+ *  stops a test at the first divergence with a trace of both CPUs.
+ *  The reference interpreter is a separate copy of the original
+ *  CPU module, it runs on the default memory context through the
+ *  adapter functions below.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "mem.h"
+#include    "cpu.h"
+#include    "cpu_ref.h"
+
+/* -----------------------------------------
+   Include files for MC6909E test code.
+   Each test file defines a 'code' array and
+   load/run addresses, rename them on inclusion
+   so they can coexist in this module.
+----------------------------------------- */
+#define     code    code_addr
+#include    "test/addr.h"
+#undef      code
+static const int addr_load = LOAD_ADDRESS, addr_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_arith
+#include    "test/arith.h"
+#undef      code
+static const int arith_load = LOAD_ADDRESS, arith_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_bcc
+#include    "test/bcc.h"
+#undef      code
+static const int bcc_load = LOAD_ADDRESS, bcc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_branch
+#include    "test/branch.h"
+#undef      code
+static const int branch_load = LOAD_ADDRESS, branch_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_fusion
+#include    "test/fusion.h"
+#undef      code
+static const int fusion_load = LOAD_ADDRESS, fusion_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_irq
+#include    "test/irq.h"
+#undef      code
+static const int irq_load = LOAD_ADDRESS, irq_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_logic
+#include    "test/logic.h"
+#undef      code
+static const int logic_load = LOAD_ADDRESS, logic_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_misc
+#include    "test/misc.h"
+#undef      code
+static const int misc_load = LOAD_ADDRESS, misc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_prefix
+#include    "test/prefix.h"
+#undef      code
+static const int prefix_load = LOAD_ADDRESS, prefix_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_profile
+#include    "test/profile.h"
+#undef      code
+static const int profile_load = LOAD_ADDRESS, profile_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_smc
+#include    "test/smc.h"
+#undef      code
+static const int smc_load = LOAD_ADDRESS, smc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_stack
+#include    "test/stack.h"
+#undef      code
+static const int stack_load = LOAD_ADDRESS, stack_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_swi
+#include    "test/swi.h"
+#undef      code
+static const int swi_load = LOAD_ADDRESS, swi_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_dragon
+#include    "dragon/dragon.h"
+#undef      code
+static const int dragon_load = LOAD_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     LOCK_INSTRUCTIONS       1000000     // Default maximum emulated instructions per test
+#define     LOCK_BATCH_CYCLES       1000        // cpu_run_cycles() batch of the optimized CPU
+#define     LOCK_TRACE              16          // Compared states listed at a divergence
+#define     DRAGON_ROM_START        0x8000
+#define     DRAGON_ROM_END          0xfeff
+#define     DRAGON_PIA_START        0xff00
+#define     DRAGON_PIA_END          0xff3f
+#define     DRAGON_VECTOR_START     0xfff0
+#define     DRAGON_VECTOR_END       0xffff
+#define     DRAGON_VECTOR_TARGET    0xbff0      // Vectors read from the top of the ROM image
+#define     IO_ADDR_ACIA_CS         0xf000      // irq.asm IO devices
+#define     IO_ADDR_ACIA_DAT        0xf001
+#define     IO_ADDR_FIRQ_ACK        0xf002
+#define     IO_ADDR_IRQ_ACK         0xf003
+#define     NMI_INTERVAL            3000        // irq.asm interrupt intervals in instructions or batches
+#define     FIRQ_INTERVAL           5000
+#define     IRQ_INTERVAL            7000
+
+#define     LOCK_CODE               0           // Test code, runs to its last instruction
+#define     LOCK_IRQ                1           // Interrupt test code, runs with interrupts and IO
+#define     LOCK_ROM                2           // Dragon ROM image, needs IO and reset vector
+
+typedef struct
+{
+    char       *name;
+    const int  *code;
+    int         load_address;
+    int         run_address;
+    int         type;
+} lock_test_t;
+
+/* One of the two CPU modules, its context, memory and write log,
+ * and the states at the last compares. The reference interpreter
+ * has no context, its functions are adapters to the ref_cpu_*() API.
+ */
+typedef struct
+{
+    char               *name;
+    cpu_context_t      *ctx;
+    mem_context_t      *mem;
+    mem_write_log_t     log;
+    cpu_state_t         trace[LOCK_TRACE];
+    int                 traced;
+
+    int                (*init)(cpu_context_t *ctx, int address);
+    void               (*reset)(cpu_context_t *ctx, int state);
+    void               (*nmi_trigger)(cpu_context_t *ctx);
+    void               (*firq)(cpu_context_t *ctx, int state);
+    void               (*irq)(cpu_context_t *ctx, int state);
+    cpu_run_state_t    (*run)(cpu_context_t *ctx);
+    int                (*run_cycles)(cpu_context_t *ctx, int cycle_budget);
+    void               (*break_point)(cpu_context_t *ctx, int address);
+    cpu_run_state_t    (*get_state)(cpu_context_t *ctx, cpu_state_t *cpu_state);
+    const char*        (*get_menmonic)(cpu_context_t *ctx, uint16_t address);
+} lock_cpu_t;
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+long    run_step(lock_test_t *test, long instructions, int interval, long long *cycles, int *diverged);
+int     run_batch(lock_test_t *test, long long cycles);
+int     load_code(lock_cpu_t *cpu, lock_test_t *test);
+void    interrupts(lock_cpu_t *cpu, lock_test_t *test, long count);
+int     compare(int step, int memory);
+int     compare_writes(void);
+void    sort_writes(mem_write_log_t *log, uint32_t *writes);
+int     compare_write_order(const void *a, const void *b);
+int     compare_memory(void);
+void    print_trace(lock_cpu_t *cpu, int step);
+void    print_writes(lock_cpu_t *cpu);
+uint8_t io_handler_acia(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_firq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_irq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_pia(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+
+int             reference_init(cpu_context_t *ctx, int address);
+void            reference_reset(cpu_context_t *ctx, int state);
+void            reference_nmi_trigger(cpu_context_t *ctx);
+void            reference_firq(cpu_context_t *ctx, int state);
+void            reference_irq(cpu_context_t *ctx, int state);
+cpu_run_state_t reference_run(cpu_context_t *ctx);
+int             reference_run_cycles(cpu_context_t *ctx, int cycle_budget);
+void            reference_break_point(cpu_context_t *ctx, int address);
+cpu_run_state_t reference_get_state(cpu_context_t *ctx, cpu_state_t *cpu_state);
+const char*     reference_get_menmonic(cpu_context_t *ctx, uint16_t address);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+lock_test_t tests[] =
+{
+    { "addr",    code_addr,         addr_load,    addr_run,    LOCK_CODE },
+    { "arith",   code_arith,        arith_load,   arith_run,   LOCK_CODE },
+    { "bcc",     code_bcc,          bcc_load,     bcc_run,     LOCK_CODE },
+    { "branch",  code_branch,       branch_load,  branch_run,  LOCK_CODE },
+    { "fusion",  code_fusion,       fusion_load,  fusion_run,  LOCK_CODE },
+    { "irq",     code_irq,          irq_load,     irq_run,     LOCK_IRQ },
+    { "logic",   code_logic,        logic_load,   logic_run,   LOCK_CODE },
+    { "misc",    code_misc,         misc_load,    misc_run,    LOCK_CODE },
+    { "prefix",  code_prefix,       prefix_load,  prefix_run,  LOCK_CODE },
+    { "profile", code_profile,      profile_load, profile_run, LOCK_CODE },
+    { "smc",     code_smc,          smc_load,     smc_run,     LOCK_CODE },
+    { "stack",   code_stack,        stack_load,   stack_run,   LOCK_CODE },
+    { "swi",     code_swi,          swi_load,     swi_run,     LOCK_CODE },
+    { "dragon",  code_dragon,       dragon_load,  0,           LOCK_ROM },
+};
+
+lock_cpu_t optimized =
+{
+    .name = "cpu",
+    .init = cpu_ctx_init,
+    .reset = cpu_ctx_reset,
+    .nmi_trigger = cpu_ctx_nmi_trigger,
+    .firq = cpu_ctx_firq,
+    .irq = cpu_ctx_irq,
+    .run = cpu_ctx_run,
+    .run_cycles = cpu_ctx_run_cycles,
+    .break_point = cpu_ctx_break_point,
+    .get_state = cpu_ctx_get_state,
+    .get_menmonic = cpu_ctx_get_menmonic,
+};
+
+lock_cpu_t reference =
+{
+    .name = "ref",
+    .init = reference_init,
+    .reset = reference_reset,
+    .nmi_trigger = reference_nmi_trigger,
+    .firq = reference_firq,
+    .irq = reference_irq,
+    .run = reference_run,
+    .run_cycles = reference_run_cycles,
+    .break_point = reference_break_point,
+    .get_state = reference_get_state,
+    .get_menmonic = reference_get_menmonic,
+};
+
+int     reference_break = -1;
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: lock09 [instructions [interval]]
+ *
+ *  Runs each test twice: by single instruction steps of both
+ *  CPU modules, compared every 'interval' instructions (default 1),
+ *  and by cpu_run_cycles() batches of the optimized CPU module with
+ *  its translated blocks, compared after every batch.
+ *  Returns '1' if any test diverged.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    int         i, interval = 1, diverged = 0, step, batch;
+    long        instructions = LOCK_INSTRUCTIONS, count;
+    long long   cycles;
+
+    if ( argc > 1 )
+        instructions = atol(argv[1]);
+    if ( argc > 2 )
+        interval = atoi(argv[2]);
+    if ( interval < 1 )
+        interval = 1;
+
+    /* The reference interpreter runs on the default memory context
+     */
+    optimized.mem = mem_create();
+    reference.mem = mem_default_context();
+    if ( optimized.mem == 0L )
+    {
+        printf("Cannot allocate memory context.\n");
+        return 1;
+    }
+
+    optimized.ctx = cpu_create(optimized.mem);
+    reference.ctx = 0L;
+    if ( optimized.ctx == 0L )
+    {
+        printf("Cannot allocate CPU context.\n");
+        return 1;
+    }
+
+    mem_ctx_write_log(optimized.mem, &optimized.log);
+    mem_ctx_write_log(reference.mem, &reference.log);
+
+    printf("MC6809E lockstep run, up to %li instructions per test, compared every %i instructions\n", instructions, interval);
+    printf("and every %i cycle batch.\n", LOCK_BATCH_CYCLES);
+    printf("%-8s %12s %12s %12s %12s\n", "Test", "Instructions", "Cycles", "Step", "Batch");
+
+    for ( i = 0; i < sizeof(tests)/sizeof(lock_test_t); i++ )
+    {
+        count = run_step(&tests[i], instructions, interval, &cycles, &step);
+        batch = run_batch(&tests[i], cycles);
+
+        printf("%-8s %12li %12lli %12s %12s\n", tests[i].name, count, cycles,
+                step ? "diverged" : "ok", batch ? "diverged" : "ok");
+
+        diverged |= step | batch;
+    }
+
+    return diverged;
+}
+
+/*------------------------------------------------
+ * run_step()
+ *
+ *  Run a test with cpu_run() on both CPU modules, one instruction
+ *  at a time, until the last instruction of test code, an emulation
+ *  exception, a divergence or a count of instructions. The CPU states
+ *  and memory writes are compared every 'interval' instructions, and
+ *  memory at the end of the run.
+ *
+ *  param:  Pointer to test, maximum emulated instruction count,
+ *          compare interval, pointer to emulated cycles result,
+ *          pointer to result '0' no divergence, '1' diverged
+ *  return: Emulated instruction count
+ */
+long run_step(lock_test_t *test, long instructions, int interval, long long *cycles, int *diverged_result)
+{
+    long            count;
+    int             break_point, diverged = 0;
+    cpu_state_t     cpu_state;
+
+    break_point = load_code(&optimized, test);
+    load_code(&reference, test);
+
+    for ( count = 0; count < instructions; count++ )
+    {
+        interrupts(&optimized, test, count);
+        interrupts(&reference, test, count);
+
+        optimized.run(optimized.ctx);
+        reference.run(reference.ctx);
+
+        optimized.get_state(optimized.ctx, &cpu_state);
+
+        if ( (count + 1) % interval == 0 ||
+             cpu_state.pc == break_point || cpu_state.cpu_state == CPU_EXCEPTION )
+        {
+            diverged = compare(1, 0);
+            if ( diverged )
+            {
+                count++;
+                break;
+            }
+        }
+
+        if ( cpu_state.pc == break_point || cpu_state.cpu_state == CPU_EXCEPTION )
+        {
+            count++;
+            break;
+        }
+    }
+
+    *cycles = (long long) cpu_state.cycles;
+
+    if ( !diverged )
+        diverged = compare(1, 1);
+
+    if ( diverged )
+        printf("%-8s diverged in single steps after %li instructions\n", test->name, count);
+
+    *diverged_result = diverged;
+
+    return count;
+}
+
+/*------------------------------------------------
+ * run_batch()
+ *
+ *  Run a test with cpu_run_cycles() batches of the optimized CPU
+ *  module, which runs translated blocks, fused instructions and
+ *  skips idle loops. The reference CPU module runs until it reaches
+ *  the same emulated time, then the CPU states and memory writes
+ *  are compared. Stops at the last instruction of test code, an
+ *  emulation exception, a divergence or a count of cycles.
+ *
+ *  param:  Pointer to test, emulated cycle count
+ *  return: '0' no divergence, '1' diverged
+ */
+int run_batch(lock_test_t *test, long long cycles)
+{
+    long            batch = 0;
+    int             break_point, diverged = 0;
+    cpu_state_t     cpu_state, ref_state;
+
+    break_point = load_code(&optimized, test);
+    load_code(&reference, test);
+
+    optimized.break_point(optimized.ctx, break_point);
+    reference.break_point(reference.ctx, break_point);
+
+    do
+    {
+        interrupts(&optimized, test, batch);
+        interrupts(&reference, test, batch);
+        batch++;
+
+        optimized.run_cycles(optimized.ctx, LOCK_BATCH_CYCLES);
+        optimized.get_state(optimized.ctx, &cpu_state);
+
+        /* The reference CPU runs to the same emulated time
+         * or stops where the optimized CPU stopped
+         */
+        do
+        {
+            reference.get_state(reference.ctx, &ref_state);
+            if ( ref_state.cycles >= cpu_state.cycles ||
+                 ref_state.cpu_state == CPU_EXCEPTION || ref_state.pc == break_point )
+                break;
+
+            reference.run_cycles(reference.ctx, (int)(cpu_state.cycles - ref_state.cycles));
+        }
+        while ( 1 );
+
+        diverged = compare(0, 0);
+    }
+    while ( !diverged &&
+            cpu_state.cycles < cycles &&
+            cpu_state.pc != break_point &&
+            cpu_state.cpu_state != CPU_EXCEPTION );
+
+    if ( !diverged )
+        diverged = compare(0, 1);
+
+    if ( diverged )
+        printf("%-8s diverged in batches after %li batches\n", test->name, batch);
+
+    optimized.break_point(optimized.ctx, -1);
+    reference.break_point(reference.ctx, -1);
+
+    return diverged;
+}
+
+/*------------------------------------------------
+ * load_code()
+ *
+ *  Load test code or the Dragon ROM image into the memory
+ *  of a CPU module, set up its IO, and initialize the CPU.
+ *
+ *  param:  Pointer to CPU module, pointer to test
+ *  return: Address of the last instruction of test code,
+ *          '-1' for the interrupt test and the Dragon ROM
+ */
+int load_code(lock_cpu_t *cpu, lock_test_t *test)
+{
+    int     i = 0;
+
+    mem_ctx_init(cpu->mem);
+
+    while ( test->code[i] != -1 )
+    {
+        mem_ctx_write(cpu->mem, i + test->load_address, test->code[i]);
+        i++;
+    }
+
+    cpu->log.count = 0;
+    cpu->log.lost = 0;
+    cpu->traced = 0;
+
+    if ( test->type == LOCK_ROM )
+    {
+        /* Minimal Dragon 32 IO, no key pressed and
+         * reset vectors redirected to the ROM image
+         */
+        mem_ctx_define_rom(cpu->mem, DRAGON_ROM_START, DRAGON_ROM_END);
+        mem_ctx_define_io(cpu->mem, DRAGON_PIA_START, DRAGON_PIA_END, io_handler_pia, cpu);
+        mem_ctx_define_alias(cpu->mem, DRAGON_VECTOR_START, DRAGON_VECTOR_END, DRAGON_VECTOR_TARGET);
+
+        cpu->init(cpu->ctx, test->run_address);
+        cpu->reset(cpu->ctx, 1);
+        cpu->run(cpu->ctx);
+        cpu->reset(cpu->ctx, 0);
+
+        return -1;
+    }
+
+    cpu->init(cpu->ctx, test->run_address);
+
+    if ( test->type == LOCK_IRQ )
+    {
+        mem_ctx_define_io(cpu->mem, IO_ADDR_ACIA_CS, IO_ADDR_ACIA_DAT, io_handler_acia, cpu);
+        mem_ctx_define_io(cpu->mem, IO_ADDR_FIRQ_ACK, IO_ADDR_FIRQ_ACK, io_handler_firq_ack, cpu);
+        mem_ctx_define_io(cpu->mem, IO_ADDR_IRQ_ACK, IO_ADDR_IRQ_ACK, io_handler_irq_ack, cpu);
+
+        return -1;
+    }
+
+    return (i + test->load_address - 1);
+}
+
+/*------------------------------------------------
+ * interrupts()
+ *
+ *  Signal NMI, FIRQ and IRQ at fixed intervals of instructions
+ *  or batches, when running the interrupt test.
+ *
+ *  param:  Pointer to CPU module, pointer to test, instruction or batch count
+ *  return: Nothing
+ */
+void interrupts(lock_cpu_t *cpu, lock_test_t *test, long count)
+{
+    if ( test->type != LOCK_IRQ )
+        return;
+
+    if ( count % NMI_INTERVAL == NMI_INTERVAL - 1 )
+        cpu->nmi_trigger(cpu->ctx);
+    if ( count % FIRQ_INTERVAL == FIRQ_INTERVAL - 1 )
+        cpu->firq(cpu->ctx, 1);
+    if ( count % IRQ_INTERVAL == IRQ_INTERVAL - 1 )
+        cpu->irq(cpu->ctx, 1);
+}
+
+/*------------------------------------------------
+ * compare()
+ *
+ *  Compare the registers, CC, run state and cycle counter of
+ *  the two CPU modules, and the memory writes since the last compare.
+ *  Memory is compared if a write log is full or when requested.
+ *  Prints the differences and the traces of both CPU modules at
+ *  a divergence. Clears the write logs.
+ *
+ *  param:  '1' single steps, also compare last instruction cycles and bytes,
+ *          '1' compare all memory
+ *  return: '0' same, '1' diverged
+ */
+int compare(int step, int memory)
+{
+    cpu_state_t    *cpu, *ref;
+    int             diverged = 0;
+
+    if ( optimized.traced == LOCK_TRACE )
+    {
+        memmove(&optimized.trace[0], &optimized.trace[1], (LOCK_TRACE - 1) * sizeof(cpu_state_t));
+        memmove(&reference.trace[0], &reference.trace[1], (LOCK_TRACE - 1) * sizeof(cpu_state_t));
+        optimized.traced--;
+        reference.traced--;
+    }
+
+    cpu = &optimized.trace[optimized.traced++];
+    ref = &reference.trace[reference.traced++];
+
+    optimized.get_state(optimized.ctx, cpu);
+    reference.get_state(reference.ctx, ref);
+
+    if ( cpu->cpu_state != ref->cpu_state ||
+         cpu->pc != ref->pc || cpu->d != ref->d ||
+         cpu->x != ref->x || cpu->y != ref->y ||
+         cpu->u != ref->u || cpu->s != ref->s ||
+         cpu->dp != ref->dp || cpu->cc != ref->cc ||
+         cpu->cycles != ref->cycles )
+    {
+        printf("Registers, CC, run state or cycle counter differ\n");
+        diverged = 1;
+    }
+
+    if ( step &&
+         (cpu->last_pc != ref->last_pc ||
+          cpu->last_opcode_cycles != ref->last_opcode_cycles ||
+          cpu->last_opcode_bytes != ref->last_opcode_bytes) )
+    {
+        printf("Last instruction address, cycles or bytes differ\n");
+        diverged = 1;
+    }
+
+    if ( optimized.log.lost || reference.log.lost )
+    {
+        memory = 1;
+    }
+    else if ( compare_writes() )
+    {
+        printf("Memory writes differ\n");
+        diverged = 1;
+    }
+
+    if ( memory && compare_memory() )
+        diverged = 1;
+
+    if ( diverged )
+    {
+        print_trace(&optimized, step);
+        print_trace(&reference, step);
+        print_writes(&optimized);
+        print_writes(&reference);
+    }
+
+    optimized.log.count = 0;
+    optimized.log.lost = 0;
+    reference.log.count = 0;
+    reference.log.lost = 0;
+
+    return diverged;
+}
+
+/*------------------------------------------------
+ * compare_writes()
+ *
+ *  Compare the memory write logs of the two CPU modules.
+ *  The writes are compared in address order, and in write order
+ *  for the same address. The order of writes to different addresses
+ *  is not compared: the CPU module writes stack frames with block
+ *  writes from the lowest address, and the reference interpreter
+ *  one byte at a time from the highest address.
+ *
+ *  param:  Nothing
+ *  return: '0' same, '1' differ
+ */
+int compare_writes(void)
+{
+    int         i;
+    uint32_t    cpu_writes[MEM_WRITE_LOG], ref_writes[MEM_WRITE_LOG];
+
+    if ( optimized.log.count != reference.log.count )
+        return 1;
+
+    sort_writes(&optimized.log, cpu_writes);
+    sort_writes(&reference.log, ref_writes);
+
+    for ( i = 0; i < optimized.log.count; i++ )
+    {
+        if ( (cpu_writes[i] & 0xffff00ff) != (ref_writes[i] & 0xffff00ff) )
+            return 1;
+    }
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * sort_writes()
+ *
+ *  Sort a memory write log by address and write order.
+ *  Each write is packed as address, log index and data byte.
+ *
+ *  param:  Pointer to write log, pointer to packed writes result
+ *  return: Nothing
+ */
+void sort_writes(mem_write_log_t *log, uint32_t *writes)
+{
+    int     i;
+
+    for ( i = 0; i < log->count; i++ )
+    {
+        writes[i] = ((uint32_t) log->address[i] << 16) | (i << 8) | log->data[i];
+    }
+
+    qsort(writes, log->count, sizeof(uint32_t), compare_write_order);
+}
+
+/*------------------------------------------------
+ * compare_write_order()
+ *
+ *  qsort() compare function of packed writes.
+ *
+ *  param:  Pointers to two packed writes
+ *  return: '-1', '0' or '1'
+ */
+int compare_write_order(const void *a, const void *b)
+{
+    uint32_t    write_a = *(const uint32_t *) a;
+    uint32_t    write_b = *(const uint32_t *) b;
+
+    return (write_a > write_b) - (write_a < write_b);
+}
+
+/*------------------------------------------------
+ * compare_memory()
+ *
+ *  Compare the memory of the two CPU modules, except IO pages.
+ *  Prints the first address that differs.
+ *
+ *  param:  Nothing
+ *  return: '0' same, '1' differs
+ */
+int compare_memory(void)
+{
+    int     page, i;
+    uint8_t cpu_page[MEM_PAGE_SIZE], ref_page[MEM_PAGE_SIZE];
+
+    for ( page = 0; page < MEM_PAGES; page++ )
+    {
+        if ( mem_ctx_page_is_io(optimized.mem, page) )
+            continue;
+
+        for ( i = 0; i < MEM_PAGE_SIZE; i++ )
+        {
+            cpu_page[i] = (uint8_t) mem_ctx_read(optimized.mem, page * MEM_PAGE_SIZE + i);
+            ref_page[i] = (uint8_t) mem_ctx_read(reference.mem, page * MEM_PAGE_SIZE + i);
+        }
+
+        if ( memcmp(cpu_page, ref_page, MEM_PAGE_SIZE) == 0 )
+            continue;
+
+        for ( i = 0; cpu_page[i] == ref_page[i]; i++ );
+
+        printf("Memory differs at 0x%04x: %s=0x%02x %s=0x%02x\n", page * MEM_PAGE_SIZE + i,
+                optimized.name, cpu_page[i], reference.name, ref_page[i]);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * print_trace()
+ *
+ *  Print the CPU states of a CPU module at the last compares,
+ *  oldest first. Single step traces list the instruction
+ *  executed before each state.
+ *
+ *  param:  Pointer to CPU module, '1' single steps
+ *  return: Nothing
+ */
+void print_trace(lock_cpu_t *cpu, int step)
+{
+    int             i;
+    cpu_state_t    *state;
+
+    printf("%s trace:\n", cpu->name);
+
+    for ( i = 0; i < cpu->traced; i++ )
+    {
+        state = &cpu->trace[i];
+
+        if ( step )
+            printf("  0x%04x %-5s %2i cycles ", state->last_pc, cpu->get_menmonic(cpu->ctx, state->last_pc), state->last_opcode_cycles);
+        else
+            printf("  ");
+
+        printf("pc=0x%04x a=0x%02x b=0x%02x x=0x%04x y=0x%04x u=0x%04x s=0x%04x dp=0x%02x cc=0x%02x cycles=%llu state=%i\n",
+                state->pc, state->a, state->b, state->x, state->y, state->u, state->s,
+                state->dp, state->cc, (unsigned long long) state->cycles, state->cpu_state);
+    }
+}
+
+/*------------------------------------------------
+ * print_writes()
+ *
+ *  Print the memory writes of a CPU module since the last compare.
+ *
+ *  param:  Pointer to CPU module
+ *  return: Nothing
+ */
+void print_writes(lock_cpu_t *cpu)
+{
+    int     i;
+
+    printf("%s writes:", cpu->name);
+
+    for ( i = 0; i < cpu->log.count; i++ )
+    {
+        printf(" 0x%04x=0x%02x", cpu->log.address[i], cpu->log.data[i]);
+    }
+
+    if ( cpu->log.lost )
+        printf(" and %lu more", cpu->log.lost);
+
+    printf("\n");
+}
+
+/*------------------------------------------------
+ * io_handler_acia()
+ *
+ *  ACIA stub, always ready to transmit, output is discarded.
+ *
+ *  param:  CPU module, call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_acia(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    if ( address == IO_ADDR_ACIA_CS )
+        return 0x02;
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * io_handler_firq_ack()
+ *
+ *  FIRQ acknowledge, removes the FIRQ request of the CPU module.
+ *
+ *  param:  CPU module, call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_firq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    lock_cpu_t *cpu = (lock_cpu_t *) user;
+
+    cpu->firq(cpu->ctx, 0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_irq_ack()
+ *
+ *  IRQ acknowledge, removes the IRQ request of the CPU module.
+ *
+ *  param:  CPU module, call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_irq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    lock_cpu_t *cpu = (lock_cpu_t *) user;
+
+    cpu->irq(cpu->ctx, 0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub returning an idle keyboard and joystick state.
+ *
+ *  param:  CPU module, call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    return 0xff;
+}
+
+/*------------------------------------------------
+ * reference_init()
+ *
+ *  Reference interpreter adapters.
+ *  The reference interpreter has a single CPU on the default memory
+ *  context, the context parameter of the adapters is not used.
+ *
+ *  param:  Unused context, start address
+ *  return: 0- initialization ok, 1- Start address error
+ */
+int reference_init(cpu_context_t *ctx, int address)
+{
+    return ref_cpu_init(address);
+}
+
+void reference_reset(cpu_context_t *ctx, int state)
+{
+    ref_cpu_reset(state);
+}
+
+void reference_nmi_trigger(cpu_context_t *ctx)
+{
+    ref_cpu_nmi_trigger();
+}
+
+void reference_firq(cpu_context_t *ctx, int state)
+{
+    ref_cpu_firq(state);
+}
+
+void reference_irq(cpu_context_t *ctx, int state)
+{
+    ref_cpu_irq(state);
+}
+
+cpu_run_state_t reference_run(cpu_context_t *ctx)
+{
+    return ref_cpu_run();
+}
+
+const char* reference_get_menmonic(cpu_context_t *ctx, uint16_t address)
+{
+    return ref_cpu_get_menmonic(address);
+}
+
+/*------------------------------------------------
+ * reference_run_cycles()
+ *
+ *  Run the reference interpreter one instruction at a time
+ *  until a budget of clock cycles is used, an emulation exception,
+ *  or the break point address set by reference_break_point().
+ *  A waiting CPU uses one clock cycle per call of ref_cpu_run().
+ *
+ *  param:  Unused context, cycle budget
+ *  return: Cycles used
+ */
+int reference_run_cycles(cpu_context_t *ctx, int cycle_budget)
+{
+    uint64_t        start;
+    ref_cpu_state_t ref_state;
+
+    start = ref_cpu_get_cycles();
+
+    do
+    {
+        ref_cpu_run();
+        ref_cpu_get_state(&ref_state);
+    }
+    while ( ref_cpu_get_cycles() - start < (uint64_t) cycle_budget &&
+            ref_state.cpu_state != CPU_EXCEPTION &&
+            ref_state.pc != reference_break );
+
+    return (int)(ref_cpu_get_cycles() - start);
+}
+
+/*------------------------------------------------
+ * reference_break_point()
+ *
+ *  Set a break point address for reference_run_cycles().
+ *
+ *  param:  Unused context, break point address, '-1' to clear the break point
+ *  return: Nothing
+ */
+void reference_break_point(cpu_context_t *ctx, int address)
+{
+    reference_break = address;
+}
+
+/*------------------------------------------------
+ * reference_get_state()
+ *
+ *  Get the state of the reference interpreter as a CPU module state,
+ *  for compare() and print_trace().
+ *
+ *  param:  Unused context, pointer to CPU state data structure
+ *  return: CPU running state
+ */
+cpu_run_state_t reference_get_state(cpu_context_t *ctx, cpu_state_t *cpu_state)
+{
+    ref_cpu_state_t ref_state;
+
+    ref_cpu_get_state(&ref_state);
+
+    memset(cpu_state, 0, sizeof(cpu_state_t));
+
+    cpu_state->cpu_state = ref_state.cpu_state;
+    cpu_state->last_pc = ref_state.last_pc;
+    cpu_state->last_opcode_bytes = ref_state.last_opcode_bytes;
+    cpu_state->last_opcode_cycles = ref_state.last_opcode_cycles;
+    cpu_state->cycles = ref_cpu_get_cycles();
+    cpu_state->x = ref_state.x;
+    cpu_state->y = ref_state.y;
+    cpu_state->u = ref_state.u;
+    cpu_state->s = ref_state.s;
+    cpu_state->pc = ref_state.pc;
+    cpu_state->a = ref_state.a;
+    cpu_state->b = ref_state.b;
+    cpu_state->dp = ref_state.dp;
+    cpu_state->cc = ref_state.cc;
+    cpu_state->int_latch = ref_state.int_latch;
+    cpu_state->nmi_armed = ref_state.nmi_armed;
+    cpu_state->nmi_latched = ref_state.nmi_latched;
+    cpu_state->halt_asserted = ref_state.halt_asserted;
+    cpu_state->reset_asserted = ref_state.reset_asserted;
+    cpu_state->irq_asserted = ref_state.irq_asserted;
+    cpu_state->firq_asserted = ref_state.firq_asserted;
+    cpu_state->exception_line_num = ref_state.exception_line_num;
+
+    return ref_state.cpu_state;
+}
@@ -7,35 +7,214 @@
  *
  *******************************************************************/
 
+#include    <stdlib.h>
+#include    <string.h>
+
 #include    "mem.h"
 
 /* -----------------------------------------
    Local definitions
 ----------------------------------------- */
 
+#define     MEM_IO_HANDLERS         256         // IO handler table entries, entry '0' is no handler
+#define     MEM_ALIASES             16          // Alias table entries, entry '0' is no alias
+
+#define     PAGE(a)                 ((unsigned int)(a) / MEM_PAGE_SIZE)
+#define     PAGE_OFFSET(a)          ((unsigned int)(a) % MEM_PAGE_SIZE)
+
+/* Data of a page, in the RAM bank if the page is mapped to it,
+ * and a page with ROM addresses that is not mapped to the RAM bank
+ */
+#define     PAGE_DATA(mem, p)       ((mem)->page_bank[p] ? \
+                                     &(mem)->bank[((mem)->page_bank[p] - 1) * MEM_PAGE_SIZE] : \
+                                     &(mem)->memory[(p) * MEM_PAGE_SIZE])
+#define     PAGE_ROM(mem, p)        ((mem)->page_rom[p] && !(mem)->page_bank[p])
+
+/* Physical RAM address of a page: the memory image below the RAM bank,
+ * then the RAM bank. '-1' for a page of the memory image from
+ * MEM_BANK_PHYSICAL up, which is not physical RAM.
+ */
+#define     PAGE_PHYSICAL(mem, p)   ((mem)->page_bank[p] ? \
+                                     MEM_BANK_PHYSICAL + ((mem)->page_bank[p] - 1) * MEM_PAGE_SIZE : \
+                                     ((p) * MEM_PAGE_SIZE < MEM_BANK_PHYSICAL ? (int) ((p) * MEM_PAGE_SIZE) : -1))
+
+/* Mark the line of a physical RAM address as written in the dirty line bitmap
+ */
+#define     WATCH_MARK(mem, a)      ((mem)->watch_lines[(unsigned int)(a) / MEM_WATCH_LINE / 32] |= \
+                                     1U << ((unsigned int)(a) / MEM_WATCH_LINE % 32))
+
 typedef enum
 {
     MEM_TYPE_RAM,
     MEM_TYPE_ROM,
     MEM_TYPE_IO,
+    MEM_TYPE_ALIAS,
 } memory_flag_t;
 
+/* Address attributes, only used by accesses of pages
+ * that are not plain RAM
+ */
+typedef struct
+{
+    uint8_t code_byte;      // Byte is part of a predecoded instruction
+    uint8_t memory_type;    // memory_flag_t
+    uint8_t io_handler;     // IO handler table entry, '0' if no handler
+    uint8_t alias;          // Alias table entry of an alias address
+    uint8_t io_read_pure;   // IO handler reads have no side effects
+} location_t;
+
+/* Alias table entry, reads of an alias address range
+ * return the data of the range at the target address
+ */
+typedef struct
+{
+    uint16_t    start;
+    uint16_t    target;
+} alias_t;
+
+/* IO handler table entry, an IO handler and its user pointer.
+ * Handlers without a user pointer are called through
+ * callback_io_handler() with the entry as the user pointer.
+ */
 typedef struct
 {
-    uint8_t data_byte;
-    memory_flag_t memory_type;
-    io_handler_callback io_handler;
-} memory_t;
+    mem_io_handler_t    handler;
+    void               *user;
+    io_handler_callback callback;
+} io_handler_t;
+
+/* Memory context
+ */
+struct mem_context_t
+{
+    /* Page table of direct read and write data, first so that the
+     * inline accessors of mem.h can find it, and flat memory image.
+     * Reads and writes of a page go directly to its data, or check the
+     * address attributes when the pointer is NULL: reads of pages with
+     * IO or alias addresses, writes of pages with ROM, IO or code bytes or
+     * a watch range, and all writes while a write log is set.
+     */
+    mem_page_table_t pages;
+    uint8_t         memory[MEMORY];
+
+    /* Per page write version, incremented when code bytes in a page are
+     * written or the page's content or type changes.
+     * Used by the CPU to invalidate predecoded instructions.
+     */
+    uint32_t        page_version[MEM_PAGES];
+
+    /* Page markers, pages that have IO or alias, ROM or code addresses
+     */
+    uint8_t         page_io[MEM_PAGES];
+    uint8_t         page_rom[MEM_PAGES];
+    uint8_t         page_code[MEM_PAGES];
+
+    /* RAM bank and the bank page of every page mapped to it plus one,
+     * '0' for pages of the memory image. A page mapped to the bank
+     * is RAM even if its addresses were defined as ROM.
+     */
+    uint8_t         page_bank[MEM_PAGES];
+    uint8_t         bank[MEM_BANK_SIZE];
+
+    /* Watch range of physical RAM addresses, the markers of the
+     * pages mapped to it, and a bitmap of the lines of MEM_WATCH_LINE
+     * bytes written since the last mem_ctx_watch_dirty() call.
+     * Start is '-1' if not set.
+     */
+    int             watch_start;
+    int             watch_end;
+    uint8_t         page_watch[MEM_PAGES];
+    uint32_t        watch_lines[MEM_WATCH_WORDS];
+
+    location_t      location[MEMORY];
+
+    /* Count of IO handler calls
+     */
+    uint32_t        io_accesses;
+
+    io_handler_t    io_handlers[MEM_IO_HANDLERS];
+    int             io_handler_count;
+
+    alias_t         aliases[MEM_ALIASES];
+    int             alias_count;
+
+    /* Write log, NULL if writes are not logged
+     */
+    mem_write_log_t *write_log;
+};
 
 /* -----------------------------------------
    Module static functions
 ----------------------------------------- */
-static uint8_t do_nothing_io_handler(uint16_t address, uint8_t data, mem_operation_t op);
+static uint8_t callback_io_handler(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+static int     add_io_handler(mem_context_t *mem, mem_io_handler_t io_handler, void *user, io_handler_callback callback);
+static int     define_io_range(mem_context_t *mem, int addr_start, int addr_end, int handler);
+static void    page_changed(mem_context_t *mem, int addr_start, int addr_end);
+static void    page_markers(mem_context_t *mem, int addr_start, int addr_end);
+static void    page_access(mem_context_t *mem, int addr_start, int addr_end);
+static int     check_bank_range(mem_context_t *mem, int addr_start, int addr_end);
+static void    page_copy_in(mem_context_t *mem, int address, const uint8_t *buffer, int length);
+static void    page_copy_out(mem_context_t *mem, int address, uint8_t *buffer, int length);
+static void    watch_pages(mem_context_t *mem, int addr_start, int addr_end);
+static void    watch_mark(mem_context_t *mem, int addr_start, int addr_end);
+static void    log_write(mem_write_log_t *log, int address, int data);
 
 /* -----------------------------------------
    Module globals
 ----------------------------------------- */
-static memory_t memory[MEMORY];
+
+/* Default memory context of the API functions without a
+ * context parameter, usable without a mem_init() call,
+ * all its accesses are indirect until initialized
+ */
+static mem_context_t default_context = { .io_handler_count = 1, .alias_count = 1, .watch_start = -1 };
+
+/*------------------------------------------------
+ * mem_create()
+ *
+ *  Allocate and initialize a memory context.
+ *
+ *  param:  Nothing
+ *  return: Pointer to memory context, NULL if allocation failed
+ */
+mem_context_t *mem_create(void)
+{
+    mem_context_t  *mem;
+
+    mem = calloc(1, sizeof(mem_context_t));
+    if ( mem != 0L )
+        mem_ctx_init(mem);
+
+    return mem;
+}
+
+/*------------------------------------------------
+ * mem_destroy()
+ *
+ *  Free a memory context allocated by mem_create().
+ *
+ *  param:  Pointer to memory context
+ *  return: Nothing
+ */
+void mem_destroy(mem_context_t *mem)
+{
+    if ( mem != &default_context )
+        free(mem);
+}
+
+/*------------------------------------------------
+ * mem_default_context()
+ *
+ *  Return the memory context used by the API functions
+ *  without a context parameter.
+ *
+ *  param:  Nothing
+ *  return: Pointer to default memory context
+ */
+mem_context_t *mem_default_context(void)
+{
+    return &default_context;
+}
 
 /*------------------------------------------------
  * mem_init()
@@ -46,15 +225,56 @@ static memory_t memory[MEMORY];
  *  return: Nothing
  */
 void mem_init(void)
+{
+    mem_ctx_init(&default_context);
+}
+
+/*------------------------------------------------
+ * mem_ctx_init()
+ *
+ *  Initialize a memory context. All addresses are RAM
+ *  without IO handlers.
+ *
+ *  param:  Pointer to memory context
+ *  return: Nothing
+ */
+void mem_ctx_init(mem_context_t *mem)
 {
     int i;
 
+    memset(mem->memory, 0, sizeof(mem->memory));
+    memset(mem->bank, 0, sizeof(mem->bank));
+
     for ( i = 0; i < MEMORY; i++ )
     {
-        memory[i].data_byte = 0;
-        memory[i].memory_type = MEM_TYPE_RAM;
-        memory[i].io_handler = do_nothing_io_handler;
+        mem->location[i].code_byte = 0;
+        mem->location[i].memory_type = MEM_TYPE_RAM;
+        mem->location[i].io_handler = 0;
+        mem->location[i].alias = 0;
+        mem->location[i].io_read_pure = 0;
+    }
+
+    for ( i = 0; i < MEM_PAGES; i++ )
+    {
+        mem->page_io[i] = 0;
+        mem->page_rom[i] = 0;
+        mem->page_code[i] = 0;
+        mem->page_bank[i] = 0;
+        mem->page_watch[i] = 0;
     }
+
+    mem->watch_start = -1;
+    mem->watch_end = -1;
+    memset(mem->watch_lines, 0, sizeof(mem->watch_lines));
+
+    mem->io_handlers[0].handler = 0L;
+    mem->io_handlers[0].user = 0L;
+    mem->io_handlers[0].callback = 0L;
+    mem->io_handler_count = 1;
+    mem->alias_count = 1;
+
+    page_changed(mem, 0, MEMORY-1);
+    page_access(mem, 0, MEMORY-1);
 }
 
 /*------------------------------------------------
@@ -68,19 +288,96 @@ void mem_init(void)
  */
 int mem_read(int address)
 {
+    return mem_ctx_read(&default_context, address);
+}
+
+/*------------------------------------------------
+ * mem_ctx_read()
+ *
+ *  Read memory address of a memory context
+ *
+ *  param:  Pointer to memory context, memory address
+ *  return: Memory content at address
+ *          '-1' if address range error
+ */
+int mem_ctx_read(mem_context_t *mem, int address)
+{
+    uint8_t        *data;
+    location_t     *location;
+    alias_t        *alias;
+    io_handler_t   *io;
+
     if ( address < 0 || address > (MEMORY-1) )
         return MEM_ADD_RANGE;
 
-    if ( memory[address].memory_type == MEM_TYPE_IO &&
-         memory[address].io_handler != do_nothing_io_handler )
+    data = mem->pages.page_read[PAGE(address)];
+
+    if ( data )
+        return (int) data[PAGE_OFFSET(address)];
+
+    /* Page with IO or alias addresses
+     */
+    location = &mem->location[address];
+
+    if ( location->memory_type == MEM_TYPE_ALIAS )
+    {
+        alias = &mem->aliases[location->alias];
+        address = alias->target + (address - alias->start);
+        return (int) PAGE_DATA(mem, PAGE(address))[PAGE_OFFSET(address)];
+    }
+
+    data = PAGE_DATA(mem, PAGE(address)) + PAGE_OFFSET(address);
+
+    if ( location->memory_type == MEM_TYPE_IO &&
+         location->io_handler )
     {
         /* An attempt to read an IO address will trigger
          * the callback that may return an alternative value.
          */
-        memory[address].data_byte = memory[address].io_handler((uint16_t) address, memory[address].data_byte, MEM_READ);
+        io = &mem->io_handlers[location->io_handler];
+        mem->io_accesses++;
+        *data = io->handler(io->user, (uint16_t) address, *data, MEM_READ);
     }
 
-    return (int)(memory[address].data_byte);
+    return (int)(*data);
+}
+
+/*------------------------------------------------
+ * mem_read_physical()
+ *
+ *  Read a physical RAM address of the default memory context.
+ *
+ *  param:  Physical RAM address
+ *  return: RAM content at address
+ *          '-1' if address range error
+ */
+int mem_read_physical(int address)
+{
+    return mem_ctx_read_physical(&default_context, address);
+}
+
+/*------------------------------------------------
+ * mem_ctx_read_physical()
+ *
+ *  Read a physical RAM address of a memory context, as a
+ *  video controller sees the RAM. Physical RAM is the memory
+ *  image below MEM_BANK_PHYSICAL, followed by the RAM bank,
+ *  whatever the bank mappings of the CPU address space are.
+ *  IO handlers and aliases are not called.
+ *
+ *  param:  Pointer to memory context, physical RAM address
+ *  return: RAM content at address
+ *          '-1' if address range error
+ */
+int mem_ctx_read_physical(mem_context_t *mem, int address)
+{
+    if ( address < 0 || address > (MEMORY-1) )
+        return MEM_ADD_RANGE;
+
+    if ( address < MEM_BANK_PHYSICAL )
+        return (int) mem->memory[address];
+
+    return (int) mem->bank[address - MEM_BANK_PHYSICAL];
 }
 
 /*------------------------------------------------
@@ -95,18 +392,205 @@ int mem_read(int address)
  */
 int mem_write(int address, int data)
 {
+    return mem_ctx_write(&default_context, address, data);
+}
+
+/*------------------------------------------------
+ * mem_ctx_write()
+ *
+ *  Write to memory address of a memory context
+ *
+ *  param:  Pointer to memory context, memory address and data to write
+ *  return: ' 0' - write ok,
+ *          '-1' - memory location is out of range
+ *          '-2' - memory location is ROM
+ */
+int mem_ctx_write(mem_context_t *mem, int address, int data)
+{
+    uint8_t        *page_data;
+    location_t     *location;
+    io_handler_t   *io;
+
     if ( address < 0 || address > (MEMORY-1) )
         return MEM_ADD_RANGE;
 
-    if ( memory[address].memory_type == MEM_TYPE_ROM )
+    page_data = mem->pages.page_write[PAGE(address)];
+
+    if ( page_data )
+    {
+        page_data[PAGE_OFFSET(address)] = (uint8_t) data;
+        return MEM_OK;
+    }
+
+    /* Page with ROM, IO or code bytes, a watch range, or a write log
+     */
+    location = &mem->location[address];
+
+    if ( mem->write_log )
+        log_write(mem->write_log, address, data);
+
+    if ( location->memory_type == MEM_TYPE_ROM &&
+         !mem->page_bank[PAGE(address)] )
         return MEM_ROM;
 
-    memory[address].data_byte = (uint8_t) data;
+    PAGE_DATA(mem, PAGE(address))[PAGE_OFFSET(address)] = (uint8_t) data;
+
+    if ( location->code_byte )
+        mem->page_version[address / MEM_PAGE_SIZE]++;
 
-    if ( memory[address].memory_type == MEM_TYPE_IO &&
-         memory[address].io_handler != do_nothing_io_handler )
+    if ( mem->page_watch[PAGE(address)] )
+        WATCH_MARK(mem, PAGE_PHYSICAL(mem, PAGE(address)) + PAGE_OFFSET(address));
+
+    if ( location->memory_type == MEM_TYPE_IO &&
+         location->io_handler )
+    {
+        io = &mem->io_handlers[location->io_handler];
+        mem->io_accesses++;
+        io->handler(io->user, (uint16_t) address, (uint8_t) data, MEM_WRITE);
+    }
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_read16()
+ *
+ *  Read a 16-bit big-endian word, high byte first.
+ *
+ *  param:  Memory address, wraps at 64K
+ *  return: Memory content at address and address + 1
+ */
+uint16_t mem_read16(uint16_t address)
+{
+    return mem_ctx_read16(&default_context, address);
+}
+
+/*------------------------------------------------
+ * mem_write16()
+ *
+ *  Write a 16-bit big-endian word, high byte first.
+ *
+ *  param:  Memory address, wraps at 64K, and data to write
+ *  return: Nothing
+ */
+void mem_write16(uint16_t address, uint16_t data)
+{
+    mem_ctx_write16(&default_context, address, data);
+}
+
+/*------------------------------------------------
+ * mem_read_block()
+ *
+ *  Read a block of memory without IO addresses
+ *
+ *  param:  Memory address, buffer and length
+ *  return: ' 0' - read ok,
+ *          '-1' - block is out of range
+ *          '-4' - block has IO addresses or is too long, nothing read
+ */
+int mem_read_block(int address, uint8_t *buffer, int length)
+{
+    return mem_ctx_read_block(&default_context, address, buffer, length);
+}
+
+/*------------------------------------------------
+ * mem_ctx_read_block()
+ *
+ *  Read a block of memory of a memory context without IO
+ *  addresses, for a caller that reads several bytes at once.
+ *  A block that touches an IO page is not read, so that the
+ *  caller can read it byte by byte in its own access order.
+ *  Blocks of up to MEM_PAGE_SIZE bytes are checked at their
+ *  first and last page.
+ *
+ *  param:  Pointer to memory context, memory address, buffer and length
+ *  return: ' 0' - read ok,
+ *          '-1' - block is out of range
+ *          '-4' - block has IO addresses or is too long, nothing read
+ */
+int mem_ctx_read_block(mem_context_t *mem, int address, uint8_t *buffer, int length)
+{
+    if ( address < 0 || length < 0 || (address + length) > MEMORY )
+        return MEM_ADD_RANGE;
+
+    if ( length == 0 )
+        return MEM_OK;
+
+    if ( length > MEM_PAGE_SIZE ||
+         mem->page_io[address / MEM_PAGE_SIZE] ||
+         mem->page_io[(address + length - 1) / MEM_PAGE_SIZE] )
+        return MEM_NOT_RAM;
+
+    page_copy_out(mem, address, buffer, length);
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_write_block()
+ *
+ *  Write a block of RAM
+ *
+ *  param:  Memory address, buffer and length
+ *  return: ' 0' - write ok,
+ *          '-1' - block is out of range
+ *          '-4' - block has ROM or IO addresses or is too long, nothing written
+ */
+int mem_write_block(int address, const uint8_t *buffer, int length)
+{
+    return mem_ctx_write_block(&default_context, address, buffer, length);
+}
+
+/*------------------------------------------------
+ * mem_ctx_write_block()
+ *
+ *  Write a block of RAM of a memory context, for a caller that writes
+ *  several bytes at once. A block that touches a ROM or IO page is not
+ *  written, so that the caller can write it byte by byte in its own
+ *  access order. Blocks of up to MEM_PAGE_SIZE bytes are checked at
+ *  their first and last page.
+ *
+ *  param:  Pointer to memory context, memory address, buffer and length
+ *  return: ' 0' - write ok,
+ *          '-1' - block is out of range
+ *          '-4' - block has ROM or IO addresses or is too long, nothing written
+ */
+int mem_ctx_write_block(mem_context_t *mem, int address, const uint8_t *buffer, int length)
+{
+    location_t *location;
+    int         first, last, i;
+
+    if ( address < 0 || length < 0 || (address + length) > MEMORY )
+        return MEM_ADD_RANGE;
+
+    if ( length == 0 )
+        return MEM_OK;
+
+    first = address / MEM_PAGE_SIZE;
+    last = (address + length - 1) / MEM_PAGE_SIZE;
+
+    if ( length > MEM_PAGE_SIZE ||
+         mem->page_io[first] || PAGE_ROM(mem, first) ||
+         mem->page_io[last] || PAGE_ROM(mem, last) )
+        return MEM_NOT_RAM;
+
+    page_copy_in(mem, address, buffer, length);
+
+    if ( mem->page_watch[first] || mem->page_watch[last] )
+        watch_mark(mem, address, address + length - 1);
+
+    if ( !mem->page_code[first] && !mem->page_code[last] && !mem->write_log )
+        return MEM_OK;
+
+    location = &mem->location[address];
+
+    for ( i = 0; i < length; i++, location++ )
     {
-        memory[address].io_handler((uint16_t) address, (uint8_t)data, MEM_WRITE);
+        if ( mem->write_log )
+            log_write(mem->write_log, address + i, buffer[i]);
+
+        if ( location->code_byte )
+            mem->page_version[(address + i) / MEM_PAGE_SIZE]++;
     }
 
     return MEM_OK;
@@ -123,6 +607,22 @@ int mem_write(int address, int data)
  *          '-1' - memory location is out of range
  */
 int  mem_define_rom(int addr_start, int addr_end)
+{
+    return mem_ctx_define_rom(&default_context, addr_start, addr_end);
+}
+
+/*------------------------------------------------
+ * mem_ctx_define_rom()
+ *
+ *  Define address range of a memory context as ROM.
+ *  Function clears IO flag and callback index.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: ' 0' - write ok,
+ *          '-1' - memory location is out of range
+ */
+int  mem_ctx_define_rom(mem_context_t *mem, int addr_start, int addr_end)
 {
     int i;
 
@@ -133,9 +633,16 @@ int  mem_define_rom(int addr_start, int addr_end)
 
     for (i = addr_start; i <= addr_end; i++)
     {
-        memory[i].memory_type = MEM_TYPE_ROM;
+        mem->location[i].memory_type = MEM_TYPE_ROM;
+        mem->location[i].io_handler = 0;
+        mem->location[i].alias = 0;
+        mem->location[i].io_read_pure = 0;
     }
 
+    page_markers(mem, addr_start, addr_end);
+    page_changed(mem, addr_start, addr_end);
+    page_access(mem, addr_start, addr_end);
+
     return MEM_OK;
 }
 
@@ -153,62 +660,930 @@ int  mem_define_rom(int addr_start, int addr_end)
  */
 int  mem_define_io(int addr_start, int addr_end, io_handler_callback io_handler)
 {
-    int i;
+    int handler = 0;
 
     if ( addr_start < 0 || addr_start > (MEMORY-1) ||
          addr_end < 0   || addr_end > (MEMORY-1)   ||
          addr_start > addr_end )
         return MEM_ADD_RANGE;
 
-    for (i = addr_start; i <= addr_end; i++)
+    if ( io_handler != 0L )
     {
-        memory[i].memory_type = MEM_TYPE_IO;
-        if ( io_handler != 0L )
-            memory[i].io_handler = io_handler;
+        handler = add_io_handler(&default_context, callback_io_handler, 0L, io_handler);
+        if ( handler == 0 )
+            return MEM_HANDLER_ERR;
     }
 
-    return MEM_OK;
+    return define_io_range(&default_context, addr_start, addr_end, handler);
 }
 
 /*------------------------------------------------
- * mem_load()
+ * mem_ctx_define_io()
  *
- *  Load a memory range from a data buffer.
- *  Function clears IO, ROM, and callback index fields.
+ *  Define IO device address range of a memory context and optional
+ *  callback handler. The handler is called with the user pointer.
+ *  Function clears ROM flag.
  *
- *  param:  Memory address start, source data buffer and
- *          number of data elements to load
+ *  param:  Pointer to memory context,
+ *          memory address range start to end, inclusive
+ *          IO handler callback for the range or NULL, user pointer
  *  return: ' 0' - write ok,
  *          '-1' - memory location is out of range
+ *          '-3' - Cannot hook IO handler
  */
-int mem_load(int addr_start, uint8_t *buffer, int length)
+int  mem_ctx_define_io(mem_context_t *mem, int addr_start, int addr_end, mem_io_handler_t io_handler, void *user)
+{
+    int handler = 0;
+
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end )
+        return MEM_ADD_RANGE;
+
+    if ( io_handler != 0L )
+    {
+        handler = add_io_handler(mem, io_handler, user, 0L);
+        if ( handler == 0 )
+            return MEM_HANDLER_ERR;
+    }
+
+    return define_io_range(mem, addr_start, addr_end, handler);
+}
+
+/*------------------------------------------------
+ * mem_define_io_pure()
+ *
+ *  Declare that reads of an IO address range have no side effects.
+ *
+ *  param:  Memory address range start to end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int  mem_define_io_pure(int addr_start, int addr_end)
+{
+    return mem_ctx_define_io_pure(&default_context, addr_start, addr_end);
+}
+
+/*------------------------------------------------
+ * mem_ctx_define_io_pure()
+ *
+ *  Declare that reads of an IO address range of a memory context
+ *  have no side effects: the IO handler returns device state and does
+ *  not change it, count the reads or react to them. The CPU can then skip
+ *  guest polling loop iterations that read the range. The declaration
+ *  is cleared when the addresses are defined again as IO, ROM or alias.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start to end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int  mem_ctx_define_io_pure(mem_context_t *mem, int addr_start, int addr_end)
 {
     int i;
 
     if ( addr_start < 0 || addr_start > (MEMORY-1) ||
-         (addr_start + length) > MEMORY )
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end )
         return MEM_ADD_RANGE;
 
-    for (i = 0; i < length; i++)
+    for ( i = addr_start; i <= addr_end; i++ )
     {
-        memory[(i+addr_start)].data_byte = buffer[i];
+        if ( mem->location[i].memory_type == MEM_TYPE_IO )
+            mem->location[i].io_read_pure = 1;
     }
 
     return MEM_OK;
 }
 
 /*------------------------------------------------
- * do_nothing_io_handler()
+ * mem_define_alias()
  *
- *  A default do-nothing IO handler
+ *  Define an address range whose reads return the data
+ *  of a range of the same length at a target address.
  *
- *  param:  Nothing
- *  return: Nothing
+ *  param:  Memory address range start and end, inclusive,
+ *          target address of the range start
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ *          '-3' - alias table is full
+ *          '-4' - target range has IO or alias addresses
  */
-static uint8_t do_nothing_io_handler(uint16_t address, uint8_t data, mem_operation_t op)
+int mem_define_alias(int addr_start, int addr_end, int target)
 {
-    /* do nothing */
-    /* TODO generate an exception? */
-    return 0;
+    return mem_ctx_define_alias(&default_context, addr_start, addr_end, target);
 }
 
+/*------------------------------------------------
+ * mem_ctx_define_alias()
+ *
+ *  Define an address range of a memory context whose reads return
+ *  the data of a range of the same length at a target address,
+ *  without an IO handler. Reads of the target range go through the
+ *  current page mapping. Writes to the alias range are written to
+ *  its own memory, which its reads do not return.
+ *  Function clears IO and ROM flags.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive,
+ *          target address of the range start
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ *          '-3' - alias table is full
+ *          '-4' - target range has IO or alias addresses
+ */
+int mem_ctx_define_alias(mem_context_t *mem, int addr_start, int addr_end, int target)
+{
+    int     i, alias;
+
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end ||
+         target < 0 || (target + addr_end - addr_start) > (MEMORY-1) )
+        return MEM_ADD_RANGE;
+
+    for ( i = target; i <= (target + addr_end - addr_start); i++ )
+    {
+        if ( mem->location[i].memory_type == MEM_TYPE_IO ||
+             mem->location[i].memory_type == MEM_TYPE_ALIAS )
+            return MEM_NOT_RAM;
+    }
+
+    /* Find or add the alias table entry
+     */
+    for ( alias = 1; alias < mem->alias_count; alias++ )
+    {
+        if ( mem->aliases[alias].start == addr_start &&
+             mem->aliases[alias].target == target )
+            break;
+    }
+
+    if ( alias == mem->alias_count )
+    {
+        if ( mem->alias_count == MEM_ALIASES )
+            return MEM_HANDLER_ERR;
+
+        mem->alias_count++;
+        mem->aliases[alias].start = (uint16_t) addr_start;
+        mem->aliases[alias].target = (uint16_t) target;
+    }
+
+    for (i = addr_start; i <= addr_end; i++)
+    {
+        mem->location[i].memory_type = MEM_TYPE_ALIAS;
+        mem->location[i].alias = (uint8_t) alias;
+        mem->location[i].io_read_pure = 0;
+    }
+
+    page_markers(mem, addr_start, addr_end);
+    page_changed(mem, addr_start, addr_end);
+    page_access(mem, addr_start, addr_end);
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_load()
+ *
+ *  Load a memory range from a data buffer.
+ *  Function clears IO, ROM, and callback index fields.
+ *
+ *  param:  Memory address start, source data buffer and
+ *          number of data elements to load
+ *  return: ' 0' - write ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_load(int addr_start, uint8_t *buffer, int length)
+{
+    return mem_ctx_load(&default_context, addr_start, buffer, length);
+}
+
+/*------------------------------------------------
+ * mem_ctx_load()
+ *
+ *  Load a memory range of a memory context from a data buffer.
+ *
+ *  param:  Pointer to memory context, memory address start,
+ *          source data buffer and number of data elements to load
+ *  return: ' 0' - write ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_ctx_load(mem_context_t *mem, int addr_start, uint8_t *buffer, int length)
+{
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         (addr_start + length) > MEMORY )
+        return MEM_ADD_RANGE;
+
+    page_copy_in(mem, addr_start, buffer, length);
+
+    if ( length > 0 )
+    {
+        page_changed(mem, addr_start, addr_start + length - 1);
+        watch_mark(mem, addr_start, addr_start + length - 1);
+    }
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_bank_map()
+ *
+ *  Map an address range to the RAM bank.
+ *
+ *  param:  Memory address range start and end, inclusive,
+ *          address in the RAM bank of the range start
+ *  return: ' 0' - ok,
+ *          '-1' - range is out of range or not whole pages
+ *          '-4' - range has IO addresses, nothing mapped
+ */
+int mem_bank_map(int addr_start, int addr_end, int bank_address)
+{
+    return mem_ctx_bank_map(&default_context, addr_start, addr_end, bank_address);
+}
+
+/*------------------------------------------------
+ * mem_ctx_bank_map()
+ *
+ *  Map an address range of a memory context to the RAM bank by
+ *  changing the data pointers of its pages, without copying memory.
+ *  The range is RAM while it is mapped, even if it was defined as
+ *  ROM, and the memory image keeps its content. The write version
+ *  of every page that changes its mapping is advanced. Physical RAM
+ *  does not change, so no line of the watch range is marked.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive, whole pages,
+ *          address in the RAM bank of the range start, page aligned
+ *  return: ' 0' - ok,
+ *          '-1' - range is out of range or not whole pages
+ *          '-4' - range has IO addresses, nothing mapped
+ */
+int mem_ctx_bank_map(mem_context_t *mem, int addr_start, int addr_end, int bank_address)
+{
+    int     result, page, bank_page, changed = 0;
+
+    result = check_bank_range(mem, addr_start, addr_end);
+    if ( result != MEM_OK )
+        return result;
+
+    if ( bank_address < 0 || PAGE_OFFSET(bank_address) ||
+         (bank_address + addr_end - addr_start + 1) > MEM_BANK_SIZE )
+        return MEM_ADD_RANGE;
+
+    bank_page = bank_address / MEM_PAGE_SIZE + 1;
+
+    for ( page = PAGE(addr_start); page <= PAGE(addr_end); page++, bank_page++ )
+    {
+        if ( mem->page_bank[page] == bank_page )
+            continue;
+
+        mem->page_bank[page] = (uint8_t) bank_page;
+        mem->page_version[page]++;
+        changed = 1;
+    }
+
+    if ( changed )
+    {
+        watch_pages(mem, addr_start, addr_end);
+        page_access(mem, addr_start, addr_end);
+    }
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_bank_unmap()
+ *
+ *  Map an address range back to the memory image.
+ *
+ *  param:  Memory address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - range is out of range or not whole pages
+ *          '-4' - range has IO addresses, nothing mapped
+ */
+int mem_bank_unmap(int addr_start, int addr_end)
+{
+    return mem_ctx_bank_unmap(&default_context, addr_start, addr_end);
+}
+
+/*------------------------------------------------
+ * mem_ctx_bank_unmap()
+ *
+ *  Map an address range of a memory context back to the memory image,
+ *  with the ROM addresses it was defined with. The write version
+ *  of every page that changes its mapping is advanced.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive, whole pages
+ *  return: ' 0' - ok,
+ *          '-1' - range is out of range or not whole pages
+ *          '-4' - range has IO addresses, nothing mapped
+ */
+int mem_ctx_bank_unmap(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     result, page, changed = 0;
+
+    result = check_bank_range(mem, addr_start, addr_end);
+    if ( result != MEM_OK )
+        return result;
+
+    for ( page = PAGE(addr_start); page <= PAGE(addr_end); page++ )
+    {
+        if ( mem->page_bank[page] == 0 )
+            continue;
+
+        mem->page_bank[page] = 0;
+        mem->page_version[page]++;
+        changed = 1;
+    }
+
+    if ( changed )
+    {
+        watch_pages(mem, addr_start, addr_end);
+        page_access(mem, addr_start, addr_end);
+    }
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_watch()
+ *
+ *  Set the watch range of the default memory context.
+ *
+ *  param:  Physical RAM address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_watch(int addr_start, int addr_end)
+{
+    return mem_ctx_watch(&default_context, addr_start, addr_end);
+}
+
+/*------------------------------------------------
+ * mem_ctx_watch()
+ *
+ *  Set the watch range of a memory context, replacing the previous one.
+ *  The range is in physical RAM addresses, see mem_ctx_read_physical(),
+ *  so it follows its RAM through bank mappings. Writes to the pages
+ *  mapped to the range mark their lines of MEM_WATCH_LINE bytes in a
+ *  dirty line bitmap of physical RAM addresses, which
+ *  mem_ctx_watch_dirty() returns. All lines of the new range are
+ *  marked as written.
+ *
+ *  param:  Pointer to memory context,
+ *          physical RAM address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_ctx_watch(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     address;
+
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end )
+        return MEM_ADD_RANGE;
+
+    mem->watch_start = addr_start;
+    mem->watch_end = addr_end;
+
+    watch_pages(mem, 0, MEMORY - 1);
+    page_access(mem, 0, MEMORY - 1);
+
+    for ( address = addr_start - addr_start % MEM_WATCH_LINE; address <= addr_end; address += MEM_WATCH_LINE )
+        WATCH_MARK(mem, address);
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_watch_dirty()
+ *
+ *  Return and clear the dirty line bitmap of the default memory context.
+ *
+ *  param:  Pointer to MEM_WATCH_WORDS words of dirty line bitmap
+ *  return: Number of lines written since the last call
+ */
+int mem_watch_dirty(uint32_t *lines)
+{
+    return mem_ctx_watch_dirty(&default_context, lines);
+}
+
+/*------------------------------------------------
+ * mem_ctx_watch_dirty()
+ *
+ *  Return and clear the dirty line bitmap of a memory context.
+ *  Bit (n % 32) of word (n / 32) is set if line n, physical RAM addresses
+ *  n * MEM_WATCH_LINE to n * MEM_WATCH_LINE + MEM_WATCH_LINE - 1,
+ *  was written since the last call. Lines of the watch range's pages
+ *  outside of the range can also be marked.
+ *
+ *  param:  Pointer to memory context,
+ *          pointer to MEM_WATCH_WORDS words of dirty line bitmap
+ *  return: Number of lines written since the last call
+ */
+int mem_ctx_watch_dirty(mem_context_t *mem, uint32_t *lines)
+{
+    int         i, count = 0;
+    uint32_t    word;
+
+    for ( i = 0; i < MEM_WATCH_WORDS; i++ )
+    {
+        word = mem->watch_lines[i];
+        lines[i] = word;
+        mem->watch_lines[i] = 0;
+
+        for ( ; word; word &= word - 1 )
+            count++;
+    }
+
+    return count;
+}
+
+/*------------------------------------------------
+ * mem_mark_code()
+ *
+ *  Mark an address range as predecoded code.
+ *
+ *  param:  Memory address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_mark_code(int addr_start, int addr_end)
+{
+    return mem_ctx_mark_code(&default_context, addr_start, addr_end);
+}
+
+/*------------------------------------------------
+ * mem_ctx_mark_code()
+ *
+ *  Mark an address range as predecoded code. A later write to
+ *  any of the bytes changes the write version of its page.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - memory location is out of range
+ */
+int mem_ctx_mark_code(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int i;
+
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end )
+        return MEM_ADD_RANGE;
+
+    for (i = addr_start; i <= addr_end; i++)
+    {
+        mem->location[i].code_byte = 1;
+        mem->page_code[i / MEM_PAGE_SIZE] = 1;
+    }
+
+    page_access(mem, addr_start, addr_end);
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * mem_page_versions()
+ *
+ *  Return the per page write version array.
+ *
+ *  param:  Nothing
+ *  return: Pointer to MEM_PAGES write versions, indexed by address / MEM_PAGE_SIZE
+ */
+const uint32_t *mem_page_versions(void)
+{
+    return mem_ctx_page_versions(&default_context);
+}
+
+/*------------------------------------------------
+ * mem_ctx_page_versions()
+ *
+ *  Return the per page write version array. A page's version
+ *  changes whenever a code byte in the page is written, or the page
+ *  is loaded or redefined as IO. The CPU uses the versions to
+ *  detect writes to code it has predecoded.
+ *
+ *  param:  Pointer to memory context
+ *  return: Pointer to MEM_PAGES write versions, indexed by address / MEM_PAGE_SIZE
+ */
+const uint32_t *mem_ctx_page_versions(mem_context_t *mem)
+{
+    return mem->page_version;
+}
+
+/*------------------------------------------------
+ * mem_io_access_counter()
+ *
+ *  Return a pointer to the count of IO handler calls.
+ *
+ *  param:  Nothing
+ *  return: Pointer to IO handler call count
+ */
+const uint32_t *mem_io_access_counter(void)
+{
+    return mem_ctx_io_access_counter(&default_context);
+}
+
+/*------------------------------------------------
+ * mem_ctx_io_access_counter()
+ *
+ *  Return a pointer to the count of IO handler calls.
+ *  The CPU uses the count to detect IO accesses of instructions.
+ *
+ *  param:  Pointer to memory context
+ *  return: Pointer to IO handler call count
+ */
+const uint32_t *mem_ctx_io_access_counter(mem_context_t *mem)
+{
+    return &mem->io_accesses;
+}
+
+/*------------------------------------------------
+ * mem_page_is_io()
+ *
+ *  Check if a memory page has IO addresses.
+ *
+ *  param:  Page number, address / MEM_PAGE_SIZE
+ *  return: '1' if the page has IO addresses or is out of range, '0' if not
+ */
+int mem_page_is_io(int page)
+{
+    return mem_ctx_page_is_io(&default_context, page);
+}
+
+/*------------------------------------------------
+ * mem_ctx_page_is_io()
+ *
+ *  Check if a memory page has IO addresses. Alias addresses
+ *  are IO addresses without an IO handler.
+ *
+ *  param:  Pointer to memory context, page number, address / MEM_PAGE_SIZE
+ *  return: '1' if the page has IO or alias addresses or is out of range, '0' if not
+ */
+int mem_ctx_page_is_io(mem_context_t *mem, int page)
+{
+    if ( page < 0 || page > (MEM_PAGES-1) )
+        return 1;
+
+    return (int) mem->page_io[page];
+}
+
+/*------------------------------------------------
+ * mem_ctx_read_is_pure()
+ *
+ *  Check if a read of an address has no side effects: an address
+ *  in a page without IO addresses, a RAM, ROM or alias address, an
+ *  IO address without a handler, or an IO address declared
+ *  with mem_ctx_define_io_pure().
+ *
+ *  param:  Pointer to memory context, memory address
+ *  return: '1' if the read has no side effects, '0' if it may have
+ */
+int mem_ctx_read_is_pure(mem_context_t *mem, int address)
+{
+    location_t     *location;
+
+    if ( address < 0 || address > (MEMORY-1) )
+        return 0;
+
+    if ( !mem->page_io[PAGE(address)] )
+        return 1;
+
+    location = &mem->location[address];
+
+    return ( location->memory_type != MEM_TYPE_IO ||
+             location->io_handler == 0 ||
+             location->io_read_pure );
+}
+
+/*------------------------------------------------
+ * mem_ctx_write_log()
+ *
+ *  Log the address and data of every write to a memory context,
+ *  including writes to ROM and IO addresses, in the order of the
+ *  writes. The log is kept by mem_ctx_init().
+ *
+ *  param:  Pointer to memory context,
+ *          pointer to write log, NULL to stop logging
+ *  return: Nothing
+ */
+void mem_ctx_write_log(mem_context_t *mem, mem_write_log_t *log)
+{
+    mem->write_log = log;
+
+    page_access(mem, 0, MEMORY-1);
+}
+
+/*------------------------------------------------
+ * define_io_range()
+ *
+ *  Mark an address range as IO, and set its IO handler table entry
+ *  if not '0'. The address range is checked by the caller.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start to end, inclusive,
+ *          IO handler table entry or '0' to keep the current handlers
+ *  return: ' 0' - ok
+ */
+static int define_io_range(mem_context_t *mem, int addr_start, int addr_end, int handler)
+{
+    int i;
+
+    for (i = addr_start; i <= addr_end; i++)
+    {
+        mem->location[i].memory_type = MEM_TYPE_IO;
+        mem->location[i].io_read_pure = 0;
+        if ( handler )
+            mem->location[i].io_handler = (uint8_t) handler;
+    }
+
+    page_markers(mem, addr_start, addr_end);
+    page_changed(mem, addr_start, addr_end);
+    page_access(mem, addr_start, addr_end);
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * add_io_handler()
+ *
+ *  Find or add an IO handler table entry.
+ *
+ *  param:  Pointer to memory context, IO handler and user pointer,
+ *          or callback_io_handler() and a callback without a user pointer
+ *  return: IO handler table entry, '0' if the table is full
+ */
+static int add_io_handler(mem_context_t *mem, mem_io_handler_t io_handler, void *user, io_handler_callback callback)
+{
+    int i;
+
+    for ( i = 1; i < mem->io_handler_count; i++ )
+    {
+        if ( mem->io_handlers[i].handler == io_handler &&
+             mem->io_handlers[i].callback == callback &&
+             (callback != 0L || mem->io_handlers[i].user == user) )
+            return i;
+    }
+
+    if ( mem->io_handler_count == MEM_IO_HANDLERS )
+        return 0;
+
+    i = mem->io_handler_count++;
+
+    mem->io_handlers[i].handler = io_handler;
+    mem->io_handlers[i].callback = callback;
+    mem->io_handlers[i].user = callback ? (void *) &mem->io_handlers[i] : user;
+
+    return i;
+}
+
+/*------------------------------------------------
+ * page_changed()
+ *
+ *  Advance the write version of all pages in an address range.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: Nothing
+ */
+static void page_changed(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int i;
+
+    for ( i = addr_start / MEM_PAGE_SIZE; i <= addr_end / MEM_PAGE_SIZE; i++ )
+    {
+        mem->page_version[i]++;
+    }
+}
+
+/*------------------------------------------------
+ * page_markers()
+ *
+ *  Set the IO and ROM markers of all pages in an address range
+ *  from the memory type of every address in the page.
+ *  A page with any IO or alias address is an IO page, and
+ *  a page with any ROM address is a ROM page.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: Nothing
+ */
+static void page_markers(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     i, address, io, rom;
+
+    for ( i = addr_start / MEM_PAGE_SIZE; i <= addr_end / MEM_PAGE_SIZE; i++ )
+    {
+        io = 0;
+        rom = 0;
+
+        for ( address = i * MEM_PAGE_SIZE; address < (i + 1) * MEM_PAGE_SIZE; address++ )
+        {
+            if ( mem->location[address].memory_type == MEM_TYPE_ROM )
+                rom = 1;
+            else if ( mem->location[address].memory_type != MEM_TYPE_RAM )
+                io = 1;
+        }
+
+        mem->page_io[i] = (uint8_t) io;
+        mem->page_rom[i] = (uint8_t) rom;
+    }
+}
+
+/*------------------------------------------------
+ * page_access()
+ *
+ *  Set the direct read and write data of all pages
+ *  in an address range from the page markers.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: Nothing
+ */
+static void page_access(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     i;
+
+    for ( i = addr_start / MEM_PAGE_SIZE; i <= addr_end / MEM_PAGE_SIZE; i++ )
+    {
+        if ( mem->page_io[i] )
+            mem->pages.page_read[i] = 0L;
+        else
+            mem->pages.page_read[i] = PAGE_DATA(mem, i);
+
+        if ( mem->page_io[i] || PAGE_ROM(mem, i) || mem->page_code[i] ||
+             mem->page_watch[i] || mem->write_log )
+            mem->pages.page_write[i] = 0L;
+        else
+            mem->pages.page_write[i] = PAGE_DATA(mem, i);
+    }
+}
+
+/*------------------------------------------------
+ * check_bank_range()
+ *
+ *  Check that an address range can be mapped to the RAM bank.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: ' 0' - ok,
+ *          '-1' - range is out of range or not whole pages
+ *          '-4' - range has IO addresses
+ */
+static int check_bank_range(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     page;
+
+    if ( addr_start < 0 || addr_start > (MEMORY-1) ||
+         addr_end < 0   || addr_end > (MEMORY-1)   ||
+         addr_start > addr_end ||
+         PAGE_OFFSET(addr_start) != 0 ||
+         PAGE_OFFSET(addr_end) != (MEM_PAGE_SIZE-1) )
+        return MEM_ADD_RANGE;
+
+    for ( page = PAGE(addr_start); page <= PAGE(addr_end); page++ )
+    {
+        if ( mem->page_io[page] )
+            return MEM_NOT_RAM;
+    }
+
+    return MEM_OK;
+}
+
+/*------------------------------------------------
+ * watch_pages()
+ *
+ *  Mark the pages of an address range whose physical RAM
+ *  is in the watch range. The caller updates the page access.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: Nothing
+ */
+static void watch_pages(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     page, physical;
+
+    for ( page = PAGE(addr_start); page <= PAGE(addr_end); page++ )
+    {
+        physical = PAGE_PHYSICAL(mem, page);
+
+        mem->page_watch[page] = ( mem->watch_start >= 0 && physical >= 0 &&
+                                  physical <= mem->watch_end &&
+                                  physical + MEM_PAGE_SIZE - 1 >= mem->watch_start );
+    }
+}
+
+/*------------------------------------------------
+ * watch_mark()
+ *
+ *  Mark the lines of an address range that are in pages
+ *  of the watch range as written, by physical RAM address.
+ *
+ *  param:  Pointer to memory context,
+ *          memory address range start and end, inclusive
+ *  return: Nothing
+ */
+static void watch_mark(mem_context_t *mem, int addr_start, int addr_end)
+{
+    int     address;
+
+    for ( address = addr_start - addr_start % MEM_WATCH_LINE; address <= addr_end; address += MEM_WATCH_LINE )
+    {
+        if ( mem->page_watch[PAGE(address)] )
+            WATCH_MARK(mem, PAGE_PHYSICAL(mem, PAGE(address)) + PAGE_OFFSET(address));
+    }
+}
+
+/*------------------------------------------------
+ * page_copy_in()
+ *
+ *  Copy a buffer to memory through the data of each page.
+ *  The address range is checked by the caller.
+ *
+ *  param:  Pointer to memory context, memory address, buffer and length
+ *  return: Nothing
+ */
+static void page_copy_in(mem_context_t *mem, int address, const uint8_t *buffer, int length)
+{
+    int     count;
+
+    while ( length > 0 )
+    {
+        count = MEM_PAGE_SIZE - PAGE_OFFSET(address);
+        if ( count > length )
+            count = length;
+
+        memcpy(PAGE_DATA(mem, PAGE(address)) + PAGE_OFFSET(address), buffer, count);
+
+        address += count;
+        buffer += count;
+        length -= count;
+    }
+}
+
+/*------------------------------------------------
+ * page_copy_out()
+ *
+ *  Copy memory to a buffer through the data of each page.
+ *  The address range is checked by the caller.
+ *
+ *  param:  Pointer to memory context, memory address, buffer and length
+ *  return: Nothing
+ */
+static void page_copy_out(mem_context_t *mem, int address, uint8_t *buffer, int length)
+{
+    int     count;
+
+    while ( length > 0 )
+    {
+        count = MEM_PAGE_SIZE - PAGE_OFFSET(address);
+        if ( count > length )
+            count = length;
+
+        memcpy(buffer, PAGE_DATA(mem, PAGE(address)) + PAGE_OFFSET(address), count);
+
+        address += count;
+        buffer += count;
+        length -= count;
+    }
+}
+
+/*------------------------------------------------
+ * callback_io_handler()
+ *
+ *  Call an IO handler callback that has no user pointer.
+ *
+ *  param:  IO handler table entry of the callback,
+ *          address, data and memory operation
+ *  return: Callback return value
+ */
+static uint8_t callback_io_handler(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    return ((io_handler_t *) user)->callback(address, data, op);
+}
+
+/*------------------------------------------------
+ * log_write()
+ *
+ *  Add a write to a write log, or count it as lost if the log is full.
+ *
+ *  param:  Pointer to write log, address and data
+ *  return: Nothing
+ */
+static void log_write(mem_write_log_t *log, int address, int data)
+{
+    if ( log->count == MEM_WRITE_LOG )
+    {
+        log->lost++;
+        return;
+    }
+
+    log->address[log->count] = (uint16_t) address;
+    log->data[log->count] = (uint8_t) data;
+    log->count++;
+}
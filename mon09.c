@@ -33,6 +33,8 @@
 #define     IO_ADDR_ACIA_CS     0xe004
 #define     IO_ADDR_ACIA_DAT    0xe005
 
+#define     RUN_CYCLES          10000   // CPU cycles per cpu_run_cycles() call
+
 /* -----------------------------------------
    Module functions
 ----------------------------------------- */
@@ -80,9 +82,11 @@ int main(int argc, char *argv[])
     printf("Starting CPU.\n");
     cpu_reset(1);
 
+    cpu_break_point(break_point);
+
     do
     {
-        cpu_run();
+        cpu_run_cycles(RUN_CYCLES);
 
         if ( cpu_get_state(&cpu_state) == CPU_RESET )
             cpu_reset(0);
@@ -216,6 +216,15 @@ void pia_init(void)
     mem_define_io(PIA1_CRA, PIA1_CRA, io_handler_pia1_cra); // Cassette tape motor control
     mem_define_io(PIA1_CRB, PIA1_CRB, io_handler_pia1_crb); // Audio multiplexer select bit.1
 
+    /* Reads without side effects, guest polling loops on them can be skipped.
+     * Reads of PIA0-B clear the field sync IRQ, and reads of PIA1-A
+     * step the cassette input bit stream.
+     */
+    mem_define_io_pure(PIA0_PA, PIA0_PA);
+    mem_define_io_pure(PIA0_CRA, PIA0_CRA);
+    mem_define_io_pure(PIA0_CRB, PIA0_CRB);
+    mem_define_io_pure(PIA1_PB, PIA1_CRB);
+
     memset(&cas_file, 0, sizeof(dir_entry_t));
 }
 
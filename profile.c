@@ -14,6 +14,7 @@
 #include    "mem.h"
 #include    "cpu.h"
 #include    "trace.h"
+#include    "symbols.h"
 #include    "bcm2835.h"
 
 /* -----------------------------------------
@@ -27,6 +28,14 @@
 #define     IO_ADDR             0xf000
 #define     RPI_GPIO            RPI_GPIO_P1_24
 
+#define     RUN_CYCLES          10000   // CPU cycles per cpu_run_cycles() call
+
+#define     PROFILE_REPORT      "profile.txt"   // Execution profile report file
+#define     PROFILE_DUMP        "profile.bin"   // Execution profile raw dump file
+#define     SYMBOL_FILE         "profile.lst"   // Optional as9 listing of the test code
+#define     CALL_GRAPH_FOLDED   "profile.folded"    // Call graph folded stacks
+#define     CALL_GRAPH_REPORT   "profile-calls.txt" // Call graph routine report
+
 /* -----------------------------------------
    Module functions
 ----------------------------------------- */
@@ -69,6 +78,11 @@ int main(int argc, char *argv[])
     printf("Initializing CPU.\n");
     cpu_init(RUN_ADDRESS);
 
+    /* Execution profile report and dump, if built with CPU_PROFILE
+     */
+    if ( cpu_profile_on_exit(PROFILE_REPORT, PROFILE_DUMP) == 0 )
+        printf("Writing execution profile to %s and %s on exit.\n", PROFILE_REPORT, PROFILE_DUMP);
+
     //break_point = 0xf099;
 
     /* Execution loop.
@@ -76,9 +90,11 @@ int main(int argc, char *argv[])
      */
     printf("Starting CPU.\n");
 
+    cpu_break_point(break_point);
+
     do
     {
-        cpu_run();
+        cpu_run_cycles(RUN_CYCLES);
 
         cpu_get_state(&cpu_state);
 
@@ -90,6 +106,15 @@ int main(int argc, char *argv[])
 
     printf("Stopped at breakpoint.\n");
 
+    /* Call graph, if built with CPU_CALL_GRAPH
+     */
+    if ( sym_load_lst(SYMBOL_FILE, LOAD_ADDRESS) >= 0 )
+        printf("Loaded symbols from %s.\n", SYMBOL_FILE);
+
+    if ( cpu_call_graph_folded(CALL_GRAPH_FOLDED, sym_name) == 0 &&
+         cpu_call_graph_report(CALL_GRAPH_REPORT, sym_name) == 0 )
+        printf("Call graph written to %s and %s.\n", CALL_GRAPH_FOLDED, CALL_GRAPH_REPORT);
+
     bcm2835_close();
     
     return 0;
@@ -281,6 +281,19 @@ uint32_t rpi_system_timer(void)
     return (uint32_t) clock();
 }
 
+/*------------------------------------------------
+ * rpi_sleep()
+ *
+ *  Release the host CPU for a time period
+ *
+ *  param:  Time in micro-seconds
+ *  return: None
+ */
+void rpi_sleep(uint32_t usec)
+{
+    usleep(usec);
+}
+
 /*------------------------------------------------
  * rpi_keyboard_read()
  *
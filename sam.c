@@ -17,12 +17,19 @@
 /* -----------------------------------------
    Local definitions
 ----------------------------------------- */
+#define     SAM_LOW_RAM_START       0x0000      // Lower 32K, RAM page 0 or 1
+#define     SAM_LOW_RAM_END         0x7fff
+#define     SAM_ROM_START           0x8000      // ROM in map type 0, RAM in map type 1
+#define     SAM_ROM_END             0xfeff
+#define     SAM_VECTOR_START        0xfff2      // Vectors read from 0xbff2 to 0xbfff
+#define     SAM_VECTOR_END          0xffff
+#define     SAM_VECTOR_TARGET       0xbff2
 
 /* -----------------------------------------
    Module static functions
 ----------------------------------------- */
-static uint8_t io_handler_vector_redirect(uint16_t address, uint8_t data, mem_operation_t op);
 static uint8_t io_handler_sam_write(uint16_t address, uint8_t data, mem_operation_t op);
+static void    sam_memory_map(void);
 
 /* -----------------------------------------
    Module globals
@@ -37,6 +44,8 @@ static struct sam_reg_t
     uint8_t memory_map_type;
 } sam_registers;
 
+static int memory_map = -1;                 // Current mapping, '-1' none
+
 /*------------------------------------------------
  * sam_init()
  *
@@ -47,36 +56,18 @@ static struct sam_reg_t
  */
 void sam_init(void)
 {
-    mem_define_io(0xfff2, 0xffff, io_handler_vector_redirect);
+    mem_define_alias(SAM_VECTOR_START, SAM_VECTOR_END, SAM_VECTOR_TARGET);
     mem_define_io(0xffc0, 0xffdf, io_handler_sam_write);
 
     sam_registers.vdg_mode = 0;             // Alphanumeric mode
     sam_registers.vdg_display_offset = 2;   // Dragon computer text page 0x0400
-    sam_registers.page = 1;                 // For compatibility, not used
+    sam_registers.page = 0;                 // Lower 32K from RAM page 0
     sam_registers.mpu_rate = 0;             // For compatibility, not used
     sam_registers.memory_size = 2;          // For compatibility, not used
-    sam_registers.memory_map_type = 0;      // For compatibility maybe future Dragon 64 emulation, not used
-}
+    sam_registers.memory_map_type = 0;      // 32K RAM and 32K ROM
 
-/*------------------------------------------------
- * io_handler_vector_redirect()
- *
- *  IO call-back handler that will redirect CPU memory access from
- *  the normal vector area 0xfff2 through 0xffff to 0xbff2 through 0xbffff
- *
- *  param:  Call address, data byte for write operation, and operation type
- *  return: Status or data byte
- */
-static uint8_t io_handler_vector_redirect(uint16_t address, uint8_t data, mem_operation_t op)
-{
-    uint8_t response = 0;
-
-    if ( op == MEM_READ )
-    {
-        response = (uint8_t) mem_read((int)(address & 0xbfff));
-    }
-
-    return response;
+    memory_map = -1;
+    sam_memory_map();
 }
 
 /*------------------------------------------------
@@ -179,6 +170,66 @@ static uint8_t io_handler_sam_write(uint16_t address, uint8_t data, mem_operatio
             case 0x13:
                 sam_registers.vdg_display_offset |= 0x40;
                 break;
+
+            /* Page bit P1
+             */
+            case 0x14:
+                sam_registers.page = 0;
+                sam_memory_map();
+                break;
+
+            case 0x15:
+                sam_registers.page = 1;
+                sam_memory_map();
+                break;
+
+            /* MPU rate
+             */
+            case 0x16:
+                sam_registers.mpu_rate &= 0xfe;
+                break;
+
+            case 0x17:
+                sam_registers.mpu_rate |= 0x01;
+                break;
+
+            case 0x18:
+                sam_registers.mpu_rate &= 0xfd;
+                break;
+
+            case 0x19:
+                sam_registers.mpu_rate |= 0x02;
+                break;
+
+            /* Memory size
+             */
+            case 0x1a:
+                sam_registers.memory_size &= 0xfe;
+                break;
+
+            case 0x1b:
+                sam_registers.memory_size |= 0x01;
+                break;
+
+            case 0x1c:
+                sam_registers.memory_size &= 0xfd;
+                break;
+
+            case 0x1d:
+                sam_registers.memory_size |= 0x02;
+                break;
+
+            /* Memory map type
+             */
+            case 0x1e:
+                sam_registers.memory_map_type = 0;
+                sam_memory_map();
+                break;
+
+            case 0x1f:
+                sam_registers.memory_map_type = 1;
+                sam_memory_map();
+                break;
         }
     }
 
@@ -190,3 +241,45 @@ static uint8_t io_handler_sam_write(uint16_t address, uint8_t data, mem_operatio
 
     return 0;
 }
+
+/*------------------------------------------------
+ * sam_memory_map()
+ *
+ *  Map the CPU address space to the 64K RAM for the memory map type
+ *  and page bit, by remapping the memory module's pages to its RAM bank,
+ *  which holds the upper 32K of RAM. In map type 0 the lower 32K comes
+ *  from RAM page 0 or 1 and the upper 32K is ROM. In map type 1 the
+ *  lower 32K is RAM page 0, the page bit has no effect, and the upper
+ *  32K up to the IO page is RAM page 1. Nothing is remapped if the
+ *  mapping did not change.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+static void sam_memory_map(void)
+{
+    int     map;
+
+    /* Map type 0 page 0 or 1, or map type 1
+     */
+    map = sam_registers.memory_map_type ? 2 : sam_registers.page;
+    if ( map == memory_map )
+        return;
+
+    memory_map = map;
+
+    if ( sam_registers.memory_map_type )
+    {
+        mem_bank_unmap(SAM_LOW_RAM_START, SAM_LOW_RAM_END);
+        mem_bank_map(SAM_ROM_START, SAM_ROM_END, 0);
+    }
+    else
+    {
+        mem_bank_unmap(SAM_ROM_START, SAM_ROM_END);
+
+        if ( sam_registers.page )
+            mem_bank_map(SAM_LOW_RAM_START, SAM_LOW_RAM_END, 0);
+        else
+            mem_bank_unmap(SAM_LOW_RAM_START, SAM_LOW_RAM_END);
+    }
+}
@@ -0,0 +1,686 @@
+/********************************************************************
+ * sam09.c
+ *
+ *  SAM memory map test.
+ *  Checks reads and writes through the pages that the SAM map type
+ *  and page bit remap to the upper 32K of RAM, CPU execution of
+ *  remapped code, the VDG display of physical RAM with the page bit
+ *  and map type set, and the Dragon 32 ROM boot with the SAM control
+ *  register writes that it performs.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "mem.h"
+#include    "cpu.h"
+#include    "sam.h"
+#include    "vdg.h"
+#include    "rpi.h"
+
+/* -----------------------------------------
+   Dragon 32 ROM image
+----------------------------------------- */
+#include    "dragon/dragon.h"
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     ROM_START               0x8000
+#define     ROM_END                 0xfeff
+#define     ROM_SIZE                (ROM_END - ROM_START + 1)
+#define     PIA_START               0xff00
+#define     PIA_END                 0xff3f
+#define     PIA_MASK                0x3f        // PIA registers, 0xff00 to 0xff3f
+#define     PIA_PORT_MASK           0x23        // PIA and register, without the mirror address bits
+#define     PIA0_PA                 0x00
+#define     PIA0_PA_IDLE            0x7f        // No key pressed, joystick comparator low
+#define     SAM_START               0xffc0
+#define     SAM_END                 0xffdf
+
+#define     SAM_P1_CLEAR            0xffd4      // SAM control register addresses
+#define     SAM_P1_SET              0xffd5
+#define     SAM_TY_CLEAR            0xffde
+#define     SAM_TY_SET              0xffdf
+#define     SAM_V0_CLEAR            0xffc0
+#define     SAM_V1_SET              0xffc3
+#define     SAM_V2_SET              0xffc5
+#define     SAM_F0_CLEAR            0xffc6      // Display offset bits F0 to F6, clear and set address pairs
+
+#define     DISPLAY_RAM             0x0400      // PMODE 4 display, physical RAM page 0 and page 1
+#define     DISPLAY_BANK            0x8400
+#define     DISPLAY_BYTES           6144
+#define     DISPLAY_PIA_MODE        0x1e        // VDG G, GM2, GM1, GM0 set, CSS clear
+#define     FB_WIDTH                256
+#define     FB_HEIGHT               192
+#define     FB_BLACK                0           // vdg.c frame buffer colors
+#define     FB_GREEN                2
+#define     FONT_WIDTH              8
+#define     FONT_HEIGHT             12
+
+#define     CODE_START              0x1000      // Map switching test program
+#define     CODE_RESULTS            0x0100
+#define     CODE_BATCH_CYCLES       1000
+#define     CODE_RUNS               200
+
+#define     BOOT_INSTRUCTIONS       2000000     // Dragon ROM boot
+#define     BOOT_SCREEN             0x0400      // Text screen
+#define     BOOT_SCREEN_COLUMNS     32
+#define     BOOT_SCREEN_ROWS        16
+#define     BOOT_SAM_WRITES         32          // Distinct SAM control writes printed
+#define     BOOT_BLANK              0x60        // Text screen space
+
+#define     CHECK(c)                check((c), #c, __LINE__)
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+int     test_map_type(void);
+int     test_code(int batch_cycles);
+int     test_display(void);
+int     test_rom_boot(void);
+void    load_rom_image(uint8_t *image);
+void    sam_display(int address);
+int     display_byte(int offset);
+int     text_cell_blank(int column, int row);
+int     check(int condition, const char *text, int line);
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+uint8_t rom_image[ROM_SIZE];
+int     failures = 0;
+uint8_t pia_registers[PIA_MASK + 1];
+uint8_t frame_buffer[FB_WIDTH * FB_HEIGHT];
+
+/* Map switching program. Calls a subroutine at 0x9000 in
+ * map type 0 (ROM), map type 1 (RAM copy), map type 0, and
+ * map type 1 after changing the RAM copy, and stores the
+ * value of A returned by each call at 0x0100 to 0x0103.
+ */
+const uint8_t code_map[] =
+{
+    0x10, 0xce, 0x20, 0x00,     // LDS  #$2000
+    0xbd, 0x90, 0x00,           // JSR  $9000       ROM, A=$11
+    0xb7, 0x01, 0x00,           // STA  $0100
+    0xb7, 0xff, 0xdf,           // STA  $FFDF       map type 1
+    0x86, 0x86,                 // LDA  #$86        LDA #$22 / RTS to RAM
+    0xb7, 0x90, 0x00,           // STA  $9000
+    0x86, 0x22,                 // LDA  #$22
+    0xb7, 0x90, 0x01,           // STA  $9001
+    0x86, 0x39,                 // LDA  #$39
+    0xb7, 0x90, 0x02,           // STA  $9002
+    0xbd, 0x90, 0x00,           // JSR  $9000       RAM, A=$22
+    0xb7, 0x01, 0x01,           // STA  $0101
+    0xb7, 0xff, 0xde,           // STA  $FFDE       map type 0
+    0xbd, 0x90, 0x00,           // JSR  $9000       ROM, A=$11
+    0xb7, 0x01, 0x02,           // STA  $0102
+    0xb7, 0xff, 0xdf,           // STA  $FFDF       map type 1
+    0x86, 0x33,                 // LDA  #$33
+    0xb7, 0x90, 0x01,           // STA  $9001       modify RAM code
+    0xbd, 0x90, 0x00,           // JSR  $9000       RAM, A=$33
+    0xb7, 0x01, 0x03,           // STA  $0103
+    0xb7, 0xff, 0xde,           // STA  $FFDE       map type 0
+    0x20, 0xfe,                 // BRA  *
+};
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: sam09
+ *
+ *  Returns '1' if any check failed.
+ *
+ */
+int main(int argc, char *argv[])
+{
+    int     i;
+
+    /* A ROM image with a different value at every address
+     * and the subroutine of the map switching program
+     */
+    for ( i = 0; i < ROM_SIZE; i++ )
+        rom_image[i] = (uint8_t)(i * 7 + 1);
+
+    rom_image[0x1000] = 0x86;   // LDA  #$11
+    rom_image[0x1001] = 0x11;
+    rom_image[0x1002] = 0x39;   // RTS
+
+    printf("SAM memory map test.\n");
+
+    printf("%-24s %s\n", "map type and page bit", test_map_type() ? "failed" : "ok");
+    printf("%-24s %s\n", "code, single steps", test_code(0) ? "failed" : "ok");
+    printf("%-24s %s\n", "code, batches", test_code(CODE_BATCH_CYCLES) ? "failed" : "ok");
+    printf("%-24s %s\n", "VDG display", test_display() ? "failed" : "ok");
+    printf("%-24s %s\n", "Dragon ROM boot", test_rom_boot() ? "failed" : "ok");
+
+    return (failures != 0);
+}
+
+/*------------------------------------------------
+ * test_map_type()
+ *
+ *  Set the map type (TY) and page bit (P1) and check
+ *  reads and writes through the remapped pages.
+ *
+ *  param:  Nothing
+ *  return: Count of failed checks
+ */
+int test_map_type(void)
+{
+    int             start = failures;
+    uint32_t        version;
+    const uint32_t *versions;
+    uint8_t         block[4] = { 1, 2, 3, 4 };
+    uint8_t         result[4];
+
+    load_rom_image(rom_image);
+
+    /* Map type 0: lower 32K RAM page 0, upper 32K ROM
+     */
+    CHECK(mem_read(ROM_START) == rom_image[0]);
+    CHECK(mem_write(ROM_START, 0x01) == MEM_ROM);
+    CHECK(mem_read(ROM_START) == rom_image[0]);
+    CHECK(mem_read(0xfffe) == rom_image[0x3ffe]);
+    CHECK(mem_write(0x1000, 0x11) == MEM_OK);
+
+    /* Map type 1: upper 32K RAM page 1, the vectors read
+     * from RAM at 0xbff2 to 0xbfff
+     */
+    mem_write(SAM_TY_SET, 0);
+    CHECK(mem_read(ROM_START) == 0);
+    CHECK(mem_write(ROM_START, 0x55) == MEM_OK);
+    CHECK(mem_read(ROM_START) == 0x55);
+    CHECK(mem_read(0xfffe) == 0);
+    mem_write(0xbffe, 0x12);
+    CHECK(mem_read(0xfffe) == 0x12);
+    CHECK(mem_write_block(0x90fe, block, 4) == MEM_OK);
+    CHECK(mem_read_block(0x90fe, result, 4) == MEM_OK);
+    CHECK(memcmp(block, result, 4) == 0);
+    CHECK(mem_read(0x9101) == 4);
+    CHECK(mem_read(0x1000) == 0x11);
+
+    /* The page bit has no effect in map type 1
+     */
+    mem_write(SAM_P1_SET, 0);
+    CHECK(mem_read(0x1000) == 0x11);
+    CHECK(mem_read(ROM_START) == 0x55);
+
+    /* Map type 0 with page bit set: ROM, and the lower
+     * 32K reads and writes RAM page 1
+     */
+    mem_write(SAM_TY_CLEAR, 0);
+    CHECK(mem_read(ROM_START) == rom_image[0]);
+    CHECK(mem_read(0x0000) == 0x55);
+    CHECK(mem_read(0x1101) == 4);
+    CHECK(mem_write(0x2000, 0x77) == MEM_OK);
+
+    /* Page bit clear: lower 32K from RAM page 0 again
+     */
+    mem_write(SAM_P1_CLEAR, 0);
+    CHECK(mem_read(0x2000) == 0);
+    CHECK(mem_read(0x1000) == 0x11);
+    CHECK(mem_read(0x0000) == 0);
+
+    mem_write(SAM_TY_SET, 0);
+    CHECK(mem_read(0xa000) == 0x77);
+    mem_write(SAM_TY_CLEAR, 0);
+    CHECK(mem_read(0xa000) == rom_image[0x2000]);
+
+    /* A map change invalidates predecoded code of the remapped pages
+     */
+    versions = mem_page_versions();
+    version = versions[ROM_START / MEM_PAGE_SIZE];
+    mem_write(SAM_TY_SET, 0);
+    mem_write(SAM_TY_CLEAR, 0);
+    CHECK(versions[ROM_START / MEM_PAGE_SIZE] == version + 2);
+
+    /* Repeated writes of the same map do not remap
+     */
+    version = versions[ROM_START / MEM_PAGE_SIZE];
+    mem_write(SAM_TY_CLEAR, 0);
+    mem_write(SAM_P1_CLEAR, 0);
+    CHECK(versions[ROM_START / MEM_PAGE_SIZE] == version);
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * test_code()
+ *
+ *  Run the map switching program, which calls the same
+ *  address in ROM and in its RAM copy, and check the
+ *  values returned by the calls.
+ *
+ *  param:  Cycles of cpu_run_cycles() batches, '0' for cpu_run() single steps
+ *  return: Count of failed checks
+ */
+int test_code(int batch_cycles)
+{
+    int     i, start = failures;
+
+    load_rom_image(rom_image);
+    mem_load(CODE_START, (uint8_t *) code_map, sizeof(code_map));
+
+    cpu_init(CODE_START);
+
+    for ( i = 0; i < CODE_RUNS; i++ )
+    {
+        if ( batch_cycles )
+            cpu_run_cycles(batch_cycles);
+        else
+            cpu_run();
+    }
+
+    CHECK(mem_read(CODE_RESULTS) == 0x11);
+    CHECK(mem_read(CODE_RESULTS + 1) == 0x22);
+    CHECK(mem_read(CODE_RESULTS + 2) == 0x11);
+    CHECK(mem_read(CODE_RESULTS + 3) == 0x33);
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * test_display()
+ *
+ *  Render a PMODE 4 display with the VDG, and check that it shows
+ *  physical RAM, which the SAM addresses whatever the page bit and
+ *  map type are: RAM page 0 while the CPU writes RAM page 1 with the
+ *  page bit set, and RAM page 1 written through the lower 32K with
+ *  the page bit set and through the upper 32K in map type 1.
+ *
+ *  param:  Nothing
+ *  return: Count of failed checks
+ */
+int test_display(void)
+{
+    vdg_render_stats_t  stats;
+    int                 i, page0, page1, start = failures;
+
+    load_rom_image(rom_image);
+
+    mem_write(SAM_V0_CLEAR, 0);
+    mem_write(SAM_V1_SET, 0);
+    mem_write(SAM_V2_SET, 0);
+    vdg_set_mode_pia(DISPLAY_PIA_MODE);
+    sam_display(DISPLAY_RAM);
+
+    for ( i = 0; i < DISPLAY_BYTES; i++ )
+        mem_write(DISPLAY_RAM + i, (uint8_t)(i * 3 + 1));
+
+    /* Page bit set: the same CPU addresses write RAM page 1
+     */
+    mem_write(SAM_P1_SET, 0);
+
+    for ( i = 0; i < DISPLAY_BYTES; i++ )
+        mem_write(DISPLAY_RAM + i, (uint8_t)(i * 5 + 2));
+
+    CHECK(mem_read_physical(DISPLAY_RAM) == 1);
+    CHECK(mem_read_physical(DISPLAY_BANK) == 2);
+
+    vdg_render();
+
+    page0 = 1;
+    for ( i = 0; i < DISPLAY_BYTES; i++ )
+    {
+        if ( display_byte(i) != (uint8_t)(i * 3 + 1) )
+            page0 = 0;
+    }
+
+    CHECK(page0);
+
+    /* Display on RAM page 1
+     */
+    sam_display(DISPLAY_BANK);
+    vdg_render();
+
+    page1 = 1;
+    for ( i = 0; i < DISPLAY_BYTES; i++ )
+    {
+        if ( display_byte(i) != (uint8_t)(i * 5 + 2) )
+            page1 = 0;
+    }
+
+    CHECK(page1);
+
+    /* Writes to RAM page 1 through the lower 32K, and through
+     * the upper 32K in map type 1, are rendered
+     */
+    mem_write(DISPLAY_RAM + 0x10, 0xa5);
+    vdg_render();
+    CHECK(display_byte(0x10) == 0xa5);
+
+    mem_write(SAM_TY_SET, 0);
+    mem_write(DISPLAY_BANK + 0x20, 0x5a);
+    vdg_render();
+    CHECK(display_byte(0x20) == 0x5a);
+    CHECK(display_byte(0x10) == 0xa5);
+
+    /* Map type 0 with page bit clear: writes to RAM page 0
+     * are not on the display
+     */
+    mem_write(SAM_TY_CLEAR, 0);
+    mem_write(SAM_P1_CLEAR, 0);
+    vdg_render();
+    vdg_get_render_stats(&stats, 1);
+
+    mem_write(DISPLAY_RAM + 0x10, 0x00);
+    vdg_render();
+    vdg_get_render_stats(&stats, 0);
+    CHECK(stats.frames_rendered == 0);
+    CHECK(display_byte(0x10) == 0xa5);
+    CHECK(display_byte(0x20) == 0x5a);
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * test_rom_boot()
+ *
+ *  Boot the Dragon 32 ROM with the SAM and a PIA stub with
+ *  no key pressed. Log the SAM control register writes of
+ *  the boot, and check that the boot reaches the BASIC 'OK'
+ *  prompt with the ROM and RAM mapped in map type 0.
+ *
+ *  param:  Nothing
+ *  return: Count of failed checks
+ */
+int test_rom_boot(void)
+{
+    static const char  prompt[] = "OK";
+
+    mem_write_log_t     log;
+    cpu_state_t         cpu_state;
+    uint16_t            sam_address[BOOT_SAM_WRITES];
+    int                 sam_count[BOOT_SAM_WRITES];
+    int                 i, j, row, column, blank, writes = 0, sam_writes = 0;
+    int                 prompt_row = -1, start = failures;
+    long                count;
+
+    /* ROM image from the Dragon 32 ROM, no cartridge
+     */
+    memset(rom_image, 0, sizeof(rom_image));
+    for ( i = 0; i < ROM_SIZE && code[i] != -1; i++ )
+        rom_image[i] = (uint8_t) code[i];
+
+    load_rom_image(rom_image);
+    mem_define_io(PIA_START, PIA_END, io_handler_pia);
+
+    log.count = 0;
+    log.lost = 0;
+    mem_ctx_write_log(mem_default_context(), &log);
+
+    cpu_init(RUN_ADDRESS);
+    cpu_reset(1);
+    cpu_run();
+    cpu_reset(0);
+
+    for ( count = 0; count < BOOT_INSTRUCTIONS; count++ )
+    {
+        cpu_run();
+
+        /* Distinct SAM control addresses written, in order
+         */
+        for ( i = 0; i < log.count; i++ )
+        {
+            if ( log.address[i] < SAM_START || log.address[i] > SAM_END )
+                continue;
+
+            writes++;
+
+            for ( j = 0; j < sam_writes; j++ )
+            {
+                if ( sam_address[j] == log.address[i] )
+                    break;
+            }
+
+            if ( j == sam_writes && sam_writes < BOOT_SAM_WRITES )
+            {
+                sam_address[j] = log.address[i];
+                sam_count[j] = 0;
+                sam_writes++;
+            }
+
+            if ( j < sam_writes )
+                sam_count[j]++;
+        }
+
+        log.count = 0;
+
+        cpu_get_state(&cpu_state);
+        if ( cpu_state.cpu_state == CPU_EXCEPTION )
+            break;
+    }
+
+    mem_ctx_write_log(mem_default_context(), 0L);
+
+    printf("%-24s %i SAM control writes:", "", writes);
+    for ( j = 0; j < sam_writes; j++ )
+    {
+        printf(" 0x%04x", sam_address[j]);
+        if ( sam_count[j] > 1 )
+            printf("(%i)", sam_count[j]);
+    }
+    printf("\n");
+
+    /* Text screen row starting with the prompt,
+     * characters in VDG code 0x40 to 0x7f
+     */
+    for ( row = 0; row < BOOT_SCREEN_ROWS && prompt_row < 0; row++ )
+    {
+        for ( column = 0; prompt[column]; column++ )
+        {
+            if ( mem_read(BOOT_SCREEN + row * BOOT_SCREEN_COLUMNS + column) != ((prompt[column] & 0x3f) | 0x40) )
+                break;
+        }
+
+        if ( !prompt[column] )
+            prompt_row = row;
+    }
+
+    CHECK(cpu_state.cpu_state != CPU_EXCEPTION);
+    CHECK(log.lost == 0);
+    CHECK(writes > 0);
+    CHECK(prompt_row >= 0);
+
+    /* The VDG shows the text screen: a blank character renders
+     * a solid cell, and the prompt row does not start with one
+     */
+    vdg_render();
+    blank = 1;
+    for ( row = 0; row < BOOT_SCREEN_ROWS; row++ )
+    {
+        for ( column = 0; column < BOOT_SCREEN_COLUMNS; column++ )
+        {
+            if ( text_cell_blank(column, row) !=
+                 (mem_read(BOOT_SCREEN + row * BOOT_SCREEN_COLUMNS + column) == BOOT_BLANK) )
+                blank = 0;
+        }
+    }
+
+    CHECK(blank);
+    CHECK(prompt_row < 0 || !text_cell_blank(0, prompt_row));
+    CHECK(mem_read(ROM_START) == rom_image[0]);
+    CHECK(mem_write(ROM_START, 0) == MEM_ROM);
+    CHECK(mem_read(0xfffe) == rom_image[0x3ffe]);
+
+    return failures - start;
+}
+
+/*------------------------------------------------
+ * load_rom_image()
+ *
+ *  Initialize memory, load a ROM image to 0x8000 to 0xfeff,
+ *  initialize the SAM in map type 0 with page bit clear,
+ *  and the VDG with the text screen at 0x0400 in alphanumeric mode.
+ *
+ *  param:  Pointer to ROM image
+ *  return: Nothing
+ */
+void load_rom_image(uint8_t *image)
+{
+    mem_init();
+    mem_load(ROM_START, image, ROM_SIZE);
+    mem_define_rom(ROM_START, ROM_END);
+
+    sam_init();
+    vdg_init();
+    vdg_set_mode_pia(0);
+}
+
+/*------------------------------------------------
+ * sam_display()
+ *
+ *  Set the SAM display offset bits F0 to F6
+ *  through the SAM control addresses.
+ *
+ *  param:  Display address, 512 byte aligned
+ *  return: Nothing
+ */
+void sam_display(int address)
+{
+    int     bit;
+
+    for ( bit = 0; bit < 7; bit++ )
+        mem_write(SAM_F0_CLEAR + 2 * bit + (((address / 512) >> bit) & 1), 0);
+}
+
+/*------------------------------------------------
+ * display_byte()
+ *
+ *  Read back a byte of a PMODE 4 display from the frame
+ *  buffer, one pixel per bit, most significant bit first.
+ *
+ *  param:  Byte offset in the display
+ *  return: Displayed byte
+ */
+int display_byte(int offset)
+{
+    int     pixel, value = 0;
+
+    for ( pixel = 0; pixel < 8; pixel++ )
+        value = (value << 1) | (frame_buffer[offset * 8 + pixel] != FB_BLACK);
+
+    return value;
+}
+
+/*------------------------------------------------
+ * text_cell_blank()
+ *
+ *  Check that a text screen character cell of the frame buffer
+ *  is solid green, as the VDG renders a blank.
+ *
+ *  param:  Text column and row
+ *  return: '1' blank, '0' not
+ */
+int text_cell_blank(int column, int row)
+{
+    int     x, y;
+
+    for ( y = 0; y < FONT_HEIGHT; y++ )
+    {
+        for ( x = 0; x < FONT_WIDTH; x++ )
+        {
+            if ( frame_buffer[(row * FONT_HEIGHT + y) * FB_WIDTH + column * FONT_WIDTH + x] != FB_GREEN )
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*------------------------------------------------
+ * check()
+ *
+ *  Count and print a failed check.
+ *
+ *  param:  Check result, check text and source line
+ *  return: Check result
+ */
+int check(int condition, const char *text, int line)
+{
+    if ( !condition )
+    {
+        printf("  check failed, sam09.c line %i: %s\n", line, text);
+        failures++;
+    }
+
+    return condition;
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub. The keyboard row input of PIA0 port A reads
+ *  no key pressed and a low joystick comparator, other
+ *  registers read the last value written to them.
+ *
+ *  param:  Call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(uint16_t address, uint8_t data, mem_operation_t op)
+{
+    if ( op == MEM_WRITE )
+    {
+        pia_registers[address & PIA_MASK] = data;
+        return data;
+    }
+
+    if ( (address & PIA_PORT_MASK) == PIA0_PA )
+        return PIA0_PA_IDLE;
+
+    return pia_registers[address & PIA_MASK];
+}
+
+/*------------------------------------------------
+ * rpi_fb_init()
+ * rpi_fb_resolution()
+ *
+ *  Frame buffer stubs, a frame buffer of one byte per pixel
+ *  for all VDG resolutions.
+ *
+ *  param:  Horizontal and vertical resolution
+ *  return: Pointer to frame buffer
+ */
+uint8_t *rpi_fb_init(int h, int v)
+{
+    return frame_buffer;
+}
+
+uint8_t *rpi_fb_resolution(int h, int v)
+{
+    memset(frame_buffer, FB_BLACK, sizeof(frame_buffer));
+    return frame_buffer;
+}
+
+/*------------------------------------------------
+ * rpi_halt()
+ *
+ *  Stop the test on a VDG error.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+void rpi_halt(void)
+{
+    printf("  VDG error, halted.\n");
+    exit(1);
+}
+
+/*------------------------------------------------
+ * _putchar()
+ *
+ *  Character output of the VDG module's printf(),
+ *  its mode change messages are not printed.
+ *
+ *  param:  Character
+ *  return: Nothing
+ */
+void _putchar(char c)
+{
+}
@@ -0,0 +1,282 @@
+/********************************************************************
+ * symbols.c
+ *
+ *  Guest symbol table module.
+ *  Names guest code addresses for the CPU call graph, from
+ *  as9 assembler listings and from the Dragon 32 ROM map.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <string.h>
+#include    <ctype.h>
+#include    <strings.h>
+
+#include    "symbols.h"
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     SYM_MAX             4096    // Symbol table entries
+#define     SYM_NAME_LENGTH     32      // Including the terminating null
+#define     LST_LINE_LENGTH     256
+
+/* as9 listing line columns, see scripts/lst2h.awk:
+ * [line] [addr] [up to 6 bytes] [original source text ...]
+ */
+#define     LST_ADDRESS_COLUMN  5
+#define     LST_SOURCE_COLUMN   29
+
+typedef struct
+{
+    int     address;
+    char    name[SYM_NAME_LENGTH];
+} symbol_t;
+
+/* -----------------------------------------
+   Module static functions
+----------------------------------------- */
+static int  find_symbol(int address, int *index);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+
+/* Symbol table sorted by address
+ */
+static symbol_t symbols[SYM_MAX];
+static int      symbol_count = 0;
+
+/* Dragon 32 ROM entry points: the ROM jump table at 0x8000, the
+ * routines it jumps to, the reset and interrupt service routines,
+ * and the RAM interrupt vectors the ROM interrupt vectors point to.
+ * The interrupt vectors in RAM are set up by the ROM at reset.
+ */
+static const struct
+{
+    int         address;
+    const char *name;
+} dragon_rom_map[] =
+{
+    { 0x0100, "SWI3_RAMVEC" },
+    { 0x0103, "SWI2_RAMVEC" },
+    { 0x0106, "SWI_RAMVEC" },
+    { 0x0109, "NMI_RAMVEC" },
+    { 0x010c, "IRQ_RAMVEC" },
+    { 0x010f, "FIRQ_RAMVEC" },
+    { 0x8000, "V_HWINIT" },
+    { 0x8003, "V_SWINIT" },
+    { 0x8006, "V_POLCAT" },
+    { 0x8009, "V_CBLINK" },
+    { 0x800c, "V_OUTCHR" },
+    { 0x800f, "V_LPTOUT" },
+    { 0x8012, "V_JOYIN" },
+    { 0x8015, "V_CASON" },
+    { 0x8018, "V_CASOFF" },
+    { 0x801b, "V_WRLDR" },
+    { 0x801e, "V_CBOUT" },
+    { 0x8021, "V_CSRDON" },
+    { 0x8024, "V_CBIN" },
+    { 0x8027, "V_BITIN" },
+    { 0x9d3d, "IRQ_SERVICE" },
+    { 0xb3b4, "RESET" },
+    { 0xb469, "FIRQ_SERVICE" },
+    { 0xbb40, "HWINIT" },          // Hardware (PIA and SAM) initialization
+    { 0xbb88, "SWINIT" },          // Software initialization
+    { 0xbbb5, "CBLINK" },          // Blink the cursor
+    { 0xbbe5, "POLCAT" },          // Scan the keyboard
+    { 0xbcab, "OUTCHR" },          // Print a character to the screen
+    { 0xbd1a, "LPTOUT" },          // Print a character to the printer
+    { 0xbd52, "JOYIN" },           // Read the joysticks
+    { 0xbda5, "BITIN" },           // Read a bit from cassette
+    { 0xbdad, "CBIN" },            // Read a byte from cassette
+    { 0xbdcf, "CASON" },           // Cassette motor on
+    { 0xbddc, "CASOFF" },          // Cassette motor off
+    { 0xbde7, "CSRDON" },          // Cassette motor on and read leader
+    { 0xbe12, "CBOUT" },           // Write a byte to cassette
+    { 0xbe68, "WRLDR" },           // Cassette motor on and write leader
+};
+
+/*------------------------------------------------
+ * sym_clear()
+ *
+ *  Remove all symbols.
+ *
+ *  param:  Nothing
+ *  return: Nothing
+ */
+void sym_clear(void)
+{
+    symbol_count = 0;
+}
+
+/*------------------------------------------------
+ * sym_add()
+ *
+ *  Add a symbol, or rename the symbol at the address.
+ *  Names longer than the symbol table name length are truncated.
+ *
+ *  param:  Address, name
+ *  return: 0- symbol added, -1- address out of range or table full
+ */
+int sym_add(int address, const char *name)
+{
+    int     index;
+
+    if ( address < 0 || address > 0xffff )
+        return -1;
+
+    if ( !find_symbol(address, &index) )
+    {
+        if ( symbol_count == SYM_MAX )
+            return -1;
+
+        memmove(&symbols[index + 1], &symbols[index], (symbol_count - index) * sizeof(symbol_t));
+        symbol_count++;
+        symbols[index].address = address;
+    }
+
+    strncpy(symbols[index].name, name, SYM_NAME_LENGTH - 1);
+    symbols[index].name[SYM_NAME_LENGTH - 1] = 0;
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * sym_load_lst()
+ *
+ *  Add the labels of an as9 assembler listing (as9 <source> -l).
+ *  EQU and SET labels are constants and are skipped. A label on
+ *  a line without an address names the next address in the listing.
+ *
+ *  param:  Listing file name, offset added to the listing addresses
+ *          when the code is loaded at a different address
+ *  return: Number of symbols added, -1- file error
+ */
+int sym_load_lst(const char *file_name, int offset)
+{
+    FILE       *file;
+    char        line[LST_LINE_LENGTH];
+    char        label[SYM_NAME_LENGTH] = {0};
+    char        directive[8];
+    char       *source;
+    int         address, length, count = 0;
+
+    file = fopen(file_name, "r");
+    if ( file == 0L )
+        return -1;
+
+    while ( fgets(line, sizeof(line), file) )
+    {
+        if ( strlen(line) <= LST_SOURCE_COLUMN )
+            continue;
+
+        /* A label starts in the first column of the source text
+         */
+        source = &line[LST_SOURCE_COLUMN];
+
+        if ( isalpha((int) source[0]) || source[0] == '_' || source[0] == '.' )
+        {
+            for ( length = 0;
+                  source[length] && !isspace((int) source[length]) && source[length] != ':';
+                  length++ );
+
+            if ( length >= SYM_NAME_LENGTH )
+                length = SYM_NAME_LENGTH - 1;
+
+            memcpy(label, source, length);
+            label[length] = 0;
+
+            if ( sscanf(&source[length + (source[length] == ':')], "%7s", directive) == 1 &&
+                 (strcasecmp(directive, "equ") == 0 || strcasecmp(directive, "set") == 0) )
+            {
+                label[0] = 0;
+                continue;
+            }
+        }
+
+        if ( label[0] == 0 ||
+             !isxdigit((int) line[LST_ADDRESS_COLUMN]) ||
+             sscanf(&line[LST_ADDRESS_COLUMN], "%4x", &address) != 1 )
+            continue;
+
+        if ( sym_add((address + offset) & 0xffff, label) == 0 )
+            count++;
+
+        label[0] = 0;
+    }
+
+    fclose(file);
+
+    return count;
+}
+
+/*------------------------------------------------
+ * sym_load_dragon_rom()
+ *
+ *  Add the Dragon 32 ROM entry points.
+ *
+ *  param:  Nothing
+ *  return: Number of symbols added
+ */
+int sym_load_dragon_rom(void)
+{
+    int     i, count = 0;
+
+    for ( i = 0; i < (int)(sizeof(dragon_rom_map) / sizeof(dragon_rom_map[0])); i++ )
+    {
+        if ( sym_add(dragon_rom_map[i].address, dragon_rom_map[i].name) == 0 )
+            count++;
+    }
+
+    return count;
+}
+
+/*------------------------------------------------
+ * sym_name()
+ *
+ *  Symbol name of an address, in the form
+ *  of a cpu_symbol_t call-back for the CPU call graph.
+ *
+ *  param:  Address
+ *  return: Pointer to symbol name, NULL if the address has no symbol
+ */
+const char *sym_name(int address)
+{
+    int     index;
+
+    if ( find_symbol(address, &index) )
+        return symbols[index].name;
+
+    return 0L;
+}
+
+/*------------------------------------------------
+ * find_symbol()
+ *
+ *  Binary search of the symbol table.
+ *
+ *  param:  Address, pointer to index of the symbol,
+ *          or of the insertion point if not found
+ *  return: 1- found, 0- not found
+ */
+static int find_symbol(int address, int *index)
+{
+    int     low = 0, high = symbol_count, middle;
+
+    while ( low < high )
+    {
+        middle = (low + high) / 2;
+
+        if ( symbols[middle].address < address )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    *index = low;
+
+    return ( low < symbol_count && symbols[low].address == address );
+}
@@ -0,0 +1,541 @@
+/********************************************************************
+ * thread09.c
+ *
+ *  MC6809E CPU emulation multiple context and thread check.
+ *  Runs every test program and the Dragon 32 ROM boot on several
+ *  threads at the same time, each thread with its own memory and
+ *  CPU context, and on the default context in the main thread.
+ *  The threads create their contexts together, so the first
+ *  cpu_create() calls race on the decode table build.
+ *  The final CPU state and memory of every thread are compared
+ *  with the default context run.
+ *
+ *  October 17, 2026
+ *
+ *******************************************************************/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <pthread.h>
+
+#include    "config.h"
+#include    "mem.h"
+#include    "cpu.h"
+
+/* -----------------------------------------
+   Include files for MC6909E test code.
+   Each test file defines a 'code' array and
+   load/run addresses, rename them on inclusion
+   so they can coexist in this module.
+----------------------------------------- */
+#define     code    code_addr
+#include    "test/addr.h"
+#undef      code
+static const int addr_load = LOAD_ADDRESS, addr_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_arith
+#include    "test/arith.h"
+#undef      code
+static const int arith_load = LOAD_ADDRESS, arith_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_bcc
+#include    "test/bcc.h"
+#undef      code
+static const int bcc_load = LOAD_ADDRESS, bcc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_branch
+#include    "test/branch.h"
+#undef      code
+static const int branch_load = LOAD_ADDRESS, branch_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_fusion
+#include    "test/fusion.h"
+#undef      code
+static const int fusion_load = LOAD_ADDRESS, fusion_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_irq
+#include    "test/irq.h"
+#undef      code
+static const int irq_load = LOAD_ADDRESS, irq_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_logic
+#include    "test/logic.h"
+#undef      code
+static const int logic_load = LOAD_ADDRESS, logic_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_misc
+#include    "test/misc.h"
+#undef      code
+static const int misc_load = LOAD_ADDRESS, misc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_prefix
+#include    "test/prefix.h"
+#undef      code
+static const int prefix_load = LOAD_ADDRESS, prefix_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_profile
+#include    "test/profile.h"
+#undef      code
+static const int profile_load = LOAD_ADDRESS, profile_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_smc
+#include    "test/smc.h"
+#undef      code
+static const int smc_load = LOAD_ADDRESS, smc_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_stack
+#include    "test/stack.h"
+#undef      code
+static const int stack_load = LOAD_ADDRESS, stack_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_swi
+#include    "test/swi.h"
+#undef      code
+static const int swi_load = LOAD_ADDRESS, swi_run = RUN_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+#define     code    code_dragon
+#include    "dragon/dragon.h"
+#undef      code
+static const int dragon_load = LOAD_ADDRESS;
+#undef      LOAD_ADDRESS
+#undef      RUN_ADDRESS
+
+/* -----------------------------------------
+   Local definitions
+----------------------------------------- */
+#define     THREAD_COUNT            8           // Default count of threads per test
+#define     THREAD_MAX              64
+#define     THREAD_BATCHES          30000       // Maximum cpu_run_cycles() batches per test
+#define     THREAD_BATCH_CYCLES     60          // Largest random batch cycle budget
+#define     DRAGON_ROM_START        0x8000
+#define     DRAGON_ROM_END          0xfeff
+#define     DRAGON_PIA_START        0xff00
+#define     DRAGON_PIA_END          0xff3f
+#define     DRAGON_VECTOR_START     0xfff0
+#define     DRAGON_VECTOR_END       0xffff
+#define     DRAGON_VECTOR_TARGET    0xbff0      // Vectors read from the top of the ROM image
+#define     IO_ADDR_ACIA_CS         0xf000      // irq.asm IO devices
+#define     IO_ADDR_ACIA_DAT        0xf001
+#define     IO_ADDR_FIRQ_ACK        0xf002
+#define     IO_ADDR_IRQ_ACK         0xf003
+#define     NMI_INTERVAL            300         // irq.asm interrupt intervals in batches
+#define     FIRQ_INTERVAL           500
+#define     IRQ_INTERVAL            700
+
+#define     TEST_CODE               0           // Test code, runs to its last instruction
+#define     TEST_IRQ                1           // Interrupt test code, runs with interrupts and IO
+#define     TEST_ROM                2           // Dragon ROM image, needs IO and reset vector
+
+typedef struct
+{
+    char       *name;
+    const int  *code;
+    int         load_address;
+    int         run_address;
+    int         type;
+} thread_test_t;
+
+/* One run of a test, on a thread or on the default contexts,
+ * and its final state
+ */
+typedef struct
+{
+    thread_test_t  *test;
+    mem_context_t  *mem;
+    cpu_context_t  *ctx;
+    cpu_state_t     state;
+    long            batches;
+    uint32_t        mem_hash;       // Hash of all memory except IO addresses
+} thread_run_t;
+
+/* -----------------------------------------
+   Module functions
+----------------------------------------- */
+void   *run_thread(void *arg);
+void    run_test(thread_run_t *run);
+int     load_code(thread_run_t *run);
+int     compare(thread_run_t *run, thread_run_t *reference);
+uint32_t memory_hash(mem_context_t *mem);
+
+uint8_t io_handler_acia(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_firq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_irq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+uint8_t io_handler_pia(void *user, uint16_t address, uint8_t data, mem_operation_t op);
+
+/* -----------------------------------------
+   Module globals
+----------------------------------------- */
+thread_test_t tests[] =
+{
+    { "addr",    code_addr,         addr_load,    addr_run,    TEST_CODE },
+    { "arith",   code_arith,        arith_load,   arith_run,   TEST_CODE },
+    { "bcc",     code_bcc,          bcc_load,     bcc_run,     TEST_CODE },
+    { "branch",  code_branch,       branch_load,  branch_run,  TEST_CODE },
+    { "fusion",  code_fusion,       fusion_load,  fusion_run,  TEST_CODE },
+    { "irq",     code_irq,          irq_load,     irq_run,     TEST_IRQ },
+    { "logic",   code_logic,        logic_load,   logic_run,   TEST_CODE },
+    { "misc",    code_misc,         misc_load,    misc_run,    TEST_CODE },
+    { "prefix",  code_prefix,       prefix_load,  prefix_run,  TEST_CODE },
+    { "profile", code_profile,      profile_load, profile_run, TEST_CODE },
+    { "smc",     code_smc,          smc_load,     smc_run,     TEST_CODE },
+    { "stack",   code_stack,        stack_load,   stack_run,   TEST_CODE },
+    { "swi",     code_swi,          swi_load,     swi_run,     TEST_CODE },
+    { "dragon",  code_dragon,       dragon_load,  0,           TEST_ROM },
+};
+
+pthread_barrier_t   start_barrier;
+
+/*------------------------------------------------
+ * main()
+ *
+ *  Usage: thread09 [threads]
+ *
+ *  Runs every test on 'threads' threads, default 8, and on the
+ *  default contexts, and compares the final states.
+ *  Returns '1' if any thread diverged.
+ *
+ */
+int main(int argc, char *argv[])
+{
+#if (CPU_CONTEXTS)
+    thread_run_t    runs[THREAD_MAX], reference;
+    pthread_t       threads[THREAD_MAX];
+    int             i, t, count = THREAD_COUNT, diverged, failed = 0;
+
+    if ( argc > 1 )
+        count = atoi(argv[1]);
+    if ( count < 1 || count > THREAD_MAX )
+        count = THREAD_COUNT;
+
+    printf("MC6809E multiple context run, %i threads per test, compared with the default context.\n", count);
+    printf("%-8s %12s %12s %12s\n", "Test", "Batches", "Cycles", "Threads");
+
+    for ( i = 0; i < sizeof(tests)/sizeof(thread_test_t); i++ )
+    {
+        /* The threads run first, so that their cpu_create() calls
+         * build the decode tables of the first test
+         */
+        pthread_barrier_init(&start_barrier, 0L, count);
+
+        for ( t = 0; t < count; t++ )
+        {
+            runs[t].test = &tests[i];
+            if ( pthread_create(&threads[t], 0L, run_thread, &runs[t]) != 0 )
+            {
+                printf("Cannot create thread.\n");
+                return 1;
+            }
+        }
+
+        for ( t = 0; t < count; t++ )
+            pthread_join(threads[t], 0L);
+
+        pthread_barrier_destroy(&start_barrier);
+
+        reference.test = &tests[i];
+        reference.mem = mem_default_context();
+        reference.ctx = cpu_default_context();
+        run_test(&reference);
+
+        diverged = 0;
+        for ( t = 0; t < count; t++ )
+        {
+            if ( runs[t].ctx == 0L )
+            {
+                printf("%-8s thread %i cannot allocate its contexts\n", tests[i].name, t);
+                diverged++;
+            }
+            else if ( compare(&runs[t], &reference) )
+            {
+                printf("%-8s thread %i diverged\n", tests[i].name, t);
+                diverged++;
+            }
+        }
+
+        printf("%-8s %12li %12llu %12s\n", tests[i].name, reference.batches,
+                (unsigned long long) reference.state.cycles, diverged ? "diverged" : "ok");
+
+        failed |= (diverged != 0);
+    }
+
+    return failed;
+#else
+    printf("Built without CPU_CONTEXTS, no tests run.\n");
+
+    return 0;
+#endif
+}
+
+/*------------------------------------------------
+ * run_thread()
+ *
+ *  Thread of one test run. Waits for all threads of the test,
+ *  creates its memory and CPU contexts, runs the test and
+ *  frees the contexts.
+ *
+ *  param:  Pointer to test run
+ *  return: NULL
+ */
+void *run_thread(void *arg)
+{
+    thread_run_t   *run = (thread_run_t *) arg;
+
+    pthread_barrier_wait(&start_barrier);
+
+    run->mem = mem_create();
+    run->ctx = 0L;
+    if ( run->mem != 0L )
+        run->ctx = cpu_create(run->mem);
+
+    if ( run->ctx != 0L )
+        run_test(run);
+
+    cpu_destroy(run->ctx);
+    mem_destroy(run->mem);
+    run->mem = 0L;
+
+    return 0L;
+}
+
+/*------------------------------------------------
+ * run_test()
+ *
+ *  Run a test with cpu_ctx_run_cycles() batches of pseudo-random
+ *  cycle budgets, the same sequence in every run, until the last
+ *  instruction of test code, an emulation exception or the
+ *  maximum count of batches. Saves the final state and a hash of
+ *  the memory.
+ *
+  *  param:  Pointer to test run
+ *  return: Nothing
+ */
+void run_test(thread_run_t *run)
+{
+    uint32_t    random = 12345;
+    int         break_point, budget;
+
+    break_point = load_code(run);
+    cpu_ctx_break_point(run->ctx, break_point);
+
+    for ( run->batches = 0; run->batches < THREAD_BATCHES; )
+    {
+        if ( run->test->type == TEST_IRQ )
+        {
+            if ( run->batches % NMI_INTERVAL == NMI_INTERVAL - 1 )
+                cpu_ctx_nmi_trigger(run->ctx);
+            if ( run->batches % FIRQ_INTERVAL == FIRQ_INTERVAL - 1 )
+                cpu_ctx_firq(run->ctx, 1);
+            if ( run->batches % IRQ_INTERVAL == IRQ_INTERVAL - 1 )
+                cpu_ctx_irq(run->ctx, 1);
+        }
+
+        random = random * 1103515245 + 12345;
+        budget = 1 + (random >> 16) % THREAD_BATCH_CYCLES;
+
+        cpu_ctx_run_cycles(run->ctx, budget);
+        cpu_ctx_get_state(run->ctx, &run->state);
+        run->batches++;
+
+        if ( run->state.pc == break_point || run->state.cpu_state == CPU_EXCEPTION )
+            break;
+    }
+
+    cpu_ctx_break_point(run->ctx, -1);
+
+    run->mem_hash = memory_hash(run->mem);
+}
+
+/*------------------------------------------------
+ * load_code()
+ *
+ *  Load test code or the Dragon ROM image into the memory
+ *  context of a run, set up its IO, and initialize the CPU.
+ *
+ *  param:  Pointer to test run
+ *  return: Break point address at the last test code instruction,
+ *          '-1' for interrupt test code and the Dragon ROM
+ */
+int load_code(thread_run_t *run)
+{
+    thread_test_t  *test = run->test;
+    int             i = 0;
+
+    mem_ctx_init(run->mem);
+
+    while ( test->code[i] != -1 )
+    {
+        mem_ctx_write(run->mem, i + test->load_address, test->code[i]);
+        i++;
+    }
+
+    if ( test->type == TEST_ROM )
+    {
+        /* Minimal Dragon 32 IO, no key pressed and
+         * reset vectors redirected to the ROM image
+         */
+        mem_ctx_define_rom(run->mem, DRAGON_ROM_START, DRAGON_ROM_END);
+        mem_ctx_define_io(run->mem, DRAGON_PIA_START, DRAGON_PIA_END, io_handler_pia, run);
+        mem_ctx_define_alias(run->mem, DRAGON_VECTOR_START, DRAGON_VECTOR_END, DRAGON_VECTOR_TARGET);
+
+        cpu_ctx_init(run->ctx, test->run_address);
+        cpu_ctx_reset(run->ctx, 1);
+        cpu_ctx_run(run->ctx);
+        cpu_ctx_reset(run->ctx, 0);
+
+        return -1;
+    }
+
+    cpu_ctx_init(run->ctx, test->run_address);
+
+    if ( test->type == TEST_IRQ )
+    {
+        mem_ctx_define_io(run->mem, IO_ADDR_ACIA_CS, IO_ADDR_ACIA_DAT, io_handler_acia, run);
+        mem_ctx_define_io(run->mem, IO_ADDR_FIRQ_ACK, IO_ADDR_FIRQ_ACK, io_handler_firq_ack, run);
+        mem_ctx_define_io(run->mem, IO_ADDR_IRQ_ACK, IO_ADDR_IRQ_ACK, io_handler_irq_ack, run);
+
+        return -1;
+    }
+
+    return (i + test->load_address - 1);
+}
+
+/*------------------------------------------------
+ * compare()
+ *
+ *  Compare the final registers, CC, run state, cycle counter,
+ *  batch count and memory hash of a thread run with the
+ *  default context run.
+ *
+ *  param:  Pointer to thread run, pointer to default context run
+ *  return: '0' same, '1' diverged
+ */
+int compare(thread_run_t *run, thread_run_t *reference)
+{
+    cpu_state_t    *cpu = &run->state, *ref = &reference->state;
+
+    return ( run->batches != reference->batches ||
+             run->mem_hash != reference->mem_hash ||
+             cpu->cycles != ref->cycles ||
+             cpu->cpu_state != ref->cpu_state ||
+             cpu->pc != ref->pc ||
+             cpu->last_pc != ref->last_pc ||
+             cpu->a != ref->a || cpu->b != ref->b ||
+             cpu->x != ref->x || cpu->y != ref->y ||
+             cpu->u != ref->u || cpu->s != ref->s ||
+             cpu->dp != ref->dp || cpu->cc != ref->cc );
+}
+
+/*------------------------------------------------
+ * memory_hash()
+ *
+ *  FNV-1a hash of the memory of a context. IO addresses are
+ *  skipped, so the hash does not call their handlers.
+ *
+ *  param:  Pointer to memory context
+ *  return: Hash
+ */
+uint32_t memory_hash(mem_context_t *mem)
+{
+    uint32_t    hash = 2166136261u;
+    int         address;
+
+    for ( address = 0; address < MEMORY; address++ )
+    {
+        if ( !mem_ctx_read_is_pure(mem, address) )
+            continue;
+
+        hash = (hash ^ mem_ctx_read(mem, address)) * 16777619u;
+    }
+
+    return hash;
+}
+
+/*------------------------------------------------
+ * io_handler_acia()
+ *
+ *  ACIA status stub, always ready to transmit.
+ *
+ *  param:  Test run, call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_acia(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    if ( address == IO_ADDR_ACIA_CS )
+        return 0x02;
+
+    return 0;
+}
+
+/*------------------------------------------------
+ * io_handler_firq_ack()
+ *
+ *  FIRQ acknowledge, removes the FIRQ request of the run's CPU context.
+ *
+ *  param:  Test run, call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_firq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    thread_run_t   *run = (thread_run_t *) user;
+
+    cpu_ctx_firq(run->ctx, 0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_irq_ack()
+ *
+ *  IRQ acknowledge, removes the IRQ request of the run's CPU context.
+ *
+ *  param:  Test run, call address, data byte for write operation, and operation type
+ *  return: Data byte
+ */
+uint8_t io_handler_irq_ack(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    thread_run_t   *run = (thread_run_t *) user;
+
+    cpu_ctx_irq(run->ctx, 0);
+
+    return data;
+}
+
+/*------------------------------------------------
+ * io_handler_pia()
+ *
+ *  PIA stub returning an idle keyboard and joystick state.
+ *
+ *  param:  Test run, call address, data byte for write operation, and operation type
+ *  return: Status or data byte
+ */
+uint8_t io_handler_pia(void *user, uint16_t address, uint8_t data, mem_operation_t op)
+{
+    return 0xff;
+}
@@ -98,6 +98,7 @@ static void vdg_draw_char(int c, int col, int row);
 static void vdg_draw_semig6(int c, int col, int row);
 static void vdg_draw_semig_ext(video_mode_t mode, int video_mem_base, int text_buffer_length);
 static video_mode_t vdg_get_mode(void);
+static int  vdg_line_dirty(int address);
 
 /* -----------------------------------------
    Module globals
@@ -110,6 +111,19 @@ static video_mode_t prev_mode;
 
 static uint8_t *fbp;
 
+static mem_context_t *vdg_mem;    // Memory context of the video memory, read with mem_ctx_read_physical()
+
+/* Video memory lines written since the last frame, and the
+ * display window, mode and color set of the last frame
+ */
+static uint32_t dirty_lines[MEM_WATCH_WORDS];
+static int      watch_base;
+static int      watch_length;
+static video_mode_t watch_mode;
+static uint8_t  watch_pia_mode;
+
+static vdg_render_stats_t render_stats;
+
 static int const resolution[][3] = {
     { SCREEN_WIDTH_PIX, SCREEN_HEIGHT_PIX, 512  },  // ALPHA_INTERNAL, 2 color 32x16 512B Default
     { SCREEN_WIDTH_PIX, SCREEN_HEIGHT_PIX, 512  },  // ALPHA_EXTERNAL, 4 color 32x16 512B
@@ -172,6 +186,9 @@ void vdg_init(void)
     video_ram_offset = 0x02;    // For offset 0x400 text screen
     sam_video_mode = 0;         // Alphanumeric
 
+    vdg_mem = mem_default_context();
+    watch_base = -1;
+
     fbp = rpi_fb_init(SCREEN_WIDTH_PIX, SCREEN_HEIGHT_PIX);
     if ( fbp == 0L )
     {
@@ -189,7 +206,11 @@ void vdg_init(void)
  * vdg_render()
  *
  *  Render video display.
- *  A full screen rendering is performed at every invocation on the function.
+ *  The video memory is read from physical RAM, as the SAM addresses it,
+ *  whatever the map type and page bit of the CPU address space are.
+ *  It is the memory module's watch range, and only the
+ *  lines of video memory written since the last call are rendered. A new
+ *  display window, video mode or color set renders the full screen.
  *  The function should be called periodically and will execute a screen refresh only
  *  if 20 milliseconds of more have elapsed since the last refresh (50Hz).
  *
@@ -204,8 +225,10 @@ void vdg_render(void)
     int     color;
     int     element;
     int     vdg_mem_base;
+    int     vdg_mem_length;
     int     vdg_mem_offset;
     int     fb_offset = 0;
+    int     fb_line_length;
 
     /* VDG/SAM mode settings
      */
@@ -224,30 +247,70 @@ void vdg_render(void)
         printf("VDG mode: %s\n", mode_name[current_mode]);
     }
 
-    /* Render screen content to RPi frame buffer
+    /* Watch the video memory of a new display window, video mode or color set,
+     * which marks all of its lines to be rendered
      */
     vdg_mem_base = video_ram_offset << 9;
+    vdg_mem_length = resolution[current_mode][RES_MEM];
+
+    if ( vdg_mem_base != watch_base || vdg_mem_length != watch_length ||
+         current_mode != watch_mode || pia_video_mode != watch_pia_mode )
+    {
+        /* A window that wraps around the top of memory watches all of it
+         */
+        if ( (vdg_mem_base + vdg_mem_length) > MEMORY )
+            mem_ctx_watch(vdg_mem, 0, MEMORY - 1);
+        else
+            mem_ctx_watch(vdg_mem, vdg_mem_base, vdg_mem_base + vdg_mem_length - 1);
+
+        watch_base = vdg_mem_base;
+        watch_length = vdg_mem_length;
+        watch_mode = current_mode;
+        watch_pia_mode = pia_video_mode;
+    }
+
+    render_stats.frames++;
 
+    if ( mem_ctx_watch_dirty(vdg_mem, dirty_lines) == 0 )
+        return;
+
+    render_stats.frames_rendered++;
+
+    for ( vdg_mem_offset = 0; vdg_mem_offset < vdg_mem_length; vdg_mem_offset += MEM_WATCH_LINE )
+    {
+        if ( vdg_line_dirty(vdg_mem_base + vdg_mem_offset) )
+            render_stats.bytes_rendered += MEM_WATCH_LINE;
+    }
+
+    /* Render the written lines of screen content to RPi frame buffer,
+     * a text row is one line of video memory
+     */
     switch ( current_mode )
     {
         case ALPHA_INTERNAL:
         case SEMI_GRAPHICS_4:
-            for ( col = 0; col < SCREEN_WIDTH_CHAR; col++ )
+            for ( row = 0; row < SCREEN_HEIGHT_CHAR; row++ )
             {
-                for ( row = 0; row < SCREEN_HEIGHT_CHAR; row++ )
+                if ( !vdg_line_dirty(row * SCREEN_WIDTH_CHAR + vdg_mem_base) )
+                    continue;
+
+                for ( col = 0; col < SCREEN_WIDTH_CHAR; col++ )
                 {
-                    c = mem_read(col + row * SCREEN_WIDTH_CHAR + vdg_mem_base);
+                    c = mem_ctx_read_physical(vdg_mem, (uint16_t) (col + row * SCREEN_WIDTH_CHAR + vdg_mem_base));
                     vdg_draw_char(c, col, row);
                 }
             }
             break;
 
         case SEMI_GRAPHICS_6:
-            for ( col = 0; col < SCREEN_WIDTH_CHAR; col++ )
+            for ( row = 0; row < SCREEN_HEIGHT_CHAR; row++ )
             {
-                for ( row = 0; row < SCREEN_HEIGHT_CHAR; row++ )
+                if ( !vdg_line_dirty(row * SCREEN_WIDTH_CHAR + vdg_mem_base) )
+                    continue;
+
+                for ( col = 0; col < SCREEN_WIDTH_CHAR; col++ )
                 {
-                    c = mem_read(col + row * SCREEN_WIDTH_CHAR + vdg_mem_base);
+                    c = mem_ctx_read_physical(vdg_mem, (uint16_t) (col + row * SCREEN_WIDTH_CHAR + vdg_mem_base));
                     vdg_draw_semig6(c, col, row);
                 }
             }
@@ -257,9 +320,21 @@ void vdg_render(void)
         case GRAPHICS_2C:
         case GRAPHICS_3C:
         case GRAPHICS_6C:
-            for ( vdg_mem_offset = 0; vdg_mem_offset < resolution[current_mode][RES_MEM]; vdg_mem_offset++)
+            fb_line_length = MEM_WATCH_LINE * ((current_mode == GRAPHICS_6C) ? 8 : 4);
+
+            for ( vdg_mem_offset = 0; vdg_mem_offset < vdg_mem_length; vdg_mem_offset++)
             {
-                vdg_data = mem_read(vdg_mem_base + vdg_mem_offset);
+                /* Skip a line of video memory that was not written
+                 */
+                if ( (vdg_mem_offset % MEM_WATCH_LINE) == 0 &&
+                     !vdg_line_dirty(vdg_mem_base + vdg_mem_offset) )
+                {
+                    vdg_mem_offset += MEM_WATCH_LINE - 1;
+                    fb_offset += fb_line_length;
+                    continue;
+                }
+
+                vdg_data = (uint8_t) mem_ctx_read_physical(vdg_mem, (uint16_t) (vdg_mem_base + vdg_mem_offset));
 
                 for ( element = 0; element < 4; element++)
                 {
@@ -281,9 +356,21 @@ void vdg_render(void)
         case GRAPHICS_2R:
         case GRAPHICS_3R:
         case GRAPHICS_6R:
-            for ( vdg_mem_offset = 0; vdg_mem_offset < resolution[current_mode][RES_MEM]; vdg_mem_offset++)
+            fb_line_length = MEM_WATCH_LINE * ((current_mode == GRAPHICS_3R) ? 16 : 8);
+
+            for ( vdg_mem_offset = 0; vdg_mem_offset < vdg_mem_length; vdg_mem_offset++)
             {
-                vdg_data = mem_read(vdg_mem_base + vdg_mem_offset);
+                /* Skip a line of video memory that was not written
+                 */
+                if ( (vdg_mem_offset % MEM_WATCH_LINE) == 0 &&
+                     !vdg_line_dirty(vdg_mem_base + vdg_mem_offset) )
+                {
+                    vdg_mem_offset += MEM_WATCH_LINE - 1;
+                    fb_offset += fb_line_length;
+                    continue;
+                }
+
+                vdg_data = (uint8_t) mem_ctx_read_physical(vdg_mem, (uint16_t) (vdg_mem_base + vdg_mem_offset));
 
                 for ( element = 0; element < 8; element++)
                 {
@@ -317,7 +404,7 @@ void vdg_render(void)
 
         case SEMI_GRAPHICS_8:
         case SEMI_GRAPHICS_12:
-            vdg_draw_semig_ext(current_mode, vdg_mem_base, resolution[current_mode][RES_MEM]);
+            vdg_draw_semig_ext(current_mode, vdg_mem_base, vdg_mem_length);
             break;
 
         case SEMI_GRAPHICS_24:
@@ -335,6 +422,27 @@ void vdg_render(void)
     }
 }
 
+/*------------------------------------------------
+ * vdg_get_render_stats()
+ *
+ *  Return the count of frames and of the bytes of video memory
+ *  rendered. A frame without written video memory renders nothing.
+ *
+ *  param:  Pointer to statistics structure, clear statistics if not '0'
+ *  return: Nothing
+ */
+void vdg_get_render_stats(vdg_render_stats_t *stats, int clear)
+{
+    *stats = render_stats;
+
+    if ( clear )
+    {
+        render_stats.frames = 0;
+        render_stats.frames_rendered = 0;
+        render_stats.bytes_rendered = 0;
+    }
+}
+
 /*------------------------------------------------
  * vdg_set_video_offset()
  *
@@ -632,7 +740,21 @@ static void vdg_draw_semig_ext(video_mode_t mode, int video_mem_base, int text_b
      */
     for ( text_buff_index = 0; text_buff_index < text_buffer_length; text_buff_index++ )
     {
-        c = mem_read(text_buff_index + video_mem_base);
+        /* Scan line of the character segments of a 32 bytes row,
+         * and skip a row that was not written
+         */
+        if ( (text_buff_index & 0x1f) == 0 )
+        {
+            char_row_index = ((text_buff_index >> 5) * segment_height) % FONT_HEIGHT;
+
+            if ( !vdg_line_dirty(text_buff_index + video_mem_base) )
+            {
+                text_buff_index += 0x1f;
+                continue;
+            }
+        }
+
+        c = mem_ctx_read_physical(vdg_mem, (uint16_t) (text_buff_index + video_mem_base));
 
         /* Mode-dependent initializations
          * for text or semigraphics:
@@ -721,19 +843,28 @@ static void vdg_draw_semig_ext(video_mode_t mode, int video_mem_base, int text_b
             }
         } /* End of render loop */
 
-        /* Move to next character segment at the end of a 32 bytes row
-         * or back to top of segment after completing character height
-         */
-        if ( (text_buff_index & 0x1f) == 0x1f )
-        {
-            char_row_index += segment_height;
-            if ( char_row_index >= FONT_HEIGHT )
-                char_row_index = 0;
-        }
-
     } /* end of outer loop */
 }
 
+/*------------------------------------------------
+ * vdg_line_dirty()
+ *
+ * Check if a line of MEM_WATCH_LINE bytes of video memory
+ * was written since the last frame.
+ *
+ * param:  Video memory address in the line
+ * return: '1' if written, '0' if not
+ *
+ */
+static int vdg_line_dirty(int address)
+{
+    int     line;
+
+    line = (address & 0xffff) / MEM_WATCH_LINE;
+
+    return (int) ((dirty_lines[line / 32] >> (line % 32)) & 1);
+}
+
 /*------------------------------------------------
  * vdg_get_mode()
  *